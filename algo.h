@@ -2437,17 +2437,17 @@ void intro_sort(RandomIter first, RandomIter last, Size depth_limit)
 
 //  unchecked_linear_insert
 template <typename RandomIter, typename T>
-void unckecked_linear_insert(RandomIter last, const T& value)
+void unckecked_linear_insert(RandomIter last, T& value)
 {
 	auto next = last;
 	--next;
 	while (value < *next)
 	{
-		*last = *next;
+		*last = mystl::move(*next);
 		last = next;
 		--next;
 	}
-	*last = value;
+	*last = mystl::move(value);
 }
 
 //  unchecked_insertion_sort
@@ -2456,7 +2456,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last)
 {
 	for (auto i = first; i != last; ++i)
 	{
-		mystl::unckecked_linear_insert(i, *i);
+		auto value = mystl::move(*i);	// Ƴ*i ںʱ
+		mystl::unckecked_linear_insert(i, value);
 	}
 }
 
@@ -2468,11 +2469,11 @@ void insertion_sort(RandomIter first, RandomIter last)
 		return;
 	for (auto i = first + 1; i != last; ++i)
 	{
-		auto value = *i;
+		auto value = mystl::move(*i);
 		if (value < *first)
 		{
-			mystl::copy_backward(first, i, i + 1);
-			*first = value;
+			mystl::move_backward(first, i, i + 1);
+			*first = mystl::move(value);
 		}
 		else
 		{
@@ -2540,7 +2541,7 @@ void intro_sort(RandomIter first, RandomIter last,
 			return;
 		}
 		--depth_limit;
-		auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
+		auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
 		auto cut = mystl::unchecked_partition(first, last, mid, comp);
 		mystl::intro_sort(cut, last, depth_limit, comp);
 		last = cut;
@@ -2549,17 +2550,17 @@ void intro_sort(RandomIter first, RandomIter last,
 
 //  unchecked_linear_insert
 template <typename RandomIter, typename T, typename Compared>
-void unchecked_linear_insert(RandomIter last, const T& value, Compared comp)
+void unchecked_linear_insert(RandomIter last, T& value, Compared comp)
 {
 	auto next = last;
 	--next;
 	while (comp(value, *next))
 	{  // βʼѰҵһɲλ
-		*last = *next;
+		*last = mystl::move(*next);
 		last = next;
 		--next;
 	}
-	*last = value;
+	*last = mystl::move(value);
 }
 
 //  unchecked_insertion_sort
@@ -2569,7 +2570,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last,
 {
 	for (auto i = first; i != last; ++i)
 	{
-		mystl::unchecked_linear_insert(i, *i, comp);
+		auto value = mystl::move(*i);	// Ƴ*i ںʱ
+		mystl::unchecked_linear_insert(i, value, comp);
 	}
 }
 
@@ -2581,11 +2583,11 @@ void insertion_sort(RandomIter first, RandomIter last, Compared comp)
 		return;
 	for (auto i = first + 1; i != last; ++i)
 	{
-		auto value = *i;
+		auto value = mystl::move(*i);
 		if (comp(value, *first))
 		{
-			mystl::copy_backward(first, i, i + 1);
-			*first = value;
+			mystl::move_backward(first, i, i + 1);
+			*first = mystl::move(value);
 		}
 		else
 		{
@@ -2632,9 +2634,9 @@ void nth_element(RandomIter first, RandomIter nth,
 		return;
 	while (last - first > 3)
 	{
-		auto cut = mystl::unchecked_partition(first, last, mystl::median(*first,
-			*(first + (last - first) / 2),
-			*(last - 1)));
+		// һݻ׼ֵʱԪػı median صֵָ
+		auto pivot = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+		auto cut = mystl::unchecked_partition(first, last, pivot);
 		if (cut <= nth)  //  nth λҶ
 			first = cut;   // Ҷνзָ
 		else
@@ -2652,9 +2654,9 @@ void nth_element(RandomIter first, RandomIter nth,
 		return;
 	while (last - first > 3)
 	{
-		auto cut = mystl::unchecked_partition(first, last, mystl::median(*first,
-			*(first + (last - first) / 2),
-			*(last - 1)), comp);
+		// һݻ׼ֵʱԪػı median صֵָ
+		auto pivot = mystl::median(*first, *(first + (last - first) / 2), *(last - 1), comp);
+		auto cut = mystl::unchecked_partition(first, last, pivot, comp);
 		if (cut <= nth)  //  nth λҶ
 			first = cut;   // Ҷνзָ
 		else
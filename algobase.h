@@ -79,15 +79,10 @@ template <typename InputIter, typename OutputIter>
 OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result,
 	mystl::input_iterator_tag)
 {
-	/*while (first != last)
+	for (; first != last; ++first, ++result)
 	{
 		*result = *first;
-		++first;
-		++last;
-	}*/
-
-	while (first != last && *first++ = *last++);
-
+	}
 	return result;
 }
 
@@ -477,7 +472,7 @@ template <typename RandomIter, typename T>
 void fill_cat(RandomIter first, RandomIter last, const T& value,
 	mystl::random_access_iterator_tag)
 {
-	fill_n(first, last - first, value);
+	mystl::fill_n(first, last - first, value);
 }
 
 template <typename ForwardIter, typename T>
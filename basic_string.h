@@ -324,9 +324,6 @@ struct char_traits<char32_t>
 };
 
 
-// ʼ basic_string ԷС buffer Сܱ
-#define STRING_INIT_SIZE 32
-
 // ģ basic_string
 // һ: ַ
 // : ȡַ͵ķʽ, ȱʡʱʹ mystl::char_traits
@@ -365,10 +362,15 @@ public:
 	// if (str.find('a') != string::npos) { /* do something */ }
 	static constexpr size_type npos = static_cast<size_type>(-1);
 
+	// ַŻ:  local_capacity ַʱֱӴڶڲ local_ Уڴ
+	// char Ϊ 15 ַchar16_t Ϊ 7 char32_t Ϊ 3 
+	static constexpr size_type local_capacity = 16 / sizeof(CharType) - 1;
+
 private:
-	iterator buffer_;		//洢ַ
+	iterator buffer_;		//洢ַָ local_ ϵڴ
 	size_type size_;		//С
-	size_type cap_;			//
+	size_type cap_;			//ĩβĿַbuffer_  cap_ + 1 λ
+	value_type local_[local_capacity + 1];	//ַĴ洢ռ
 
 public:
 	// 캯
@@ -379,35 +381,35 @@ public:
 
 	//ʹ n  ch 
 	basic_string(size_type n, value_type ch)
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		fill_init(n, ch);		//ڴ沢
 	}
 
 	// other basic_string  pos λÿ
 	basic_string(const basic_string& other, size_t pos)
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		init_from(other.buffer_, pos, other.size_ - pos);
 	}
 
 	// other basic_string  pos λÿ count ַ
 	basic_string(const basic_string& other, size_type pos, size_type count)
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		init_from(other.buffer_, pos, count);
 	}
 
 	//c ַĹ
 	basic_string(const_pointer str)
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		init_from(str, 0, char_traits::length(str));
 	}
 
 	//c ַ ͨǰcountַ
 	basic_string(const_pointer str, size_type count)
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		init_from(str, 0, count);
 	}
@@ -416,13 +418,14 @@ public:
 	template <typename Iter, typename mystl::enable_if_t<
 		mystl::is_input_iterator<Iter>::value, int> = 0>
 	basic_string(Iter first, Iter last)
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		copy_init(first, last, iterator_category(first));
 	}
 
 	// 
 	basic_string(const basic_string& rhs) noexcept
-		:buffer_{ nullptr }, size_{ 0 }, cap_{ 0 }
+		:buffer_{ local_ }, size_{ 0 }, cap_{ local_capacity }
 	{
 		init_from(rhs.buffer_, 0, rhs.size_);
 	}
@@ -431,9 +434,13 @@ public:
 	basic_string(basic_string&& rhs) noexcept
 		:buffer_{ rhs.buffer_ }, size_{ rhs.size_ }, cap_{ rhs.cap_ }
 	{
-		rhs.buffer_ = nullptr;
-		rhs.size_ = 0;
-		rhs.cap_ = 0;
+		if (rhs.is_local())
+		{
+			// ַ rhs ڲַֻܿ
+			buffer_ = local_;
+			char_traits::copy(local_, rhs.local_, size_);
+		}
+		rhs.try_init();
 	}
 
 	//ֵ
@@ -454,13 +461,18 @@ public:
 		{
 			// delete Ȼָ rhs
 			destroy_buffer();
-			buffer_ = rhs.buffer_;
+			if (rhs.is_local())
+			{
+				char_traits::copy(local_, rhs.local_, rhs.size_);
+			}
+			else
+			{
+				buffer_ = rhs.buffer_;
+				cap_ = rhs.cap_;
+			}
 			size_ = rhs.size_;
-			cap_ = rhs.cap_;
-			// rhs ָ
-			rhs.buffer_ = nullptr;
-			rhs.size_ = 0;
-			rhs.cap_ = 0;
+			// rhs ΪյĶַ
+			rhs.try_init();
 		}
 
 		return *this;
@@ -471,16 +483,19 @@ public:
 	{
 		const size_type len = char_traits::length(str);
 
-		// СҪַ ڴ
+		// СҪַ ڴ棬ȿͷţstr ָ
 		if (cap_ < len)
 		{
 			auto new_buffer = data_allocator::allocate(len + 1);
-			data_allocator::deallocate(buffer_);
+			char_traits::copy(new_buffer, str, len);
+			release_buffer(buffer_, cap_);
 			buffer_ = new_buffer;
-			cap_ = len + 1;
+			cap_ = len;
+		}
+		else
+		{
+			char_traits::move(buffer_, str, len);
 		}
-
-		char_traits::copy(buffer_, str, len);
 		size_ = len;
 		return *this;
 
@@ -488,14 +503,7 @@ public:
 	// һֵַ
 	basic_string& operator=(value_type ch)
 	{
-		if (cap_ < 1)
-		{
-			auto new_buffer = data_allocator::allocate(2);
-			data_allocator::deallocate(buffer_);
-			buffer_ = new_buffer;
-			cap_ = 2;
-		}
-
+		// Ϊ local_capacityܷһַ
 		*buffer_ = ch;
 		size_ = 1;
 		return *this;
@@ -608,8 +616,9 @@ public:
 		{
 			THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size()"
 				"in basic_string<Char,Traits>::reserve(n)");
-			auto new_buffer = data_allocator::allocate(n);
-			char_traits::move(new_buffer, buffer_, size_);
+			auto new_buffer = data_allocator::allocate(n + 1);
+			char_traits::copy(new_buffer, buffer_, size_);
+			release_buffer(buffer_, cap_);
 			buffer_ = new_buffer;
 			cap_ = n;
 		}
@@ -618,7 +627,7 @@ public:
 	// ٲõĿռ
 	void shrink_to_fit()
 	{
-		if (size_ != cap_)
+		if (!is_local() && size_ != cap_)
 		{
 			reinsert(size_);
 		}
@@ -734,7 +743,7 @@ public:
 		}
 
 
-		char_traits::move(s + count, s, count);
+		char_traits::move(s + count, s, end() - s);
 		char_traits::fill(s, ch, count);
 		size_ += count;
 		return s;
@@ -764,7 +773,7 @@ public:
 			return s;
 		}
 		
-		char_traits::move(s + len, s, len);
+		char_traits::move(s + len, s, end() - s);
 		mystl::uninitialized_copy(first, last, s);
 		size_ += len;
 		return s;
@@ -1033,9 +1042,19 @@ public:
 	{
 		if (this != &rhs)
 		{
-			mystl::swap(buffer_, rhs.buffer_);
-			mystl::swap(size_, rhs.size_);
-			mystl::swap(cap_, rhs.cap_);
+			if (!is_local() && !rhs.is_local())
+			{
+				mystl::swap(buffer_, rhs.buffer_);
+				mystl::swap(size_, rhs.size_);
+				mystl::swap(cap_, rhs.cap_);
+			}
+			else
+			{
+				// ַڶڲָֻ
+				basic_string tmp(mystl::move(rhs));
+				rhs = mystl::move(*this);
+				*this = mystl::move(tmp);
+			}
 		}
 	}
 
@@ -1076,7 +1095,7 @@ public:
 				size_type j = 1;
 				for (; j < len; ++j)
 				{
-					if ((*buffer_ + i + j) != *(str + j))
+					if (*(buffer_ + i + j) != *(str + j))
 					{
 						break;
 					}
@@ -1167,6 +1186,10 @@ public:
 	// ± pos ʼֵΪ ch Ԫأ find 
 	size_type rfind(value_type ch, size_type pos = npos) const noexcept
 	{
+		if (size_ == 0)
+		{
+			return npos;
+		}
 		if (pos >= size_)
 		{
 			pos = size_ - 1;
@@ -1186,60 +1209,16 @@ public:
 	// ± pos ʼַ str find 
 	size_type rfind(const_pointer str, size_type pos = npos) const noexcept
 	{
-		if (pos >= size_)
-		{
-			pos = size_ - 1;
-		}
-
-		const size_type len = char_traits::length(str);
-
-		if (len == 0)
-		{
-			return pos;
-		}
-		else if (len == 1)	//൱һַ
-		{
-			for (auto i = pos; i != 0; --i)
-			{
-				if (*(buffer_ + i) == *str)
-				{
-					return i;
-				}
-			}
-			return front() == *str ? 0 : npos;
-		}
-		else	//len >= 2
-		{
-			for (auto i = pos; i >= len - 1; --i)
-			{
-				if (*(buffer_ + i) == *(str + len - i))
-				{
-					size_type j = 1;
-					for (; j < len; ++j) 
-					{
-						if (*(buffer_ + i + j) != *(str + len - j - 1))
-						{
-							break;
-						}
-					}
-
-					if (j == len)
-					{
-						return i - len + 1;
-					}
-				}
-			}
-		}
-
-		return npos;
+		return rfind(str, pos, char_traits::length(str));
 	}
 
 	// ± pos ʼַ str ǰ count ַ find 
+	// pos ΪƥһַԳֵλ
 	size_type rfind(const_pointer str, size_type pos, size_type count) const noexcept
 	{
-		if (count == 0)
+		if (size_ == 0)
 		{
-			return pos;
+			return npos;
 		}
 
 		if (pos >= size_) 
@@ -1247,11 +1226,17 @@ public:
 			pos = size_ - 1;
 		}
 
+		if (count == 0)
+		{
+			return pos;
+		}
+
 		if (pos < count - 1) 
 		{
 			return npos;
 		}
-		for (auto i = pos; i >= count - 1; --i)
+		// i  pos ݼ count - 1count Ϊ 1 ʱ i ܼ 0 
+		for (auto i = pos + 1; i-- > count - 1; )
 		{
 			if (*(buffer_ + i) == *(str + count - 1))
 			{
@@ -1277,43 +1262,7 @@ public:
 	// ± pos ʼַ str find 
 	size_type rfind(const basic_string& str, size_type pos = npos) const noexcept
 	{
-		const size_type count = str.size_;
-		if (pos >= size_) 
-		{
-			pos = size_ - 1;
-		}
-
-		if (count == 0) 
-		{
-			return pos;
-		}
-
-		if (pos < count - 1)
-		{
-			return npos;
-		}
-
-		for (auto i = pos; i >= count - 1; --i)
-		{
-			if (*(buffer_ + i) == str[count - 1])
-			{
-				size_type j = 1;
-				for (; j < count; ++j)
-				{
-					if (*(buffer_ + i - j) != str[count - j - 1])
-					{
-						break;
-					}
-				}
-
-				if (j == count)
-				{
-					return i - count + 1;
-				}
-			}
-		}
-
-		return npos;
+		return rfind(str.buffer_, pos, str.size_);
 	}
 
 	// find_first_of
@@ -1648,94 +1597,81 @@ private:
 	// helper functions
 
 	// init / destroy 
+	// ΪյĶַڴ
 	void try_init() noexcept
 	{
-		try
+		buffer_ = local_;
+		size_ = 0;
+		cap_ = local_capacity;
+	}
+
+	bool is_local() const noexcept
+	{
+		return buffer_ == local_;
+	}
+
+	// ׼ n ַĿռ䣬 local_capacity ʱʹ local_
+	void init_buffer(size_type n)
+	{
+		if (n > local_capacity)
 		{
-			buffer_ = data_allocator::allocate(static_cast<size_type>(STRING_INIT_SIZE));
-			size_ = 0;
-			cap_ = 0;
+			buffer_ = data_allocator::allocate(n + 1);
+			cap_ = n;
 		}
-		catch (const std::exception&)
+	}
+
+	// ͷΪ cap  buflocal_ Ҫͷ
+	void release_buffer(pointer buf, size_type cap) noexcept
+	{
+		if (buf != local_)
 		{
-			buffer_ = nullptr;
-			size_ = 0;
-			cap_ = 0;
+			data_allocator::deallocate(buf, cap + 1);
 		}
 	}
 
 	void fill_init(size_type n, value_type ch)
 	{
-		const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-		buffer_ = data_allocator::allocate(init_size);
+		init_buffer(n);
 		char_traits::fill(buffer_, ch, n);
 		size_ = n;
-		cap_ = init_size;
 	}
 
 	template <class Iter>
 	void copy_init(Iter first, Iter last, mystl::input_iterator_tag)
 	{
-		size_type n = mystl::distance(first, last);
-		const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
 		try
 		{
-			buffer_ = data_allocator::allocate(init_size);
-			size_ = n;
-			cap_ = init_size;
+			for (; first != last; ++first)
+			{
+				push_back(*first);
+			}
 		}
 		catch (...)
 		{
-			buffer_ = nullptr;
-			size_ = 0;
-			cap_ = 0;
+			destroy_buffer();
 			throw;
 		}
-
-		for (; n > 0; --n, ++first)
-		{
-			append(*first);
-		}
 	}
 	template <class Iter>
 	void copy_init(Iter first, Iter last, mystl::forward_iterator_tag)
 	{
 		const size_type n = mystl::distance(first, last);
-		const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-		try
-		{
-			buffer_ = data_allocator::allocate(init_size);
-			size_ = n;
-			cap_ = init_size;
-			mystl::uninitialized_copy(first, last, buffer_);
-		}
-		catch (...)
-		{
-			buffer_ = nullptr;
-			size_ = 0;
-			cap_ = 0;
-			throw;
-		}
+		init_buffer(n);
+		mystl::uninitialized_copy(first, last, buffer_);
+		size_ = n;
 	}
 
 	void init_from(const_pointer src, size_type pos, size_type count)
 	{
-		const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), count + 1);
-		buffer_ = data_allocator::allocate(init_size);
+		init_buffer(count);
 		char_traits::copy(buffer_, src + pos, count);
 		size_ = count;
-		cap_ = init_size;
 	}
 
-	void destroy_buffer()
+	void destroy_buffer() noexcept
 	{
-		if (buffer_)
-		{
-			data_allocator::deallocate(buffer_, cap_);
-			buffer_ = nullptr;
-			size_ = 0;
-			cap_ = 0;
-		}
+		release_buffer(buffer_, cap_);
+		try_init();
 	}
 
 	// get raw pointer
@@ -1745,21 +1681,21 @@ private:
 		return buffer_;
 	}
 
-	// shrink_to_fit
+	// shrink_to_fitܷŽ local_ ʱضڲ
 	void reinsert(size_type size)
 	{
-		auto new_buffer = data_allocator::allocate(size);
-		try
-		{
-			char_traits::move(new_buffer, buffer_, size);
-		}
-		catch (...)
+		pointer new_buffer = local_;
+		size_type new_cap = local_capacity;
+		if (size > local_capacity)
 		{
-			data_allocator::deallocate(new_buffer);
+			new_buffer = data_allocator::allocate(size + 1);
+			new_cap = size;
 		}
+		char_traits::copy(new_buffer, buffer_, size);
+		release_buffer(buffer_, cap_);
 		buffer_ = new_buffer;
 		size_ = size;
-		cap_ = size;
+		cap_ = new_cap;
 	}
 
 	// append
@@ -1803,12 +1739,13 @@ private:
 			const size_type add = count2 - count1;
 			THROW_LENGTH_ERROR_IF(size_ > max_size() - add,
 				"basic_string<Char, Traits>'s size too big");
-			if (size_ > cap_ - add)
+			const size_type r = first - cbegin();
+			if (cap_ - size_ < add)
 			{
 				reallocate(add);
 			}
-			pointer s = const_cast<pointer>(first);
-			char_traits::move(s + count2, first + count1, end() - (first + count1));
+			pointer s = buffer_ + r;
+			char_traits::move(s + count2, s + count1, end() - (s + count1));
 			char_traits::copy(s, str, count2);
 			size_ += add;
 		}
@@ -1834,12 +1771,13 @@ private:
 			const size_type add = count2 - count1;
 			THROW_LENGTH_ERROR_IF(size_ > max_size() - add,
 				"basic_string<Char, Traits>'s size too big");
-			if (size_ > cap_ - add)
+			const size_type r = first - cbegin();
+			if (cap_ - size_ < add)
 			{
 				reallocate(add);
 			}
-			pointer s = const_cast<pointer>(first);
-			char_traits::move(s + count2, first + count1, end() - (first + count1));
+			pointer s = buffer_ + r;
+			char_traits::move(s + count2, s + count1, end() - (s + count1));
 			char_traits::fill(s, ch, count2);
 			size_ += add;
 		}
@@ -1864,12 +1802,13 @@ private:
 			const size_type add = len2 - len1;
 			THROW_LENGTH_ERROR_IF(size_ > max_size() - add,
 				"basic_string<Char, Traits>'s size too big");
-			if (size_ > cap_ - add)
+			const size_type r = first - cbegin();
+			if (cap_ - size_ < add)
 			{
 				reallocate(add);
 			}
-			pointer s = const_cast<pointer>(first);
-			char_traits::move(s + len2, first + len1, end() - (first + len1));
+			pointer s = buffer_ + r;
+			char_traits::move(s + len2, s + len1, end() - (s + len1));
 			char_traits::copy(s, first2, len2);
 			size_ += add;
 		}
@@ -1887,9 +1826,9 @@ private:
 	void reallocate(size_type need)
 	{
 		const auto new_cap = mystl::max(cap_ + need, cap_ + (cap_ >> 1));
-		auto new_buffer = data_allocator::allocate(new_cap);
-		char_traits::move(new_buffer, buffer_, size_);
-		data_allocator::deallocate(buffer_);
+		auto new_buffer = data_allocator::allocate(new_cap + 1);
+		char_traits::copy(new_buffer, buffer_, size_);
+		release_buffer(buffer_, cap_);
 		buffer_ = new_buffer;
 		cap_ = new_cap;
 	}
@@ -1898,11 +1837,11 @@ private:
 		const auto r = pos - buffer_;
 		const auto old_cap = cap_;
 		const auto new_cap = mystl::max(old_cap + n, old_cap + (old_cap >> 1));
-		auto new_buffer = data_allocator::allocate(new_cap);
+		auto new_buffer = data_allocator::allocate(new_cap + 1);
 		auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
 		auto e2 = char_traits::fill(e1, ch, n) + n;
 		char_traits::move(e2, buffer_ + r, size_ - r);
-		data_allocator::deallocate(buffer_, old_cap);
+		release_buffer(buffer_, old_cap);
 		buffer_ = new_buffer;
 		size_ += n;
 		cap_ = new_cap;
@@ -1914,11 +1853,11 @@ private:
 		const auto old_cap = cap_;
 		const size_type n = mystl::distance(first, last);
 		const auto new_cap = mystl::max(old_cap + n, old_cap + (old_cap >> 1));
-		auto new_buffer = data_allocator::allocate(new_cap);
+		auto new_buffer = data_allocator::allocate(new_cap + 1);
 		auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
-		auto e2 = mystl::uninitialized_copy_n(first, n, e1) + n;
+		auto e2 = mystl::uninitialized_copy_n(first, n, e1);
 		char_traits::move(e2, buffer_ + r, size_ - r);
-		data_allocator::deallocate(buffer_, old_cap);
+		release_buffer(buffer_, old_cap);
 		buffer_ = new_buffer;
 		size_ += n;
 		cap_ = new_cap;
@@ -2085,6 +2024,79 @@ bool operator>=(const basic_string<CharType, CharTraits>& lhs,
 	return lhs.compare(rhs) >= 0;
 }
 
+// ԿַβַȽϣʱ basic_string
+template <class CharType, class CharTraits>
+bool operator==(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) <= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	return lhs.compare(rhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator==(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return rhs.compare(lhs) <= 0;
+}
+
 //  mystl  swap
 template <class CharType, class CharTraits>
 void swap(basic_string<CharType, CharTraits>& lhs,
@@ -2097,10 +2109,9 @@ void swap(basic_string<CharType, CharTraits>& lhs,
 template <class CharType, class CharTraits>
 struct hash<basic_string<CharType, CharTraits>>
 {
-	size_t operator()(const basic_string<CharType, CharTraits>& str)
+	size_t operator()(const basic_string<CharType, CharTraits>& str) const
 	{
-		return bitwise_hash((const unsigned char*)str.c_str(),
-			str.size() * sizeof(CharType));
+		return hash_bytes(str.data(), str.size() * sizeof(CharType));
 	}
 };
 
@@ -0,0 +1,507 @@
+#ifndef MY_STL_BLOOM_FILTER_H_
+#define MY_STL_BLOOM_FILTER_H_
+
+// ͷļģ bloom_filter  blocked_bloom_filter
+// bloom_filter         : ¡ÿֵλ k λ
+// blocked_bloom_filter : зֿĲ¡ÿֵֻһ 64 ֽڵĿ
+
+// notes:
+//
+// ¡ֻشһڡ򡰿ڡcontains  false ʱֵһûв
+//  true ʱһĸʣʣСֵɾڽĲ֮ǰ˵ڵļֵ
+//
+// ߶ mystl::hash Ľٻһεõ 64 λĹϣֵ
+//   * bloom_filter ˫عϣ i λΪ h1 + i * h2 ӳ䵽 [0, m)ֻһιϣ
+//     k λͨ k ͬĻУʱ k ζȡλõ֧
+//   * blocked_bloom_filter ø 32 λѡһ飬 8  64 λɣ 32 λֱ 8 
+//     ÿиһλk ̶Ϊ 8һβֻһλȱʧ8 ֵĲͬ㣬
+//     ͬλ¼Ը bloom_filter
+//
+// Ժϲλ򣩣ǰλϣͬͬĲ졣
+//  insert  contains_batch ȼһֵλòԤȡʣʹֵĻȱʧص
+
+#include <cmath>
+#include <cstdint>
+
+#include "functional.h"
+#include "hashtable.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+namespace bloom_detail
+{
+
+// 64 λĻϺMurmurHash3  fmix64ʹȹϣֵļֵҲܵõȵλ
+inline uint64_t mix64(uint64_t h) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	return h;
+}
+
+//  32 λ x ȵӳ䵽 [0, n)ó˷ȡģ
+inline uint32_t fastrange32(uint32_t x, uint64_t n) noexcept
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(x) * n) >> 32);
+}
+
+inline size_t popcount64(uint64_t x) noexcept
+{
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return static_cast<size_t>((x * 0x0101010101010101ull) >> 56);
+}
+
+//  n ֵΪ p ʱλ-n * ln(p) / ln(2)^2
+inline double optimal_bits(size_t n, double p)
+{
+	THROW_OUT_OF_RANGE_IF(!(p > 0.0 && p < 1.0), "bloom filter false positive rate must be in (0, 1)");
+	const double ln2 = 0.69314718055994531;
+	return -static_cast<double>(n == 0 ? 1 : n) * std::log(p) / (ln2 * ln2);
+}
+
+// ÿļֵ
+constexpr size_t group = 16;
+
+} // namespace bloom_detail
+
+// ģ bloom_filter
+// һֵͣϣȱʡʹ mystl::hash
+template <typename Key, typename Hash = mystl::hash<Key>>
+class bloom_filter
+{
+public:
+	using key_type					= Key;
+	using hasher					= Hash;
+	using size_type					= size_t;
+
+private:
+	mystl::vector<uint64_t>	words_;
+	uint64_t				bit_count_;
+	uint32_t				hash_count_;
+	size_type				size_;
+	hasher					hash_;
+
+public:
+	// 캯һΪԤƲļֵΪļ
+	explicit bloom_filter(size_type expected_count, double fp_rate = 0.01,
+		const Hash& hash = Hash())
+		:size_(0), hash_(hash)
+	{
+		const double bits = bloom_detail::optimal_bits(expected_count, fp_rate);
+		THROW_LENGTH_ERROR_IF(bits > 4294967296.0, "bloom_filter<Key> too many bits");
+		bit_count_ = (static_cast<uint64_t>(std::ceil(bits)) + 63) & ~uint64_t(63);
+		const double k = std::round(bits / (expected_count == 0 ? 1 : expected_count) * 0.69314718055994531);
+		hash_count_ = static_cast<uint32_t>(mystl::max(1.0, mystl::min(k, 30.0)));
+		words_.assign(static_cast<size_type>(bit_count_ / 64), uint64_t(0));
+	}
+
+	// ֵ
+	void insert(const key_type& key)
+	{
+		set_bits(hash_of(key));
+		++size_;
+	}
+
+	//  [first, last) еļֵ
+	template <class ForwardIter>
+	void insert(ForwardIter first, ForwardIter last)
+	{
+		uint64_t hs[bloom_detail::group];
+		while (first != last)
+		{
+			size_type n = 0;
+			for (; n < bloom_detail::group && first != last; ++n, ++first)
+			{
+				hs[n] = hash_of(*first);
+				prefetch_bits(hs[n]);
+			}
+			for (size_type i = 0; i < n; ++i)
+				set_bits(hs[i]);
+			size_ += n;
+		}
+	}
+
+	// ֵܴʱ trueһʱ false
+	bool contains(const key_type& key) const
+	{
+		return test_bits(hash_of(key));
+	}
+
+	//  [first, last) еÿֵΰ contains Ľд out
+	template <class ForwardIter, class OutputIter>
+	OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		uint64_t hs[bloom_detail::group];
+		while (first != last)
+		{
+			size_type n = 0;
+			for (; n < bloom_detail::group && first != last; ++n, ++first)
+			{
+				hs[n] = hash_of(*first);
+				prefetch_bits(hs[n]);
+			}
+			for (size_type i = 0; i < n; ++i, ++out)
+				*out = test_bits(hs[i]);
+		}
+		return out;
+	}
+
+	// ϲһͬĹ߲֮ļֵ true
+	void merge(const bloom_filter& rhs)
+	{
+		THROW_RUNTIME_ERROR_IF(bit_count_ != rhs.bit_count_ || hash_count_ != rhs.hash_count_,
+			"bloom_filter<Key> cannot merge filters with different parameters");
+		for (size_type i = 0; i < words_.size(); ++i)
+			words_[i] |= rhs.words_[i];
+		size_ += rhs.size_;
+	}
+
+	bloom_filter& operator|=(const bloom_filter& rhs)
+	{
+		merge(rhs);
+		return *this;
+	}
+
+	void clear()
+	{
+		mystl::fill(words_.begin(), words_.end(), uint64_t(0));
+		size_ = 0;
+	}
+
+	// ĴظͬһֵҲ
+	size_type size() const noexcept { return size_; }
+	bool      empty() const noexcept { return size_ == 0; }
+
+	size_type bit_count() const noexcept { return static_cast<size_type>(bit_count_); }
+	size_type hash_count() const noexcept { return hash_count_; }
+	size_type memory_bytes() const noexcept { return words_.size() * sizeof(uint64_t); }
+
+	// λıƵǰļ
+	double estimated_fp_rate() const
+	{
+		size_type ones = 0;
+		for (auto w : words_)
+			ones += bloom_detail::popcount64(w);
+		return std::pow(static_cast<double>(ones) / static_cast<double>(bit_count_), hash_count_);
+	}
+
+	hasher hash_fcn() const { return hash_; }
+
+	void swap(bloom_filter& rhs) noexcept
+	{
+		words_.swap(rhs.words_);
+		mystl::swap(bit_count_, rhs.bit_count_);
+		mystl::swap(hash_count_, rhs.hash_count_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(hash_, rhs.hash_);
+	}
+
+private:
+	uint64_t hash_of(const key_type& key) const
+	{
+		return bloom_detail::mix64(static_cast<uint64_t>(hash_(key)));
+	}
+
+	//  i λãh2 Ϊλûͬĸʺܸ
+	uint32_t bit_at(uint64_t h, uint32_t i) const noexcept
+	{
+		const uint32_t h1 = static_cast<uint32_t>(h);
+		const uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1u;
+		return bloom_detail::fastrange32(h1 + i * h2, bit_count_);
+	}
+
+	void set_bits(uint64_t h)
+	{
+		for (uint32_t i = 0; i < hash_count_; ++i)
+		{
+			const uint32_t b = bit_at(h, i);
+			words_[b >> 6] |= uint64_t(1) << (b & 63);
+		}
+	}
+
+	// ڵһδλأk ζȡͬʱ
+	bool test_bits(uint64_t h) const
+	{
+		uint64_t hit = 1;
+		for (uint32_t i = 0; i < hash_count_; ++i)
+		{
+			const uint32_t b = bit_at(h, i);
+			hit &= words_[b >> 6] >> (b & 63);
+		}
+		return hit != 0;
+	}
+
+	void prefetch_bits(uint64_t h) const
+	{
+		for (uint32_t i = 0; i < hash_count_; ++i)
+			ht_prefetch(words_.data() + (bit_at(h, i) >> 6));
+	}
+};
+
+//  mystl  swap
+template <typename Key, typename Hash>
+void swap(bloom_filter<Key, Hash>& lhs, bloom_filter<Key, Hash>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ blocked_bloom_filter
+// һֵͣϣȱʡʹ mystl::hash
+template <typename Key, typename Hash = mystl::hash<Key>>
+class blocked_bloom_filter
+{
+public:
+	using key_type					= Key;
+	using hasher					= Hash;
+	using size_type					= size_t;
+
+private:
+	// ÿ 8 ֣һ
+	static constexpr size_type block_words = 8;
+	static constexpr size_type block_bytes = block_words * sizeof(uint64_t);
+
+	using word_allocator			= mystl::allocator<uint64_t>;
+
+	uint64_t*	raw_;			// 䵽ڴ棬 block_words - 1 ڶ
+	uint64_t*	blocks_;		// raw_ еһ 64 ֽڶλ
+	size_type	block_count_;
+	size_type	size_;
+	hasher		hash_;
+
+public:
+	// 캯һΪԤƲļֵΪļ
+	explicit blocked_bloom_filter(size_type expected_count, double fp_rate = 0.01,
+		const Hash& hash = Hash())
+		:raw_(nullptr), blocks_(nullptr), size_(0), hash_(hash)
+	{
+		// k ̶Ϊ 8 ʱλΪ -8n / ln(1 - p^(1/8))ֿļʱԸ
+		THROW_OUT_OF_RANGE_IF(!(fp_rate > 0.0 && fp_rate < 1.0),
+			"bloom filter false positive rate must be in (0, 1)");
+		const double n = static_cast<double>(expected_count == 0 ? 1 : expected_count);
+		const double bits = -8.0 * n / std::log(1.0 - std::pow(fp_rate, 1.0 / 8));
+		const double blocks = std::ceil(bits / (block_bytes * 8));
+		THROW_LENGTH_ERROR_IF(blocks > 4294967295.0, "blocked_bloom_filter<Key> too many bits");
+		block_count_ = static_cast<size_type>(blocks);
+		allocate();
+	}
+
+	blocked_bloom_filter(const blocked_bloom_filter& rhs)
+		:raw_(nullptr), blocks_(nullptr), block_count_(rhs.block_count_), size_(rhs.size_), hash_(rhs.hash_)
+	{
+		allocate();
+		mystl::copy(rhs.blocks_, rhs.blocks_ + word_count(), blocks_);
+	}
+
+	blocked_bloom_filter(blocked_bloom_filter&& rhs) noexcept
+		:raw_(rhs.raw_), blocks_(rhs.blocks_), block_count_(rhs.block_count_), size_(rhs.size_),
+		hash_(mystl::move(rhs.hash_))
+	{
+		rhs.raw_ = nullptr;
+		rhs.blocks_ = nullptr;
+		rhs.block_count_ = 0;
+		rhs.size_ = 0;
+	}
+
+	blocked_bloom_filter& operator=(const blocked_bloom_filter& rhs)
+	{
+		if (this != &rhs)
+		{
+			blocked_bloom_filter tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	blocked_bloom_filter& operator=(blocked_bloom_filter&& rhs) noexcept
+	{
+		blocked_bloom_filter tmp(mystl::move(rhs));
+		swap(tmp);
+		return *this;
+	}
+
+	~blocked_bloom_filter()
+	{
+		word_allocator::deallocate(raw_);
+	}
+
+	// ֵ
+	void insert(const key_type& key)
+	{
+		set_block(hash_of(key));
+		++size_;
+	}
+
+	//  [first, last) еļֵ
+	template <class ForwardIter>
+	void insert(ForwardIter first, ForwardIter last)
+	{
+		uint64_t hs[bloom_detail::group];
+		while (first != last)
+		{
+			size_type n = 0;
+			for (; n < bloom_detail::group && first != last; ++n, ++first)
+			{
+				hs[n] = hash_of(*first);
+				ht_prefetch(block_of(hs[n]));
+			}
+			for (size_type i = 0; i < n; ++i)
+				set_block(hs[i]);
+			size_ += n;
+		}
+	}
+
+	// ֵܴʱ trueһʱ false
+	bool contains(const key_type& key) const
+	{
+		return test_block(hash_of(key));
+	}
+
+	//  [first, last) еÿֵΰ contains Ľд out
+	template <class ForwardIter, class OutputIter>
+	OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		uint64_t hs[bloom_detail::group];
+		while (first != last)
+		{
+			size_type n = 0;
+			for (; n < bloom_detail::group && first != last; ++n, ++first)
+			{
+				hs[n] = hash_of(*first);
+				ht_prefetch(block_of(hs[n]));
+			}
+			for (size_type i = 0; i < n; ++i, ++out)
+				*out = test_block(hs[i]);
+		}
+		return out;
+	}
+
+	// ϲһͬĹ߲֮ļֵ true
+	void merge(const blocked_bloom_filter& rhs)
+	{
+		THROW_RUNTIME_ERROR_IF(block_count_ != rhs.block_count_,
+			"blocked_bloom_filter<Key> cannot merge filters with different parameters");
+		for (size_type i = 0; i < word_count(); ++i)
+			blocks_[i] |= rhs.blocks_[i];
+		size_ += rhs.size_;
+	}
+
+	blocked_bloom_filter& operator|=(const blocked_bloom_filter& rhs)
+	{
+		merge(rhs);
+		return *this;
+	}
+
+	void clear()
+	{
+		mystl::fill(blocks_, blocks_ + word_count(), uint64_t(0));
+		size_ = 0;
+	}
+
+	// ĴظͬһֵҲ
+	size_type size() const noexcept { return size_; }
+	bool      empty() const noexcept { return size_ == 0; }
+
+	size_type bit_count() const noexcept { return word_count() * 64; }
+	size_type hash_count() const noexcept { return block_words; }
+	size_type block_count() const noexcept { return block_count_; }
+	size_type memory_bytes() const noexcept { return word_count() * sizeof(uint64_t); }
+
+	// λıƵǰļʣƸ鸺زӰ죬ʵʵֵԸ
+	double estimated_fp_rate() const
+	{
+		size_type ones = 0;
+		for (size_type i = 0; i < word_count(); ++i)
+			ones += bloom_detail::popcount64(blocks_[i]);
+		return std::pow(static_cast<double>(ones) / static_cast<double>(bit_count()), block_words);
+	}
+
+	hasher hash_fcn() const { return hash_; }
+
+	void swap(blocked_bloom_filter& rhs) noexcept
+	{
+		mystl::swap(raw_, rhs.raw_);
+		mystl::swap(blocks_, rhs.blocks_);
+		mystl::swap(block_count_, rhs.block_count_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(hash_, rhs.hash_);
+	}
+
+private:
+	size_type word_count() const noexcept { return block_count_ * block_words; }
+
+	void allocate()
+	{
+		raw_ = word_allocator::allocate(word_count() + block_words - 1);
+		const auto addr = reinterpret_cast<uintptr_t>(raw_);
+		blocks_ = reinterpret_cast<uint64_t*>((addr + block_bytes - 1) & ~uintptr_t(block_bytes - 1));
+		mystl::fill(blocks_, blocks_ + word_count(), uint64_t(0));
+	}
+
+	uint64_t hash_of(const key_type& key) const
+	{
+		return bloom_detail::mix64(static_cast<uint64_t>(hash_(key)));
+	}
+
+	// ɸ 32 λѡ
+	uint64_t* block_of(uint64_t h) const noexcept
+	{
+		return blocks_ + bloom_detail::fastrange32(static_cast<uint32_t>(h >> 32), block_count_) * block_words;
+	}
+
+	//  32 λԵ i ȡ˻ĸ 6 λΪ i еλ
+	static uint64_t lane_mask(uint32_t x, size_type i) noexcept
+	{
+		static constexpr uint32_t salt[block_words] = {
+			0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+			0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+		};
+		return uint64_t(1) << ((x * salt[i]) >> 26);
+	}
+
+	void set_block(uint64_t h)
+	{
+		uint64_t* block = block_of(h);
+		const uint32_t x = static_cast<uint32_t>(h);
+		for (size_type i = 0; i < block_words; ++i)
+			block[i] |= lane_mask(x, i);
+	}
+
+	bool test_block(uint64_t h) const
+	{
+		const uint64_t* block = block_of(h);
+		const uint32_t x = static_cast<uint32_t>(h);
+		uint64_t miss = 0;
+		for (size_type i = 0; i < block_words; ++i)
+			miss |= lane_mask(x, i) & ~block[i];
+		return miss == 0;
+	}
+};
+
+template <typename Key, typename Hash>
+constexpr typename blocked_bloom_filter<Key, Hash>::size_type
+blocked_bloom_filter<Key, Hash>::block_words;
+
+template <typename Key, typename Hash>
+constexpr typename blocked_bloom_filter<Key, Hash>::size_type
+blocked_bloom_filter<Key, Hash>::block_bytes;
+
+//  mystl  swap
+template <typename Key, typename Hash>
+void swap(blocked_bloom_filter<Key, Hash>& lhs, blocked_bloom_filter<Key, Hash>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_BLOOM_FILTER_H_
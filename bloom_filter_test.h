@@ -0,0 +1,297 @@
+#ifndef MY_STL_BLOOM_FILTER_TEST_H_
+#define MY_STL_BLOOM_FILTER_TEST_H_
+
+// bloom_filter test :  bloom_filter, blocked_bloom_filter ĽӿڡʵʵļʣԼ unordered_set ĲܶԱ
+
+#include "bloom_filter.h"
+#include "astring.h"
+#include "unordered_set.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace bloom_filter_test
+{
+
+//  i ֵ i һһӳ䣬˳ʹڵ i  unordered_set Ҳڲص bucket
+inline int filter_key(size_t i)
+{
+    uint32_t x = static_cast<uint32_t>(i) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2c1b3c6du;
+    x ^= x >> 12;
+    return static_cast<int>(x);
+}
+
+//  [0, len) ֵҵ [len, 2 * len) ֵеı
+template <typename Filter>
+double measured_fp_rate(size_t len, double fp_rate)
+{
+    Filter f(len, fp_rate);
+    for (size_t i = 0; i < len; ++i)
+        f.insert(filter_key(i));
+    size_t fp = 0;
+    for (size_t i = len; i < 2 * len; ++i)
+        fp += f.contains(filter_key(i)) ? 1 : 0;
+    return static_cast<double>(fp) / static_cast<double>(len);
+}
+
+//  len ֵΪ fp_rate ʱʵʵļ
+template <typename Filter>
+void fp_rate_do_test(size_t len, double fp_rate)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%.3f%%", measured_fp_rate<Filter>(len, fp_rate) * 100);
+    std::string t = buf;
+    t += "  |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// Ϊ fp_rate ʱÿֵռõλ
+template <typename Filter>
+void bits_per_key_do_test(size_t len, double fp_rate)
+{
+    char buf[16];
+    Filter f(len, fp_rate);
+    std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(f.bit_count()) / len);
+    std::string t = buf;
+    t += "    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+enum class filter_op { insert, find_miss };
+
+//  len ֵʱ C  op  len Σʱ
+template <typename C>
+void filter_op_do_test(filter_op op, size_t len)
+{
+    C c(len);
+    mystl::vector<int> keys(len);
+    for (size_t i = 0; i < len; ++i)
+        keys[i] = filter_key(i);
+    if (op != filter_op::insert)
+        c.insert(keys.begin(), keys.end());
+    // ҵļֵڣ󲿷ֱֱų
+    mystl::vector<int> misses(len);
+    for (size_t i = 0; i < len; ++i)
+        misses[i] = filter_key(len + i);
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    switch (op)
+    {
+    case filter_op::insert:
+        for (size_t i = 0; i < len; ++i)
+            c.insert(keys[i]);
+        break;
+    case filter_op::find_miss:
+        for (size_t i = 0; i < len; ++i)
+            hits += c.count(misses[i]);
+        break;
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  len ֵʱ contains_batch  len ڵļֵʱ
+template <typename Filter>
+void filter_batch_do_test(size_t len)
+{
+    Filter f(len);
+    for (size_t i = 0; i < len; ++i)
+        f.insert(filter_key(i));
+    mystl::vector<int> misses(len);
+    for (size_t i = 0; i < len; ++i)
+        misses[i] = filter_key(len + i);
+    mystl::vector<char> result(len);
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    f.contains_batch(misses.begin(), misses.end(), result.begin());
+    for (size_t i = 0; i < len; ++i)
+        hits += result[i];
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// ùҲ count unordered_set ʹͬĲԴ
+template <typename Filter>
+struct counted : public Filter
+{
+    explicit counted(size_t len) :Filter(len) {}
+    size_t count(int key) const { return this->contains(key) ? 1 : 0; }
+};
+
+#define FP_RATE_TEST(len, p1, p2, p3)                                         \
+  std::cout << "| bloom_filter        |";                                   \
+  fp_rate_do_test<mystl::bloom_filter<int>>(len, p1);                       \
+  fp_rate_do_test<mystl::bloom_filter<int>>(len, p2);                       \
+  fp_rate_do_test<mystl::bloom_filter<int>>(len, p3);                       \
+  std::cout << "\n| blocked_bloom_filter|";                                 \
+  fp_rate_do_test<mystl::blocked_bloom_filter<int>>(len, p1);               \
+  fp_rate_do_test<mystl::blocked_bloom_filter<int>>(len, p2);               \
+  fp_rate_do_test<mystl::blocked_bloom_filter<int>>(len, p3);               \
+  std::cout << "\n| bits/key (bloom)    |";                                 \
+  bits_per_key_do_test<mystl::bloom_filter<int>>(len, p1);                  \
+  bits_per_key_do_test<mystl::bloom_filter<int>>(len, p2);                  \
+  bits_per_key_do_test<mystl::bloom_filter<int>>(len, p3);                  \
+  std::cout << "\n| bits/key (blocked)  |";                                 \
+  bits_per_key_do_test<mystl::blocked_bloom_filter<int>>(len, p1);          \
+  bits_per_key_do_test<mystl::blocked_bloom_filter<int>>(len, p2);          \
+  bits_per_key_do_test<mystl::blocked_bloom_filter<int>>(len, p3);
+
+#define FILTER_OP_TEST(op, len1, len2, len3)                                  \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_set |";                                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len1);                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len2);                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len3);                   \
+  std::cout << "\n| bloom_filter        |";                                 \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len1);           \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len2);           \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len3);           \
+  std::cout << "\n| blocked_bloom_filter|";                                 \
+  filter_op_do_test<counted<mystl::blocked_bloom_filter<int>>>(op, len1);   \
+  filter_op_do_test<counted<mystl::blocked_bloom_filter<int>>>(op, len2);   \
+  filter_op_do_test<counted<mystl::blocked_bloom_filter<int>>>(op, len3);
+
+#define FILTER_BATCH_TEST(len1, len2, len3)                                   \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "| bloom_filter        |";                                   \
+  filter_batch_do_test<mystl::bloom_filter<int>>(len1);                     \
+  filter_batch_do_test<mystl::bloom_filter<int>>(len2);                     \
+  filter_batch_do_test<mystl::bloom_filter<int>>(len3);                     \
+  std::cout << "\n| blocked_bloom_filter|";                                 \
+  filter_batch_do_test<mystl::blocked_bloom_filter<int>>(len1);             \
+  filter_batch_do_test<mystl::blocked_bloom_filter<int>>(len2);             \
+  filter_batch_do_test<mystl::blocked_bloom_filter<int>>(len3);
+
+void bloom_filter_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[-------------- Run container test : bloom_filter --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = { 1,2,3,4,5 };
+    int b[] = { 6,7,8,9,10 };
+    mystl::bloom_filter<int> bf1(100);
+    mystl::bloom_filter<int> bf2(100, 0.001);
+    mystl::bloom_filter<int> bf3(100);
+    mystl::blocked_bloom_filter<int> bb1(100);
+    mystl::blocked_bloom_filter<int> bb2(100);
+    mystl::bloom_filter<mystl::string> sf(100);
+    mystl::vector<char> r(5);
+
+    bf1.insert(a, a + 5);
+    bf3.insert(6);
+    bb1.insert(a, a + 5);
+    bb2.insert(b, b + 5);
+    sf.insert("apple");
+    sf.insert("banana");
+    std::cout << std::boolalpha;
+    FUN_VALUE(bf1.empty());
+    FUN_VALUE(bf1.contains(3));
+    FUN_VALUE(bf2.contains(3));
+    FUN_VALUE(bb1.contains(5));
+    FUN_VALUE(sf.contains("apple"));
+    FUN_VALUE(sf.contains(mystl::string("banana")));
+    FUN_VALUE(bf1.size());
+    FUN_VALUE(bf1.bit_count());
+    FUN_VALUE(bf1.hash_count());
+    FUN_VALUE(bf2.bit_count());
+    FUN_VALUE(bf2.hash_count());
+    FUN_VALUE(bb1.bit_count());
+    FUN_VALUE(bb1.hash_count());
+    FUN_VALUE(bb1.block_count());
+    FUN_VALUE(bb1.memory_bytes());
+    bf1.contains_batch(a, a + 5, r.begin());
+    std::cout << " bf1.contains_batch(a, a + 5) :";
+    for (auto x : r)    std::cout << " " << (x ? "true" : "false");
+    std::cout << std::endl;
+    bb1.merge(bb2);
+    bb1.contains_batch(b, b + 5, r.begin());
+    std::cout << " after bb1.merge(bb2), bb1.contains_batch(b, b + 5) :";
+    for (auto x : r)    std::cout << " " << (x ? "true" : "false");
+    std::cout << std::endl;
+    FUN_VALUE(bb1.size());
+    bf1 |= bf3;
+    FUN_VALUE(bf1.contains(6));
+    FUN_VALUE(bf1.estimated_fp_rate());
+    try
+    {
+        bf1.merge(bf2);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << " bf1.merge(bf2) : " << e.what() << std::endl;
+    }
+    bf1.clear();
+    bb1.clear();
+    FUN_VALUE(bf1.size());
+    FUN_VALUE(bf1.contains(3));
+    FUN_VALUE(bb1.contains(5));
+    auto bb3 = bb2;
+    FUN_VALUE(bb3.contains(7));
+    bb3.swap(bb1);
+    FUN_VALUE(bb1.contains(7));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| false positive rate |" << std::setw(WIDE) << "1%   |"
+        << std::setw(WIDE) << "0.1%   |" << std::setw(WIDE) << "0.01%   |" << std::endl;
+    FP_RATE_TEST(SCALE_S(LEN2), 0.01, 0.001, 0.0001);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|       insert        |";
+#if LARGER_TEST_DATA_ON
+    FILTER_OP_TEST(filter_op::insert, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    FILTER_OP_TEST(filter_op::insert, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    find (miss)      |";
+#if LARGER_TEST_DATA_ON
+    FILTER_OP_TEST(filter_op::find_miss, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    FILTER_OP_TEST(filter_op::find_miss, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   contains_batch    |";
+#if LARGER_TEST_DATA_ON
+    FILTER_BATCH_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    FILTER_BATCH_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : bloom_filter --------------]" << std::endl;
+}
+
+} // namespace bloom_filter_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_BLOOM_FILTER_TEST_H_
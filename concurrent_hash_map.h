@@ -0,0 +1,654 @@
+#ifndef MY_STL_CONCURRENT_HASH_MAP_H_
+#define MY_STL_CONCURRENT_HASH_MAP_H_
+
+// ͷļģ concurrent_hash_map
+// concurrent_hash_map : ϣӳ䣬߳̿ͬʱҡ롢ɾ£ֵظ
+
+// notes:
+//
+// ײǷֶμlock stripingĿϣ
+//   * bucket  stripe_count ıbucket i  i % stripe_count ι
+//     ÿԼ汾šԪؼԼǰʹõ bucket 飻
+//   * дֻסֵڵĶΣ޸ģʵֵʱһ½㣬
+//     ժĽ㽻 epoch_domainȵûж߿ܳʱͷţ
+//   * ȼ¶εİ汾ţң;а汾ű仯˵һǨƣ²ң
+//   * ʱǨƣסһΣѰ汾ŸΪĽڵӵ飬ٻ飬
+//     ڴڼճдֻԼĶǨʱȴ
+// bucket i ݺ i  i + nͬһΣԪԶͬһΡ
+//
+//  unordered_map 
+//   * ṩҷʵֵĸfor_each μ
+//   * upsertcompute_if_present ĻصڶִУٵñĺ
+//   * size() ڲ޸ʱֻһֵ
+//   * ִУ󲻿ɸơƶ
+
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+
+#include "epoch.h"
+#include "hashtable.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// concurrent_hash_map Ľ㣬ֵĹϣֵ value ٸı
+template <typename T>
+struct chm_node
+{
+	std::atomic<chm_node*>	next;
+	size_t					hash;
+	T						value;
+};
+
+// bucket 飬buckets ʵʳΪ sizeͷһ
+template <typename T>
+struct chm_table
+{
+	using link_type = std::atomic<chm_node<T>*>;
+
+	size_t		size;
+	link_type	buckets[1];
+};
+
+// ģ concurrent_hash_mapֵظ
+// һֵͣʵֵͣϣȱʡʹ mystl::hash
+// ĴֵȽϷʽȱʡʹ mystl::equal_to
+template <typename Key, typename T, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+class concurrent_hash_map
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= mystl::pair<const Key, T>;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using node_type					= chm_node<value_type>;
+	using node_ptr					= node_type*;
+	using table_type				= chm_table<value_type>;
+	using table_ptr					= table_type*;
+	using link_type					= typename table_type::link_type;
+
+	using allocator_type			= mystl::allocator<value_type>;
+	using data_allocator			= mystl::allocator<value_type>;
+	using node_allocator			= mystl::allocator<node_type>;
+	using byte_allocator			= mystl::allocator<char>;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+
+	//  2 ݣҲ bucket С
+	static constexpr size_type stripe_count = 64;
+
+private:
+	// ÿζռһУⲻͬεд֮α
+	struct alignas(64) stripe
+	{
+		std::atomic<bool>		locked{ false };
+		std::atomic<uint64_t>	version{ 0 };	// ǨʱΪ
+		std::atomic<table_ptr>	table{ nullptr };
+		std::atomic<size_type>	count{ 0 };		// ֻڳʱ޸
+
+		void lock() noexcept
+		{
+			while (locked.exchange(true, std::memory_order_acquire))
+			{
+				while (locked.load(std::memory_order_relaxed))
+					std::this_thread::yield();
+			}
+		}
+
+		void unlock() noexcept
+		{
+			locked.store(false, std::memory_order_release);
+		}
+	};
+
+	// ж RAII 
+	class stripe_lock
+	{
+	private:
+		stripe& s_;
+	public:
+		explicit stripe_lock(stripe& s) noexcept :s_(s) { s_.lock(); }
+		~stripe_lock() { s_.unlock(); }
+		stripe_lock(const stripe_lock&) = delete;
+		stripe_lock& operator=(const stripe_lock&) = delete;
+	};
+
+	mutable stripe			stripes_[stripe_count];
+	std::atomic<bool>		resizing_;	// ͬһʱֻһ߳
+	float					mlf_;
+	hasher					hash_;
+	key_equal				equal_;
+	mutable epoch_domain	domain_;
+
+public:
+	// 졢
+
+	explicit concurrent_hash_map(size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:resizing_{ false }, mlf_{ 1.0f }, hash_(hash), equal_(equal)
+	{
+		table_ptr t = create_table(table_size(bucket_count));
+		for (auto& s : stripes_)
+			s.table.store(t, std::memory_order_relaxed);
+	}
+
+	template <typename InputIterator>
+	concurrent_hash_map(InputIterator first, InputIterator last,
+		const size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:concurrent_hash_map(mystl::max(bucket_count,
+			static_cast<size_type>(mystl::distance(first, last))), hash, equal)
+	{
+		insert(first, last);
+	}
+
+	concurrent_hash_map(std::initializer_list<value_type> ilist,
+		const size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:concurrent_hash_map(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	concurrent_hash_map(const concurrent_hash_map&) = delete;
+	concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+	// ûڽеݣжʹͬһ
+	~concurrent_hash_map()
+	{
+		table_ptr t = stripes_[0].table.load(std::memory_order_relaxed);
+		for (size_type i = 0; i < t->size; ++i)
+		{
+			node_ptr p = t->buckets[i].load(std::memory_order_relaxed);
+			while (p != nullptr)
+			{
+				node_ptr next = p->next.load(std::memory_order_relaxed);
+				destroy_node(p);
+				p = next;
+			}
+		}
+		destroy_table(t);
+	}
+
+public:
+	// ؽӿ
+
+	allocator_type	get_allocator()	const { return allocator_type(); }
+	hasher			hash_fcn()		const { return hash_; }
+	key_equal		key_eq()		const { return equal_; }
+
+	// 
+	bool		empty()		const noexcept { return size() == 0; }
+	size_type	max_size()	const noexcept { return static_cast<size_type>(-1); }
+
+	size_type size() const noexcept
+	{
+		size_type n = 0;
+		for (auto& s : stripes_)
+			n += s.count.load(std::memory_order_relaxed);
+		return n;
+	}
+
+	// ݹиεܲͬһ
+	size_type bucket_count() const noexcept
+	{
+		size_type n = 0;
+		for (auto& s : stripes_)
+			n = mystl::max(n, s.table.load(std::memory_order_acquire)->size);
+		return n;
+	}
+
+	float load_factor() const noexcept
+	{
+		return static_cast<float>(size()) / bucket_count();
+	}
+
+	float max_load_factor() const noexcept { return mlf_; }
+
+	// Ԫ
+
+	// ֵڣat ׳һ쳣Ԫؿʱ߳ɾ˷ʵֵĸ
+	mapped_type at(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		node_ptr p = find_node(key, hash_(key));
+		THROW_OUT_OF_RANGE_IF(p == nullptr, "concurrent_hash_map<Key, T> no such element exists");
+		return p->value.second;
+	}
+
+	// ɾ
+
+	// ǷԪأֵѴʱıԭԪ
+	template <typename ...Args>
+	bool emplace(Args&& ...args)
+	{
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		if (!insert_node(np))
+		{
+			destroy_node(np);
+			return false;
+		}
+		return true;
+	}
+
+	bool insert(const value_type& value)
+	{
+		return emplace(value);
+	}
+	bool insert(value_type&& value)
+	{
+		return emplace(mystl::move(value));
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			emplace(*first);
+	}
+
+	// ֵʱ룬ʵֵ滻Ϊ objǷԪ
+	template <typename M>
+	bool insert_or_assign(const key_type& key, M&& obj)
+	{
+		const mapped_type value(mystl::forward<M>(obj));
+		return upsert(key, value, [&value](const mapped_type&) { return value; });
+	}
+
+	// ֵʱ <key, value>ʵֵ滻Ϊ f(ԭʵֵ)ǷԪ
+	// ͬһֵϵ upsert ִУʵּȶ--д
+	template <typename F>
+	bool upsert(const key_type& key, const mapped_type& value, F f);
+
+	// ֵʱʵֵ滻Ϊ f(ԭʵֵ)ؼֵǷ
+	template <typename F>
+	bool compute_if_present(const key_type& key, F f);
+
+	// ɾֵΪ key Ԫأɾĸ0  1
+	size_type erase(const key_type& key);
+
+	// ɾȫԪأִ
+	void clear();
+
+	// 
+
+	// ҵʱʵֵƵ value 
+	bool find(const key_type& key, mapped_type& value) const
+	{
+		epoch_guard guard(domain_);
+		node_ptr p = find_node(key, hash_(key));
+		if (p == nullptr)
+			return false;
+		value = p->value.second;
+		return true;
+	}
+
+	size_type count(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		return find_node(key, hash_(key)) != nullptr ? 1 : 0;
+	}
+
+	bool contains(const key_type& key) const
+	{
+		return count(key) != 0;
+	}
+
+	// μÿԪص f(const value_type&)ÿԪһ
+	template <typename F>
+	void for_each(F f) const;
+
+	// hash policy
+
+	// ֱ bucket  count / max_load_factor()
+	void reserve(size_type count)
+	{
+		const auto n = table_size(static_cast<size_type>((float)count / mlf_ + 0.5f));
+		while (bucket_count() < n)
+		{
+			if (!resize(stripes_[0].table.load(std::memory_order_acquire)))
+				std::this_thread::yield();
+		}
+	}
+
+private:
+	// node / table
+	template <typename ...Args>
+	node_ptr create_node(Args&& ...args)
+	{
+		node_ptr p = node_allocator::allocate(1);
+		try
+		{
+			data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			node_allocator::deallocate(p);
+			throw;
+		}
+		::new (static_cast<void*>(mystl::address_of(p->next))) std::atomic<node_ptr>(nullptr);
+		p->hash = hash_(p->value.first);
+		return p;
+	}
+
+	static void destroy_node(node_ptr p)
+	{
+		data_allocator::destroy(mystl::address_of(p->value));
+		node_allocator::deallocate(p);
+	}
+
+	//  epoch_domain ɾ
+	static void destroy_retired_node(void* p)
+	{
+		destroy_node(static_cast<node_ptr>(p));
+	}
+
+	static size_type table_size(size_type n) noexcept
+	{
+		return mystl::max(stripe_count, ht_pow2_policy::next_size(n));
+	}
+
+	static table_ptr create_table(size_type n)
+	{
+		const size_t bytes = sizeof(table_type) + (n - 1) * sizeof(link_type);
+		table_ptr t = reinterpret_cast<table_ptr>(byte_allocator::allocate(bytes));
+		t->size = n;
+		for (size_type i = 0; i < n; ++i)
+			::new (static_cast<void*>(t->buckets + i)) link_type(nullptr);
+		return t;
+	}
+
+	static void destroy_table(table_ptr t)
+	{
+		byte_allocator::deallocate(reinterpret_cast<char*>(t));
+	}
+
+	static void destroy_retired_table(void* p)
+	{
+		destroy_table(static_cast<table_ptr>(p));
+	}
+
+	// ɢĹϣֵͬʱ bucketbucket Ƕı
+	static size_type stripe_index(size_type code) noexcept
+	{
+		return ht_hash_mix(code) & (stripe_count - 1);
+	}
+
+	static size_type bucket_index(size_type code, size_type n) noexcept
+	{
+		return ht_hash_mix(code) & (n - 1);
+	}
+
+	bool node_equal(const node_type* p, size_type code, const key_type& key) const
+	{
+		return p->hash == code && equal_(p->value.first, key);
+	}
+
+	// ڳжʱңֵָ key Ľӣʱ nullptr
+	link_type* find_link(table_ptr t, size_type code, const key_type& key) const
+	{
+		link_type* link = &t->buckets[bucket_index(code, t->size)];
+		for (node_ptr p = link->load(std::memory_order_relaxed); p != nullptr;
+			p = link->load(std::memory_order_relaxed))
+		{
+			if (node_equal(p, code, key))
+				return link;
+			link = &p->next;
+		}
+		return nullptr;
+	}
+
+	// Ĳң epoch_guard
+	node_ptr find_node(const key_type& key, size_type code) const;
+
+	// ½УֵѴʱ false
+	bool insert_node(node_ptr np);
+
+	// ½ np 滻 link ָĽ㣬߳ж
+	void replace_node(link_type* link, node_ptr np)
+	{
+		node_ptr old = link->load(std::memory_order_relaxed);
+		np->next.store(old->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		link->store(np, std::memory_order_release);
+		domain_.retire(old, &destroy_retired_node);
+	}
+
+	// Ԫظڵǰе bucket ʱ
+	bool overloaded(const stripe& s, table_ptr t) const noexcept
+	{
+		return static_cast<float>(s.count.load(std::memory_order_relaxed)) >
+			static_cast<float>(t->size / stripe_count) * mlf_;
+	}
+
+	//  old һold ѱ滻߳ʱ false
+	bool resize(table_ptr old);
+};
+
+/*****************************************************************************************/
+
+// ߼°汾źңʱ汾Ų˵ڼһûǨ
+// ϵĽ epoch_guard ı²ᱻͷţдֻԭӵ release д޸ӣ
+// ˼ʹ롢ɾҲֻῴ޸֮ǰ֮
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+typename concurrent_hash_map<Key, T, Hash, KeyEqual>::node_ptr
+concurrent_hash_map<Key, T, Hash, KeyEqual>::
+find_node(const key_type& key, size_type code) const
+{
+	const stripe& s = stripes_[stripe_index(code)];
+	for (;;)
+	{
+		const uint64_t version = s.version.load(std::memory_order_acquire);
+		if ((version & 1) != 0)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		table_ptr t = s.table.load(std::memory_order_acquire);
+		node_ptr p = t->buckets[bucket_index(code, t->size)].load(std::memory_order_acquire);
+		bool moved = false;
+		while (p != nullptr && !node_equal(p, code, key))
+		{
+			p = p->next.load(std::memory_order_acquire);
+			// Ǩƻд next˺ٿɿ
+			if (s.version.load(std::memory_order_acquire) != version)
+			{
+				moved = true;
+				break;
+			}
+		}
+		if (!moved && s.version.load(std::memory_order_acquire) == version)
+			return p;
+	}
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool concurrent_hash_map<Key, T, Hash, KeyEqual>::
+insert_node(node_ptr np)
+{
+	const auto code = np->hash;
+	stripe& s = stripes_[stripe_index(code)];
+	table_ptr t;
+	{
+		stripe_lock lock(s);
+		t = s.table.load(std::memory_order_relaxed);
+		if (find_link(t, code, np->value.first) != nullptr)
+			return false;
+		link_type& head = t->buckets[bucket_index(code, t->size)];
+		np->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		head.store(np, std::memory_order_release);
+		s.count.fetch_add(1, std::memory_order_relaxed);
+		if (!overloaded(s, t))
+			return true;
+	}
+	// ʱܳж
+	resize(t);
+	return true;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename F>
+bool concurrent_hash_map<Key, T, Hash, KeyEqual>::
+upsert(const key_type& key, const mapped_type& value, F f)
+{
+	const auto code = hash_(key);
+	stripe& s = stripes_[stripe_index(code)];
+	for (;;)
+	{
+		{
+			stripe_lock lock(s);
+			table_ptr t = s.table.load(std::memory_order_relaxed);
+			link_type* link = find_link(t, code, key);
+			if (link != nullptr)
+			{
+				node_ptr old = link->load(std::memory_order_relaxed);
+				replace_node(link, create_node(key, f(old->value.second)));
+				return false;
+			}
+		}
+		// ½⹹죬߳̿Ȳͬļֵʱ߸µķ֧
+		node_ptr np = create_node(key, value);
+		if (insert_node(np))
+			return true;
+		destroy_node(np);
+	}
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename F>
+bool concurrent_hash_map<Key, T, Hash, KeyEqual>::
+compute_if_present(const key_type& key, F f)
+{
+	const auto code = hash_(key);
+	stripe& s = stripes_[stripe_index(code)];
+	stripe_lock lock(s);
+	table_ptr t = s.table.load(std::memory_order_relaxed);
+	link_type* link = find_link(t, code, key);
+	if (link == nullptr)
+		return false;
+	node_ptr old = link->load(std::memory_order_relaxed);
+	replace_node(link, create_node(key, f(old->value.second)));
+	return true;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+typename concurrent_hash_map<Key, T, Hash, KeyEqual>::size_type
+concurrent_hash_map<Key, T, Hash, KeyEqual>::
+erase(const key_type& key)
+{
+	const auto code = hash_(key);
+	stripe& s = stripes_[stripe_index(code)];
+	stripe_lock lock(s);
+	table_ptr t = s.table.load(std::memory_order_relaxed);
+	link_type* link = find_link(t, code, key);
+	if (link == nullptr)
+		return 0;
+	node_ptr p = link->load(std::memory_order_relaxed);
+	// ժ p->next ֲ䣬ͣ p ϵĶܼ
+	link->store(p->next.load(std::memory_order_relaxed), std::memory_order_release);
+	s.count.fetch_sub(1, std::memory_order_relaxed);
+	domain_.retire(p, &destroy_retired_node);
+	return 1;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void concurrent_hash_map<Key, T, Hash, KeyEqual>::
+clear()
+{
+	for (size_type si = 0; si < stripe_count; ++si)
+	{
+		stripe& s = stripes_[si];
+		stripe_lock lock(s);
+		table_ptr t = s.table.load(std::memory_order_relaxed);
+		for (size_type i = si; i < t->size; i += stripe_count)
+		{
+			node_ptr p = t->buckets[i].load(std::memory_order_relaxed);
+			t->buckets[i].store(nullptr, std::memory_order_release);
+			while (p != nullptr)
+			{
+				node_ptr next = p->next.load(std::memory_order_relaxed);
+				domain_.retire(p, &destroy_retired_node);
+				p = next;
+			}
+		}
+		s.count.store(0, std::memory_order_relaxed);
+	}
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+template <typename F>
+void concurrent_hash_map<Key, T, Hash, KeyEqual>::
+for_each(F f) const
+{
+	for (size_type si = 0; si < stripe_count; ++si)
+	{
+		stripe& s = stripes_[si];
+		stripe_lock lock(s);
+		table_ptr t = s.table.load(std::memory_order_relaxed);
+		for (size_type i = si; i < t->size; i += stripe_count)
+		{
+			for (node_ptr p = t->buckets[i].load(std::memory_order_relaxed); p != nullptr;
+				p = p->next.load(std::memory_order_relaxed))
+				f(const_cast<const value_type&>(p->value));
+		}
+	}
+}
+
+// ǨƵС飬ÿǨʱֻסһ
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+bool concurrent_hash_map<Key, T, Hash, KeyEqual>::
+resize(table_ptr old)
+{
+	if (resizing_.exchange(true, std::memory_order_acquire))
+		return false;
+	if (stripes_[0].table.load(std::memory_order_acquire) != old)
+	{
+		resizing_.store(false, std::memory_order_release);
+		return false;
+	}
+	table_ptr t;
+	try
+	{
+		t = create_table(old->size * 2);
+	}
+	catch (...)
+	{
+		resizing_.store(false, std::memory_order_release);
+		throw;
+	}
+	for (size_type si = 0; si < stripe_count; ++si)
+	{
+		stripe& s = stripes_[si];
+		stripe_lock lock(s);
+		s.version.fetch_add(1, std::memory_order_acq_rel);
+		for (size_type i = si; i < old->size; i += stripe_count)
+		{
+			node_ptr p = old->buckets[i].load(std::memory_order_relaxed);
+			while (p != nullptr)
+			{
+				node_ptr next = p->next.load(std::memory_order_relaxed);
+				link_type& head = t->buckets[bucket_index(p->hash, t->size)];
+				p->next.store(head.load(std::memory_order_relaxed), std::memory_order_release);
+				head.store(p, std::memory_order_release);
+				p = next;
+			}
+		}
+		s.table.store(t, std::memory_order_release);
+		s.version.fetch_add(1, std::memory_order_release);
+	}
+	// Կж߳о
+	domain_.retire(old, &destroy_retired_table);
+	resizing_.store(false, std::memory_order_release);
+	return true;
+}
+
+} // namespace mystl
+#endif // !MY_STL_CONCURRENT_HASH_MAP_H_
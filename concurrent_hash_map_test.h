@@ -0,0 +1,244 @@
+#ifndef MY_STL_CONCURRENT_HASH_MAP_TEST_H_
+#define MY_STL_CONCURRENT_HASH_MAP_TEST_H_
+
+// concurrent_hash_map test :  concurrent_hash_map ĽӿڣԼ 1  64 ߳ڲͬдµ
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_hash_map.h"
+#include "unordered_map.h"
+#include "map_test.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace concurrent_hash_map_test
+{
+
+// concurrent_hash_map ûеֵ
+#define CHM_COUT(m) do { \
+    std::string m_name = #m; \
+    mystl::vector<mystl::pair<int, int>> elems; \
+    m.for_each([&elems](const mystl::pair<const int, int>& p) { elems.push_back(mystl::pair<int, int>(p.first, p.second)); }); \
+    mystl::sort(elems.begin(), elems.end(), [](const mystl::pair<int, int>& a, const mystl::pair<int, int>& b) { return a.first < b.first; }); \
+    std::cout << " " << m_name << " :"; \
+    for (auto& e : elems)    std::cout << " <" << e.first << "," << e.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// concurrent_hash_map ĺ
+#define CHM_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    CHM_COUT(con); \
+} while(0)
+
+// һ unordered_mapΪܲԵĶ
+struct locked_map
+{
+    mystl::unordered_map<int, int>  m;
+    mutable std::mutex              mutex;
+
+    bool find(int key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return m.find(key) != m.end();
+    }
+    void insert(int key, int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        m.emplace(key, value);
+    }
+    void erase(int key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        m.erase(key);
+    }
+};
+
+struct striped_map
+{
+    mystl::concurrent_hash_map<int, int> m;
+
+    bool find(int key) const { return m.contains(key); }
+    void insert(int key, int value) { m.emplace(key, value); }
+    void erase(int key) { m.erase(key); }
+};
+
+// threads ̶߳Ԥȷ count Ԫصӳ乲ִ count * 10 β
+// ÿβ write_percent% ĸдɾ룩Ϊңʹǽʱ
+template <typename Map>
+void concurrent_mix_do_test(size_t threads, size_t count, int write_percent)
+{
+    char buf[10];
+    Map m;
+    const int range = static_cast<int>(count) * 2;
+    for (int i = 0; i < range; i += 2)
+        m.insert(i, i);
+    const size_t ops = count * 10 / threads;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&m, ops, range, write_percent, t]()
+        {
+            uint32_t seed = static_cast<uint32_t>(t) * 2654435761u + 1;
+            size_t found = 0;
+            for (size_t i = 0; i < ops; ++i)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const int key = static_cast<int>((seed >> 8) % range);
+                const int dice = static_cast<int>((seed >> 4) % 100);
+                if (dice < write_percent / 2)
+                    m.insert(key, key);
+                else if (dice < write_percent)
+                    m.erase(key);
+                else
+                    found += m.find(key);
+            }
+            volatile size_t sink = found;
+            (void)sink;
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    int n = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  t1, t2, t3 ̸߳һ
+#define CONCURRENT_HASH_MIX_TEST(count, write_percent, t1, t2, t3)            \
+  TEST_LEN(t1, t2, t3, WIDE);                                              \
+  std::cout << "| mutex+unordered_map |";                                  \
+  concurrent_mix_do_test<locked_map>(t1, count, write_percent);            \
+  concurrent_mix_do_test<locked_map>(t2, count, write_percent);            \
+  concurrent_mix_do_test<locked_map>(t3, count, write_percent);            \
+  std::cout << "\n| concurrent_hash_map |";                                \
+  concurrent_mix_do_test<striped_map>(t1, count, write_percent);           \
+  concurrent_mix_do_test<striped_map>(t2, count, write_percent);           \
+  concurrent_mix_do_test<striped_map>(t3, count, write_percent);
+
+#if LARGER_TEST_DATA_ON
+#define CONCURRENT_HASH_MIX_TEST_ALL(write_percent)                           \
+  CONCURRENT_HASH_MIX_TEST(LEN2, write_percent, 1, 2, 4);                    \
+  std::cout << "\n|                     |";                                  \
+  CONCURRENT_HASH_MIX_TEST(LEN2, write_percent, 8, 16, 64)
+#else
+#define CONCURRENT_HASH_MIX_TEST_ALL(write_percent)                           \
+  CONCURRENT_HASH_MIX_TEST(LEN1, write_percent, 1, 2, 4);                    \
+  std::cout << "\n|                     |";                                  \
+  CONCURRENT_HASH_MIX_TEST(LEN1, write_percent, 8, 16, 64)
+#endif
+
+void concurrent_hash_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------- Run container test : concurrent_hash_map -----------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<mystl::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(mystl::pair<int, int>(i, i));
+    mystl::concurrent_hash_map<int, int> m1;
+    mystl::concurrent_hash_map<int, int> m2(520);
+    mystl::concurrent_hash_map<int, int> m3(v.begin(), v.end());
+    mystl::concurrent_hash_map<int, int> m4{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+
+    for (int i = 5; i > 0; --i)
+    {
+        CHM_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    CHM_FUN_AFTER(m1, m1.insert(PAIR(0, 0)));
+    CHM_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    CHM_FUN_AFTER(m1, m1.insert_or_assign(1, 10));
+    CHM_FUN_AFTER(m1, m1.upsert(2, 0, [](int x) { return x + 100; }));
+    CHM_FUN_AFTER(m1, m1.upsert(9, 0, [](int x) { return x + 100; }));
+    CHM_FUN_AFTER(m1, m1.compute_if_present(3, [](int x) { return x * 3; }));
+    CHM_FUN_AFTER(m1, m1.erase(0));
+    CHM_COUT(m3);
+    CHM_COUT(m4);
+    int value = 0;
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.find(4, value));
+    FUN_VALUE(m1.find(7, value));
+    FUN_VALUE(m1.compute_if_present(7, [](int x) { return x; }));
+    FUN_VALUE(m1.contains(9));
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(value);
+    FUN_VALUE(m1.count(0));
+    FUN_VALUE(m1.at(9));
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m2.bucket_count());
+    CHM_FUN_AFTER(m2, m2.reserve(2000));
+    FUN_VALUE(m2.bucket_count());
+
+    // ĸ߳ͬʱ뻥ཻļֵͬһ upsertл
+    mystl::concurrent_hash_map<int, int> m5;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&m5, t]()
+        {
+            for (int i = t; i < 20000; i += 4)
+            {
+                m5.emplace(i, i);
+                m5.upsert(-1 - i % 10, 1, [](int x) { return x + 1; });
+            }
+            for (int i = t; i < 20000; i += 4)
+            {
+                if (i % 2 != 0)
+                    m5.erase(i);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    size_t evens = 0;
+    int total = 0;
+    m5.for_each([&evens, &total](const mystl::pair<const int, int>& p)
+    {
+        if (p.first >= 0 && p.first % 2 == 0 && p.second == p.first)
+            ++evens;
+        if (p.first < 0)
+            total += p.second;
+    });
+    FUN_VALUE(m5.size());
+    FUN_VALUE(evens);
+    FUN_VALUE(total);
+    CHM_FUN_AFTER(m1, m1.clear());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 1% write  / threads |";
+    CONCURRENT_HASH_MIX_TEST_ALL(1);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 10% write / threads |";
+    CONCURRENT_HASH_MIX_TEST_ALL(10);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 50% write / threads |";
+    CONCURRENT_HASH_MIX_TEST_ALL(50);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[---------- End container test : concurrent_hash_map -----------]" << std::endl;
+}
+
+} // namespace concurrent_hash_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_CONCURRENT_HASH_MAP_TEST_H_
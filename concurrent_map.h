@@ -0,0 +1,621 @@
+#ifndef MY_STL_CONCURRENT_MAP_H_
+#define MY_STL_CONCURRENT_MAP_H_
+
+// ͷļģ concurrent_map
+// concurrent_map : ӳ䣬߳̿ͬʱҡ롢ɾֵظ
+
+// notes:
+//
+// ײһֹ۵lazy skip list
+//   * ֻ next ָȡ֮䲻дκιĻУ
+//   * ɾȲضλסǰ㲢֤Ȼڣ֤ʧԣ
+//   * ɾȸ marked ǣ߼ɾٴӸժɾ
+//     ժĽ㽻 epoch_domainȵûж߿ܳʱͷš
+// ˶ӲдֻͬһλøͻʱŻȴ
+//
+//  map 
+//   * ֻǰṩ reverse_iteratorһ epoch_guard
+//     ָԪڵڼ䲻ᱻͷţѱ߳ɾ
+//   * һµģ̵߳Ĳ롢ɾܱҲܿ
+//     ÿԪһҰֵ
+//   * Ԫزʵֵ޸ģat ʵֵĸ
+//   * size() ڲ޸ʱֻһֵ
+//   * clearִУ󲻿ɸơƶ
+//
+// ʱеƳٱɾĻա
+
+#include <atomic>
+#include <initializer_list>
+#include <thread>
+
+#include "epoch.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// Ľ㣬next ʵʳΪ heightһ
+template <typename T>
+struct skip_list_node
+{
+	using link_type = std::atomic<skip_list_node*>;
+
+	T					value;
+	std::atomic<bool>	locked;			// дʹõ
+	std::atomic<bool>	marked;			// ѱ߼ɾ
+	std::atomic<bool>	fully_linked;	// ȫ height 
+	int					height;
+	link_type			next[1];
+
+	void lock() noexcept
+	{
+		while (locked.exchange(true, std::memory_order_acquire))
+		{
+			while (locked.load(std::memory_order_relaxed))
+				std::this_thread::yield();
+		}
+	}
+
+	void unlock() noexcept
+	{
+		locked.store(false, std::memory_order_release);
+	}
+
+	bool live() const noexcept
+	{
+		return fully_linked.load(std::memory_order_acquire) && !marked.load(std::memory_order_acquire);
+	}
+
+	//  p ʼһδɾȫĽ
+	static skip_list_node* next_live(skip_list_node* p) noexcept
+	{
+		while (p != nullptr && !p->live())
+			p = p->next[0].load(std::memory_order_acquire);
+		return p;
+	}
+};
+
+// concurrent_map ĵֻܶȡԪ
+template <typename T>
+struct skip_list_iterator :public mystl::iterator<mystl::forward_iterator_tag, T,
+	ptrdiff_t, const T*, const T&>
+{
+	using value_type	= T;
+	using pointer		= const T*;
+	using reference		= const T&;
+	using node_ptr		= skip_list_node<T>*;
+	using self			= skip_list_iterator<T>;
+
+	node_ptr	node;	// nullptr ʾ end()
+	epoch_guard	guard;	// ֤ node ڵڼ䲻ͷţend() 
+
+	skip_list_iterator() :node{ nullptr } {}
+
+	skip_list_iterator(node_ptr n, epoch_guard&& g)
+		:node{ n }, guard{ mystl::move(g) }
+	{
+		if (node == nullptr)
+			guard.reset();
+	}
+
+	reference operator*()  const { return node->value; }
+	pointer   operator->() const { return &(operator*()); }
+
+	self& operator++()
+	{
+		MYSTL_DEBUG(node != nullptr);
+		node = skip_list_node<T>::next_live(node->next[0].load(std::memory_order_acquire));
+		if (node == nullptr)
+			guard.reset();
+		return *this;
+	}
+
+	self operator++(int)
+	{
+		self tmp(*this);
+		++*this;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return node == rhs.node; }
+	bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// ģ concurrent_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+class concurrent_map
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= mystl::pair<const Key, T>;
+	using key_compare				= Compare;
+
+	using node_type					= skip_list_node<value_type>;
+	using node_ptr					= node_type*;
+	using link_type					= typename node_type::link_type;
+
+	using allocator_type			= mystl::allocator<value_type>;
+	using data_allocator			= mystl::allocator<value_type>;
+	using byte_allocator			= mystl::allocator<char>;
+
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+
+	using iterator					= skip_list_iterator<value_type>;
+	using const_iterator			= skip_list_iterator<value_type>;
+
+	// ÿ 1/4 ĸʽ16  2^32 Ԫ
+	static constexpr int max_height = 16;
+
+	// Ϊ map һ£ṩһȽ value_type ĺ
+	class value_compare : public binary_function<value_type, value_type, bool>
+	{
+		friend class concurrent_map<Key, T, Compare>;
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	public:
+		bool operator()(const value_type& lhs, const value_type& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	};
+
+private:
+	node_ptr				head_;		// ͷ㣬Ԫأ߶Ϊ max_height
+	std::atomic<int>		height_;	// ʹõֻ߲ߴһ㿪ʼ
+	std::atomic<size_type>	count_;		// Ԫظ
+	key_compare				key_comp_;
+	mutable epoch_domain	domain_;
+
+public:
+	// 졢
+
+	concurrent_map() :head_{ create_head() }, height_{ 1 }, count_{ 0 }, key_comp_{} {}
+
+	explicit concurrent_map(const Compare& comp)
+		:head_{ create_head() }, height_{ 1 }, count_{ 0 }, key_comp_{ comp }
+	{
+	}
+
+	template <typename InputIterator>
+	concurrent_map(InputIterator first, InputIterator last)
+		:head_{ create_head() }, height_{ 1 }, count_{ 0 }, key_comp_{}
+	{
+		insert(first, last);
+	}
+
+	concurrent_map(std::initializer_list<value_type> ilist)
+		:head_{ create_head() }, height_{ 1 }, count_{ 0 }, key_comp_{}
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	concurrent_map(const concurrent_map&) = delete;
+	concurrent_map& operator=(const concurrent_map&) = delete;
+
+	~concurrent_map()
+	{
+		clear();
+		byte_allocator::deallocate(reinterpret_cast<char*>(head_));
+	}
+
+public:
+	// ؽӿ
+
+	key_compare		key_comp()		const { return key_comp_; }
+	value_compare	value_comp()	const { return value_compare(key_comp_); }
+	allocator_type	get_allocator()	const { return allocator_type(); }
+
+	// 
+
+	iterator begin() const
+	{
+		epoch_guard guard(domain_);
+		return iterator(node_type::next_live(head_->next[0].load(std::memory_order_acquire)),
+			mystl::move(guard));
+	}
+	iterator end() const noexcept
+	{ return iterator(); }
+
+	const_iterator cbegin() const
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+
+	// 
+	bool		empty()		const noexcept { return size() == 0; }
+	size_type	size()		const noexcept { return count_.load(std::memory_order_relaxed); }
+	size_type	max_size()	const noexcept { return static_cast<size_type>(-1); }
+
+	// Ԫ
+
+	// ֵڣat ׳һ쳣Ԫؿʱ߳ɾ˷ʵֵĸ
+	mapped_type at(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		node_ptr p = find_node(key);
+		THROW_OUT_OF_RANGE_IF(p == nullptr, "concurrent_map<Key, T> no such element exists");
+		return p->value.second;
+	}
+
+	// ɾ
+
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		return insert_node(create_node(mystl::forward<Args>(args)...));
+	}
+
+	// ֵѴʱκζ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{
+		{
+			epoch_guard guard(domain_);
+			node_ptr p = find_node(key);
+			if (p != nullptr)
+				return mystl::pair<iterator, bool>(iterator(p, mystl::move(guard)), false);
+		}
+		return insert_node(create_node(key, mapped_type(mystl::forward<Args>(args)...)));
+	}
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{
+		return try_emplace(value.first, value.second);
+	}
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{
+		return emplace(mystl::move(value));
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			emplace(*first);
+	}
+
+	// ɾֵΪ key Ԫأɾĸ0  1
+	size_type erase(const key_type& key);
+
+	void erase(iterator position)
+	{
+		if (position.node != nullptr)
+			erase(position->first);
+	}
+
+	// ִ
+	void clear();
+
+	// 
+
+	iterator find(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		return iterator(find_node(key), mystl::move(guard));
+	}
+
+	size_type count(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		return find_node(key) != nullptr ? 1 : 0;
+	}
+
+	// ֵС key ĵһԪ
+	iterator lower_bound(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		return iterator(node_type::next_live(bound_node(key, false)), mystl::move(guard));
+	}
+
+	// ֵ key ĵһԪ
+	iterator upper_bound(const key_type& key) const
+	{
+		epoch_guard guard(domain_);
+		return iterator(node_type::next_live(bound_node(key, true)), mystl::move(guard));
+	}
+
+	mystl::pair<iterator, iterator> equal_range(const key_type& key) const
+	{
+		return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+
+private:
+	// node related
+	static node_ptr allocate_node(int height)
+	{
+		const size_t bytes = sizeof(node_type) + (height - 1) * sizeof(link_type);
+		return reinterpret_cast<node_ptr>(byte_allocator::allocate(bytes));
+	}
+
+	static void init_links(node_ptr p, int height) noexcept
+	{
+		::new (static_cast<void*>(mystl::address_of(p->locked))) std::atomic<bool>(false);
+		::new (static_cast<void*>(mystl::address_of(p->marked))) std::atomic<bool>(false);
+		::new (static_cast<void*>(mystl::address_of(p->fully_linked))) std::atomic<bool>(false);
+		p->height = height;
+		for (int i = 0; i < height; ++i)
+			::new (static_cast<void*>(p->next + i)) link_type(nullptr);
+	}
+
+	// ͷ㲻Ԫ
+	static node_ptr create_head()
+	{
+		node_ptr p = allocate_node(max_height);
+		init_links(p, max_height);
+		p->fully_linked.store(true, std::memory_order_relaxed);
+		return p;
+	}
+
+	template <typename ...Args>
+	static node_ptr create_node(Args&& ...args)
+	{
+		const int height = random_height();
+		node_ptr p = allocate_node(height);
+		try
+		{
+			data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			byte_allocator::deallocate(reinterpret_cast<char*>(p));
+			throw;
+		}
+		init_links(p, height);
+		return p;
+	}
+
+	static void destroy_node(node_ptr p)
+	{
+		data_allocator::destroy(mystl::address_of(p->value));
+		byte_allocator::deallocate(reinterpret_cast<char*>(p));
+	}
+
+	//  epoch_domain ɾ
+	static void destroy_retired(void* p)
+	{
+		destroy_node(static_cast<node_ptr>(p));
+	}
+
+	// ߶Ϊ h ĸΪ (3/4) * (1/4)^(h-1)ÿ߳ʹԼ״̬
+	static int random_height() noexcept
+	{
+		static thread_local uint64_t state =
+			std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		uint64_t r = state;
+		int height = 1;
+		while (height < max_height && (r & 3) == 0)
+		{
+			++height;
+			r >>= 2;
+		}
+		return height;
+	}
+
+	// ºҪ߳ epoch_guard
+
+	// ֵ key δɾĽ㣬ʱ nullptr
+	node_ptr find_node(const key_type& key) const
+	{
+		node_ptr p = bound_node(key, false);
+		if (p == nullptr || key_comp_(key, p->value.first) || !p->live())
+			return nullptr;
+		return p;
+	}
+
+	// strict Ϊ false ʱصһֵС key Ľ㣬򷵻صһֵ key Ľ
+	// صĽѱɾ
+	node_ptr bound_node(const key_type& key, bool strict) const
+	{
+		node_ptr pred = head_;
+		node_ptr cur = nullptr;
+		for (int l = height_.load(std::memory_order_relaxed) - 1; l >= 0; --l)
+		{
+			cur = pred->next[l].load(std::memory_order_acquire);
+			while (cur != nullptr && (strict ? !key_comp_(key, cur->value.first)
+				: key_comp_(cur->value.first, key)))
+			{
+				pred = cur;
+				cur = pred->next[l].load(std::memory_order_acquire);
+			}
+		}
+		return cur;
+	}
+
+	// ¼ key ǰ̣ҵ key ߲㣬ûҵʱ -1
+	int find_position(const key_type& key, node_ptr* preds, node_ptr* succs) const
+	{
+		int found = -1;
+		node_ptr pred = head_;
+		for (int l = max_height - 1; l >= 0; --l)
+		{
+			node_ptr cur = pred->next[l].load(std::memory_order_acquire);
+			while (cur != nullptr && key_comp_(cur->value.first, key))
+			{
+				pred = cur;
+				cur = pred->next[l].load(std::memory_order_acquire);
+			}
+			if (found == -1 && cur != nullptr && !key_comp_(key, cur->value.first))
+				found = l;
+			preds[l] = pred;
+			succs[l] = cur;
+		}
+		return found;
+	}
+
+	// ڲǰͬһ㣬ֻһ
+	static void unlock_preds(node_ptr* preds, int levels) noexcept
+	{
+		node_ptr prev = nullptr;
+		for (int l = 0; l < levels; ++l)
+		{
+			if (preds[l] != prev)
+				preds[l]->unlock();
+			prev = preds[l];
+		}
+	}
+
+	mystl::pair<iterator, bool> insert_node(node_ptr np);
+};
+
+/*****************************************************************************************/
+
+// ½ֵѴʱ½㲢еԪ
+template <typename Key, typename T, typename Compare>
+mystl::pair<typename concurrent_map<Key, T, Compare>::iterator, bool>
+concurrent_map<Key, T, Compare>::
+insert_node(node_ptr np)
+{
+	epoch_guard guard(domain_);
+	const int top = np->height;
+	node_ptr preds[max_height];
+	node_ptr succs[max_height];
+	for (;;)
+	{
+		const int found = find_position(np->value.first, preds, succs);
+		if (found != -1)
+		{
+			node_ptr cur = succs[found];
+			if (!cur->marked.load(std::memory_order_acquire))
+			{
+				// һ߳ڲͬļֵɺ󷵻ظԪ
+				while (!cur->fully_linked.load(std::memory_order_acquire))
+					std::this_thread::yield();
+				destroy_node(np);
+				return mystl::pair<iterator, bool>(iterator(cur, mystl::move(guard)), false);
+			}
+			// еԪڱɾժ
+			std::this_thread::yield();
+			continue;
+		}
+		// Եסǰ֤δɾָ
+		int locked = 0;
+		bool valid = true;
+		node_ptr prev = nullptr;
+		for (int l = 0; valid && l < top; ++l)
+		{
+			node_ptr pred = preds[l];
+			node_ptr succ = succs[l];
+			if (pred != prev)
+				pred->lock();
+			prev = pred;
+			locked = l + 1;
+			valid = !pred->marked.load(std::memory_order_acquire) &&
+				(succ == nullptr || !succ->marked.load(std::memory_order_acquire)) &&
+				pred->next[l].load(std::memory_order_acquire) == succ;
+		}
+		if (!valid)
+		{
+			unlock_preds(preds, locked);
+			continue;
+		}
+		for (int l = 0; l < top; ++l)
+			np->next[l].store(succs[l], std::memory_order_relaxed);
+		for (int l = 0; l < top; ++l)
+			preds[l]->next[l].store(np, std::memory_order_release);
+		np->fully_linked.store(true, std::memory_order_release);
+		unlock_preds(preds, locked);
+		int h = height_.load(std::memory_order_relaxed);
+		while (h < top && !height_.compare_exchange_weak(h, top, std::memory_order_relaxed))
+		{
+		}
+		count_.fetch_add(1, std::memory_order_relaxed);
+		return mystl::pair<iterator, bool>(iterator(np, mystl::move(guard)), true);
+	}
+}
+
+// ɾֵΪ key Ԫأȱǽ㣬סǰժ
+template <typename Key, typename T, typename Compare>
+typename concurrent_map<Key, T, Compare>::size_type
+concurrent_map<Key, T, Compare>::
+erase(const key_type& key)
+{
+	epoch_guard guard(domain_);
+	node_ptr preds[max_height];
+	node_ptr succs[max_height];
+	node_ptr victim = nullptr;
+	int top = 0;
+	for (;;)
+	{
+		const int found = find_position(key, preds, succs);
+		if (victim == nullptr)
+		{
+			if (found == -1)
+				return 0;
+			node_ptr cur = succs[found];
+			// δȫĽΪδ룬ѱǵĽһ̸߳ɾ
+			if (!cur->fully_linked.load(std::memory_order_acquire) || cur->height - 1 != found ||
+				cur->marked.load(std::memory_order_acquire))
+				return 0;
+			cur->lock();
+			if (cur->marked.load(std::memory_order_relaxed))
+			{
+				cur->unlock();
+				return 0;
+			}
+			cur->marked.store(true, std::memory_order_release);
+			victim = cur;
+			top = cur->height;
+		}
+		int locked = 0;
+		bool valid = true;
+		node_ptr prev = nullptr;
+		for (int l = 0; valid && l < top; ++l)
+		{
+			node_ptr pred = preds[l];
+			if (pred != prev)
+				pred->lock();
+			prev = pred;
+			locked = l + 1;
+			valid = !pred->marked.load(std::memory_order_acquire) &&
+				pred->next[l].load(std::memory_order_acquire) == victim;
+		}
+		if (!valid)
+		{
+			unlock_preds(preds, locked);
+			continue;
+		}
+		for (int l = top - 1; l >= 0; --l)
+			preds[l]->next[l].store(victim->next[l].load(std::memory_order_relaxed), std::memory_order_release);
+		victim->unlock();
+		unlock_preds(preds, locked);
+		count_.fetch_sub(1, std::memory_order_relaxed);
+		domain_.retire(victim, &destroy_retired);
+		return 1;
+	}
+}
+
+// ɾδյĽ epoch_domain ͷ
+template <typename Key, typename T, typename Compare>
+void concurrent_map<Key, T, Compare>::
+clear()
+{
+	node_ptr p = head_->next[0].load(std::memory_order_relaxed);
+	while (p != nullptr)
+	{
+		node_ptr next = p->next[0].load(std::memory_order_relaxed);
+		destroy_node(p);
+		p = next;
+	}
+	for (int l = 0; l < max_height; ++l)
+		head_->next[l].store(nullptr, std::memory_order_relaxed);
+	height_.store(1, std::memory_order_relaxed);
+	count_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace mystl
+#endif // !MY_STL_CONCURRENT_MAP_H_
@@ -0,0 +1,237 @@
+#ifndef MY_STL_CONCURRENT_MAP_TEST_H_
+#define MY_STL_CONCURRENT_MAP_TEST_H_
+
+// concurrent_map test :  concurrent_map Ľӿ̶߳дϵ
+
+#include <chrono>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_map.h"
+#include "map.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace concurrent_map_test
+{
+
+// pair ĺ궨
+#define CONCURRENT_PAIR    mystl::pair<const int, int>
+
+// concurrent_map ı
+#define CONCURRENT_MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it = m.begin(); it != m.end(); ++it)    std::cout << " <" << it->first << "," << it->second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// concurrent_map ĺ
+#define CONCURRENT_MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    CONCURRENT_MAP_COUT(con); \
+} while(0)
+
+// concurrent_map ĺֵ
+#define CONCURRENT_MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// öд mapΪܲԵĶ
+struct locked_map
+{
+    mystl::map<int, int>            m;
+    mutable std::shared_timed_mutex mutex;
+
+    bool find(int key) const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex);
+        return m.find(key) != m.end();
+    }
+    void insert(int key, int value)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        m.emplace(key, value);
+    }
+    void erase(int key)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        m.erase(key);
+    }
+};
+
+struct lock_free_map
+{
+    mystl::concurrent_map<int, int> m;
+
+    bool find(int key) const { return m.count(key) != 0; }
+    void insert(int key, int value) { m.emplace(key, value); }
+    void erase(int key) { m.erase(key); }
+};
+
+// threads ̶߳Ԥȷ count Ԫصӳ乲ִ count * 10 β
+// ÿβ write_percent% ĸдɾ룩Ϊ
+// ߳ͬʱʱ clock() ڲƽ̨ͳƵ̵߳ CPU ʱ䣬ʹǽʱ
+template <typename Map>
+void concurrent_mix_do_test(size_t threads, size_t count, int write_percent)
+{
+    char buf[10];
+    Map m;
+    const int range = static_cast<int>(count) * 2;
+    for (int i = 0; i < range; i += 2)
+        m.insert(i, i);
+    const size_t ops = count * 10 / threads;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&m, ops, range, write_percent, t]()
+        {
+            uint32_t seed = static_cast<uint32_t>(t) * 2654435761u + 1;
+            size_t found = 0;
+            for (size_t i = 0; i < ops; ++i)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const int key = static_cast<int>((seed >> 8) % range);
+                const int dice = static_cast<int>((seed >> 4) % 100);
+                if (dice < write_percent / 2)
+                    m.insert(key, key);
+                else if (dice < write_percent)
+                    m.erase(key);
+                else
+                    found += m.find(key);
+            }
+            volatile size_t sink = found;
+            (void)sink;
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    int n = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define CONCURRENT_MIX_TEST(count, write_percent)                            \
+  TEST_LEN(2, 4, 8, WIDE);                                                 \
+  std::cout << "| map + rw lock       |";                                  \
+  concurrent_mix_do_test<locked_map>(2, count, write_percent);             \
+  concurrent_mix_do_test<locked_map>(4, count, write_percent);             \
+  concurrent_mix_do_test<locked_map>(8, count, write_percent);             \
+  std::cout << "\n|mystl::concurrent_map|";                                \
+  concurrent_mix_do_test<lock_free_map>(2, count, write_percent);          \
+  concurrent_mix_do_test<lock_free_map>(4, count, write_percent);          \
+  concurrent_mix_do_test<lock_free_map>(8, count, write_percent);
+
+void concurrent_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : concurrent_map -------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<mystl::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(mystl::pair<int, int>(i, i));
+    mystl::concurrent_map<int, int> m1;
+    mystl::concurrent_map<int, int, mystl::greater<int>> m2;
+    mystl::concurrent_map<int, int> m3(v.begin(), v.end());
+    mystl::concurrent_map<int, int> m4{ CONCURRENT_PAIR(1,1),CONCURRENT_PAIR(3,2),CONCURRENT_PAIR(2,3) };
+
+    for (int i = 5; i > 0; --i)
+    {
+        CONCURRENT_MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.insert(CONCURRENT_PAIR(0, 0)));
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.try_emplace(8, 8));
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.erase(0));
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.erase(m1.find(3)));
+    CONCURRENT_MAP_FUN_AFTER(m2, m2.insert(v.begin(), v.end()));
+    CONCURRENT_MAP_COUT(m3);
+    CONCURRENT_MAP_COUT(m4);
+    FUN_VALUE(m1.count(0));
+    FUN_VALUE(m1.count(4));
+    FUN_VALUE(m1.at(8));
+    CONCURRENT_MAP_VALUE(*m1.find(4));
+    CONCURRENT_MAP_VALUE(*m1.lower_bound(3));
+    CONCURRENT_MAP_VALUE(*m1.upper_bound(5));
+    CONCURRENT_MAP_VALUE(*m2.lower_bound(3));
+    auto first = *m1.equal_range(2).first;
+    auto second = *m1.equal_range(2).second;
+    std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+        << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.empty());
+    FUN_VALUE((m1.find(0) == m1.end()));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+
+    // ĸ߳ͬʱ벢ɾཻļֵֻʣżֵ
+    mystl::concurrent_map<int, int> m5;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&m5, t]()
+        {
+            for (int i = t; i < 4000; i += 4)
+                m5.emplace(i, i);
+            for (int i = t; i < 4000; i += 4)
+            {
+                if (i % 2 != 0)
+                    m5.erase(i);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    size_t evens = 0;
+    int prev = -1;
+    for (auto it = m5.begin(); it != m5.end(); ++it)
+    {
+        if (it->first % 2 == 0 && it->first > prev)
+            ++evens;
+        prev = it->first;
+    }
+    FUN_VALUE(m5.size());
+    FUN_VALUE(evens);
+    CONCURRENT_MAP_FUN_AFTER(m1, m1.clear());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 1% write  / threads |";
+#if LARGER_TEST_DATA_ON
+    CONCURRENT_MIX_TEST(LEN2, 1);
+#else
+    CONCURRENT_MIX_TEST(LEN1, 1);
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 10% write / threads |";
+#if LARGER_TEST_DATA_ON
+    CONCURRENT_MIX_TEST(LEN2, 10);
+#else
+    CONCURRENT_MIX_TEST(LEN1, 10);
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : concurrent_map -------------]" << std::endl;
+}
+
+} // namespace concurrent_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_CONCURRENT_MAP_TEST_H_
@@ -67,9 +67,9 @@ void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
 {
 	for (; first != last; ++first)
 	{
-		//destroy(&*first) дΪȷڲͬ͵ĵ϶ȷö
-		// ָ͵ĵ
-		destroy(&*first);
+		//destroy_one(&*first) дΪȷڲͬ͵ĵ϶ȷö
+		// ָ͵ĵ޶ mystl:: Ԫ std ʱҵ std::destroy
+		mystl::destroy_one(&*first, std::false_type{});
 	}
 }
 
@@ -0,0 +1,379 @@
+#ifndef MY_STL_CUCKOO_FILTER_H_
+#define MY_STL_CUCKOO_FILTER_H_
+
+// ͷļһģ cuckoo_filter
+// cuckoo_filter : 벼¡һشһڡ򡰿ڡɾֵ
+
+// notes:
+//
+// ÿ bucket  4 ۣÿ۱ֵָƣ812  16 λ0 ʾղۣλУ
+// һ bucket ռ 46  8 ֽڡֵ mystl::hash Ľٻһεõ 64 λϣֵ
+//  32 λѡһ bucket i1 32 λָ fpڶ bucket Ϊ i2 = (t(fp) - i1) mod m
+//  t ֻ fp i1i2 ֻɶԷ fp bucket Ҳ 2 ݡ
+//
+// Ҷȡ bucket bucket һ 64 λáǷΪֶΡλһαȽ 4 ۣ
+// ȡָơʱ bucket ߳һָƷŵһ bucketظ max_kicks Σ
+// Ȼʧʱָ߳ݴ˺Ĳ붼 falseֱɾڳλá
+//
+// ɾֻڲļֵɾһָͬļֵͬһֵԲΣ
+//  bucket ֻ 8 ָͬơԼΪ 8 / 2^ff ΪָƵλ
+
+#include <cstdint>
+
+#include "functional.h"
+#include "hashtable.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+namespace cuckoo_detail
+{
+
+// 64 λĻϺMurmurHash3  fmix64
+inline uint64_t mix64(uint64_t h) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	return h;
+}
+
+//  32 λ x ȵӳ䵽 [0, n)
+inline uint32_t fastrange32(uint32_t x, uint64_t n) noexcept
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(x) * n) >> 32);
+}
+
+} // namespace cuckoo_detail
+
+// ģ cuckoo_filter
+// һֵָͣƵλֻΪ 812  16ϣȱʡʹ mystl::hash
+template <typename Key, size_t FingerprintBits = 12, typename Hash = mystl::hash<Key>>
+class cuckoo_filter
+{
+	static_assert(FingerprintBits == 8 || FingerprintBits == 12 || FingerprintBits == 16,
+		"cuckoo_filter fingerprints must have 8, 12 or 16 bits");
+
+public:
+	using key_type					= Key;
+	using hasher					= Hash;
+	using size_type					= size_t;
+
+	static constexpr size_type slots_per_bucket = 4;
+	static constexpr size_type fingerprint_bits = FingerprintBits;
+
+private:
+	static constexpr size_type bucket_bytes = slots_per_bucket * fingerprint_bits / 8;
+	static constexpr uint64_t  fp_mask = (uint64_t(1) << fingerprint_bits) - 1;
+	// ÿλΪ 1 ĳÿλΪ 1 ĳһαȽ 4 
+	static constexpr uint64_t  lane_ones = 1 | (uint64_t(1) << fingerprint_bits) |
+		(uint64_t(1) << (2 * fingerprint_bits)) | (uint64_t(1) << (3 * fingerprint_bits));
+	static constexpr uint64_t  lane_highs = lane_ones << (fingerprint_bits - 1);
+
+	// ߳ʧʱݴָ
+	struct victim_type
+	{
+		bool     used;
+		uint32_t index;
+		uint32_t fp;
+	};
+
+	mystl::vector<unsigned char>	table_;
+	size_type						bucket_count_;
+	size_type						size_;
+	size_type						max_kicks_;
+	victim_type						victim_;
+	uint64_t						rng_;		// ѡ߳ĸ۵α
+	hasher							hash_;
+
+public:
+	// 캯һΪԤƲļֵΪʱ߳Ĵ
+	// bucket ʹԤƵļֵռܲ 90%
+	explicit cuckoo_filter(size_type expected_count, size_type max_kicks = 500,
+		const Hash& hash = Hash())
+		:size_(0), max_kicks_(max_kicks), victim_{ false, 0, 0 }, rng_(0x9e3779b97f4a7c15ull), hash_(hash)
+	{
+		const size_type slots = expected_count / 9 * 10 + (expected_count % 9 * 10 + 8) / 9;
+		bucket_count_ = mystl::max(size_type(1), (slots + slots_per_bucket - 1) / slots_per_bucket);
+		THROW_LENGTH_ERROR_IF(bucket_count_ > size_type(0xffffffffu), "cuckoo_filter<Key> too many buckets");
+		// ĩβ 8 ֽڣʹȡһ bucket ʱԽ
+		table_.assign(bucket_count_ * bucket_bytes + 8, static_cast<unsigned char>(0));
+	}
+
+	// ֵʱ false
+	bool insert(const key_type& key)
+	{
+		if (victim_.used)
+			return false;
+		uint32_t fp, i1, i2;
+		locate(key, fp, i1, i2);
+		place(fp, i1, i2);
+		++size_;
+		return true;
+	}
+
+	//  [first, last) еļֵسɹĸ
+	template <class InputIter>
+	size_type insert(InputIter first, InputIter last)
+	{
+		size_type n = 0;
+		for (; first != last; ++first)
+			n += insert(*first) ? 1 : 0;
+		return n;
+	}
+
+	// ɾֵһָƣҵʱ true
+	bool erase(const key_type& key)
+	{
+		uint32_t fp, i1, i2;
+		locate(key, fp, i1, i2);
+		if (remove_from_bucket(i1, fp) || remove_from_bucket(i2, fp))
+		{
+			--size_;
+			// ڳλã·ݴָ
+			if (victim_.used)
+			{
+				victim_.used = false;
+				place(victim_.fp, victim_.index, alt_index(victim_.index, victim_.fp));
+			}
+			return true;
+		}
+		if (victim_.used && victim_.fp == fp && (victim_.index == i1 || victim_.index == i2))
+		{
+			victim_.used = false;
+			--size_;
+			return true;
+		}
+		return false;
+	}
+
+	// ֵܴʱ trueһʱ false
+	bool contains(const key_type& key) const
+	{
+		uint32_t fp, i1, i2;
+		locate(key, fp, i1, i2);
+		return test(fp, i1, i2);
+	}
+
+	//  [first, last) еÿֵΰ contains Ľд out
+	// ÿȡһֵȼ bucket ԤȡȽϣʹֵĻȱʧص
+	template <class ForwardIter, class OutputIter>
+	OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		static constexpr size_type group = 16;
+		uint32_t fps[group], i1s[group], i2s[group];
+		while (first != last)
+		{
+			size_type n = 0;
+			for (; n < group && first != last; ++n, ++first)
+			{
+				locate(*first, fps[n], i1s[n], i2s[n]);
+				ht_prefetch(table_.data() + static_cast<size_type>(i1s[n]) * bucket_bytes);
+				ht_prefetch(table_.data() + static_cast<size_type>(i2s[n]) * bucket_bytes);
+			}
+			for (size_type i = 0; i < n; ++i, ++out)
+				*out = test(fps[i], i1s[i], i2s[i]);
+		}
+		return out;
+	}
+
+	void clear()
+	{
+		mystl::fill(table_.begin(), table_.end(), static_cast<unsigned char>(0));
+		size_ = 0;
+		victim_.used = false;
+	}
+
+	// ָƸ
+	size_type size() const noexcept { return size_; }
+	bool      empty() const noexcept { return size_ == 0; }
+	// ֮Ĳʧ
+	bool      full() const noexcept { return victim_.used; }
+
+	size_type capacity() const noexcept { return bucket_count_ * slots_per_bucket; }
+	size_type bucket_count() const noexcept { return bucket_count_; }
+	float     load_factor() const noexcept { return (float)size_ / (float)capacity(); }
+	size_type memory_bytes() const noexcept { return table_.size(); }
+
+	size_type max_kicks() const noexcept { return max_kicks_; }
+	void      max_kicks(size_type n) noexcept { max_kicks_ = n; }
+
+	hasher hash_fcn() const { return hash_; }
+
+	void swap(cuckoo_filter& rhs) noexcept
+	{
+		table_.swap(rhs.table_);
+		mystl::swap(bucket_count_, rhs.bucket_count_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(max_kicks_, rhs.max_kicks_);
+		mystl::swap(victim_, rhs.victim_);
+		mystl::swap(rng_, rhs.rng_);
+		mystl::swap(hash_, rhs.hash_);
+	}
+
+private:
+	// ֵָ bucket
+	void locate(const key_type& key, uint32_t& fp, uint32_t& i1, uint32_t& i2) const
+	{
+		const uint64_t h = cuckoo_detail::mix64(static_cast<uint64_t>(hash_(key)));
+		fp = static_cast<uint32_t>((h >> 32) & fp_mask);
+		if (fp == 0)
+			fp = 1;
+		i1 = cuckoo_detail::fastrange32(static_cast<uint32_t>(h), bucket_count_);
+		i2 = alt_index(i1, fp);
+	}
+
+	// ָƷ bucket i1  i2ʱָ߳ƣʧʱݴָ߳
+	void place(uint32_t fp, uint32_t i1, uint32_t i2)
+	{
+		if (add_to_bucket(i1, fp) || add_to_bucket(i2, fp))
+			return;
+		uint32_t i = (next_random() & 1) ? i1 : i2;
+		for (size_type kick = 0; kick < max_kicks_; ++kick)
+		{
+			const size_type slot = static_cast<size_type>(next_random() % slots_per_bucket);
+			uint64_t word = load_bucket(i);
+			const uint32_t old = lane(word, slot);
+			store_bucket(i, set_lane(word, slot, fp));
+			fp = old;
+			i = alt_index(i, fp);
+			if (add_to_bucket(i, fp))
+				return;
+		}
+		victim_.used = true;
+		victim_.index = i;
+		victim_.fp = fp;
+	}
+
+	// һ bucket(t - i) mod mt ָֻƣ alt_index(alt_index(i, fp), fp) == i
+	uint32_t alt_index(uint32_t i, uint32_t fp) const noexcept
+	{
+		const uint32_t t = cuckoo_detail::fastrange32(fp * 0x9e3779b1u, bucket_count_);
+		return t >= i ? t - i : static_cast<uint32_t>(t + bucket_count_ - i);
+	}
+
+	bool test(uint32_t fp, uint32_t i1, uint32_t i2) const
+	{
+		if (has_lane(load_bucket(i1), fp) || has_lane(load_bucket(i2), fp))
+			return true;
+		return victim_.used && victim_.fp == fp && (victim_.index == i1 || victim_.index == i2);
+	}
+
+	//  word Ϊ 0 Ĳۣÿ۵λ͵һ׼ȷ
+	static uint64_t zero_lanes(uint64_t word) noexcept
+	{
+		return (word - lane_ones) & ~word & lane_highs;
+	}
+
+	// bucket Ƿе fp Ĳۣ4 ͬʱȽ
+	static bool has_lane(uint64_t word, uint32_t fp) noexcept
+	{
+		return zero_lanes(word ^ (fp * lane_ones)) != 0;
+	}
+
+	// һ fp Ĳۣûʱ slots_per_bucket
+	static size_type find_lane(uint64_t word, uint32_t fp) noexcept
+	{
+		const uint64_t z = zero_lanes(word ^ (fp * lane_ones));
+		for (size_type i = 0; i < slots_per_bucket; ++i)
+		{
+			if (z & (uint64_t(1) << (i * fingerprint_bits + fingerprint_bits - 1)))
+				return i;
+		}
+		return slots_per_bucket;
+	}
+
+	static uint32_t lane(uint64_t word, size_type i) noexcept
+	{
+		return static_cast<uint32_t>((word >> (i * fingerprint_bits)) & fp_mask);
+	}
+
+	static uint64_t set_lane(uint64_t word, size_type i, uint32_t fp) noexcept
+	{
+		const size_type shift = i * fingerprint_bits;
+		return (word & ~(fp_mask << shift)) | (static_cast<uint64_t>(fp) << shift);
+	}
+
+	// Сдһ bucketƽֽ̨޹
+	uint64_t load_bucket(uint32_t b) const noexcept
+	{
+		const unsigned char* p = table_.data() + static_cast<size_type>(b) * bucket_bytes;
+		uint64_t word = 0;
+		for (size_type i = 0; i < bucket_bytes; ++i)
+			word |= static_cast<uint64_t>(p[i]) << (8 * i);
+		return word;
+	}
+
+	void store_bucket(uint32_t b, uint64_t word) noexcept
+	{
+		unsigned char* p = table_.data() + static_cast<size_type>(b) * bucket_bytes;
+		for (size_type i = 0; i < bucket_bytes; ++i)
+			p[i] = static_cast<unsigned char>(word >> (8 * i));
+	}
+
+	bool add_to_bucket(uint32_t b, uint32_t fp) noexcept
+	{
+		const uint64_t word = load_bucket(b);
+		const size_type i = find_lane(word, 0);
+		if (i == slots_per_bucket)
+			return false;
+		store_bucket(b, set_lane(word, i, fp));
+		return true;
+	}
+
+	bool remove_from_bucket(uint32_t b, uint32_t fp) noexcept
+	{
+		const uint64_t word = load_bucket(b);
+		const size_type i = find_lane(word, fp);
+		if (i == slots_per_bucket)
+			return false;
+		store_bucket(b, set_lane(word, i, 0));
+		return true;
+	}
+
+	// xorshift64
+	uint64_t next_random() noexcept
+	{
+		rng_ ^= rng_ << 13;
+		rng_ ^= rng_ >> 7;
+		rng_ ^= rng_ << 17;
+		return rng_;
+	}
+};
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr typename cuckoo_filter<Key, FingerprintBits, Hash>::size_type
+cuckoo_filter<Key, FingerprintBits, Hash>::slots_per_bucket;
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr typename cuckoo_filter<Key, FingerprintBits, Hash>::size_type
+cuckoo_filter<Key, FingerprintBits, Hash>::fingerprint_bits;
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr typename cuckoo_filter<Key, FingerprintBits, Hash>::size_type
+cuckoo_filter<Key, FingerprintBits, Hash>::bucket_bytes;
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr uint64_t cuckoo_filter<Key, FingerprintBits, Hash>::fp_mask;
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr uint64_t cuckoo_filter<Key, FingerprintBits, Hash>::lane_ones;
+
+template <typename Key, size_t FingerprintBits, typename Hash>
+constexpr uint64_t cuckoo_filter<Key, FingerprintBits, Hash>::lane_highs;
+
+//  mystl  swap
+template <typename Key, size_t FingerprintBits, typename Hash>
+void swap(cuckoo_filter<Key, FingerprintBits, Hash>& lhs,
+	cuckoo_filter<Key, FingerprintBits, Hash>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_CUCKOO_FILTER_H_
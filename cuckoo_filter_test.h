@@ -0,0 +1,232 @@
+#ifndef MY_STL_CUCKOO_FILTER_TEST_H_
+#define MY_STL_CUCKOO_FILTER_TEST_H_
+
+// cuckoo_filter test :  cuckoo_filter ĽӿڣԼ bloom_filterunordered_set ÿֵռõڴͲܶԱ
+
+#include "cuckoo_filter.h"
+#include "bloom_filter_test.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace cuckoo_filter_test
+{
+
+using bloom_filter_test::counted;
+using bloom_filter_test::filter_key;
+using bloom_filter_test::filter_op;
+using bloom_filter_test::filter_op_do_test;
+
+//  [0, len) ֵÿֵռõλҵ [len, 2 * len) ֵʱļÿĲҴ
+template <typename C>
+void filter_summary_do_test(size_t len)
+{
+    C c(len);
+    for (size_t i = 0; i < len; ++i)
+        c.insert(filter_key(i));
+    clock_t start, end;
+    char buf[16];
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = len; i < 2 * len; ++i)
+        hits += c.count(filter_key(i));
+    end = clock();
+    std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(c.memory_bytes()) * 8 / len);
+    std::string t = buf;
+    t += "    |";
+    std::cout << std::setw(WIDE) << t;
+    std::snprintf(buf, sizeof(buf), "%.3f%%", static_cast<double>(hits) / len * 100);
+    t = buf;
+    t += "  |";
+    std::cout << std::setw(WIDE) << t;
+    const double seconds = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+    std::snprintf(buf, sizeof(buf), "%.1fM", seconds > 0 ? len / seconds / 1e6 : 0.0);
+    t = buf;
+    t += "    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  unordered_set Ҳ memory_bytesʹͬĲԴ
+struct measured_set : public mystl::unordered_set<int>
+{
+    explicit measured_set(size_t len) :mystl::unordered_set<int>(len) {}
+    size_t memory_bytes() const
+    {
+        const auto s = stats();
+        return s.bucket_bytes + s.node_bytes;
+    }
+};
+
+//  len ֵʱɾǣʱ
+template <typename C>
+void erase_do_test(size_t len)
+{
+    C c(len);
+    for (size_t i = 0; i < len; ++i)
+        c.insert(filter_key(i));
+    clock_t start, end;
+    char buf[10];
+    size_t erased = 0;
+    start = clock();
+    for (size_t i = 0; i < len; ++i)
+        erased += c.erase(filter_key(i)) ? 1 : 0;
+    end = clock();
+    volatile size_t sink = erased;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define FILTER_SUMMARY_TEST(len)                                              \
+  std::cout << "| cuckoo_filter<8>    |";                                   \
+  filter_summary_do_test<counted<mystl::cuckoo_filter<int, 8>>>(len);       \
+  std::cout << "\n| cuckoo_filter<12>   |";                                 \
+  filter_summary_do_test<counted<mystl::cuckoo_filter<int, 12>>>(len);      \
+  std::cout << "\n| cuckoo_filter<16>   |";                                 \
+  filter_summary_do_test<counted<mystl::cuckoo_filter<int, 16>>>(len);      \
+  std::cout << "\n| bloom_filter (1%)   |";                                 \
+  filter_summary_do_test<counted<mystl::bloom_filter<int>>>(len);           \
+  std::cout << "\n| blocked_bloom (1%)  |";                                 \
+  filter_summary_do_test<counted<mystl::blocked_bloom_filter<int>>>(len);   \
+  std::cout << "\n|mystl::unordered_set |";                                 \
+  filter_summary_do_test<measured_set>(len);
+
+#define CUCKOO_OP_TEST(op, len1, len2, len3)                                  \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_set |";                                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len1);                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len2);                   \
+  filter_op_do_test<mystl::unordered_set<int>>(op, len3);                   \
+  std::cout << "\n| bloom_filter        |";                                 \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len1);           \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len2);           \
+  filter_op_do_test<counted<mystl::bloom_filter<int>>>(op, len3);           \
+  std::cout << "\n| cuckoo_filter<12>   |";                                 \
+  filter_op_do_test<counted<mystl::cuckoo_filter<int>>>(op, len1);          \
+  filter_op_do_test<counted<mystl::cuckoo_filter<int>>>(op, len2);          \
+  filter_op_do_test<counted<mystl::cuckoo_filter<int>>>(op, len3);
+
+#define CUCKOO_ERASE_TEST(len1, len2, len3)                                   \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_set |";                                   \
+  erase_do_test<mystl::unordered_set<int>>(len1);                           \
+  erase_do_test<mystl::unordered_set<int>>(len2);                           \
+  erase_do_test<mystl::unordered_set<int>>(len3);                           \
+  std::cout << "\n| cuckoo_filter<12>   |";                                 \
+  erase_do_test<mystl::cuckoo_filter<int>>(len1);                           \
+  erase_do_test<mystl::cuckoo_filter<int>>(len2);                           \
+  erase_do_test<mystl::cuckoo_filter<int>>(len3);
+
+void cuckoo_filter_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : cuckoo_filter --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = { 1,2,3,4,5 };
+    mystl::cuckoo_filter<int> cf1(100);
+    mystl::cuckoo_filter<int, 8> cf2(100);
+    mystl::cuckoo_filter<int, 16> cf3(100, 50);
+    mystl::cuckoo_filter<mystl::string> sf(100);
+    mystl::vector<char> r(5);
+
+    cf1.insert(a, a + 5);
+    cf2.insert(a, a + 5);
+    cf3.insert(3);
+    sf.insert("apple");
+    std::cout << std::boolalpha;
+    FUN_VALUE(cf1.empty());
+    FUN_VALUE(cf1.contains(3));
+    FUN_VALUE(cf2.contains(5));
+    FUN_VALUE(cf3.contains(3));
+    FUN_VALUE(sf.contains("apple"));
+    FUN_VALUE(cf1.size());
+    FUN_VALUE(cf1.capacity());
+    FUN_VALUE(cf1.bucket_count());
+    FUN_VALUE(cf1.memory_bytes());
+    FUN_VALUE(cf2.memory_bytes());
+    FUN_VALUE(cf3.memory_bytes());
+    FUN_VALUE(cf3.max_kicks());
+    FUN_VALUE(cf1.erase(3));
+    FUN_VALUE(cf1.contains(3));
+    FUN_VALUE(cf1.size());
+    cf1.contains_batch(a, a + 5, r.begin());
+    std::cout << " cf1.contains_batch(a, a + 5) :";
+    for (auto x : r)    std::cout << " " << (x ? "true" : "false");
+    std::cout << std::endl;
+    // ͬһֵΣɾһκȻ
+    cf1.insert(4);
+    FUN_VALUE(cf1.erase(4));
+    FUN_VALUE(cf1.contains(4));
+    // һСĹ֮ĲʧܣɾֿԲ
+    mystl::cuckoo_filter<int> tiny(8, 20);
+    size_t inserted = 0;
+    for (int i = 0; i < 100 && !tiny.full(); ++i)
+        inserted += tiny.insert(i) ? 1 : 0;
+    FUN_VALUE(tiny.capacity());
+    FUN_VALUE(inserted);
+    FUN_VALUE(tiny.full());
+    FUN_VALUE(tiny.insert(1000));
+    FUN_VALUE(tiny.erase(0));
+    FUN_VALUE(tiny.full());
+    FUN_VALUE(tiny.load_factor());
+    cf1.clear();
+    FUN_VALUE(cf1.contains(1));
+    FUN_VALUE(cf1.size());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+#if LARGER_TEST_DATA_ON
+    std::cout << "|" << std::setw(14) << SCALE_M(LEN3) << " keys  |";
+#else
+    std::cout << "|" << std::setw(14) << SCALE_S(LEN3) << " keys  |";
+#endif
+    std::cout << std::setw(WIDE) << "bits/key   |" << std::setw(WIDE) << "fp rate   |"
+        << std::setw(WIDE) << "queries/s  |" << std::endl;
+#if LARGER_TEST_DATA_ON
+    FILTER_SUMMARY_TEST(SCALE_M(LEN3));
+#else
+    FILTER_SUMMARY_TEST(SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|       insert        |";
+#if LARGER_TEST_DATA_ON
+    CUCKOO_OP_TEST(filter_op::insert, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    CUCKOO_OP_TEST(filter_op::insert, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    find (miss)      |";
+#if LARGER_TEST_DATA_ON
+    CUCKOO_OP_TEST(filter_op::find_miss, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    CUCKOO_OP_TEST(filter_op::find_miss, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|        erase        |";
+#if LARGER_TEST_DATA_ON
+    CUCKOO_ERASE_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    CUCKOO_ERASE_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : cuckoo_filter --------------]" << std::endl;
+}
+
+} // namespace cuckoo_filter_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_CUCKOO_FILTER_TEST_H_
@@ -0,0 +1,266 @@
+#ifndef MY_STL_EPOCH_H_
+#define MY_STL_EPOCH_H_
+
+// ͷļڼԪepochڴգepoch_domain  epoch_guard
+// ڲȡĽӳͷ
+
+// notes:
+//
+// ڷʹ֮ǰͨ epoch_guard ٽ epoch_domain ĳеǼǵǰԪ
+// д߰ѽӽṹժ retire㰴ժʱļԪ֮һ
+// ֻелԾĶ߶Ǽ˵ǰԪ e ʱȫּԪƽ e + 1
+// ʱ e - 2 ԪժĽ㲻ٱκζ߳У԰ȫͷš
+//
+// Ǽ鶼ʹ˳һµԭӲһҪôڼ֮ǰǼǣֹԪƽ
+// Ҫôڼ֮Ǽǣʱֻܿ㱻ժĽṹ
+//
+// ۵ĸ̶Ϊ slot_countÿ̴߳Ӱ߳ id ɢеõĲۿʼѰҿвۡ
+// ٽǿģͬһ߳ͬһ epoch_domain еĶ epoch_guard丱
+// һۣм¼ռ߳Ƕ׵Ĵһ epoch_guard 뿪ʱͷŲۡ
+// ˲ֻڳ slot_count ߳ͬʱٽʱŻþʱ pin ȴ߳뿪
+// epoch_guard ߳٣Ƕ״ԭӲά
+// ʱ epoch_guard ֹգӰȷԡ
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "vector.h"
+
+namespace mystl
+{
+
+class epoch_domain
+{
+public:
+	static constexpr size_t slot_count = 128;
+	// ÿժٸ㳢ƽһμԪ
+	static constexpr size_t advance_interval = 64;
+
+	using deleter_type = void(*)(void*);
+
+private:
+	// ۵״̬0 ʾУΪ (Ԫ << 1) | 1ÿ۶ռһбα
+	// owner ĸ 32 λΪռ̵߳ıţ 32 λΪǶ׵ĴʱΪ 0
+	struct alignas(64) slot
+	{
+		std::atomic<uint64_t> state{ 0 };
+		std::atomic<uint64_t> owner{ 0 };
+	};
+
+	// ÿ̻߳ɸ epoch_domain ռõĲۣ epoch_domain ĵַɢУֻΪʾ
+	static constexpr size_t thread_cache_size = 8;
+
+	struct retired_node
+	{
+		void*			ptr;
+		deleter_type	deleter;
+	};
+
+	slot						slots_[slot_count];
+	std::atomic<uint64_t>		epoch_{ 0 };
+	std::mutex					mutex_;			//  retired_  retire_count_
+	mystl::vector<retired_node>	retired_[3];	// ժʱļԪģ 3 
+	size_t						retire_count_{ 0 };
+
+public:
+	epoch_domain() = default;
+	epoch_domain(const epoch_domain&) = delete;
+	epoch_domain& operator=(const epoch_domain&) = delete;
+
+	// ʱӦжߣͷȫս
+	~epoch_domain()
+	{
+		for (auto& list : retired_)
+			free_all(list);
+	}
+
+	// ٽز۵±
+	// ǰ߳ epoch_domain ռ˲ʱֻǶ״ռһв۲ǼǵǰԪ
+	size_t pin() noexcept
+	{
+		const uint64_t tag = static_cast<uint64_t>(thread_tag()) << 32;
+		size_t& cached = thread_cache()[(reinterpret_cast<uintptr_t>(this) >> 6) % thread_cache_size];
+		if (cached < slot_count)
+		{
+			// owner ͬʱ¼߳Ϊ 0 ʾڱͷţٽ
+			auto& owner = slots_[cached].owner;
+			uint64_t cur = owner.load(std::memory_order_relaxed);
+			while ((cur >> 32) == (tag >> 32) && (cur & 0xffffffffu) != 0)
+			{
+				if (owner.compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed))
+					return cached;
+			}
+		}
+		size_t i = thread_hint() % slot_count;
+		for (;;)
+		{
+			for (size_t n = 0; n < slot_count; ++n, i = (i + 1) % slot_count)
+			{
+				uint64_t expected = 0;
+				if (slots_[i].state.load(std::memory_order_relaxed) == 0 &&
+					slots_[i].state.compare_exchange_strong(expected,
+						(epoch_.load(std::memory_order_seq_cst) << 1) | 1, std::memory_order_seq_cst))
+				{
+					slots_[i].owner.store(tag | 1, std::memory_order_relaxed);
+					cached = i;
+					return i;
+				}
+			}
+			//  slot_count ߳ͬʱٽȴ߳뿪
+			std::this_thread::yield();
+		}
+	}
+
+	// 뿪ٽǶ״Ϊ 0 ʱͷŲ
+	// acq_rel ֤ͬһ뿪 epoch_guard ٽڵĶȡͷŲ۷
+	void unpin(size_t i) noexcept
+	{
+		if ((slots_[i].owner.fetch_sub(1, std::memory_order_acq_rel) & 0xffffffffu) == 1)
+		{
+			slots_[i].owner.store(0, std::memory_order_relaxed);
+			slots_[i].state.store(0, std::memory_order_release);
+		}
+	}
+
+	// ǼһѴӽṹժĽ㣬ȵûж߿ܳʱ deleter(p)
+	void retire(void* p, deleter_type deleter)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		const uint64_t e = epoch_.load(std::memory_order_relaxed);
+		retired_[e % 3].push_back(retired_node{ p, deleter });
+		if (++retire_count_ % advance_interval == 0)
+			try_advance(e);
+	}
+
+	// ƽһμԪͷѾȫĽ
+	void collect()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		try_advance(epoch_.load(std::memory_order_relaxed));
+	}
+
+	uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_relaxed); }
+
+private:
+	// ʱѳ mutex_
+	bool try_advance(uint64_t e)
+	{
+		for (auto& s : slots_)
+		{
+			const uint64_t state = s.state.load(std::memory_order_seq_cst);
+			if ((state & 1) != 0 && (state >> 1) != e)
+				return false;
+		}
+		// ж߶ڼԪ eԪ e - 2 ժĽͷţ e + 1 һ
+		free_all(retired_[(e + 1) % 3]);
+		epoch_.store(e + 1, std::memory_order_seq_cst);
+		return true;
+	}
+
+	static void free_all(mystl::vector<retired_node>& list)
+	{
+		for (auto& r : list)
+			r.deleter(r.ptr);
+		list.clear();
+	}
+
+	static size_t thread_hint() noexcept
+	{
+		static thread_local const size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+		return hint;
+	}
+
+	// ̵߳ıţ 1 ʼǲĸ߳
+	static uint32_t thread_tag() noexcept
+	{
+		static std::atomic<uint32_t> next{ 0 };
+		static thread_local const uint32_t tag = next.fetch_add(1, std::memory_order_relaxed) + 1;
+		return tag;
+	}
+
+	// е slot_count ʾûл
+	static size_t* thread_cache() noexcept
+	{
+		struct cache
+		{
+			size_t slots[thread_cache_size];
+			cache() { for (auto& s : slots) s = slot_count; }
+		};
+		static thread_local cache c;
+		return c.slots;
+	}
+};
+
+// epoch_guard : ʱٽʱ뿪ʱٽһΣͬһ̹߳һۣƶ
+class epoch_guard
+{
+private:
+	epoch_domain*	domain_;
+	size_t			slot_;
+
+public:
+	epoch_guard() noexcept :domain_{ nullptr }, slot_{ 0 } {}
+
+	explicit epoch_guard(epoch_domain& d) noexcept
+		:domain_{ &d }, slot_{ d.pin() }
+	{
+	}
+
+	epoch_guard(const epoch_guard& rhs) noexcept
+		:domain_{ rhs.domain_ }, slot_{ rhs.domain_ == nullptr ? 0 : rhs.domain_->pin() }
+	{
+	}
+
+	epoch_guard(epoch_guard&& rhs) noexcept
+		:domain_{ rhs.domain_ }, slot_{ rhs.slot_ }
+	{
+		rhs.domain_ = nullptr;
+	}
+
+	epoch_guard& operator=(const epoch_guard& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			epoch_guard tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	epoch_guard& operator=(epoch_guard&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			reset();
+			domain_ = rhs.domain_;
+			slot_ = rhs.slot_;
+			rhs.domain_ = nullptr;
+		}
+		return *this;
+	}
+
+	~epoch_guard() { reset(); }
+
+	bool active() const noexcept { return domain_ != nullptr; }
+
+	void reset() noexcept
+	{
+		if (domain_ != nullptr)
+		{
+			domain_->unpin(slot_);
+			domain_ = nullptr;
+		}
+	}
+
+	void swap(epoch_guard& rhs) noexcept
+	{
+		mystl::swap(domain_, rhs.domain_);
+		mystl::swap(slot_, rhs.slot_);
+	}
+};
+
+} // namespace mystl
+#endif // !MY_STL_EPOCH_H_
@@ -0,0 +1,284 @@
+#ifndef MY_STL_FLAT_HASH_MAP_H_
+#define MY_STL_FLAT_HASH_MAP_H_
+
+// ͷļģ flat_hash_map
+// flat_hash_map : ÷ unordered_map ƣײΪŶַ flat_hashtableԪֱӴڱ
+
+// notes:
+//
+//  unordered_map 
+//   * ԪشĲжǵĽУʱÿֽڳˣٷ޹صԪأ
+//   * ¹ϣƶԪأ֮ǰȡõԪصָ֮ʧЧ
+//   * ûͰľֲbucket_count() ز۵ĸӹ̶Ϊ 7/8
+//   * ṩextract / merge
+//
+// 쳣֤
+// mystl::flat_hash_map<Key, T> 쳣֤µȺǿ쳣ȫ֤
+//   * emplace
+//   * try_emplace
+//   * insert
+
+#include "flat_hashtable.h"
+
+namespace mystl
+{
+
+// ģ flat_hash_mapֵظ
+// һֵͣʵֵͣϣȱʡʹ mystl::hash
+// ĴֵȽϷʽȱʡʹ mystl::equal_to
+template <typename Key, typename T, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+class flat_hash_map
+{
+private:
+	using base_type = flat_hashtable<mystl::pair<const Key, T>, Hash, KeyEqual>;
+	base_type ht_;
+
+public:
+	using allocator_type			= typename base_type::allocator_type;
+	using key_type					= typename base_type::key_type;
+	using mapped_type				= typename base_type::mapped_type;
+	using value_type				= typename base_type::value_type;
+	using hasher					= typename base_type::hasher;
+	using key_equal					= typename base_type::key_equal;
+
+	using size_type					= typename base_type::size_type;
+	using difference_type			= typename base_type::difference_type;
+	using pointer					= typename base_type::pointer;
+	using const_pointer				= typename base_type::const_pointer;
+	using reference					= typename base_type::reference;
+	using const_reference			= typename base_type::const_reference;
+
+	using iterator					= typename base_type::iterator;
+	using const_iterator			= typename base_type::const_iterator;
+
+	allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+	// 졢ơƶ
+	flat_hash_map() = default;
+
+	explicit flat_hash_map(size_type bucket_count,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+	}
+
+	template <typename InputIterator>
+	flat_hash_map(InputIterator first, InputIterator last,
+		const size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+		ht_.insert_unique(first, last);
+	}
+
+	flat_hash_map(std::initializer_list<value_type> ilist,
+		const size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+		ht_.reserve(ilist.size());
+		ht_.insert_unique(ilist.begin(), ilist.end());
+	}
+
+	flat_hash_map(const flat_hash_map& rhs) = default;
+	flat_hash_map(flat_hash_map&& rhs) noexcept = default;
+
+	flat_hash_map& operator=(const flat_hash_map& rhs) = default;
+	flat_hash_map& operator=(flat_hash_map&& rhs) noexcept = default;
+
+	flat_hash_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		ht_.clear();
+		ht_.reserve(ilist.size());
+		ht_.insert_unique(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~flat_hash_map() = default;
+
+	// 
+	iterator begin() noexcept
+	{ return ht_.begin(); }
+	const_iterator begin() const noexcept
+	{ return ht_.begin(); }
+	iterator end() noexcept
+	{ return ht_.end(); }
+	const_iterator end() const noexcept
+	{ return ht_.end(); }
+
+	const_iterator cbegin() const noexcept
+	{ return ht_.cbegin(); }
+	const_iterator cend() const noexcept
+	{ return ht_.cend(); }
+
+	// 
+	bool		empty()		const noexcept { return ht_.empty(); }
+	size_type	size()		const noexcept { return ht_.size(); }
+	size_type	max_size()	const noexcept { return ht_.max_size(); }
+
+	// ޸
+
+	// emplace / emplace_hint / try_emplace
+
+	template <typename ...Args>
+	pair<iterator, bool> emplace(Args&& ...args)
+	{
+		return ht_.emplace_unique(mystl::forward<Args>(args)...);
+	}
+
+	// Ŷַı޷ hint
+	template <typename ...Args>
+	iterator emplace_hint(const_iterator, Args&& ...args)
+	{
+		return ht_.emplace_unique(mystl::forward<Args>(args)...).first;
+	}
+
+	// ֵѴʱκζ
+	template <typename ...Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{
+		return ht_.emplace_key(key, key, mapped_type(mystl::forward<Args>(args)...));
+	}
+
+	// insert
+
+	pair<iterator, bool> insert(const value_type& value)
+	{
+		return ht_.insert_unique(value);
+	}
+	pair<iterator, bool> insert(value_type&& value)
+	{
+		return ht_.insert_unique(mystl::move(value));
+	}
+
+	iterator insert(const_iterator, const value_type& value)
+	{
+		return ht_.insert_unique(value).first;
+	}
+	iterator insert(const_iterator, value_type&& value)
+	{
+		return ht_.insert_unique(mystl::move(value)).first;
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		ht_.insert_unique(first, last);
+	}
+
+	// erase / clear
+
+	void erase(iterator it)
+	{
+		ht_.erase(it);
+	}
+	void erase(iterator first, iterator last)
+	{
+		ht_.erase(first, last);
+	}
+
+	size_type erase(const key_type& key)
+	{
+		return ht_.erase_unique(key);
+	}
+
+	void clear()
+	{
+		ht_.clear();
+	}
+
+	void swap(flat_hash_map& other) noexcept
+	{
+		ht_.swap(other.ht_);
+	}
+
+	// 
+	mapped_type& at(const key_type& key)
+	{
+		iterator it = ht_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_hash_map<Key, T> no such element exists");
+		return it->second;
+	}
+	const mapped_type& at(const key_type& key) const
+	{
+		const_iterator it = ht_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_hash_map<Key, T> no such element exists");
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		return ht_.emplace_key(key, key, mapped_type()).first->second;
+	}
+	// ڹԪ֮ǰɣֵѴʱ key ᱻƶ
+	mapped_type& operator[](key_type&& key)
+	{
+		return ht_.emplace_key(key, mystl::move(key), mapped_type()).first->second;
+	}
+
+	size_type count(const key_type& key) const
+	{
+		return ht_.count(key);
+	}
+
+	iterator find(const key_type& key)
+	{
+		return ht_.find(key);
+	}
+	const_iterator find(const key_type& key) const
+	{
+		return ht_.find(key);
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		return ht_.equal_range_unique(key);
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return ht_.equal_range_unique(key);
+	}
+
+	// bucket interface
+
+	size_type bucket_count() const noexcept
+	{ return ht_.bucket_count(); }
+	size_type max_bucket_count() const noexcept
+	{ return ht_.max_bucket_count(); }
+
+	// hash policy
+
+	float load_factor() const noexcept { return ht_.load_factor(); }
+	float max_load_factor() const noexcept { return ht_.max_load_factor(); }
+
+	void rehash(size_type count) { ht_.rehash(count); }
+	void reserve(size_type count) { ht_.reserve(count); }
+
+	hasher hash_fcn() const { return ht_.hash_fcn(); }
+	key_equal key_eq() const { return ht_.key_eq(); }
+
+public:
+	friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs)
+	{
+		return lhs.ht_.equal_to(rhs.ht_);
+	}
+	friend bool operator!=(const flat_hash_map& lhs, const flat_hash_map& rhs)
+	{
+		return !lhs.ht_.equal_to(rhs.ht_);
+	}
+};
+
+//  mystl  swap
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual>& lhs,
+	flat_hash_map<Key, T, Hash, KeyEqual>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FLAT_HASH_MAP_H_
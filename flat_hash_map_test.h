@@ -0,0 +1,278 @@
+#ifndef MY_STL_FLAT_HASH_MAP_TEST_H_
+#define MY_STL_FLAT_HASH_MAP_TEST_H_
+
+// flat_hash_map test :  flat_hash_map, flat_hash_set ĽӿڣԼ unordered_map Ĳ롢ҡɾܶԱ
+
+#include <unordered_map>
+
+#include "flat_hash_map.h"
+#include "flat_hash_set.h"
+#include "unordered_map.h"
+#include "map_test.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_hash_map_test
+{
+
+// ܲԵֲ
+enum class hash_op { emplace, find_hit, find_miss, erase };
+
+//  i ԼֵʹֵͬҸλб仯
+inline int hash_test_key(size_t i)
+{
+    return static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+}
+
+//  count Ԫִһֲʱ emplace ⶼȷȫԪأֻͳƲ
+// rand() ڲƽֻ̨ 15 λԲ㹻໥ͬļֵﲻʹ
+template <typename Map>
+void hash_op_do_test(hash_op op, size_t count)
+{
+    clock_t start, end;
+    char buf[10];
+    Map m;
+    if (op != hash_op::emplace)
+    {
+        for (size_t i = 0; i < count; ++i)
+            m.emplace(hash_test_key(i), static_cast<int>(i));
+    }
+    size_t hits = 0;
+    start = clock();
+    switch (op)
+    {
+    case hash_op::emplace:
+        for (size_t i = 0; i < count; ++i)
+            m.emplace(hash_test_key(i), static_cast<int>(i));
+        hits = m.size();
+        break;
+    case hash_op::find_hit:
+        for (size_t i = 0; i < count; ++i)
+            hits += m.find(hash_test_key(i)) != m.end();
+        break;
+    case hash_op::find_miss:
+        for (size_t i = 0; i < count; ++i)
+            hits += m.find(hash_test_key(i) + 1) != m.end();
+        break;
+    case hash_op::erase:
+        for (size_t i = 0; i < count; ++i)
+            hits += m.erase(hash_test_key(i));
+        break;
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define HASH_OP_TEST(op, len1, len2, len3)                                    \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "| std::unordered_map  |";                                   \
+  hash_op_do_test<std::unordered_map<int, int>>(op, len1);                  \
+  hash_op_do_test<std::unordered_map<int, int>>(op, len2);                  \
+  hash_op_do_test<std::unordered_map<int, int>>(op, len3);                  \
+  std::cout << "\n|mystl::unordered_map |";                                 \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len1);                \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len2);                \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len3);                \
+  std::cout << "\n|mystl::flat_hash_map |";                                 \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len1);                \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len2);                \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len3);
+
+#if LARGER_TEST_DATA_ON
+#define HASH_OP_TEST_ALL(op) HASH_OP_TEST(op, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3))
+#else
+#define HASH_OP_TEST_ALL(op) HASH_OP_TEST(op, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3))
+#endif
+
+// budget  0 ֮ǰعϣֵ֮׳쳣¹ϣ;ʧ
+struct fail_after_hash
+{
+    int* budget = nullptr;
+    size_t operator()(int key) const
+    {
+        if (budget != nullptr && (*budget)-- == 0)
+            throw std::runtime_error("hash failed");
+        return mystl::hash<int>()(key);
+    }
+};
+
+void flat_hash_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : flat_hash_map --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<PAIR> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(PAIR(5 - i, 5 - i));
+    mystl::flat_hash_map<int, int> fm1;
+    mystl::flat_hash_map<int, int> fm2(520);
+    mystl::flat_hash_map<int, int> fm3(520, mystl::hash<int>());
+    mystl::flat_hash_map<int, int> fm4(520, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::flat_hash_map<int, int> fm5(v.begin(), v.end());
+    mystl::flat_hash_map<int, int> fm6(v.begin(), v.end(), 100);
+    mystl::flat_hash_map<int, int> fm7(v.begin(), v.end(), 100, mystl::hash<int>());
+    mystl::flat_hash_map<int, int> fm8(v.begin(), v.end(), 100, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::flat_hash_map<int, int> fm9(fm5);
+    mystl::flat_hash_map<int, int> fm10(std::move(fm5));
+    mystl::flat_hash_map<int, int> fm11;
+    fm11 = fm6;
+    mystl::flat_hash_map<int, int> fm12;
+    fm12 = std::move(fm6);
+    mystl::flat_hash_map<int, int> fm13{ PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+    mystl::flat_hash_map<int, int> fm14;
+    fm14 = { PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+
+    MAP_FUN_AFTER(fm1, fm1.emplace(1, 1));
+    MAP_FUN_AFTER(fm1, fm1.emplace_hint(fm1.begin(), 1, 2));
+    MAP_FUN_AFTER(fm1, fm1.insert(PAIR(2, 2)));
+    MAP_FUN_AFTER(fm1, fm1.insert(fm1.end(), PAIR(3, 3)));
+    MAP_FUN_AFTER(fm1, fm1.insert(v.begin(), v.end()));
+    MAP_FUN_AFTER(fm1, fm1.try_emplace(6, 6));
+    MAP_FUN_AFTER(fm1, fm1.erase(fm1.begin()));
+    MAP_FUN_AFTER(fm1, fm1.erase(fm1.find(3), fm1.end()));
+    MAP_FUN_AFTER(fm1, fm1.erase(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE(fm1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(fm1.size());
+    FUN_VALUE(fm1.bucket_count());
+    MAP_FUN_AFTER(fm1, fm1.clear());
+    MAP_FUN_AFTER(fm1, fm1.swap(fm7));
+    FUN_VALUE(fm1.at(1));
+    FUN_VALUE(fm1[1]);
+    FUN_VALUE(fm1[10]);
+    std::cout << std::boolalpha;
+    FUN_VALUE(fm1.empty());
+    FUN_VALUE((fm1 == fm7));
+    FUN_VALUE((fm8 == fm9));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(fm1.size());
+    FUN_VALUE(fm1.bucket_count());
+    MAP_FUN_AFTER(fm1, fm1.reserve(1000));
+    FUN_VALUE(fm1.size());
+    FUN_VALUE(fm1.bucket_count());
+    MAP_FUN_AFTER(fm1, fm1.rehash(150));
+    FUN_VALUE(fm1.bucket_count());
+    FUN_VALUE(fm1.count(1));
+    MAP_VALUE(*fm1.find(3));
+    auto first = *fm1.equal_range(3).first;
+    std::cout << " fm1.equal_range(3).first : <" << first.first << ", " << first.second << ">" << std::endl;
+    FUN_VALUE(fm1.load_factor());
+    FUN_VALUE(fm1.max_load_factor());
+
+    // ¹ϣʱ 8 μϣֵʧܣеԪֲ
+    int budget = -1;
+    mystl::flat_hash_map<int, int, fail_after_hash> fm15(0, fail_after_hash{ &budget });
+    for (int i = 0; i < 14; ++i)
+        fm15.emplace(i, i);
+    FUN_VALUE(fm15.bucket_count());
+    budget = 8;
+    try
+    {
+        fm15.emplace(14, 14);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << " fm15.emplace(14, 14) : " << e.what() << std::endl;
+    }
+    budget = -1;
+    FUN_VALUE(fm15.size());
+    FUN_VALUE(fm15.bucket_count());
+    size_t found = 0;
+    for (int i = 0; i < 14; ++i)
+        found += fm15.count(i);
+    FUN_VALUE(found);
+    fm15.emplace(14, 14);
+    FUN_VALUE(fm15.size());
+    FUN_VALUE(fm15.bucket_count());
+    FUN_VALUE(fm15.at(14));
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|       emplace       |";
+    HASH_OP_TEST_ALL(hash_op::emplace);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     find (hit)      |";
+    HASH_OP_TEST_ALL(hash_op::find_hit);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     find (miss)     |";
+    HASH_OP_TEST_ALL(hash_op::find_miss);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|        erase        |";
+    HASH_OP_TEST_ALL(hash_op::erase);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : flat_hash_map --------------]" << std::endl;
+}
+
+void flat_hash_set_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : flat_hash_set --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = { 5,4,3,2,1 };
+    mystl::flat_hash_set<int> fs1;
+    mystl::flat_hash_set<int> fs2(520);
+    mystl::flat_hash_set<int> fs3(520, mystl::hash<int>());
+    mystl::flat_hash_set<int> fs4(520, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::flat_hash_set<int> fs5(a, a + 5);
+    mystl::flat_hash_set<int> fs6(a, a + 5, 100);
+    mystl::flat_hash_set<int> fs7(a, a + 5, 100, mystl::hash<int>());
+    mystl::flat_hash_set<int> fs8(a, a + 5, 100, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::flat_hash_set<int> fs9(fs5);
+    mystl::flat_hash_set<int> fs10(std::move(fs5));
+    mystl::flat_hash_set<int> fs11;
+    fs11 = fs6;
+    mystl::flat_hash_set<int> fs12;
+    fs12 = std::move(fs6);
+    mystl::flat_hash_set<int> fs13{ 1,2,3,4,5 };
+    mystl::flat_hash_set<int> fs14;
+    fs14 = { 1,2,3,4,5 };
+
+    FUN_AFTER(fs1, fs1.emplace(1));
+    FUN_AFTER(fs1, fs1.emplace_hint(fs1.end(), 2));
+    FUN_AFTER(fs1, fs1.insert(5));
+    FUN_AFTER(fs1, fs1.insert(fs1.begin(), 5));
+    FUN_AFTER(fs1, fs1.insert(a, a + 5));
+    FUN_AFTER(fs1, fs1.erase(fs1.begin()));
+    FUN_AFTER(fs1, fs1.erase(fs1.find(3), fs1.end()));
+    FUN_AFTER(fs1, fs1.erase(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE(fs1.empty());
+    FUN_VALUE((fs13 == fs14));
+    FUN_VALUE((fs1 == fs14));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(fs1.size());
+    FUN_VALUE(fs1.bucket_count());
+    FUN_AFTER(fs1, fs1.swap(fs7));
+    FUN_VALUE(*fs1.begin());
+    FUN_VALUE(fs1.count(1));
+    FUN_VALUE(*fs1.find(3));
+    FUN_AFTER(fs1, fs1.reserve(1000));
+    FUN_VALUE(fs1.bucket_count());
+    FUN_AFTER(fs1, fs1.clear());
+    FUN_VALUE(fs1.load_factor());
+    PASSED;
+    std::cout << "[------------- End container test : flat_hash_set --------------]" << std::endl;
+}
+
+} // namespace flat_hash_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_FLAT_HASH_MAP_TEST_H_
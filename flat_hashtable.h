@@ -0,0 +1,819 @@
+#ifndef MY_STL_FLAT_HASHTABLE_H_
+#define MY_STL_FLAT_HASHTABLE_H_
+
+// ͷļһģ flat_hashtable
+// flat_hashtable : ŶַĹϣԪֱӴĲУ 16 Ϊһÿֽ̽
+
+// notes:
+//
+// ֣
+//   * slots_  capacity Ԫأcapacity Ϊ 16Ϊ 2 ݣ
+//   * ctrl_ Ϊÿ۱һֽڣղΪ flat_ctrl_emptyλΪ 1
+//     ΪԪعϣֵߵ 7 λtagctrl_[capacity] Ϊڱڴֹͣ
+//   * overflow_ Ϊÿ鱣һ̽ʱһ顢ںеԪظ
+//
+// ʱɹϣֵõʼ tagһ SSE2 Ƚָͬʱһ 16 ֽڣ
+// ֻ tag ͬĲ۲űȽϼֵ overflow Ϊ 0ûԪԽһ飬ҽ
+// У+1, +2, +3, ...̽һ飬Ϊ 2 ʱлᾭÿһ顣
+// û SSE2 ʱʹֽڱȽϵĿֲʵ֡
+//
+// ɾĹtombstoneֱΪգ̽·ϸ overflow һ
+// ˷ɾ֮ҳȲ˻ҲҪΪĹ¹ϣ
+// overflow ﵽ 255 ֻʹҶ̽⼸飬Ӱȷԡ
+//
+// ӹ̶Ϊ 7/8ʱmystl::hash ֱӷԭֵ
+// ˹ϣֵȳһٰѸλ۵λʹʼ tag ȫλ
+//
+// ¹ϣʱеԪصöʧЧ벻ʹʧЧ
+// ɾֻʹָɾԪصĵʧЧ¹ϣʱƶ׳쳣ԪظΪƣ
+// ¹ϣ׳쳣ʱֲ䡣
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYSTL_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define MYSTL_FLAT_HASH_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// ֽڵȡֵղڱλΪ 1Ϊ 0 ~ 127  tag
+constexpr int8_t flat_ctrl_empty	= -128;
+constexpr int8_t flat_ctrl_sentinel	= -1;
+
+// һֽڣ 16 ֽڶԱ
+struct alignas(16) flat_ctrl_block
+{
+	int8_t ctrl[16];
+};
+
+// λ 1 ±꣬x Ϊ 0
+inline int flat_hash_ctz(uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+	unsigned long i;
+	_BitScanForward(&i, x);
+	return static_cast<int>(i);
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(x);
+#else
+	int i = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++i;
+	return i;
+#endif
+}
+
+// һ 16 ֽڵƥ䣬ĵ i λӦ i 
+struct flat_hash_group
+{
+	static constexpr size_t width = 16;
+
+#if MYSTL_FLAT_HASH_SSE2
+	__m128i ctrl;
+
+	explicit flat_hash_group(const int8_t* p) noexcept
+		:ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(p)))
+	{
+	}
+
+	uint32_t match(int8_t tag) const noexcept
+	{
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+	}
+
+	uint32_t match_empty() const noexcept
+	{
+		return match(flat_ctrl_empty);
+	}
+
+	// ۵λΪ 0
+	uint32_t match_full() const noexcept
+	{
+		return static_cast<uint32_t>(~_mm_movemask_epi8(ctrl)) & 0xffffu;
+	}
+#else
+	const int8_t* ctrl;
+
+	explicit flat_hash_group(const int8_t* p) noexcept :ctrl(p) {}
+
+	uint32_t match(int8_t tag) const noexcept
+	{
+		uint32_t mask = 0;
+		for (size_t i = 0; i < width; ++i)
+		{
+			if (ctrl[i] == tag)
+				mask |= 1u << i;
+		}
+		return mask;
+	}
+
+	uint32_t match_empty() const noexcept
+	{
+		return match(flat_ctrl_empty);
+	}
+
+	uint32_t match_full() const noexcept
+	{
+		uint32_t mask = 0;
+		for (size_t i = 0; i < width; ++i)
+		{
+			if (ctrl[i] >= 0)
+				mask |= 1u << i;
+		}
+		return mask;
+	}
+#endif
+};
+
+// ձõĿֽڣֻһڱʹձ begin() == end() ҲҪڴ
+inline int8_t* flat_hash_empty_ctrl() noexcept
+{
+	static flat_ctrl_block block = { { flat_ctrl_sentinel } };
+	return block.ctrl;
+}
+
+// flat_hashtable ĵֽ۵ָ룬ǰʱղۣڱֹͣ
+template <typename T, typename Ref, typename Ptr>
+struct flat_ht_iterator :public mystl::iterator<mystl::forward_iterator_tag, T, ptrdiff_t, Ptr, Ref>
+{
+	using iterator			= flat_ht_iterator<T, T&, T*>;
+	using self				= flat_ht_iterator<T, Ref, Ptr>;
+	using reference			= Ref;
+	using pointer			= Ptr;
+
+	const int8_t*	ctrl;
+	T*				slot;
+
+	flat_ht_iterator() noexcept :ctrl{ nullptr }, slot{ nullptr } {}
+	flat_ht_iterator(const int8_t* c, T* s) noexcept :ctrl{ c }, slot{ s } {}
+	flat_ht_iterator(const iterator& rhs) noexcept :ctrl{ rhs.ctrl }, slot{ rhs.slot } {}
+
+	reference operator*()  const { return *slot; }
+	pointer   operator->() const { return slot; }
+
+	self& operator++()
+	{
+		do
+		{
+			++ctrl;
+			++slot;
+		} while (*ctrl == flat_ctrl_empty);
+		return *this;
+	}
+
+	self operator++(int)
+	{
+		self tmp(*this);
+		++*this;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return ctrl == rhs.ctrl; }
+	bool operator!=(const self& rhs) const { return ctrl != rhs.ctrl; }
+};
+
+// ģ flat_hashtableֵظ
+// һԪͣϣֵȵıȽϺ
+template <typename T, typename Hash, typename KeyEqual>
+class flat_hashtable
+{
+public:
+	using value_traits				= ht_value_traits<T>;
+	using key_type					= typename value_traits::key_type;
+	using mapped_type				= typename value_traits::mapped_type;
+	using value_type				= typename value_traits::value_type;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using allocator_type			= mystl::allocator<T>;
+	using data_allocator			= mystl::allocator<T>;
+	using ctrl_allocator			= mystl::allocator<flat_ctrl_block>;
+	using count_allocator			= mystl::allocator<uint8_t>;
+	using hash_allocator			= mystl::allocator<size_t>;
+
+	using pointer					= typename allocator_type::pointer;
+	using const_pointer				= typename allocator_type::const_pointer;
+	using reference					= typename allocator_type::reference;
+	using const_reference			= typename allocator_type::const_reference;
+	using size_type					= typename allocator_type::size_type;
+	using difference_type			= typename allocator_type::difference_type;
+
+	using iterator					= flat_ht_iterator<T, T&, T*>;
+	using const_iterator			= flat_ht_iterator<T, const T&, const T*>;
+
+	static constexpr size_type group_width	= flat_hash_group::width;
+	static constexpr size_type npos			= static_cast<size_type>(-1);
+
+	allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+	int8_t*		ctrl_;		// capacity + 1 ֽڣһΪڱ
+	T*			slots_;		// capacity 
+	uint8_t*	overflow_;	// ÿһ
+	size_type	groups_;	// Ϊ 0  2 
+	size_type	size_;
+	hasher		hash_;
+	key_equal	equal_;
+
+public:
+	// 졢ơƶ
+	explicit flat_hashtable(size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:ctrl_(flat_hash_empty_ctrl()), slots_(nullptr), overflow_(nullptr),
+		groups_(0), size_(0), hash_(hash), equal_(equal)
+	{
+		if (bucket_count > 0)
+			rehash(bucket_count);
+	}
+
+	flat_hashtable(const flat_hashtable& rhs);
+
+	flat_hashtable(flat_hashtable&& rhs) noexcept
+		:ctrl_(rhs.ctrl_), slots_(rhs.slots_), overflow_(rhs.overflow_),
+		groups_(rhs.groups_), size_(rhs.size_), hash_(rhs.hash_), equal_(rhs.equal_)
+	{
+		rhs.reset_empty();
+	}
+
+	flat_hashtable& operator=(const flat_hashtable& rhs)
+	{
+		if (this != &rhs)
+		{
+			flat_hashtable tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	flat_hashtable& operator=(flat_hashtable&& rhs) noexcept
+	{
+		flat_hashtable tmp(mystl::move(rhs));
+		swap(tmp);
+		return *this;
+	}
+
+	~flat_hashtable()
+	{
+		clear();
+		deallocate_arrays(ctrl_, slots_, overflow_, groups_);
+	}
+
+	// ز
+	iterator begin() noexcept
+	{ return make_begin<iterator>(); }
+	const_iterator begin() const noexcept
+	{ return make_begin<const_iterator>(); }
+	iterator end() noexcept
+	{ return iterator(ctrl_ + capacity(), slots_ + capacity()); }
+	const_iterator end() const noexcept
+	{ return const_iterator(ctrl_ + capacity(), slots_ + capacity()); }
+
+	const_iterator cbegin() const noexcept
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	bool		empty()		const noexcept { return size_ == 0; }
+	size_type	size()		const noexcept { return size_; }
+	size_type	max_size()	const noexcept { return max_groups() * group_width; }
+	size_type	capacity()	const noexcept { return groups_ * group_width; }
+
+	// ޸ز
+
+	// emplace / try_emplace
+
+	// ȹԪزܵõֵֵѴʱԪ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_unique(Args&& ...args)
+	{
+		T tmp(mystl::forward<Args>(args)...);
+		return emplace_key(value_traits::get_key(tmp), mystl::move(tmp));
+	}
+
+	// ֵѴʱκζ󣬷 args ڲԭعԪ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_key(const key_type& key, Args&& ...args);
+
+	mystl::pair<iterator, bool> insert_unique(const value_type& value)
+	{
+		return emplace_key(value_traits::get_key(value), value);
+	}
+	mystl::pair<iterator, bool> insert_unique(value_type&& value)
+	{
+		return emplace_key(value_traits::get_key(value), mystl::move(value));
+	}
+
+	template <typename InputIter>
+	void insert_unique(InputIter first, InputIter last)
+	{
+		for (; first != last; ++first)
+			insert_unique(*first);
+	}
+
+	// erase / clear
+
+	void erase(const_iterator position)
+	{
+		erase_index(static_cast<size_type>(position.slot - slots_));
+	}
+	void erase(const_iterator first, const_iterator last)
+	{
+		// ɾƶԪأȡúɾǰԪؼ
+		while (first != last)
+		{
+			const_iterator cur = first++;
+			erase(cur);
+		}
+	}
+
+	size_type erase_unique(const key_type& key)
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		if (idx == npos)
+			return 0;
+		erase_index(idx);
+		return 1;
+	}
+
+	void clear();
+
+	void swap(flat_hashtable& rhs) noexcept;
+
+	// ز
+
+	size_type count(const key_type& key) const
+	{
+		return find_index(key, hash_code(key)) == npos ? 0 : 1;
+	}
+
+	iterator find(const key_type& key)
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		return idx == npos ? end() : iterator(ctrl_ + idx, slots_ + idx);
+	}
+	const_iterator find(const key_type& key) const
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		return idx == npos ? end() : const_iterator(ctrl_ + idx, slots_ + idx);
+	}
+
+	mystl::pair<iterator, iterator> equal_range_unique(const key_type& key)
+	{
+		iterator it = find(key);
+		if (it == end())
+			return mystl::pair<iterator, iterator>(it, it);
+		iterator next = it;
+		return mystl::pair<iterator, iterator>(it, ++next);
+	}
+	mystl::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		if (it == end())
+			return mystl::pair<const_iterator, const_iterator>(it, it);
+		const_iterator next = it;
+		return mystl::pair<const_iterator, const_iterator>(it, ++next);
+	}
+
+	// bucket interfaceۼͰÿͰһԪ
+
+	size_type bucket_count() const noexcept { return capacity(); }
+	size_type max_bucket_count() const noexcept { return max_size(); }
+
+	// hash policy
+
+	float load_factor() const noexcept
+	{ return capacity() != 0 ? static_cast<float>(size_) / capacity() : 0.0f; }
+
+	// ӹ̶Ϊ 7/8
+	float max_load_factor() const noexcept { return 0.875f; }
+
+	// ʹΪ count Ԫ
+	void rehash(size_type count);
+
+	// ʹ count Ԫض¹ϣ
+	void reserve(size_type count)
+	{
+		THROW_LENGTH_ERROR_IF(count > max_size(), "flat_hashtable<T>'s size too big");
+		if (count > max_elements(groups_))
+			rehash(count + count / 7 + 1);
+	}
+
+	hasher		hash_fcn()	const { return hash_; }
+	key_equal	key_eq()	const { return equal_; }
+
+	// ͬԪʱ true
+	bool equal_to(const flat_hashtable& rhs) const;
+
+private:
+	// ֽܳ PTRDIFF_MAX
+	static size_type max_groups() noexcept
+	{
+		return static_cast<size_type>(PTRDIFF_MAX) / sizeof(T) / group_width;
+	}
+
+	// ÿ 14 Ԫأ 7/8
+	static size_type max_elements(size_type groups) noexcept
+	{
+		return groups * (group_width - group_width / 8);
+	}
+
+	size_type hash_code(const key_type& key) const
+	{
+		return ht_hash_mix(hash_(key));
+	}
+
+	static int8_t tag_of(size_type h) noexcept
+	{
+		return static_cast<int8_t>(h >> (sizeof(size_type) * 8 - 7));
+	}
+
+	size_type home_group(size_type h) const noexcept
+	{
+		return h & (groups_ - 1);
+	}
+
+	template <typename Iter>
+	Iter make_begin() const noexcept
+	{
+		if (size_ == 0)
+			return Iter(ctrl_ + capacity(), slots_ + capacity());
+		Iter it(ctrl_, slots_);
+		if (*ctrl_ == flat_ctrl_empty)
+			++it;
+		return it;
+	}
+
+	void reset_empty() noexcept
+	{
+		ctrl_ = flat_hash_empty_ctrl();
+		slots_ = nullptr;
+		overflow_ = nullptr;
+		groups_ = 0;
+		size_ = 0;
+	}
+
+	static void allocate_arrays(size_type groups, int8_t*& ctrl, T*& slots, uint8_t*& overflow);
+	static void deallocate_arrays(int8_t* ctrl, T* slots, uint8_t* overflow, size_type groups) noexcept;
+
+	size_type find_index(const key_type& key, size_type h) const;
+	size_type find_empty(size_type h) const noexcept;
+	void      add_overflow(size_type h, size_type idx) noexcept;
+	void      erase_index(size_type idx);
+	void      grow(size_type min_size);
+	void      resize(size_type groups);
+};
+
+/*****************************************************************************************/
+
+// ƹʱͬ벼֣Ԫ
+template <typename T, typename Hash, typename KeyEqual>
+flat_hashtable<T, Hash, KeyEqual>::
+flat_hashtable(const flat_hashtable& rhs)
+	:ctrl_(flat_hash_empty_ctrl()), slots_(nullptr), overflow_(nullptr),
+	groups_(0), size_(0), hash_(rhs.hash_), equal_(rhs.equal_)
+{
+	if (rhs.size_ == 0)
+		return;
+	int8_t* ctrl;
+	T* slots;
+	uint8_t* overflow;
+	allocate_arrays(rhs.groups_, ctrl, slots, overflow);
+	const size_type cap = rhs.capacity();
+	size_type i = 0;
+	try
+	{
+		for (; i < cap; ++i)
+		{
+			if (rhs.ctrl_[i] >= 0)
+				data_allocator::construct(slots + i, rhs.slots_[i]);
+		}
+	}
+	catch (...)
+	{
+		while (i-- > 0)
+		{
+			if (rhs.ctrl_[i] >= 0)
+				data_allocator::destroy(slots + i);
+		}
+		deallocate_arrays(ctrl, slots, overflow, rhs.groups_);
+		throw;
+	}
+	std::memcpy(ctrl, rhs.ctrl_, cap + 1);
+	std::memcpy(overflow, rhs.overflow_, rhs.groups_);
+	ctrl_ = ctrl;
+	slots_ = slots;
+	overflow_ = overflow;
+	groups_ = rhs.groups_;
+	size_ = rhs.size_;
+}
+
+// ڼֵʱԪ
+template <typename T, typename Hash, typename KeyEqual>
+template <typename ...Args>
+mystl::pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+emplace_key(const key_type& key, Args&& ...args)
+{
+	const size_type h = hash_code(key);
+	size_type idx = find_index(key, h);
+	if (idx != npos)
+		return mystl::pair<iterator, bool>(iterator(ctrl_ + idx, slots_ + idx), false);
+	if (size_ + 1 > max_elements(groups_))
+		grow(size_ + 1);
+	idx = find_empty(h);
+	// ȹԪأɹ޸Ŀֽ׳쳣ʱֲ
+	data_allocator::construct(slots_ + idx, mystl::forward<Args>(args)...);
+	ctrl_[idx] = tag_of(h);
+	add_overflow(h, idx);
+	++size_;
+	return mystl::pair<iterator, bool>(iterator(ctrl_ + idx, slots_ + idx), true);
+}
+
+// Ԫأ
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+clear()
+{
+	if (groups_ == 0)
+		return;
+	if (size_ != 0)
+	{
+		const size_type cap = capacity();
+		for (size_type i = 0; i < cap; ++i)
+		{
+			if (ctrl_[i] >= 0)
+				data_allocator::destroy(slots_ + i);
+		}
+		std::memset(ctrl_, flat_ctrl_empty, cap);
+	}
+	std::memset(overflow_, 0, groups_);
+	size_ = 0;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+swap(flat_hashtable& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		mystl::swap(ctrl_, rhs.ctrl_);
+		mystl::swap(slots_, rhs.slots_);
+		mystl::swap(overflow_, rhs.overflow_);
+		mystl::swap(groups_, rhs.groups_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(hash_, rhs.hash_);
+		mystl::swap(equal_, rhs.equal_);
+	}
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+rehash(size_type count)
+{
+	THROW_LENGTH_ERROR_IF(count > max_size(), "flat_hashtable<T>'s size too big");
+	size_type groups = 1;
+	while (groups * group_width < count || max_elements(groups) < size_)
+		groups <<= 1;
+	if (groups != groups_)
+		resize(groups);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool flat_hashtable<T, Hash, KeyEqual>::
+equal_to(const flat_hashtable& rhs) const
+{
+	if (size_ != rhs.size_)
+		return false;
+	for (auto it = begin(), last = end(); it != last; ++it)
+	{
+		auto p = rhs.find(value_traits::get_key(*it));
+		if (p == rhs.end() || !ht_value_equal(*it, *p, mystl::is_pair<T>()))
+			return false;
+	}
+	return true;
+}
+
+//  groups 飬ֽȫÿղڱ
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+allocate_arrays(size_type groups, int8_t*& ctrl, T*& slots, uint8_t*& overflow)
+{
+	THROW_LENGTH_ERROR_IF(groups > max_groups(), "flat_hashtable<T>'s size too big");
+	const size_type cap = groups * group_width;
+	ctrl = ctrl_allocator::allocate(groups + 1)->ctrl;
+	try
+	{
+		slots = data_allocator::allocate(cap);
+		try
+		{
+			overflow = count_allocator::allocate(groups);
+		}
+		catch (...)
+		{
+			data_allocator::deallocate(slots);
+			throw;
+		}
+	}
+	catch (...)
+	{
+		ctrl_allocator::deallocate(reinterpret_cast<flat_ctrl_block*>(ctrl));
+		throw;
+	}
+	std::memset(ctrl, flat_ctrl_empty, cap);
+	std::memset(ctrl + cap, flat_ctrl_sentinel, group_width);
+	std::memset(overflow, 0, groups);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+deallocate_arrays(int8_t* ctrl, T* slots, uint8_t* overflow, size_type groups) noexcept
+{
+	if (groups == 0)
+		return;
+	ctrl_allocator::deallocate(reinterpret_cast<flat_ctrl_block*>(ctrl));
+	data_allocator::deallocate(slots);
+	count_allocator::deallocate(overflow);
+}
+
+// ҼֵΪ key ԪڵĲۣʱ npos
+template <typename T, typename Hash, typename KeyEqual>
+typename flat_hashtable<T, Hash, KeyEqual>::size_type
+flat_hashtable<T, Hash, KeyEqual>::
+find_index(const key_type& key, size_type h) const
+{
+	if (size_ == 0)
+		return npos;
+	const int8_t tag = tag_of(h);
+	size_type g = home_group(h);
+	for (size_type i = 1; i <= groups_; ++i)
+	{
+		flat_hash_group group(ctrl_ + g * group_width);
+		for (uint32_t m = group.match(tag); m != 0; m &= m - 1)
+		{
+			const size_type idx = g * group_width + flat_hash_ctz(m);
+			if (equal_(value_traits::get_key(slots_[idx]), key))
+				return idx;
+		}
+		if (overflow_[g] == 0)
+			return npos;
+		g = (g + i) & (groups_ - 1);
+	}
+	return npos;
+}
+
+// ̽·ϵһղۣǰ豣֤пղ
+template <typename T, typename Hash, typename KeyEqual>
+typename flat_hashtable<T, Hash, KeyEqual>::size_type
+flat_hashtable<T, Hash, KeyEqual>::
+find_empty(size_type h) const noexcept
+{
+	size_type g = home_group(h);
+	for (size_type i = 1; ; ++i)
+	{
+		const uint32_t m = flat_hash_group(ctrl_ + g * group_width).match_empty();
+		if (m != 0)
+			return g * group_width + flat_hash_ctz(m);
+		g = (g + i) & (groups_ - 1);
+	}
+}
+
+// Ԫط idx ڵ飬Ϊ̽·֮ǰ
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+add_overflow(size_type h, size_type idx) noexcept
+{
+	const size_type target = idx / group_width;
+	size_type g = home_group(h);
+	for (size_type i = 1; g != target; ++i)
+	{
+		if (overflow_[g] != 255)
+			++overflow_[g];
+		g = (g + i) & (groups_ - 1);
+	}
+}
+
+// ɾ idx еԪأΪղۣʱӵ
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+erase_index(size_type idx)
+{
+	const size_type h = hash_code(value_traits::get_key(slots_[idx]));
+	data_allocator::destroy(slots_ + idx);
+	ctrl_[idx] = flat_ctrl_empty;
+	--size_;
+	const size_type target = idx / group_width;
+	size_type g = home_group(h);
+	for (size_type i = 1; g != target; ++i)
+	{
+		if (overflow_[g] != 255)
+			--overflow_[g];
+		g = (g + i) & (groups_ - 1);
+	}
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+grow(size_type min_size)
+{
+	THROW_LENGTH_ERROR_IF(min_size > max_size(), "flat_hashtable<T>'s size too big");
+	size_type groups = groups_ == 0 ? 1 : groups_ * 2;
+	while (max_elements(groups) < min_size)
+		groups <<= 1;
+	resize(groups);
+}
+
+// Ԫƶ groups 
+// ȫԪصĹϣֵȷھֲУϣ׳쳣ʱ䣻
+// Ԫ move_if_noexcept 飬׳쳣ʱ鲢ԭ飬
+// ȫź֮ԭԪ
+template <typename T, typename Hash, typename KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+resize(size_type groups)
+{
+	int8_t* ctrl;
+	T* slots;
+	uint8_t* overflow;
+	allocate_arrays(groups, ctrl, slots, overflow);
+	const size_type old_cap = capacity();
+	size_type* hashes = nullptr;
+	try
+	{
+		hashes = hash_allocator::allocate(size_);
+		size_type n = 0;
+		for (size_type i = 0; i < old_cap; ++i)
+		{
+			if (ctrl_[i] >= 0)
+				hashes[n++] = hash_code(value_traits::get_key(slots_[i]));
+		}
+	}
+	catch (...)
+	{
+		hash_allocator::deallocate(hashes);
+		deallocate_arrays(ctrl, slots, overflow, groups);
+		throw;
+	}
+
+	int8_t* old_ctrl = ctrl_;
+	T* old_slots = slots_;
+	uint8_t* old_overflow = overflow_;
+	const size_type old_groups = groups_;
+	ctrl_ = ctrl;
+	slots_ = slots;
+	overflow_ = overflow;
+	groups_ = groups;
+	try
+	{
+		size_type n = 0;
+		for (size_type i = 0; i < old_cap; ++i)
+		{
+			if (old_ctrl[i] < 0)
+				continue;
+			const size_type h = hashes[n++];
+			const size_type idx = find_empty(h);
+			data_allocator::construct(slots_ + idx, std::move_if_noexcept(old_slots[i]));
+			ctrl_[idx] = tag_of(h);
+			add_overflow(h, idx);
+		}
+	}
+	catch (...)
+	{
+		const size_type cap = capacity();
+		for (size_type i = 0; i < cap; ++i)
+		{
+			if (ctrl_[i] >= 0)
+				data_allocator::destroy(slots_ + i);
+		}
+		deallocate_arrays(ctrl_, slots_, overflow_, groups_);
+		ctrl_ = old_ctrl;
+		slots_ = old_slots;
+		overflow_ = old_overflow;
+		groups_ = old_groups;
+		hash_allocator::deallocate(hashes);
+		throw;
+	}
+	for (size_type i = 0; i < old_cap; ++i)
+	{
+		if (old_ctrl[i] >= 0)
+			data_allocator::destroy(old_slots + i);
+	}
+	deallocate_arrays(old_ctrl, old_slots, old_overflow, old_groups);
+	hash_allocator::deallocate(hashes);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FLAT_HASHTABLE_H_
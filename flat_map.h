@@ -0,0 +1,1098 @@
+#ifndef MY_STL_FLAT_MAP_H_
+#define MY_STL_FLAT_MAP_H_
+
+// ͷļģ flat_map  flat_multimap
+// flat_map      : ƽӳ䣬ֵʵֱֵ vector Уֵظ
+// flat_multimap : ƽӳ䣬ֵʵֱֵ vector Уֵظ
+
+// notes:
+//
+// flat_map һι֮ԲΪıԪţΪֲң
+// û rb_tree ڵָɫĿҲߵöࣻǵԪص
+// ɾҪƶԪأӶΪ O(n)
+//
+// ֵʵֵֿţֲʱֻʼֵ顣˵õõһ
+// pair<const Key&, T&>  pair<const Key, T>&
+//
+//  insert(first, last) ȰԪ׷ӵȥغԭԪһ
+// ϲɣӶΪ O(m log m + n) O(m * n)
+// ϲǰȫȽϣٰԪطµ飬ԭԪֻڲ׳쳣ʱƶ
+// ʧʱԭԪرֲ䡣
+//
+// 쳣֤
+// mystl::flat_map<Key, T> / mystl::flat_multimap<Key, T> 쳣֤µȺǿ쳣ȫ֤
+//   * emplace
+//   * insert
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// flat_map ĵ
+// ͬʱֵָʵֵеͬһλãʾǷΪ const 
+template <typename Key, typename T, bool IsConst>
+struct flat_map_iterator
+{
+	using key_pointer			= const Key*;
+	using mapped_pointer		= typename std::conditional<IsConst, const T*, T*>::type;
+	using mapped_reference		= typename std::conditional<IsConst, const T&, T&>::type;
+
+	using iterator_category		= mystl::random_access_iterator_tag;
+	using value_type			= mystl::pair<const Key, T>;
+	using reference				= mystl::pair<const Key&, mapped_reference>;
+	using difference_type		= ptrdiff_t;
+
+	// operator-> Ҫһָ룬һС
+	struct pointer
+	{
+		reference ref;
+		reference* operator->() { return &ref; }
+	};
+
+	using self					= flat_map_iterator<Key, T, IsConst>;
+
+	key_pointer    kp;	// ֵָ
+	mapped_pointer vp;	// ָʵֵ
+
+	flat_map_iterator() :kp{ nullptr }, vp{ nullptr } {}
+	flat_map_iterator(key_pointer k, mapped_pointer v) :kp{ k }, vp{ v } {}
+
+	//  const תΪ const 
+	template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+	flat_map_iterator(const flat_map_iterator<Key, T, C>& rhs)
+		:kp{ rhs.kp }, vp{ rhs.vp }
+	{
+	}
+
+	reference operator*() const { return reference(*kp, *vp); }
+	pointer operator->() const { return pointer{ operator*() }; }
+	reference operator[](difference_type n) const { return reference(kp[n], vp[n]); }
+
+	self& operator++() { ++kp; ++vp; return *this; }
+	self operator++(int) { self tmp{ *this }; ++*this; return tmp; }
+	self& operator--() { --kp; --vp; return *this; }
+	self operator--(int) { self tmp{ *this }; --*this; return tmp; }
+
+	self& operator+=(difference_type n) { kp += n; vp += n; return *this; }
+	self& operator-=(difference_type n) { kp -= n; vp -= n; return *this; }
+	self operator+(difference_type n) const { return self(kp + n, vp + n); }
+	self operator-(difference_type n) const { return self(kp - n, vp - n); }
+
+	template <bool C>
+	difference_type operator-(const flat_map_iterator<Key, T, C>& rhs) const { return kp - rhs.kp; }
+
+	template <bool C>
+	bool operator==(const flat_map_iterator<Key, T, C>& rhs) const { return kp == rhs.kp; }
+	template <bool C>
+	bool operator!=(const flat_map_iterator<Key, T, C>& rhs) const { return kp != rhs.kp; }
+	template <bool C>
+	bool operator<(const flat_map_iterator<Key, T, C>& rhs) const { return kp < rhs.kp; }
+	template <bool C>
+	bool operator>(const flat_map_iterator<Key, T, C>& rhs) const { return kp > rhs.kp; }
+	template <bool C>
+	bool operator<=(const flat_map_iterator<Key, T, C>& rhs) const { return kp <= rhs.kp; }
+	template <bool C>
+	bool operator>=(const flat_map_iterator<Key, T, C>& rhs) const { return kp >= rhs.kp; }
+};
+
+template <typename Key, typename T, bool IsConst>
+flat_map_iterator<Key, T, IsConst> operator+(ptrdiff_t n, const flat_map_iterator<Key, T, IsConst>& it)
+{
+	return it + n;
+}
+
+// ģ flat_table
+// flat_map  flat_multimap ĵײʵ֣ӿ rb_tree һ
+// һֵͣʵֵֵͣıȽϷʽ
+template <typename Key, typename T, typename Compare>
+class flat_table
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= mystl::pair<const Key, T>;
+	using key_compare				= Compare;
+
+	using key_container_type		= mystl::vector<Key>;
+	using mapped_container_type		= mystl::vector<T>;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+
+	using iterator					= flat_map_iterator<Key, T, false>;
+	using const_iterator			= flat_map_iterator<Key, T, true>;
+	using reverse_iterator			= mystl::reverse_iterator<iterator>;
+	using const_reverse_iterator	= mystl::reverse_iterator<const_iterator>;
+
+	using reference					= typename iterator::reference;
+	using const_reference			= typename const_iterator::reference;
+
+private:
+	// ʱʹõĻԪأֵ const Ա
+	using buffer_value_type			= mystl::pair<Key, T>;
+
+	// ֵȽԪ
+	struct buffer_compare
+	{
+		Compare comp;
+		bool operator()(const buffer_value_type& lhs, const buffer_value_type& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	};
+
+	// ֵжԪǷȼ
+	struct buffer_equivalent
+	{
+		Compare comp;
+		bool operator()(const buffer_value_type& lhs, const buffer_value_type& rhs) const
+		{
+			return !comp(lhs.first, rhs.first) && !comp(rhs.first, lhs.first);
+		}
+	};
+
+	// ֵȽԪص±ֵ꣬ȼʱ±Сǰȶ
+	struct buffer_index_compare
+	{
+		const mystl::vector<buffer_value_type>* buf;
+		Compare comp;
+		bool operator()(size_type lhs, size_type rhs) const
+		{
+			if (comp((*buf)[lhs].first, (*buf)[rhs].first))
+				return true;
+			if (comp((*buf)[rhs].first, (*buf)[lhs].first))
+				return false;
+			return lhs < rhs;
+		}
+	};
+
+private:
+	key_container_type    keys_;		// ļֵ
+	mapped_container_type values_;		// ֵһһӦʵֵ
+	key_compare           key_comp_;	// ֵȽϵ׼
+
+public:
+	flat_table() = default;
+
+	flat_table(const flat_table& rhs) = default;
+
+	flat_table(flat_table&& rhs) noexcept
+		:keys_{ mystl::move(rhs.keys_) },
+		values_{ mystl::move(rhs.values_) },
+		key_comp_{ rhs.key_comp_ }
+	{
+	}
+
+	flat_table& operator=(const flat_table& rhs)
+	{
+		if (this != &rhs)
+		{
+			keys_ = rhs.keys_;
+			values_ = rhs.values_;
+			key_comp_ = rhs.key_comp_;
+		}
+		return *this;
+	}
+
+	flat_table& operator=(flat_table&& rhs) noexcept
+	{
+		keys_ = mystl::move(rhs.keys_);
+		values_ = mystl::move(rhs.values_);
+		key_comp_ = rhs.key_comp_;
+		return *this;
+	}
+
+	key_compare key_comp() const { return key_comp_; }
+
+	// ֱӷʵײ
+	const key_container_type& keys() const noexcept { return keys_; }
+	const mapped_container_type& values() const noexcept { return values_; }
+
+public:
+	// ز
+	iterator begin() noexcept { return iterator(keys_.begin(), values_.begin()); }
+	const_iterator begin() const noexcept { return const_iterator(keys_.begin(), values_.begin()); }
+	iterator end() noexcept { return iterator(keys_.end(), values_.end()); }
+	const_iterator end() const noexcept { return const_iterator(keys_.end(), values_.end()); }
+
+	// ز
+	bool empty() const noexcept { return keys_.empty(); }
+	size_type size() const noexcept { return keys_.size(); }
+	size_type max_size() const noexcept { return keys_.max_size(); }
+	size_type capacity() const noexcept { return keys_.capacity(); }
+
+	void reserve(size_type n)
+	{
+		keys_.reserve(n);
+		values_.reserve(n);
+	}
+
+	void shrink_to_fit()
+	{
+		keys_.shrink_to_fit();
+		values_.shrink_to_fit();
+	}
+
+	// ɾز
+
+	// ͵زԪأֵظ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_unique(Args&& ...args)
+	{
+		buffer_value_type value(mystl::forward<Args>(args)...);
+		const size_type pos = lower_bound_pos(value.first);
+		if (pos != size() && !key_comp_(value.first, keys_[pos]))
+		{
+			return mystl::pair<iterator, bool>(iterator_at(pos), false);
+		}
+		return mystl::pair<iterator, bool>(insert_at(pos, mystl::move(value)), true);
+	}
+
+	// ͵زԪأֵظԪλеȼԪ֮
+	template <typename ...Args>
+	iterator emplace_multi(Args&& ...args)
+	{
+		buffer_value_type value(mystl::forward<Args>(args)...);
+		return insert_at(upper_bound_pos(value.first), mystl::move(value));
+	}
+
+	// ʹ hint 룬 hint ǡǲλʱʡȥһζֲ
+	template <typename ...Args>
+	iterator emplace_unique_use_hint(const_iterator hint, Args&& ...args)
+	{
+		buffer_value_type value(mystl::forward<Args>(args)...);
+		const size_type h = index_of(hint);
+		if ((h == 0 || key_comp_(keys_[h - 1], value.first)) &&
+			(h == size() || key_comp_(value.first, keys_[h])))
+		{
+			return insert_at(h, mystl::move(value));
+		}
+		const size_type pos = lower_bound_pos(value.first);
+		if (pos != size() && !key_comp_(value.first, keys_[pos]))
+		{
+			return iterator_at(pos);
+		}
+		return insert_at(pos, mystl::move(value));
+	}
+
+	template <typename ...Args>
+	iterator emplace_multi_use_hint(const_iterator hint, Args&& ...args)
+	{
+		buffer_value_type value(mystl::forward<Args>(args)...);
+		const size_type h = index_of(hint);
+		if ((h == 0 || !key_comp_(value.first, keys_[h - 1])) &&
+			(h == size() || !key_comp_(keys_[h], value.first)))
+		{
+			return insert_at(h, mystl::move(value));
+		}
+		return insert_at(upper_bound_pos(value.first), mystl::move(value));
+	}
+
+	// 룬ֵظ
+	// Ԫ׷ӵȶȥأԭԪһκϲظļֵһγֵԪ
+	template <typename InputIterator>
+	void insert_unique(InputIterator first, InputIterator last)
+	{
+		mystl::vector<buffer_value_type> buf;
+		fill_buffer(buf, first, last);
+		if (buf.empty())
+			return;
+		stable_sort_buffer(buf);
+		buf.erase(mystl::unique(buf.begin(), buf.end(), buffer_equivalent{ key_comp_ }), buf.end());
+		merge_buffer(buf, true);
+	}
+
+	// 룬ֵظȼ۵Ԫرֲ˳
+	template <typename InputIterator>
+	void insert_multi(InputIterator first, InputIterator last)
+	{
+		mystl::vector<buffer_value_type> buf;
+		fill_buffer(buf, first, last);
+		if (buf.empty())
+			return;
+		stable_sort_buffer(buf);
+		merge_buffer(buf, false);
+	}
+
+	// ɾ pos λõԪ
+	iterator erase(const_iterator pos)
+	{
+		const size_type n = index_of(pos);
+		keys_.erase(keys_.begin() + n);
+		values_.erase(values_.begin() + n);
+		return iterator_at(n);
+	}
+
+	// ɾ [first, last) ڵԪ
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		const size_type f = index_of(first);
+		const size_type l = index_of(last);
+		keys_.erase(keys_.begin() + f, keys_.begin() + l);
+		values_.erase(values_.begin() + f, values_.begin() + l);
+		return iterator_at(f);
+	}
+
+	size_type erase_unique(const key_type& key)
+	{
+		auto it = find(key);
+		if (it == end())
+			return 0;
+		erase(it);
+		return 1;
+	}
+
+	size_type erase_multi(const key_type& key)
+	{
+		auto p = equal_range_multi(key);
+		const size_type n = static_cast<size_type>(p.second - p.first);
+		erase(p.first, p.second);
+		return n;
+	}
+
+	void clear()
+	{
+		keys_.clear();
+		values_.clear();
+	}
+
+	// ز
+	iterator find(const key_type& key)
+	{
+		const size_type pos = lower_bound_pos(key);
+		return (pos == size() || key_comp_(key, keys_[pos])) ? end() : iterator_at(pos);
+	}
+	const_iterator find(const key_type& key) const
+	{
+		const size_type pos = lower_bound_pos(key);
+		return (pos == size() || key_comp_(key, keys_[pos])) ? end() : iterator_at(pos);
+	}
+
+	size_type count_unique(const key_type& key) const
+	{
+		return find(key) != end() ? 1 : 0;
+	}
+	size_type count_multi(const key_type& key) const
+	{
+		return upper_bound_pos(key) - lower_bound_pos(key);
+	}
+
+	iterator lower_bound(const key_type& key) { return iterator_at(lower_bound_pos(key)); }
+	const_iterator lower_bound(const key_type& key) const { return iterator_at(lower_bound_pos(key)); }
+
+	iterator upper_bound(const key_type& key) { return iterator_at(upper_bound_pos(key)); }
+	const_iterator upper_bound(const key_type& key) const { return iterator_at(upper_bound_pos(key)); }
+
+	mystl::pair<iterator, iterator> equal_range_unique(const key_type& key)
+	{
+		iterator it = find(key);
+		return mystl::pair<iterator, iterator>(it, it == end() ? it : it + 1);
+	}
+	mystl::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		return mystl::pair<const_iterator, const_iterator>(it, it == end() ? it : it + 1);
+	}
+
+	mystl::pair<iterator, iterator> equal_range_multi(const key_type& key)
+	{
+		return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+	mystl::pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const
+	{
+		return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+	}
+
+	void swap(flat_table& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			keys_.swap(rhs.keys_);
+			values_.swap(rhs.values_);
+			mystl::swap(key_comp_, rhs.key_comp_);
+		}
+	}
+
+private:
+	// helper functions
+
+	iterator iterator_at(size_type n) noexcept
+	{
+		return iterator(keys_.begin() + n, values_.begin() + n);
+	}
+	const_iterator iterator_at(size_type n) const noexcept
+	{
+		return const_iterator(keys_.begin() + n, values_.begin() + n);
+	}
+
+	size_type index_of(const_iterator it) const noexcept
+	{
+		return static_cast<size_type>(it.kp - keys_.begin());
+	}
+
+	// ֲֻʼֵ
+	size_type lower_bound_pos(const key_type& key) const
+	{
+		return static_cast<size_type>(
+			mystl::lower_bound(keys_.begin(), keys_.end(), key, key_comp_) - keys_.begin());
+	}
+
+	size_type upper_bound_pos(const key_type& key) const
+	{
+		return static_cast<size_type>(
+			mystl::upper_bound(keys_.begin(), keys_.end(), key, key_comp_) - keys_.begin());
+	}
+
+	// ڵ n λòԪأʵֵʧʱֵĲ
+	iterator insert_at(size_type n, buffer_value_type&& value)
+	{
+		keys_.insert(keys_.begin() + n, mystl::move(value.first));
+		try
+		{
+			values_.insert(values_.begin() + n, mystl::move(value.second));
+		}
+		catch (...)
+		{
+			keys_.erase(keys_.begin() + n);
+			throw;
+		}
+		return iterator_at(n);
+	}
+
+	template <typename InputIterator>
+	void fill_buffer(mystl::vector<buffer_value_type>& buf, InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			buf.emplace_back((*first).first, (*first).second);
+		}
+	}
+
+	// ֵȶ򻺳ֵȼ۵Ԫرԭ˳
+	// mystl::sort ȶ±꣬±ΪֵȼʱĴٰ±Ԫ
+	void stable_sort_buffer(mystl::vector<buffer_value_type>& buf)
+	{
+		// صݲҪ
+		if (mystl::is_sorted(buf.begin(), buf.end(), buffer_compare{ key_comp_ }))
+			return;
+		const size_type n = buf.size();
+		mystl::vector<size_type> order(n);
+		for (size_type i = 0; i < n; ++i)
+			order[i] = i;
+		mystl::sort(order.begin(), order.end(), buffer_index_compare{ &buf, key_comp_ });
+		mystl::vector<buffer_value_type> sorted;
+		sorted.reserve(n);
+		for (size_type i = 0; i < n; ++i)
+			sorted.push_back(mystl::move(buf[order[i]]));
+		buf.swap(sorted);
+	}
+
+	using nothrow_move_tag = m_bool_constant<std::is_nothrow_move_constructible<Key>::value &&
+		std::is_nothrow_move_constructible<T>::value>;
+
+	template <typename U>
+	static U&& take(U& x, m_true_type) noexcept { return mystl::move(x); }
+	template <typename U>
+	static const U& take(U& x, m_false_type) noexcept { return x; }
+
+	// ĻԭԪغϲ
+	// unique Ϊ true ʱԭԪصȼ۵ԪأԭԪڵȼ۵Ԫ֮ǰ
+	void merge_buffer(mystl::vector<buffer_value_type>& buf, bool unique)
+	{
+		const size_type n1 = keys_.size();
+		const size_type n2 = buf.size();
+
+		// ԪȫλԭԪ֮簴صݣֱ׷ӵβ
+		if (n1 == 0 || key_comp_(keys_[n1 - 1], buf[0].first) ||
+			(!unique && !key_comp_(buf[0].first, keys_[n1 - 1])))
+		{
+			reserve(n1 + n2);
+			try
+			{
+				for (size_type j = 0; j < n2; ++j)
+				{
+					keys_.push_back(mystl::move(buf[j].first));
+					values_.push_back(mystl::move(buf[j].second));
+				}
+			}
+			catch (...)
+			{
+				keys_.erase(keys_.begin() + n1, keys_.end());
+				values_.erase(values_.begin() + n1, values_.end());
+				throw;
+			}
+			return;
+		}
+
+		// ȱȽϳÿԪ֮ǰмԭԪأdrop ʾԭԪصȼ۶Ƚ׳쳣ʱûƶκԪ
+		const size_type drop = static_cast<size_type>(-1);
+		mystl::vector<size_type> pos(n2);
+		size_type i = 0;
+		for (size_type j = 0; j < n2; ++j)
+		{
+			while (i < n1 && !key_comp_(buf[j].first, keys_[i]))
+				++i;
+			// ԭԪڵȼ۵Ԫ֮ǰֵظʱԪ
+			pos[j] = unique && i > 0 && !key_comp_(keys_[i - 1], buf[j].first) ? drop : i;
+		}
+
+		// ٺϲµУԭԪֻڼֵʵֵܲ׳쳣ƶʱƶƣ
+		// ֮׳쳣ʱԭԪرֲ
+		key_container_type keys;
+		mapped_container_type values;
+		keys.reserve(n1 + n2);
+		values.reserve(n1 + n2);
+		i = 0;
+		for (size_type j = 0; j < n2; ++j)
+		{
+			if (pos[j] == drop)
+				continue;
+			for (; i < pos[j]; ++i)
+			{
+				keys.push_back(take(keys_[i], nothrow_move_tag()));
+				values.push_back(take(values_[i], nothrow_move_tag()));
+			}
+			keys.push_back(mystl::move(buf[j].first));
+			values.push_back(mystl::move(buf[j].second));
+		}
+		for (; i < n1; ++i)
+		{
+			keys.push_back(take(keys_[i], nothrow_move_tag()));
+			values.push_back(take(values_[i], nothrow_move_tag()));
+		}
+		keys_.swap(keys);
+		values_.swap(values);
+	}
+};
+
+/*****************************************************************************************/
+
+// ģ flat_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+class flat_map
+{
+public:
+	// flat_map Ƕͱ
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = mystl::pair<const Key, T>;
+	using key_compare = Compare;
+
+	// һ functorԪرȽ
+	class value_compare : public binary_function <value_type, value_type, bool>
+	{
+		friend class flat_map<Key, T, Compare>;
+	public:
+		bool operator()(const value_type& lhs, const value_type& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	};
+
+private:
+	using base_type = mystl::flat_table<Key, T, Compare>;
+	base_type table_;
+
+public:
+	// ʹ flat_table ͱ
+	using key_container_type		= typename base_type::key_container_type;
+	using mapped_container_type		= typename base_type::mapped_container_type;
+	using reference					= typename base_type::reference;
+	using const_reference			= typename base_type::const_reference;
+	using iterator					= typename base_type::iterator;
+	using const_iterator			= typename base_type::const_iterator;
+	using reverse_iterator			= typename base_type::reverse_iterator;
+	using const_reverse_iterator	= typename base_type::const_reverse_iterator;
+	using size_type					= typename base_type::size_type;
+	using difference_type			= typename base_type::difference_type;
+
+public:
+	// 졢ơƶֵ
+
+	flat_map() = default;
+
+	template <typename InputIterator>
+	flat_map(InputIterator first, InputIterator last)
+		:table_()
+	{
+		table_.insert_unique(first, last);
+	}
+
+	flat_map(std::initializer_list<value_type> ilist)
+		:table_()
+	{
+		table_.insert_unique(ilist.begin(), ilist.end());
+	}
+
+	flat_map(const flat_map& rhs) : table_{ rhs.table_ } {}
+
+	flat_map(flat_map&& rhs) noexcept : table_{ mystl::move(rhs.table_) } {}
+
+	flat_map& operator=(const flat_map& rhs)
+	{
+		table_ = rhs.table_;
+		return *this;
+	}
+	flat_map& operator=(flat_map&& rhs) noexcept
+	{
+		table_ = mystl::move(rhs.table_);
+		return *this;
+	}
+
+	flat_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		table_.clear();
+		table_.insert_unique(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	// ؽӿ
+
+	key_compare key_comp() const { return table_.key_comp(); }
+	value_compare value_comp() const { return value_compare(table_.key_comp()); }
+
+	const key_container_type& keys() const noexcept { return table_.keys(); }
+	const mapped_container_type& values() const noexcept { return table_.values(); }
+
+	// iterator
+
+	iterator begin() noexcept { return table_.begin(); }
+	const_iterator begin() const noexcept { return table_.begin(); }
+	iterator end() noexcept { return table_.end(); }
+	const_iterator end() const noexcept { return table_.end(); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+	const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator crend() const noexcept { return rend(); }
+
+	// 
+
+	bool empty() const noexcept { return table_.empty(); }
+	size_type size() const noexcept { return table_.size(); }
+	size_type max_size() const noexcept { return table_.max_size(); }
+	size_type capacity() const noexcept { return table_.capacity(); }
+
+	void reserve(size_type n) { table_.reserve(n); }
+	void shrink_to_fit() { table_.shrink_to_fit(); }
+
+	// Ԫ
+
+	// ֵڣat ׳һ쳣
+	mapped_type& at(const key_type& key)
+	{
+		iterator it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T> no such element exists");
+		return it->second;
+	}
+	const mapped_type& at(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T> no such element exists");
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		iterator it = lower_bound(key);
+		// it->first >= key
+		if (it == end() || key_comp()(key, it->first))
+			it = emplace_hint(it, key, T{});
+		return it->second;
+	}
+	mapped_type& operator[](key_type&& key)
+	{
+		iterator it = lower_bound(key);
+		// it->first >= key
+		if (it == end() || key_comp()(key, it->first))
+			it = emplace_hint(it, mystl::move(key), T{});
+		return it->second;
+	}
+
+	// ɾ
+
+	template <typename ...Args>
+	pair<iterator, bool> emplace(Args&& ...args)
+	{
+		return table_.emplace_unique(mystl::forward<Args>(args)...);
+	}
+
+	template <typename ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		return table_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...);
+	}
+
+	pair<iterator, bool> insert(const value_type& value)
+	{
+		return table_.emplace_unique(value.first, value.second);
+	}
+	pair<iterator, bool> insert(value_type&& value)
+	{
+		return table_.emplace_unique(value.first, mystl::move(value.second));
+	}
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{
+		return table_.emplace_unique_use_hint(hint, value.first, value.second);
+	}
+	iterator insert(const_iterator hint, value_type&& value)
+	{
+		return table_.emplace_unique_use_hint(hint, value.first, mystl::move(value.second));
+	}
+
+	// 룺׷ӡ򡢺ϲһ
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		table_.insert_unique(first, last);
+	}
+
+	void insert(std::initializer_list<value_type> ilist)
+	{
+		table_.insert_unique(ilist.begin(), ilist.end());
+	}
+
+	iterator erase(const_iterator position) { return table_.erase(position); }
+	size_type erase(const key_type& key) { return table_.erase_unique(key); }
+	iterator erase(const_iterator first, const_iterator last) { return table_.erase(first, last); }
+
+	void clear() { table_.clear(); }
+
+	// flat_map ز
+
+	iterator find(const key_type& key) { return table_.find(key); }
+	const_iterator find(const key_type& key) const { return table_.find(key); }
+
+	size_type count(const key_type& key) const { return table_.count_unique(key); }
+
+	iterator lower_bound(const key_type& key) { return table_.lower_bound(key); }
+	const_iterator lower_bound(const key_type& key) const { return table_.lower_bound(key); }
+
+	iterator upper_bound(const key_type& key) { return table_.upper_bound(key); }
+	const_iterator upper_bound(const key_type& key) const { return table_.upper_bound(key); }
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		return table_.equal_range_unique(key);
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return table_.equal_range_unique(key);
+	}
+
+	void swap(flat_map& rhs) noexcept
+	{
+		table_.swap(rhs.table_);
+	}
+
+public:
+	friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+	{
+		return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+	}
+	friend bool operator<(const flat_map& lhs, const flat_map& rhs)
+	{
+		return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+			[](const_reference a, const_reference b)
+			{
+				return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+			});
+	}
+};
+
+// رȽϲ
+template <typename Key, typename T, typename Compare>
+bool operator!=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator>(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator<=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator>=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <typename Key, typename T, typename Compare>
+void swap(flat_map<Key, T, Compare>& lhs, flat_map<Key, T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ flat_multimapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+class flat_multimap
+{
+public:
+	// flat_multimap Ƕͱ
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = mystl::pair<const Key, T>;
+	using key_compare = Compare;
+
+	// һ functorԪرȽ
+	class value_compare : public binary_function <value_type, value_type, bool>
+	{
+		friend class flat_multimap<Key, T, Compare>;
+	public:
+		bool operator()(const value_type& lhs, const value_type& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	};
+
+private:
+	using base_type = mystl::flat_table<Key, T, Compare>;
+	base_type table_;
+
+public:
+	// ʹ flat_table ͱ
+	using key_container_type		= typename base_type::key_container_type;
+	using mapped_container_type		= typename base_type::mapped_container_type;
+	using reference					= typename base_type::reference;
+	using const_reference			= typename base_type::const_reference;
+	using iterator					= typename base_type::iterator;
+	using const_iterator			= typename base_type::const_iterator;
+	using reverse_iterator			= typename base_type::reverse_iterator;
+	using const_reverse_iterator	= typename base_type::const_reverse_iterator;
+	using size_type					= typename base_type::size_type;
+	using difference_type			= typename base_type::difference_type;
+
+public:
+	flat_multimap() = default;
+
+	template <typename InputIterator>
+	flat_multimap(InputIterator first, InputIterator last)
+		:table_{}
+	{
+		table_.insert_multi(first, last);
+	}
+
+	flat_multimap(std::initializer_list<value_type> ilist)
+		:table_{}
+	{
+		table_.insert_multi(ilist.begin(), ilist.end());
+	}
+
+	flat_multimap(const flat_multimap& rhs) : table_{ rhs.table_ } {}
+
+	flat_multimap(flat_multimap&& rhs) noexcept : table_{ mystl::move(rhs.table_) } {}
+
+	flat_multimap& operator=(const flat_multimap& rhs)
+	{
+		table_ = rhs.table_;
+		return *this;
+	}
+
+	flat_multimap& operator=(flat_multimap&& rhs) noexcept
+	{
+		table_ = mystl::move(rhs.table_);
+		return *this;
+	}
+
+	flat_multimap& operator=(std::initializer_list<value_type> ilist)
+	{
+		table_.clear();
+		table_.insert_multi(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	// ؽӿ
+
+	key_compare key_comp() const { return table_.key_comp(); }
+	value_compare value_comp() const { return value_compare(table_.key_comp()); }
+
+	const key_container_type& keys() const noexcept { return table_.keys(); }
+	const mapped_container_type& values() const noexcept { return table_.values(); }
+
+	// iterator
+
+	iterator begin() noexcept { return table_.begin(); }
+	const_iterator begin() const noexcept { return table_.begin(); }
+	iterator end() noexcept { return table_.end(); }
+	const_iterator end() const noexcept { return table_.end(); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+	const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator crend() const noexcept { return rend(); }
+
+	// 
+
+	bool empty() const noexcept { return table_.empty(); }
+	size_type size() const noexcept { return table_.size(); }
+	size_type max_size() const noexcept { return table_.max_size(); }
+	size_type capacity() const noexcept { return table_.capacity(); }
+
+	void reserve(size_type n) { table_.reserve(n); }
+	void shrink_to_fit() { table_.shrink_to_fit(); }
+
+	// ɾ
+
+	template <typename ...Args>
+	iterator emplace(Args&& ...args)
+	{
+		return table_.emplace_multi(mystl::forward<Args>(args)...);
+	}
+
+	template <typename ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		return table_.emplace_multi_use_hint(hint, mystl::forward<Args>(args)...);
+	}
+
+	iterator insert(const value_type& value)
+	{
+		return table_.emplace_multi(value.first, value.second);
+	}
+	iterator insert(value_type&& value)
+	{
+		return table_.emplace_multi(value.first, mystl::move(value.second));
+	}
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{
+		return table_.emplace_multi_use_hint(hint, value.first, value.second);
+	}
+	iterator insert(const_iterator hint, value_type&& value)
+	{
+		return table_.emplace_multi_use_hint(hint, value.first, mystl::move(value.second));
+	}
+
+	// 룺׷ӡ򡢺ϲһ
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		table_.insert_multi(first, last);
+	}
+
+	void insert(std::initializer_list<value_type> ilist)
+	{
+		table_.insert_multi(ilist.begin(), ilist.end());
+	}
+
+	iterator erase(const_iterator position) { return table_.erase(position); }
+	size_type erase(const key_type& key) { return table_.erase_multi(key); }
+	iterator erase(const_iterator first, const_iterator last) { return table_.erase(first, last); }
+
+	void clear() { table_.clear(); }
+
+	// flat_multimap ز
+
+	iterator find(const key_type& key) { return table_.find(key); }
+	const_iterator find(const key_type& key) const { return table_.find(key); }
+
+	size_type count(const key_type& key) const { return table_.count_multi(key); }
+
+	iterator lower_bound(const key_type& key) { return table_.lower_bound(key); }
+	const_iterator lower_bound(const key_type& key) const { return table_.lower_bound(key); }
+
+	iterator upper_bound(const key_type& key) { return table_.upper_bound(key); }
+	const_iterator upper_bound(const key_type& key) const { return table_.upper_bound(key); }
+
+	pair<iterator, iterator> equal_range(const key_type& key)
+	{
+		return table_.equal_range_multi(key);
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return table_.equal_range_multi(key);
+	}
+
+	void swap(flat_multimap& rhs) noexcept
+	{
+		table_.swap(rhs.table_);
+	}
+
+public:
+	friend bool operator==(const flat_multimap& lhs, const flat_multimap& rhs)
+	{
+		return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+	}
+	friend bool operator<(const flat_multimap& lhs, const flat_multimap& rhs)
+	{
+		return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+			[](const_reference a, const_reference b)
+			{
+				return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+			});
+	}
+};
+
+// رȽϲ
+template <typename Key, typename T, typename Compare>
+bool operator!=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator>(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator<=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator>=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <typename Key, typename T, typename Compare>
+void swap(flat_multimap<Key, T, Compare>& lhs, flat_multimap<Key, T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FLAT_MAP_H_
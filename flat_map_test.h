@@ -0,0 +1,245 @@
+#ifndef MY_STL_FLAT_MAP_TEST_H_
+#define MY_STL_FLAT_MAP_TEST_H_
+
+// flat_map test :  flat_map, flat_multimap, flat_set Ľӿҵ
+
+#include <map>
+#include <vector>
+
+#include "flat_map.h"
+#include "flat_set.h"
+#include "map.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_map_test
+{
+
+// pair ĺ궨
+#define FLAT_PAIR    mystl::pair<int, int>
+
+// flat_map ı
+#define FLAT_MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// flat_map ĺ
+#define FLAT_MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    FLAT_MAP_COUT(con); \
+} while(0)
+
+// flat_map ĺֵ
+#define FLAT_MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// ٲ len 
+#define FLAT_FIND_DO_TEST(mode, con, len) do {               \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::vector<mode::pair<int, int>> v;                      \
+  for (size_t i = 0; i < len; ++i)                           \
+    v.push_back(mode::pair<int, int>(rand(), rand()));       \
+  start = clock();                                           \
+  mode::con<int, int> c(v.begin(), v.end());                 \
+  size_t found = 0;                                          \
+  for (size_t i = 0; i < len; ++i)                           \
+    found += c.count(rand());                                \
+  end = clock();                                             \
+  volatile size_t sink = found; (void)sink;                  \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define FLAT_FIND_TEST(len1, len2, len3)                     \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  FLAT_FIND_DO_TEST(std, map, len1);                         \
+  FLAT_FIND_DO_TEST(std, map, len2);                         \
+  FLAT_FIND_DO_TEST(std, map, len3);                         \
+  std::cout << "\n|     mystl::map      |";                  \
+  FLAT_FIND_DO_TEST(mystl, map, len1);                       \
+  FLAT_FIND_DO_TEST(mystl, map, len2);                       \
+  FLAT_FIND_DO_TEST(mystl, map, len3);                       \
+  std::cout << "\n|   mystl::flat_map   |";                  \
+  FLAT_FIND_DO_TEST(mystl, flat_map, len1);                  \
+  FLAT_FIND_DO_TEST(mystl, flat_map, len2);                  \
+  FLAT_FIND_DO_TEST(mystl, flat_map, len3);
+
+void flat_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : flat_map ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<FLAT_PAIR> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(FLAT_PAIR(i, i));
+    mystl::flat_map<int, int> m1;
+    mystl::flat_map<int, int, mystl::greater<int>> m2;
+    mystl::flat_map<int, int> m3(v.begin(), v.end());
+    mystl::flat_map<int, int> m4(v.begin(), v.end());
+    mystl::flat_map<int, int> m5(m3);
+    mystl::flat_map<int, int> m6(std::move(m3));
+    mystl::flat_map<int, int> m7;
+    m7 = m4;
+    mystl::flat_map<int, int> m8;
+    m8 = std::move(m4);
+    mystl::flat_map<int, int> m9{ FLAT_PAIR(1,1),FLAT_PAIR(3,2),FLAT_PAIR(2,3) };
+    mystl::flat_map<int, int> m10;
+    m10 = { FLAT_PAIR(1,1),FLAT_PAIR(3,2),FLAT_PAIR(2,3) };
+
+    for (int i = 5; i > 0; --i)
+    {
+        FLAT_MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    FLAT_MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(0));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(1));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+    for (int i = 0; i < 5; ++i)
+    {
+        FLAT_MAP_FUN_AFTER(m1, m1.insert(FLAT_PAIR(i, i)));
+    }
+    FLAT_MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    FLAT_MAP_FUN_AFTER(m1, m1.insert(m1.end(), FLAT_PAIR(5, 5)));
+    FLAT_MAP_FUN_AFTER(m1, m1.insert({ FLAT_PAIR(9,9),FLAT_PAIR(7,7),FLAT_PAIR(3,30),FLAT_PAIR(8,8) }));
+    FUN_VALUE(m1.count(1));
+    FLAT_MAP_VALUE(*m1.find(3));
+    FLAT_MAP_VALUE(*m1.lower_bound(3));
+    FLAT_MAP_VALUE(*m1.upper_bound(2));
+    auto first = *m1.equal_range(2).first;
+    auto second = *m1.equal_range(2).second;
+    std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+        << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(1));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
+    FLAT_MAP_FUN_AFTER(m1, m1.clear());
+    FLAT_MAP_FUN_AFTER(m1, m1.swap(m9));
+    FLAT_MAP_VALUE(*m1.begin());
+    FLAT_MAP_VALUE(*m1.rbegin());
+    FUN_VALUE(m1[1]);
+    FLAT_MAP_FUN_AFTER(m1, m1[1] = 3);
+    FUN_VALUE(m1.at(1));
+    FUN_VALUE(m1.keys().size());
+    FUN_VALUE(m1.values().size());
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1.max_size());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    build + find     |";
+#if LARGER_TEST_DATA_ON
+    FLAT_FIND_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    FLAT_FIND_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[---------------- End container test : flat_map ----------------]" << std::endl;
+}
+
+void flat_multimap_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : flat_multimap --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<FLAT_PAIR> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(FLAT_PAIR(i, i));
+    mystl::flat_multimap<int, int> m1;
+    mystl::flat_multimap<int, int, mystl::greater<int>> m2;
+    mystl::flat_multimap<int, int> m3(v.begin(), v.end());
+    mystl::flat_multimap<int, int> m4(m3);
+    mystl::flat_multimap<int, int> m5(std::move(m3));
+    mystl::flat_multimap<int, int> m6{ FLAT_PAIR(1,1),FLAT_PAIR(3,2),FLAT_PAIR(2,3) };
+
+    for (int i = 5; i > 0; --i)
+    {
+        FLAT_MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    FLAT_MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    FLAT_MAP_FUN_AFTER(m1, m1.insert(FLAT_PAIR(3, 30)));
+    FLAT_MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    FLAT_MAP_FUN_AFTER(m1, m1.insert(m1.end(), FLAT_PAIR(5, 5)));
+    FUN_VALUE(m1.count(3));
+    FLAT_MAP_VALUE(*m1.find(3));
+    FLAT_MAP_VALUE(*m1.lower_bound(3));
+    FLAT_MAP_VALUE(*m1.upper_bound(2));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(3));
+    FLAT_MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(4)));
+    FLAT_MAP_FUN_AFTER(m1, m1.swap(m6));
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    PASSED;
+    std::cout << "[------------- End container test : flat_multimap --------------]" << std::endl;
+}
+
+void flat_set_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : flat_set ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = { 5,4,3,2,1 };
+    mystl::flat_set<int> s1;
+    mystl::flat_set<int, mystl::greater<int>> s2(a, a + 5);
+    mystl::flat_set<int> s3(a, a + 5);
+    mystl::flat_set<int> s4(s3);
+    mystl::flat_set<int> s5(std::move(s3));
+    mystl::flat_set<int> s6{ 1,2,3,4,5 };
+
+    for (int i = 5; i > 0; --i)
+    {
+        FUN_AFTER(s1, s1.emplace(i));
+    }
+    FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(1));
+    FUN_AFTER(s1, s1.insert(a, a + 5));
+    FUN_AFTER(s1, s1.insert({ 9,7,3,8,7 }));
+    FUN_AFTER(s1, s1.insert(s1.end(), 10));
+    FUN_AFTER(s2, s2.insert(0));
+    FUN_VALUE(s1.count(5));
+    FUN_VALUE(*s1.find(3));
+    FUN_VALUE(*s1.lower_bound(6));
+    FUN_VALUE(*s1.upper_bound(3));
+    FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(7)));
+    FUN_AFTER(s1, s1.swap(s6));
+    std::cout << std::boolalpha;
+    FUN_VALUE(s1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(s1.size());
+    PASSED;
+    std::cout << "[---------------- End container test : flat_set ----------------]" << std::endl;
+}
+
+} // namespace flat_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_FLAT_MAP_TEST_H_
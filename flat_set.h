@@ -0,0 +1,316 @@
+#ifndef MY_STL_FLAT_SET_H_
+#define MY_STL_FLAT_SET_H_
+
+// ͷļһģ flat_set
+// flat_set : ƽϣԪشһ vector Уֵʵֵֵظ
+
+// notes:
+//
+// flat_set  flat_map һһι֮ԲΪĳΪֲң
+// ԪصĲɾΪ O(n)
+//  insert(first, last) Ԫ׷ӵβ inplace_merge
+// ԭвֺϲ unique ȥظԪأӶΪ O(m log m + n)
+//
+// 쳣֤
+// mystl::flat_set<Key> 쳣֤µȺǿ쳣ȫ֤
+//   * emplace
+//   * insertԪأ
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// ģ flat_setֵظ
+// һֵֵͣȽϷʽȱʡʹ mystl::less
+template <typename Key, typename Compare = mystl::less<Key>>
+class flat_set
+{
+public:
+	using key_type			= Key;
+	using value_type		= Key;
+	using key_compare		= Compare;
+	using value_compare		= Compare;
+
+	using container_type	= mystl::vector<Key>;
+
+private:
+	// жԪǷȼ
+	struct equivalent
+	{
+		Compare comp;
+		bool operator()(const value_type& lhs, const value_type& rhs) const
+		{
+			return !comp(lhs, rhs);
+		}
+	};
+
+	container_type keys_;		// Ԫ
+	key_compare    key_comp_;	// ԪرȽϵ׼
+
+public:
+	using pointer					= typename container_type::const_pointer;
+	using const_pointer				= typename container_type::const_pointer;
+	using reference					= typename container_type::const_reference;
+	using const_reference			= typename container_type::const_reference;
+	using iterator					= typename container_type::const_iterator;
+	using const_iterator			= typename container_type::const_iterator;
+	using reverse_iterator			= typename container_type::const_reverse_iterator;
+	using const_reverse_iterator	= typename container_type::const_reverse_iterator;
+	using size_type					= typename container_type::size_type;
+	using difference_type			= typename container_type::difference_type;
+
+public:
+	flat_set() = default;
+
+	template <typename InputIterator>
+	flat_set(InputIterator first, InputIterator last)
+		:keys_(), key_comp_()
+	{
+		insert(first, last);
+	}
+
+	flat_set(std::initializer_list<value_type> ilist)
+		:keys_(), key_comp_()
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	flat_set(const flat_set& rhs)
+		:keys_{ rhs.keys_ }, key_comp_{ rhs.key_comp_ }
+	{
+	}
+
+	flat_set(flat_set&& rhs) noexcept
+		:keys_{ mystl::move(rhs.keys_) }, key_comp_{ rhs.key_comp_ }
+	{
+	}
+
+	flat_set& operator=(const flat_set& rhs)
+	{
+		if (this != &rhs)
+		{
+			keys_ = rhs.keys_;
+			key_comp_ = rhs.key_comp_;
+		}
+		return *this;
+	}
+
+	flat_set& operator=(flat_set&& rhs) noexcept
+	{
+		keys_ = mystl::move(rhs.keys_);
+		key_comp_ = rhs.key_comp_;
+		return *this;
+	}
+
+	flat_set& operator=(std::initializer_list<value_type> ilist)
+	{
+		keys_.clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	// ؽӿ
+
+	key_compare key_comp() const { return key_comp_; }
+	value_compare value_comp() const { return key_comp_; }
+
+	// ֱӷʵײ
+	const container_type& keys() const noexcept { return keys_; }
+
+	iterator begin() const noexcept { return keys_.begin(); }
+	iterator end() const noexcept { return keys_.end(); }
+
+	reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+	reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+	const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator crend() const noexcept { return rend(); }
+
+	// 
+	bool empty() const noexcept { return keys_.empty(); }
+	size_type size() const noexcept { return keys_.size(); }
+	size_type max_size() const noexcept { return keys_.max_size(); }
+	size_type capacity() const noexcept { return keys_.capacity(); }
+
+	void reserve(size_type n) { keys_.reserve(n); }
+	void shrink_to_fit() { keys_.shrink_to_fit(); }
+
+	// ɾ
+
+	template <typename ...Args>
+	pair<iterator, bool> emplace(Args&& ...args)
+	{
+		return insert_value(value_type(mystl::forward<Args>(args)...));
+	}
+
+	template <typename ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		return insert_value_use_hint(hint, value_type(mystl::forward<Args>(args)...));
+	}
+
+	pair<iterator, bool> insert(const value_type& value)
+	{
+		return insert_value(value_type(value));
+	}
+	pair<iterator, bool> insert(value_type&& value)
+	{
+		return insert_value(mystl::move(value));
+	}
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{
+		return insert_value_use_hint(hint, value_type(value));
+	}
+	iterator insert(const_iterator hint, value_type&& value)
+	{
+		return insert_value_use_hint(hint, mystl::move(value));
+	}
+
+	// 룺׷ӵβ֣ԭвֺϲȥ
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		const size_type n = keys_.size();
+		try
+		{
+			for (; first != last; ++first)
+				keys_.push_back(*first);
+		}
+		catch (...)
+		{
+			keys_.erase(keys_.begin() + n, keys_.end());
+			throw;
+		}
+		if (keys_.size() == n)
+			return;
+
+		auto middle = keys_.begin() + n;
+		mystl::sort(middle, keys_.end(), key_comp_);
+		// inplace_merge ȶģȼԪԭеԪǰ棬unique ᱣ
+		mystl::inplace_merge(keys_.begin(), middle, keys_.end(), key_comp_);
+		keys_.erase(mystl::unique(keys_.begin(), keys_.end(), equivalent{ key_comp_ }), keys_.end());
+	}
+
+	void insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	iterator erase(const_iterator position) { return keys_.erase(position); }
+	size_type erase(const key_type& key)
+	{
+		auto it = find(key);
+		if (it == end())
+			return 0;
+		keys_.erase(it);
+		return 1;
+	}
+	iterator erase(const_iterator first, const_iterator last) { return keys_.erase(first, last); }
+
+	void clear() { keys_.clear(); }
+
+	// flat_set ز
+
+	iterator find(const key_type& key) const
+	{
+		auto it = lower_bound(key);
+		return (it == end() || key_comp_(key, *it)) ? end() : it;
+	}
+
+	size_type count(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+
+	iterator lower_bound(const key_type& key) const
+	{
+		return mystl::lower_bound(keys_.begin(), keys_.end(), key, key_comp_);
+	}
+
+	iterator upper_bound(const key_type& key) const
+	{
+		return mystl::upper_bound(keys_.begin(), keys_.end(), key, key_comp_);
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key) const
+	{
+		auto it = find(key);
+		return pair<iterator, iterator>(it, it == end() ? it : it + 1);
+	}
+
+	void swap(flat_set& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			keys_.swap(rhs.keys_);
+			mystl::swap(key_comp_, rhs.key_comp_);
+		}
+	}
+
+public:
+	friend bool operator==(const flat_set& lhs, const flat_set& rhs) { return lhs.keys_ == rhs.keys_; }
+	friend bool operator< (const flat_set& lhs, const flat_set& rhs) { return lhs.keys_ < rhs.keys_; }
+
+private:
+	// 뵥Ԫ
+	pair<iterator, bool> insert_value(value_type&& value)
+	{
+		auto it = lower_bound(value);
+		if (it != end() && !key_comp_(value, *it))
+			return pair<iterator, bool>(it, false);
+		return pair<iterator, bool>(keys_.insert(it, mystl::move(value)), true);
+	}
+
+	// ʹ hint 룬 hint ǡǲλʱʡȥһζֲ
+	iterator insert_value_use_hint(const_iterator hint, value_type&& value)
+	{
+		if ((hint == begin() || key_comp_(*(hint - 1), value)) &&
+			(hint == end() || key_comp_(value, *hint)))
+		{
+			return keys_.insert(hint, mystl::move(value));
+		}
+		return insert_value(mystl::move(value)).first;
+	}
+};
+
+// رȽϲ
+template <typename Key, typename Compare>
+bool operator!=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare>
+bool operator>(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <typename Key, typename Compare>
+bool operator<=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <typename Key, typename Compare>
+bool operator>=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <typename Key, typename Compare>
+void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FLAT_SET_H_
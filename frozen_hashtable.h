@@ -0,0 +1,316 @@
+#ifndef MY_STL_FROZEN_HASHTABLE_H_
+#define MY_STL_FROZEN_HASHTABLE_H_
+
+// ͷļ frozen_map / frozen_set õĲ֣ڿõַϣԼСϣĹ
+
+// notes:
+//
+// ֵڱ֪ʱڱΪҵһСϣPTHash 
+//   * ôӵ 64 λϣֵĸ 32 λ N ֵֵ M = N / 2 + 1  bucket У
+//   *  bucket ӴСΪÿ bucket һ pilotʹÿֵλ
+//     ϣֵĵ 32 λ pilotӳ䵽 [0, N)ͬҲ֮ǰźõļֵͻ
+//   * ԪذλôڳǡΪ N Уֻһιϣһ pilot һμֵȽϣ
+//     û̽ѭǷҵҲֻһѡ
+// ͬһ bucket ֵϣֵĵ 32 λͬʱκ pilot ʹǳͻʱһ¿ʼ
+// ȵļֵȻͬһ bucket ҹϣֵͬɴ˷ظļֵ
+//
+// ȫ constexpr ɣ constexpr ʱڱֵʱڴ棬Ҳû
+// ʧܣֵظʱ׳쳣ڱֵʱΪ
+// ֵܶʱܳĳֵƣҪMSVC /constexpr:stepsGCC -fconstexpr-ops-limit
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "astring.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// frozen_string : ڿõַãӵַ frozen_map / frozen_set ֵַ
+// ַʽ죬Ҳ mystl::string ڲ
+class frozen_string
+{
+private:
+	const char* data_;
+	size_t      size_;
+
+public:
+	constexpr frozen_string() noexcept :data_(""), size_(0) {}
+	constexpr frozen_string(const char* s) noexcept :data_(s), size_(length(s)) {}
+	constexpr frozen_string(const char* s, size_t n) noexcept :data_(s), size_(n) {}
+	frozen_string(const mystl::string& s) noexcept :data_(s.data()), size_(s.size()) {}
+
+	constexpr const char* data() const noexcept { return data_; }
+	constexpr size_t      size() const noexcept { return size_; }
+	constexpr bool        empty() const noexcept { return size_ == 0; }
+	constexpr char operator[](size_t n) const noexcept { return data_[n]; }
+
+	friend constexpr bool operator==(const frozen_string& lhs, const frozen_string& rhs) noexcept
+	{
+		if (lhs.size_ != rhs.size_)
+			return false;
+		for (size_t i = 0; i < lhs.size_; ++i)
+		{
+			if (lhs.data_[i] != rhs.data_[i])
+				return false;
+		}
+		return true;
+	}
+	friend constexpr bool operator!=(const frozen_string& lhs, const frozen_string& rhs) noexcept
+	{
+		return !(lhs == rhs);
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const frozen_string& s)
+	{
+		return os.write(s.data_, static_cast<std::streamsize>(s.size_));
+	}
+
+private:
+	static constexpr size_t length(const char* s) noexcept
+	{
+		size_t n = 0;
+		while (s[n] != '\0')
+			++n;
+		return n;
+	}
+};
+
+namespace frozen_detail
+{
+
+// MurmurHash3  64 λսắһ˫
+constexpr uint64_t fmix(uint64_t h) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	return h;
+}
+
+// Сȡ p  8  4 ַλƴԱڱʹãϲһζȡ
+constexpr uint64_t read8(const char* p) noexcept
+{
+	return static_cast<uint64_t>(static_cast<unsigned char>(p[0]))
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[1])) << 8
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[2])) << 16
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[3])) << 24
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[4])) << 32
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[5])) << 40
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[6])) << 48
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[7])) << 56;
+}
+
+constexpr uint64_t read4(const char* p) noexcept
+{
+	return static_cast<uint64_t>(static_cast<unsigned char>(p[0]))
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[1])) << 8
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[2])) << 16
+		| static_cast<uint64_t>(static_cast<unsigned char>(p[3])) << 24;
+}
+
+// ȡ 8 ַ4  8 ʱβοص 4 ַ1  3 ʱסСβַ
+// ͬʱͬûаѭ
+constexpr uint64_t read_small(const char* p, size_t n) noexcept
+{
+	return n >= 4 ? (read4(p) << 32 | read4(p + n - 4))
+		: n > 0 ? (static_cast<uint64_t>(static_cast<unsigned char>(p[0])) << 16
+			| static_cast<uint64_t>(static_cast<unsigned char>(p[n >> 1])) << 8
+			| static_cast<uint64_t>(static_cast<unsigned char>(p[n - 1])))
+		: 0;
+}
+
+//  32 λ x ӳ䵽 [0, n)ó˷ȡģ
+constexpr size_t fastrange(uint32_t x, size_t n) noexcept
+{
+	return static_cast<size_t>((static_cast<uint64_t>(x) * n) >> 32);
+}
+
+} // namespace frozen_detail
+
+// frozen_hash : frozen_map / frozen_set Ĺϣһӣʱֱҵϣ
+// ѾǴɢ 64 λֵϣٻͬļֵڲͬµĹϣֵӦر仯
+// ȱʡ֧ö٣Լ frozen_stringֵͿػ
+template <typename Key>
+struct frozen_hash
+{
+	constexpr uint64_t operator()(const Key& key, uint64_t seed) const noexcept
+	{
+		static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value,
+			"frozen_hash<Key> needs a specialization for this key type");
+		return frozen_detail::fmix(static_cast<uint64_t>(key) ^ seed);
+	}
+};
+
+template <>
+struct frozen_hash<frozen_string>
+{
+	constexpr uint64_t operator()(const frozen_string& s, uint64_t seed) const noexcept
+	{
+		const char* p = s.data();
+		const size_t n = s.size();
+		if (n <= 8)
+			return frozen_detail::fmix(seed ^ frozen_detail::read_small(p, n) ^ (n * 0x9E3779B97F4A7C15ull));
+		uint64_t h = seed ^ (n * 0x9E3779B97F4A7C15ull);
+		for (size_t i = 0; i + 8 < n; i += 8)
+			h = frozen_detail::fmix(h ^ frozen_detail::read8(p + i));
+		return frozen_detail::fmix(h ^ frozen_detail::read8(p + n - 8));
+	}
+};
+
+// N Ԫصı bucket 
+constexpr size_t frozen_bucket_count(size_t n) noexcept
+{
+	return n / 2 + 1;
+}
+
+// ϣֵΪ h ļֵڵ bucket
+constexpr size_t frozen_bucket(uint64_t h, size_t buckets) noexcept
+{
+	return frozen_detail::fastrange(static_cast<uint32_t>(h >> 32), buckets);
+}
+
+// ϣֵΪ h ļֵ bucket  pilot Ϊ pilot ʱλ
+constexpr size_t frozen_position(uint64_t h, uint32_t pilot, size_t n) noexcept
+{
+	return frozen_detail::fastrange(static_cast<uint32_t>(h) ^ pilot, n);
+}
+
+// ʱõĲϣÿ bucket  pilot
+template <size_t M>
+struct frozen_pilots
+{
+	uint64_t seed;
+	uint32_t value[M];
+};
+
+// Ľorder[i] Ϊλ i ϵԪе±
+template <size_t N>
+struct frozen_layout
+{
+	frozen_pilots<frozen_bucket_count(N)> pilots;
+	size_t order[N];
+};
+
+// ȡԪصļֵ
+struct frozen_key_of_pair
+{
+	template <typename Pair>
+	constexpr const typename Pair::first_type& operator()(const Pair& p) const noexcept
+	{
+		return p.first;
+	}
+};
+
+struct frozen_key_identity
+{
+	template <typename Key>
+	constexpr const Key& operator()(const Key& key) const noexcept
+	{
+		return key;
+	}
+};
+
+//  seed Թ죬Ҫʱ false
+template <size_t N, typename Item, typename KeyOf, typename Hash, typename KeyEqual>
+constexpr bool frozen_try_build(const Item (&items)[N], KeyOf key_of, const Hash& hash,
+	const KeyEqual& equal, uint64_t seed, frozen_layout<N>& layout)
+{
+	constexpr size_t M = frozen_bucket_count(N);
+	uint64_t hashes[N] = {};
+	size_t start[M + 1] = {};	//  b  bucket Ԫ members еķΧΪ [start[b], start[b + 1])
+	size_t fill[M] = {};
+	size_t members[N] = {};
+	bool taken[N] = {};
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		hashes[i] = hash(key_of(items[i]), seed);
+		++start[frozen_bucket(hashes[i], M) + 1];
+	}
+	size_t max_bucket = 0;
+	for (size_t b = 0; b < M; ++b)
+	{
+		if (start[b + 1] > max_bucket)
+			max_bucket = start[b + 1];
+		start[b + 1] += start[b];
+	}
+	for (size_t i = 0; i < N; ++i)
+	{
+		const size_t b = frozen_bucket(hashes[i], M);
+		members[start[b] + fill[b]++] = i;
+	}
+
+	layout.pilots.seed = seed;
+	const uint64_t pilot_limit = 64 * static_cast<uint64_t>(N) + 1024;
+	for (size_t sz = max_bucket; sz > 0; --sz)
+	{
+		for (size_t b = 0; b < M; ++b)
+		{
+			if (start[b + 1] - start[b] != sz)
+				continue;
+			const size_t* mem = members + start[b];
+			for (size_t j = 1; j < sz; ++j)
+			{
+				for (size_t k = 0; k < j; ++k)
+				{
+					if (static_cast<uint32_t>(hashes[mem[j]]) == static_cast<uint32_t>(hashes[mem[k]]))
+					{
+						THROW_RUNTIME_ERROR_IF(equal(key_of(items[mem[j]]), key_of(items[mem[k]])),
+							"frozen hash table has duplicate keys");
+						return false;
+					}
+				}
+			}
+			bool placed = false;
+			for (uint64_t p = 0; p < pilot_limit && !placed; ++p)
+			{
+				const uint32_t pilot = static_cast<uint32_t>(frozen_detail::fmix(p + 1));
+				bool ok = true;
+				for (size_t j = 0; j < sz && ok; ++j)
+				{
+					const size_t pos = frozen_position(hashes[mem[j]], pilot, N);
+					ok = !taken[pos];
+					for (size_t k = 0; k < j && ok; ++k)
+						ok = frozen_position(hashes[mem[k]], pilot, N) != pos;
+				}
+				if (ok)
+				{
+					for (size_t j = 0; j < sz; ++j)
+					{
+						const size_t pos = frozen_position(hashes[mem[j]], pilot, N);
+						taken[pos] = true;
+						layout.order[pos] = mem[j];
+					}
+					layout.pilots.value[b] = pilot;
+					placed = true;
+				}
+			}
+			if (!placed)
+				return false;
+		}
+	}
+	return true;
+}
+
+// Ϊ items ļֵСϣ
+template <size_t N, typename Item, typename KeyOf, typename Hash, typename KeyEqual>
+constexpr frozen_layout<N> frozen_build(const Item (&items)[N], KeyOf key_of,
+	const Hash& hash, const KeyEqual& equal)
+{
+	for (uint64_t attempt = 0; ; ++attempt)
+	{
+		THROW_RUNTIME_ERROR_IF(attempt == 64, "frozen hash table cannot find a perfect hash");
+		frozen_layout<N> layout{};
+		if (frozen_try_build(items, key_of, hash, equal, frozen_detail::fmix(attempt + 0x9E3779B97F4A7C15ull), layout))
+			return layout;
+	}
+}
+
+} // namespace mystl
+#endif // !MY_STL_FROZEN_HASHTABLE_H_
@@ -0,0 +1,152 @@
+#ifndef MY_STL_FROZEN_MAP_H_
+#define MY_STL_FROZEN_MAP_H_
+
+// ͷļģ frozen_map
+// frozen_map : Ԫظֵڹʱȷ֮޸ĵӳ䣬ײΪڹСϣ
+
+// notes:
+//
+// ʺϹؼֱöٵֵӳڱھ֪ľ̬ݣ
+//   *  constexpr 󱣴ʱϣڱԪֱӴڶУڴ棬Ҳû
+//   * ֻһιϣһ pilotȽһμֵû̽ѭ
+//   * Ԫظ N ͵һ֣ͨ make_frozen_map Ƶ
+//   * Ԫص˳ϣ˳޹أ
+//   * ֵظҲϣʱ׳쳣ڱֵʱΪ
+// ϣĲ mystl::hash һӣȱʡΪ frozen_hash֧ö frozen_string
+
+#include "frozen_hashtable.h"
+
+namespace mystl
+{
+
+// ģ frozen_mapֵظ
+// һֵͣʵֵͣԪظ
+// Ĵϣȱʡʹ mystl::frozen_hashֵȽϷʽȱʡʹ mystl::equal_to
+template <typename Key, typename T, size_t N, typename Hash = mystl::frozen_hash<Key>,
+	typename KeyEqual = mystl::equal_to<Key>>
+class frozen_map
+{
+	static_assert(N > 0, "frozen_map needs at least one element");
+
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= mystl::pair<Key, T>;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+
+	using iterator					= const value_type*;
+	using const_iterator			= const value_type*;
+
+private:
+	static constexpr size_type bucket_count_ = frozen_bucket_count(N);
+
+	value_type						items_[N];
+	frozen_pilots<bucket_count_>	pilots_;
+	hasher							hash_;
+	key_equal						equal_;
+
+public:
+	// 캯 N Ԫع
+	constexpr explicit frozen_map(const value_type (&items)[N],
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:frozen_map(items, frozen_build(items, frozen_key_of_pair(), hash, equal),
+			hash, equal, std::make_index_sequence<N>())
+	{
+	}
+
+	// ز
+	constexpr const_iterator begin() const noexcept
+	{ return items_; }
+	constexpr const_iterator end() const noexcept
+	{ return items_ + N; }
+	constexpr const_iterator cbegin() const noexcept
+	{ return begin(); }
+	constexpr const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	constexpr bool empty() const noexcept { return false; }
+	constexpr size_type size() const noexcept { return N; }
+	constexpr size_type max_size() const noexcept { return N; }
+
+	// ز
+	constexpr const mapped_type& at(const key_type& key) const
+	{
+		const size_type i = index_of(key);
+		THROW_OUT_OF_RANGE_IF(i == N, "frozen_map<Key, T> no such element exists");
+		return items_[i].second;
+	}
+
+	constexpr const_iterator find(const key_type& key) const
+	{
+		return items_ + index_of(key);
+	}
+
+	constexpr size_type count(const key_type& key) const
+	{
+		return index_of(key) != N ? 1 : 0;
+	}
+
+	constexpr bool contains(const key_type& key) const
+	{
+		return index_of(key) != N;
+	}
+
+	constexpr pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return pair<const_iterator, const_iterator>(find(key), find(key) + (contains(key) ? 1 : 0));
+	}
+
+	// bucket ϣ
+	constexpr size_type bucket_count() const noexcept { return bucket_count_; }
+	constexpr float load_factor() const noexcept { return 1.0f; }
+
+	constexpr hasher hash_fcn() const { return hash_; }
+	constexpr key_equal key_eq() const { return equal_; }
+
+private:
+	template <size_t... I>
+	constexpr frozen_map(const value_type (&items)[N], const frozen_layout<N>& layout,
+		const Hash& hash, const KeyEqual& equal, std::index_sequence<I...>)
+		:items_{ items[layout.order[I]]... }, pilots_(layout.pilots), hash_(hash), equal_(equal)
+	{
+	}
+
+	// ؼֵΪ key Ԫصλãʱ N
+	constexpr size_type index_of(const key_type& key) const
+	{
+		const uint64_t h = hash_(key, pilots_.seed);
+		const size_type i = frozen_position(h, pilots_.value[frozen_bucket(h, bucket_count_)], N);
+		return equal_(items_[i].first, key) ? i : N;
+	}
+};
+
+template <typename Key, typename T, size_t N, typename Hash, typename KeyEqual>
+constexpr typename frozen_map<Key, T, N, Hash, KeyEqual>::size_type
+frozen_map<Key, T, N, Hash, KeyEqual>::bucket_count_;
+
+// 鹹 frozen_mapԪظĳƵ
+template <typename Key, typename T, size_t N>
+constexpr frozen_map<Key, T, N> make_frozen_map(const mystl::pair<Key, T> (&items)[N])
+{
+	return frozen_map<Key, T, N>(items);
+}
+
+template <typename Key, typename T, size_t N, typename Hash, typename KeyEqual>
+constexpr frozen_map<Key, T, N, Hash, KeyEqual> make_frozen_map(const mystl::pair<Key, T> (&items)[N],
+	const Hash& hash, const KeyEqual& equal)
+{
+	return frozen_map<Key, T, N, Hash, KeyEqual>(items, hash, equal);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FROZEN_MAP_H_
@@ -0,0 +1,290 @@
+#ifndef MY_STL_FROZEN_MAP_TEST_H_
+#define MY_STL_FROZEN_MAP_TEST_H_
+
+// frozen_map test :  frozen_map, frozen_set Ľӿڹ죬Լ unordered_mapflat_hash_map ĲܶԱ
+
+#include "frozen_map.h"
+#include "frozen_set.h"
+#include "flat_hash_map.h"
+#include "unordered_map.h"
+#include "map_test.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace frozen_map_test
+{
+
+// C ԵĹؼֵ֣Ϊַ
+constexpr mystl::pair<mystl::frozen_string, int> keyword_items[] = {
+    { "auto", 0 }, { "break", 1 }, { "case", 2 }, { "char", 3 }, { "const", 4 },
+    { "continue", 5 }, { "default", 6 }, { "do", 7 }, { "double", 8 }, { "else", 9 },
+    { "enum", 10 }, { "extern", 11 }, { "float", 12 }, { "for", 13 }, { "goto", 14 },
+    { "if", 15 }, { "int", 16 }, { "long", 17 }, { "register", 18 }, { "return", 19 },
+    { "short", 20 }, { "signed", 21 }, { "sizeof", 22 }, { "static", 23 }, { "struct", 24 },
+    { "switch", 25 }, { "typedef", 26 }, { "union", 27 }, { "unsigned", 28 }, { "void", 29 },
+    { "volatile", 30 }, { "while", 31 }
+};
+
+// ǹؼֵıʶڲʧܵ
+const char* const identifier_items[] = {
+    "value", "index", "count", "size", "first", "last", "node", "next",
+    "prev", "data", "buffer", "length", "result", "begin", "end", "key",
+    "hash", "left", "right", "parent", "color", "level", "width", "height",
+    "name", "type", "flags", "state", "error", "offset", "width_", "autos"
+};
+
+// HTTP ״̬룬ֵΪϡ
+constexpr mystl::pair<int, mystl::frozen_string> status_items[] = {
+    { 100, "Continue" }, { 101, "Switching Protocols" }, { 200, "OK" }, { 201, "Created" },
+    { 202, "Accepted" }, { 204, "No Content" }, { 206, "Partial Content" },
+    { 301, "Moved Permanently" }, { 302, "Found" }, { 303, "See Other" }, { 304, "Not Modified" },
+    { 307, "Temporary Redirect" }, { 308, "Permanent Redirect" }, { 400, "Bad Request" },
+    { 401, "Unauthorized" }, { 403, "Forbidden" }, { 404, "Not Found" },
+    { 405, "Method Not Allowed" }, { 406, "Not Acceptable" }, { 408, "Request Timeout" },
+    { 409, "Conflict" }, { 410, "Gone" }, { 411, "Length Required" },
+    { 412, "Precondition Failed" }, { 413, "Payload Too Large" }, { 414, "URI Too Long" },
+    { 415, "Unsupported Media Type" }, { 416, "Range Not Satisfiable" },
+    { 429, "Too Many Requests" }, { 500, "Internal Server Error" }, { 501, "Not Implemented" },
+    { 502, "Bad Gateway" }, { 503, "Service Unavailable" }, { 504, "Gateway Timeout" }
+};
+
+enum class fruit { apple, banana, cherry, grape, lemon, lime, orange, peach };
+
+constexpr fruit citrus_items[] = { fruit::lemon, fruit::lime, fruit::orange };
+
+constexpr int prime_items[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29 };
+
+// ϣڱҲڱ
+constexpr auto keywords = mystl::make_frozen_map(keyword_items);
+constexpr auto status = mystl::make_frozen_map(status_items);
+constexpr auto citrus = mystl::make_frozen_set(citrus_items);
+constexpr auto primes = mystl::make_frozen_set(prime_items);
+
+static_assert(keywords.size() == 32, "frozen_map size");
+static_assert(keywords.at("while") == 31, "frozen_map at");
+static_assert(keywords.contains("goto") && !keywords.contains("goto_"), "frozen_map contains");
+static_assert(keywords.find("switch")->second == 25, "frozen_map find");
+static_assert(status.count(404) == 1 && status.count(418) == 0, "frozen_map count");
+static_assert(status.at(200) == "OK", "frozen_map at");
+static_assert(citrus.contains(fruit::lime) && !citrus.contains(fruit::apple), "frozen_set contains");
+static_assert(primes.count(17) == 1 && primes.count(15) == 0, "frozen_set count");
+
+//  count β words еַʱ
+template <typename Map>
+void keyword_find_do_test(const Map& m, const mystl::vector<mystl::string>& words, size_t count)
+{
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = 0, j = 0; i < count; ++i)
+    {
+        hits += m.find(words[j]) != m.end();
+        if (++j == words.size())
+            j = 0;
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  count β [100, 600) е״̬룬󲿷ֲڣʱ
+template <typename Map>
+void status_find_do_test(const Map& m, size_t count)
+{
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = 0, code = 100; i < count; ++i)
+    {
+        hits += m.find(static_cast<int>(code)) != m.end();
+        if (++code == 600)
+            code = 100;
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define KEYWORD_FIND_TEST(len1, len2, len3)                                   \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_map |";                                   \
+  keyword_find_do_test(um, words, len1);                                    \
+  keyword_find_do_test(um, words, len2);                                    \
+  keyword_find_do_test(um, words, len3);                                    \
+  std::cout << "\n|mystl::flat_hash_map |";                                 \
+  keyword_find_do_test(fm, words, len1);                                    \
+  keyword_find_do_test(fm, words, len2);                                    \
+  keyword_find_do_test(fm, words, len3);                                    \
+  std::cout << "\n|  mystl::frozen_map  |";                                 \
+  keyword_find_do_test(keywords, words, len1);                              \
+  keyword_find_do_test(keywords, words, len2);                              \
+  keyword_find_do_test(keywords, words, len3);
+
+#define STATUS_FIND_TEST(len1, len2, len3)                                    \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_map |";                                   \
+  status_find_do_test(sum, len1);                                           \
+  status_find_do_test(sum, len2);                                           \
+  status_find_do_test(sum, len3);                                           \
+  std::cout << "\n|mystl::flat_hash_map |";                                 \
+  status_find_do_test(sfm, len1);                                           \
+  status_find_do_test(sfm, len2);                                           \
+  status_find_do_test(sfm, len3);                                           \
+  std::cout << "\n|  mystl::frozen_map  |";                                 \
+  status_find_do_test(status, len1);                                        \
+  status_find_do_test(status, len2);                                        \
+  status_find_do_test(status, len3);
+
+void frozen_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : frozen_map ---------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    constexpr PAIR a[] = { PAIR(5, 5), PAIR(4, 4), PAIR(3, 3), PAIR(2, 2), PAIR(1, 1) };
+    constexpr mystl::frozen_map<int, int, 5> fm1(a);
+    constexpr auto fm2 = mystl::make_frozen_map(a);
+    const auto fm3 = mystl::make_frozen_map(a, mystl::frozen_hash<int>(), mystl::equal_to<int>());
+    auto fm4 = fm1;
+
+    MAP_COUT(fm1);
+    MAP_COUT(fm2);
+    MAP_COUT(fm3);
+    MAP_COUT(fm4);
+    std::cout << std::boolalpha;
+    FUN_VALUE(fm1.empty());
+    FUN_VALUE(fm1.contains(3));
+    FUN_VALUE(fm1.contains(6));
+    FUN_VALUE((fm1.find(6) == fm1.end()));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(fm1.size());
+    FUN_VALUE(fm1.bucket_count());
+    FUN_VALUE(fm1.at(1));
+    FUN_VALUE(fm1.count(1));
+    MAP_VALUE(*fm1.find(3));
+    auto first = *fm1.equal_range(3).first;
+    std::cout << " fm1.equal_range(3).first : <" << first.first << ", " << first.second << ">" << std::endl;
+    FUN_VALUE(fm1.load_factor());
+    try
+    {
+        fm1.at(6);
+    }
+    catch (const std::out_of_range& e)
+    {
+        std::cout << " fm1.at(6) : " << e.what() << std::endl;
+    }
+
+    // ֵַ mystl::string 
+    mystl::string word = "continue";
+    FUN_VALUE(keywords.at(word));
+    FUN_VALUE(keywords.count("continues"));
+    FUN_VALUE(status.at(404));
+    FUN_VALUE(status.count(418));
+
+    // ڹ죬ظļֵ׳쳣
+    const PAIR dup[] = { PAIR(1, 1), PAIR(2, 2), PAIR(1, 3) };
+    try
+    {
+        auto fm5 = mystl::make_frozen_map(dup);
+        (void)fm5;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << " make_frozen_map(dup) : " << e.what() << std::endl;
+    }
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    mystl::vector<mystl::string> words;
+    for (const auto& item : keyword_items)
+        words.push_back(mystl::string(item.first.data(), item.first.size()));
+    for (const char* s : identifier_items)
+        words.push_back(mystl::string(s));
+    mystl::unordered_map<mystl::string, int> um;
+    mystl::flat_hash_map<mystl::string, int> fm;
+    for (const auto& item : keyword_items)
+    {
+        um.emplace(mystl::string(item.first.data(), item.first.size()), item.second);
+        fm.emplace(mystl::string(item.first.data(), item.first.size()), item.second);
+    }
+    mystl::unordered_map<int, int> sum;
+    mystl::flat_hash_map<int, int> sfm;
+    for (const auto& item : status_items)
+    {
+        sum.emplace(item.first, item.first);
+        sfm.emplace(item.first, item.first);
+    }
+
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|keyword find (string)|";
+#if LARGER_TEST_DATA_ON
+    KEYWORD_FIND_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    KEYWORD_FIND_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  status find (int)  |";
+#if LARGER_TEST_DATA_ON
+    STATUS_FIND_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    STATUS_FIND_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : frozen_map ---------------]" << std::endl;
+}
+
+void frozen_set_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : frozen_set ---------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    constexpr int a[] = { 5,4,3,2,1 };
+    constexpr mystl::frozen_set<int, 5> fs1(a);
+    constexpr auto fs2 = mystl::make_frozen_set(a);
+    const auto fs3 = mystl::make_frozen_set(a, mystl::frozen_hash<int>(), mystl::equal_to<int>());
+
+    COUT(fs1);
+    COUT(fs2);
+    COUT(fs3);
+    COUT(primes);
+    std::cout << std::boolalpha;
+    FUN_VALUE(fs1.empty());
+    FUN_VALUE(fs1.contains(3));
+    FUN_VALUE(fs1.contains(6));
+    FUN_VALUE(citrus.contains(fruit::orange));
+    FUN_VALUE(citrus.contains(fruit::peach));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(fs1.size());
+    FUN_VALUE(fs1.bucket_count());
+    FUN_VALUE(fs1.count(1));
+    FUN_VALUE(*fs1.find(3));
+    FUN_VALUE(primes.count(23));
+    FUN_VALUE(primes.count(25));
+    PASSED;
+    std::cout << "[--------------- End container test : frozen_set ---------------]" << std::endl;
+}
+
+} // namespace frozen_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_FROZEN_MAP_TEST_H_
@@ -0,0 +1,139 @@
+#ifndef MY_STL_FROZEN_SET_H_
+#define MY_STL_FROZEN_SET_H_
+
+// ͷļģ frozen_set
+// frozen_set : Ԫظֵڹʱȷ֮޸ĵļϣײΪڹСϣ
+
+// notes:
+//
+//  frozen_map ͬ constexpr 󱣴ʱϣڱڴ棬Ҳû
+// Ԫص˳ϣԪظʱ׳쳣ڱֵʱΪ󣩡
+
+#include "frozen_hashtable.h"
+
+namespace mystl
+{
+
+// ģ frozen_setֵظ
+// һֵͣԪظ
+// ϣȱʡʹ mystl::frozen_hashĴֵȽϷʽȱʡʹ mystl::equal_to
+template <typename Key, size_t N, typename Hash = mystl::frozen_hash<Key>,
+	typename KeyEqual = mystl::equal_to<Key>>
+class frozen_set
+{
+	static_assert(N > 0, "frozen_set needs at least one element");
+
+public:
+	using key_type					= Key;
+	using value_type				= Key;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+
+	using iterator					= const value_type*;
+	using const_iterator			= const value_type*;
+
+private:
+	static constexpr size_type bucket_count_ = frozen_bucket_count(N);
+
+	value_type						items_[N];
+	frozen_pilots<bucket_count_>	pilots_;
+	hasher							hash_;
+	key_equal						equal_;
+
+public:
+	// 캯 N Ԫع
+	constexpr explicit frozen_set(const value_type (&items)[N],
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:frozen_set(items, frozen_build(items, frozen_key_identity(), hash, equal),
+			hash, equal, std::make_index_sequence<N>())
+	{
+	}
+
+	// ز
+	constexpr const_iterator begin() const noexcept
+	{ return items_; }
+	constexpr const_iterator end() const noexcept
+	{ return items_ + N; }
+	constexpr const_iterator cbegin() const noexcept
+	{ return begin(); }
+	constexpr const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	constexpr bool empty() const noexcept { return false; }
+	constexpr size_type size() const noexcept { return N; }
+	constexpr size_type max_size() const noexcept { return N; }
+
+	// ز
+	constexpr const_iterator find(const key_type& key) const
+	{
+		return items_ + index_of(key);
+	}
+
+	constexpr size_type count(const key_type& key) const
+	{
+		return index_of(key) != N ? 1 : 0;
+	}
+
+	constexpr bool contains(const key_type& key) const
+	{
+		return index_of(key) != N;
+	}
+
+	constexpr pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return pair<const_iterator, const_iterator>(find(key), find(key) + (contains(key) ? 1 : 0));
+	}
+
+	// bucket ϣ
+	constexpr size_type bucket_count() const noexcept { return bucket_count_; }
+	constexpr float load_factor() const noexcept { return 1.0f; }
+
+	constexpr hasher hash_fcn() const { return hash_; }
+	constexpr key_equal key_eq() const { return equal_; }
+
+private:
+	template <size_t... I>
+	constexpr frozen_set(const value_type (&items)[N], const frozen_layout<N>& layout,
+		const Hash& hash, const KeyEqual& equal, std::index_sequence<I...>)
+		:items_{ items[layout.order[I]]... }, pilots_(layout.pilots), hash_(hash), equal_(equal)
+	{
+	}
+
+	// Ԫ key λãʱ N
+	constexpr size_type index_of(const key_type& key) const
+	{
+		const uint64_t h = hash_(key, pilots_.seed);
+		const size_type i = frozen_position(h, pilots_.value[frozen_bucket(h, bucket_count_)], N);
+		return equal_(items_[i], key) ? i : N;
+	}
+};
+
+template <typename Key, size_t N, typename Hash, typename KeyEqual>
+constexpr typename frozen_set<Key, N, Hash, KeyEqual>::size_type
+frozen_set<Key, N, Hash, KeyEqual>::bucket_count_;
+
+// 鹹 frozen_setԪظĳƵ
+template <typename Key, size_t N>
+constexpr frozen_set<Key, N> make_frozen_set(const Key (&items)[N])
+{
+	return frozen_set<Key, N>(items);
+}
+
+template <typename Key, size_t N, typename Hash, typename KeyEqual>
+constexpr frozen_set<Key, N, Hash, KeyEqual> make_frozen_set(const Key (&items)[N],
+	const Hash& hash, const KeyEqual& equal)
+{
+	return frozen_set<Key, N, Hash, KeyEqual>(items, hash, equal);
+}
+
+} // namespace mystl
+#endif // !MY_STL_FROZEN_SET_H_
@@ -3,8 +3,15 @@
 
 // ͷļ mystl ĺϣ
 
+#include <cfloat>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
+#include "util.h"
 
 namespace mystl
 {
@@ -85,7 +92,7 @@ T identity_element(multiplies<T>) { return T(1); }
 template <typename T>
 struct equal_to : public binary_function<T, T, bool>
 {
-	bool operator()(const T& x, const T& y) const { return x == y; }
+	constexpr bool operator()(const T& x, const T& y) const { return x == y; }
 };
 
 // 
@@ -96,19 +103,48 @@ struct not_equal_to : public binary_function<T, T, bool>
 };
 
 //
-template <typename T>
+template <typename T = void>
 struct greater : public binary_function<T, T, bool>
 {
 	bool operator()(const T& x, const T& y) const { return x > y; }
 };
 
+// ͸Ĵڣǲͬ
+template <>
+struct greater<void>
+{
+	using is_transparent = void;
+
+	template <typename T, typename U>
+	constexpr auto operator()(T&& x, U&& y) const
+		-> decltype(mystl::forward<T>(x) > mystl::forward<U>(y))
+	{
+		return mystl::forward<T>(x) > mystl::forward<U>(y);
+	}
+};
+
 //С
-template <typename T>
+template <typename T = void>
 struct less : public binary_function<T, T, bool>
 {
 	bool operator()(const T& x, const T& y) const { return x < y; }
 };
 
+// ͸Сڣǲͬ
+//  map / set ıȽϺʱֱ const char* Ͳ string ֵعʱ
+template <>
+struct less<void>
+{
+	using is_transparent = void;
+
+	template <typename T, typename U>
+	constexpr auto operator()(T&& x, U&& y) const
+		-> decltype(mystl::forward<T>(x) < mystl::forward<U>(y))
+	{
+		return mystl::forward<T>(x) < mystl::forward<U>(y);
+	}
+};
+
 //ڵ
 template <typename T>
 struct greater_equal : public binary_function<T, T, bool>
@@ -246,49 +282,159 @@ MYSTL_TRIVIAL_HASH_FCN(unsigned long long)
 
 #undef MYSTL_TRIVIAL_HASH_FCN
 
-// ڸ, λϣ
-inline size_t bitwise_hash(const unsigned char* first, size_t count)
+// ֽеĹϣ wyhashÿζȡ 8 ֽڲ 64 λ˷ 128 λϣ
+//  16 ֽʱֻγ˷ƽ̨϶ 64 λ㣬size_t Ϊ 32 λʱض
+namespace hash_detail
 {
-#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
-	const size_t fnv_offset = 14695981039346656037ull;
-	const size_t fnv_prime = 1099511628211ull;
+
+constexpr uint64_t secret0 = 0x2d358dccaa6c78a5ull;
+constexpr uint64_t secret1 = 0x8bb84b93962eacc9ull;
+constexpr uint64_t secret2 = 0x4b33a62ed433d4a3ull;
+constexpr uint64_t secret3 = 0x4d5a2da51de1aa47ull;
+
+// a * b  128 λ 64 λ a 64 λ b
+inline void mul128(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t r = static_cast<__uint128_t>(a) * b;
+	a = static_cast<uint64_t>(r);
+	b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	a = _umul128(a, b, &b);
 #else
-	const size_t fnv_offset = 2166136261u;
-	const size_t fnv_prime = 16777619u;
+	const uint64_t ha = a >> 32, la = static_cast<uint32_t>(a);
+	const uint64_t hb = b >> 32, lb = static_cast<uint32_t>(b);
+	const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	const uint64_t t = rl + (rm0 << 32);
+	uint64_t lo = t + (rm1 << 32);
+	uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+	a = lo;
+	b = hi;
 #endif
-	size_t result = fnv_offset;
-	for (size_t i = 0; i < count; ++i)
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept
+{
+	mul128(a, b);
+	return a ^ b;
+}
+
+// ֽȡmemcpy δ
+inline uint64_t read8(const unsigned char* p) noexcept
+{
+	uint64_t v;
+	std::memcpy(&v, p, 8);
+	return v;
+}
+
+inline uint64_t read4(const unsigned char* p) noexcept
+{
+	uint32_t v;
+	std::memcpy(&v, p, 4);
+	return v;
+}
+
+// 1  3 ֽڣȡסСβֽ
+inline uint64_t read_small(const unsigned char* p, size_t k) noexcept
+{
+	return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace hash_detail
+
+inline size_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) noexcept
+{
+	using namespace hash_detail;
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	seed ^= mix(seed ^ secret0, secret1);
+	uint64_t a, b;
+	if (len <= 16)
+	{
+		// 4  16 ֽÿصĴ 4 ֽڶȡȫ
+		if (len >= 4)
+		{
+			a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+			b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (len > 0)
+		{
+			a = read_small(p, len);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
 	{
-		result ^= (size_t)first[i];
-		result *= fnv_prime;
+		size_t i = len;
+		if (i > 48)
+		{
+			// ĳ˷д 48 ֽ
+			uint64_t see1 = seed, see2 = seed;
+			do
+			{
+				seed = mix(read8(p) ^ secret1, read8(p + 8) ^ seed);
+				see1 = mix(read8(p + 16) ^ secret2, read8(p + 24) ^ see1);
+				see2 = mix(read8(p + 32) ^ secret3, read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = mix(read8(p) ^ secret1, read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		//  16 ֽڣѴĲص
+		a = read8(p + i - 16);
+		b = read8(p + i - 8);
 	}
-	return result;
+	a ^= secret1;
+	b ^= seed;
+	mul128(a, b);
+	return static_cast<size_t>(mix(a ^ secret0 ^ len, b ^ secret1));
 }
 
+// ɵĽӿڣеĵ
+inline size_t bitwise_hash(const unsigned char* first, size_t count) noexcept
+{
+	return hash_bytes(first, count);
+}
+
+// ڸ, λϣ+0.0  -0.0 ȣϣֵΪ 0
 template <>
 struct hash<float>
 {
-	size_t operator()(const float& val)
+	size_t operator()(const float& val) const noexcept
 	{
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(float));
+		return val == 0.0f ? 0 : hash_bytes(&val, sizeof(float));
 	}
 };
 
 template <>
 struct hash<double>
 {
-	size_t operator()(const double& val)
+	size_t operator()(const double& val) const noexcept
 	{
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(double));
+		return val == 0.0 ? 0 : hash_bytes(&val, sizeof(double));
 	}
 };
 
+// x87  80 λչֻǰ 10 ֽ壬䣬ܲϣ
 template <>
 struct hash<long double>
 {
-	size_t operator()(const long double& val)
+	size_t operator()(const long double& val) const noexcept
 	{
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(long double));
+#if LDBL_MANT_DIG == 64
+		return val == 0.0L ? 0 : hash_bytes(&val, 10);
+#else
+		return val == 0.0L ? 0 : hash_bytes(&val, sizeof(long double));
+#endif
 	}
 };
 
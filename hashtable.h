@@ -3,22 +3,62 @@
 
 // ͷļһģ hashtable
 // hashtable : ϣʹÿͻ
+//
+// нڵ㴮һϣͬһ bucket Ľڵڣbucket бָ bucket һڵ
+// ӣǰһڵ next߱ͷ head_ begin() ǰ O(1) bucket ޹
+//
+// ʽ rehashincremental_rehash(true)ʱһǨȫڵ㣬 Redis  dict һ
+// ͬʱ¾ bucket 飬֮ÿβǨƼ bucketС rehash_index_ 
+// bucket ѾǨϣڵھУʱһĸ
+//
+// bucket ȱʡֻshrink_to_fit() СɵǰԪĴСclear_and_release() պ
+// ԭΪС飻Сӣmin_load_factor󣬸ӵıһβʱԶС
+// СڲɾʱУ뱾Ϳ rehashɾ뱣Ԫصĵ˳
 
 #include <initializer_list>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
 #include "algo.h"
 #include "functional.h"
 #include "memory.h"
 #include "vector.h"
 #include "util.h"
 #include "exceptdef.h"
+#include "node_handle.h"
 
 
 namespace mystl
 {
 
+// ʾ CPU  p ڵĻǰ뻺棬ֵ֧ƽ̨ʲôҲ
+inline void ht_prefetch(const void* p) noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(p);
+#else
+	(void)p;
+#endif
+}
+
+// ڵǷ񱣴ֵĹϣֵ
+// ָʹ mystl::hash ʱϣûп棻ϣַģĬϱ棬
+// ¹ϣʱٵùϣʱȱȽϹϣֵͬ򲻱رȽϼֵ
+// ΪԶĹϣػ ht_cache_hash_code ıһѡ
+template <typename Hash>
+struct ht_cache_hash_code :public m_true_type {};
+
+template <typename Key>
+struct ht_cache_hash_code<mystl::hash<Key>>
+	:public m_bool_constant<!(std::is_arithmetic<Key>::value ||
+		std::is_pointer<Key>::value || std::is_enum<Key>::value)> {};
+
 // hashtable Ľڵ㶨
-template <typename T>
+template <typename T, bool CacheHash = false>
 struct hashtable_node
 {
 	hashtable_node* next;	// ָһڵ
@@ -44,6 +84,15 @@ struct hashtable_node
 	}
 };
 
+// ϣֵĽڵ
+template <typename T>
+struct hashtable_node<T, true>
+{
+	hashtable_node* next;	// ָһڵ
+	size_t hash_code;		// ֵĹϣֵ
+	T value;				// ʵֵ
+};
+
 template <typename T, bool>
 struct ht_value_traits_imp
 {
@@ -108,33 +157,49 @@ struct ht_value_traits
 	}
 };
 
+// ȽϼֵͬԪأӳ仹ȽʵֵϵԪؾǼֵ
+template <typename T>
+bool ht_value_equal(const T&, const T&, mystl::m_false_type)
+{
+	return true;
+}
+
+template <typename T>
+bool ht_value_equal(const T& lhs, const T& rhs, mystl::m_true_type)
+{
+	return lhs.second == rhs.second;
+}
+
 // forward declaration
 
-template <typename T, typename HashFun, typename KeyEqual>
+struct ht_prime_policy;
+
+template <typename T, typename HashFun, typename KeyEqual, typename BucketPolicy = ht_prime_policy>
 class hashtable;
 
-template <typename T, typename HashFun, typename KeyEqual>
+template <typename T, typename HashFun, typename KeyEqual, typename BucketPolicy>
 struct ht_iterator;
 
-template <typename T, typename HashFun, typename KeyEqual>
+template <typename T, typename HashFun, typename KeyEqual, typename BucketPolicy>
 struct ht_const_iterator;
 
-template <typename T>
+template <typename T, typename HashFun, typename KeyEqual, typename BucketPolicy>
 struct ht_local_iterator;
 
-template <typename T>
+template <typename T, typename HashFun, typename KeyEqual, typename BucketPolicy>
 struct ht_const_local_iterator;
 
 // ht_iterator
 
-template <typename T, typename Hash, typename KeyEqual>
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
 struct ht_iterator_base: public mystl::iterator<mystl::forward_iterator_tag, T>
 {
-	using hashtable					= mystl::hashtable<T, Hash, KeyEqual>;
-	using base						= ht_iterator_base<T, Hash, KeyEqual>;
-	using iterator					= mystl::ht_iterator<T, Hash, KeyEqual>;
-	using const_iterator			= ht_const_iterator<T, Hash, KeyEqual>;
-	using node_ptr					= hashtable_node<T>*;
+	using hashtable					= mystl::hashtable<T, Hash, KeyEqual, BucketPolicy>;
+	using base						= ht_iterator_base<T, Hash, KeyEqual, BucketPolicy>;
+	using iterator					= mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using const_iterator			= ht_const_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using node_type					= hashtable_node<T, ht_cache_hash_code<Hash>::value>;
+	using node_ptr					= node_type*;
 	using contain_ptr				= hashtable*;
 	using const_node_ptr			= const node_ptr;
 	using const_contain_ptr			= const contain_ptr;
@@ -151,10 +216,10 @@ struct ht_iterator_base: public mystl::iterator<mystl::forward_iterator_tag, T>
 	bool operator!=(const base& rhs) const { return node != rhs.node; }
 };
 
-template <typename T, typename Hash, typename KeyEqual>
-struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual, BucketPolicy>
 {
-	using base					= ht_iterator_base<T, Hash, KeyEqual>;
+	using base					= ht_iterator_base<T, Hash, KeyEqual, BucketPolicy>;
 	using hashtable				= base::hashtable;
 	using iterator				= base::iterator;
 	using const_iterator		= base::const_iterator;
@@ -212,22 +277,11 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
 	reference operator*() const { return node->value; }
 	pointer operator->() const { return &(operator*()); }
 
+	// нڵ㴮һϣǰһҪϣҲҪ鿴 bucket
 	iterator& operator++()
 	{
 		MYSTL_DEBUG(node != nullptr);
-		
-		const node_ptr old = node;
 		node = node->next;
-
-		// һλΪգһ bucket ʼ
-		if (node == nullptr)
-		{
-			auto index = ht->hash(value_traits::get_key(old->value));
-			while (!node && ++index < ht->bucket_size_)
-			{
-				node = ht->buckets_[index];
-			}
-		}
 		return *this;
 	}
 
@@ -239,10 +293,10 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
 	}
 };
 
-template <typename T, typename Hash, typename KeyEqual>
-struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual, BucketPolicy>
 {
-	using base					= ht_iterator_base<T, Hash, KeyEqual>;
+	using base					= ht_iterator_base<T, Hash, KeyEqual, BucketPolicy>;
 	using hashtable				= base::hashtable;
 	using iterator				= base::iterator;
 	using const_iterator		= base::const_iterator;
@@ -279,11 +333,8 @@ struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
 
 	const_iterator& operator=(const iterator& rhs)
 	{
-		if (this != &rhs)
-		{
-			node = rhs.node;
-			ht = rhs.ht;
-		}
+		node = rhs.node;
+		ht = rhs.ht;
 		return *this;
 	}
 
@@ -304,19 +355,7 @@ struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
 	const_iterator& operator++()
 	{
 		MYSTL_DEBUG(node != nullptr);
-
-		const node_ptr old = node;
 		node = node->next;
-
-		// һλΪգһ bucket ʼ
-		if (node == nullptr)
-		{ 
-			auto index = ht->hash(value_traits::get_key(old->value));
-			while (!node && ++index < ht->bucket_size_)
-			{
-				node = ht->buckets_[index];
-			}
-		}
 		return *this;
 	}
 
@@ -329,8 +368,9 @@ struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
 };
 
 // local iterator
+// ͬһ bucket Ľڵڣϵһڵ bucket ʱĩβ
 
-template <typename T>
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
 struct ht_local_iterator: public mystl::iterator<mystl::forward_iterator_tag, T>
 {
 	using value_type				= T;
@@ -338,28 +378,33 @@ struct ht_local_iterator: public mystl::iterator<mystl::forward_iterator_tag, T>
 	using reference					= value_type&;
 	using size_type					= size_t;
 	using difference_type			= ptrdiff_t;
-	using node_ptr					= hashtable_node<T>*;
+	using node_type					= hashtable_node<T, ht_cache_hash_code<Hash>::value>;
+	using node_ptr					= node_type*;
+	using hashtable					= mystl::hashtable<T, Hash, KeyEqual, BucketPolicy>;
+	using contain_ptr				= const hashtable*;
 
-	using self						= ht_local_iterator<T>;
-	using local_iterator			= ht_local_iterator<T>;
-	using const_local_iterator		= ht_const_local_iterator<T>;
+	using self						= ht_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using local_iterator			= ht_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using const_local_iterator		= ht_const_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
 
 	node_ptr node;
+	size_type bucket;		// ڵ bucket
+	contain_ptr ht;
 
-	ht_local_iterator(node_ptr n)
-		:node{ n }
+	ht_local_iterator(node_ptr n, size_type b, contain_ptr t)
+		:node{ n }, bucket{ b }, ht{ t }
 	{
 
 	}
 
 	ht_local_iterator(const local_iterator& rhs)
-		:node{ rhs.node }
+		:node{ rhs.node }, bucket{ rhs.bucket }, ht{ rhs.ht }
 	{
 
 	}
 
 	ht_local_iterator(const const_local_iterator& rhs)
-		:node{ rhs.node }
+		:node{ rhs.node }, bucket{ rhs.bucket }, ht{ rhs.ht }
 	{
 
 	}
@@ -371,6 +416,8 @@ struct ht_local_iterator: public mystl::iterator<mystl::forward_iterator_tag, T>
 	{
 		MYSTL_DEBUG(node != nullptr);
 		node = node->next;
+		if (node && ht->node_bucket(node) != bucket)
+			node = nullptr;
 		return *this;
 	}
 
@@ -386,7 +433,7 @@ struct ht_local_iterator: public mystl::iterator<mystl::forward_iterator_tag, T>
 };
 
 
-template <typename T>
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
 struct ht_const_local_iterator :public mystl::iterator<mystl::forward_iterator_tag, T>
 {
 	using value_type				= T;
@@ -394,24 +441,29 @@ struct ht_const_local_iterator :public mystl::iterator<mystl::forward_iterator_t
 	using reference					= const value_type&;
 	using size_type					= size_t;
 	using difference_type			= ptrdiff_t;
-	using node_ptr					= const hashtable_node<T>*;
+	using node_type					= hashtable_node<T, ht_cache_hash_code<Hash>::value>;
+	using node_ptr					= const node_type*;
+	using hashtable					= mystl::hashtable<T, Hash, KeyEqual, BucketPolicy>;
+	using contain_ptr				= const hashtable*;
 
-	using self						= ht_const_local_iterator<T>;
-	using local_iterator			= ht_local_iterator<T>;
-	using const_local_iterator		= ht_const_local_iterator<T>;
+	using self						= ht_const_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using local_iterator			= ht_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using const_local_iterator		= ht_const_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
 
 	node_ptr node;
+	size_type bucket;		// ڵ bucket
+	contain_ptr ht;
 
-	ht_const_local_iterator(node_ptr n)
-		:node{ n }
+	ht_const_local_iterator(node_ptr n, size_type b, contain_ptr t)
+		:node{ n }, bucket{ b }, ht{ t }
 	{
 	}
 	ht_const_local_iterator(const local_iterator& rhs)
-		:node{ rhs.node }
+		:node{ rhs.node }, bucket{ rhs.bucket }, ht{ rhs.ht }
 	{
 	}
 	ht_const_local_iterator(const const_local_iterator& rhs)
-		:node{ rhs.node }
+		:node{ rhs.node }, bucket{ rhs.bucket }, ht{ rhs.ht }
 	{
 	}
 
@@ -422,6 +474,8 @@ struct ht_const_local_iterator :public mystl::iterator<mystl::forward_iterator_t
 	{
 		MYSTL_DEBUG(node != nullptr);
 		node = node->next;
+		if (node && ht->node_bucket(node) != bucket)
+			node = nullptr;
 		return *this;
 	}
 
@@ -510,13 +564,82 @@ inline size_t ht_next_prime(size_t n)
 	return pos == last ? *(last - 1) : *pos;
 }
 
+// ɢϣֵԻƽָѸ߰벿۵Ͱ벿֣ʹλȫλ
+// mystl::hash ָǺӳ䣬ֻȡλ֮ǰȴɢ
+inline size_t ht_hash_mix(size_t h) noexcept
+{
+	constexpr size_t multiplier = sizeof(size_t) == 8
+		? static_cast<size_t>(0x9E3779B97F4A7C15ull) : static_cast<size_t>(0x9E3779B9u);
+	h *= multiplier;
+	return h ^ (h >> (sizeof(size_t) * 4));
+}
+
+// bucket ԣ bucket ĸԼϣֵ bucket ӳ䣬Ϊ hashtable ĵĸģ
+// ɸֱѡ
+//   next_size(n) : С n  bucket 
+//   max_size()   : bucket 
+//   index(h, n)  : ϣֵ h  n  bucket еλ
+
+// ht_prime_policy : bucket ȡȡģõλãֱʹùϣֵȱʡʹֲ
+struct ht_prime_policy
+{
+	static size_t next_size(size_t n) noexcept
+	{
+		return ht_next_prime(n);
+	}
+	static size_t max_size() noexcept
+	{
+		return ht_prime_list[PRIME_NUM - 1];
+	}
+	static size_t index(size_t h, size_t n) noexcept
+	{
+		return h % n;
+	}
+};
+
+// ht_pow2_policy : bucket ȡ 2 ݣɢϣֵõλãʱûг
+struct ht_pow2_policy
+{
+	static size_t next_size(size_t n) noexcept
+	{
+		size_t size = 16;
+		while (size < n && size < max_size())
+			size <<= 1;
+		return size;
+	}
+	static size_t max_size() noexcept
+	{
+		return static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+	}
+	static size_t index(size_t h, size_t n) noexcept
+	{
+		return ht_hash_mix(h) & (n - 1);
+	}
+};
+
+// hashtable ڴֲͳƣ hashtable::stats() 
+struct hashtable_stats
+{
+	size_t size;				// Ԫظ
+	size_t bucket_count;		// bucket 
+	size_t used_buckets;		// ǿյ bucket 
+	size_t max_bucket_size;		//  bucket еԪظ
+	size_t bucket_bytes;		// bucket ռõֽʽ rehash δͷŵľ
+	size_t node_bytes;			// ڵռõֽĶ⿪
+};
+
 // ģ hashtable
-// һͣϣֵȵıȽϺ
-template <typename T, typename Hash, typename KeyEqual>
+// һͣϣֵȵıȽϺĴ bucket 
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
 class hashtable
 {
-	friend struct mystl::ht_iterator<T, Hash, KeyEqual>;
-	friend struct mystl::ht_const_iterator<T, Hash, KeyEqual>;
+	friend struct mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	friend struct mystl::ht_const_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	friend struct mystl::ht_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	friend struct mystl::ht_const_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	// ڵҪٽڵ㣬merge Ҫһ hashtable ժ½ڵ
+	friend class mystl::node_handle<hashtable>;
+	template <typename, typename, typename, typename> friend class hashtable;
 
 public:
 	// hashtable ͱ
@@ -527,9 +650,14 @@ public:
 	using hasher					= Hash;
 	using key_equal					= KeyEqual;
 
-	using node_type					= hashtable_node<T>;
+	// ڵǷ񱣴ϣֵ ht_cache_hash_code
+	static constexpr bool cache_hash = ht_cache_hash_code<Hash>::value;
+	using cache_tag					= m_bool_constant<cache_hash>;
+
+	using node_type					= hashtable_node<T, cache_hash>;
 	using node_ptr					= node_type*;
-	using bucket_type				= mystl::vector<node_ptr>;
+	using link_type					= node_ptr*;
+	using bucket_type				= mystl::vector<link_type>;
 
 	using allocator_type			= mystl::allocator<T>;
 	using data_allocator			= mystl::allocator<T>;
@@ -542,21 +670,37 @@ public:
 	using size_type					= allocator_type::size_type;
 	using difference_type			= allocator_type::difference_type;
 
-	using iterator					= mystl::ht_iterator<T, Hash, KeyEqual>;
-	using const_iterator			= mystl::ht_const_iterator<T, Hash, KeyEqual>;
-	using local_iterator			= mystl::ht_local_iterator<T>;
-	using const_local_iterator		= mystl::ht_const_local_iterator<T>;
+	using iterator					= mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using const_iterator			= mystl::ht_const_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using local_iterator			= mystl::ht_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+	using const_local_iterator		= mystl::ht_const_local_iterator<T, Hash, KeyEqual, BucketPolicy>;
+
+	using node_handle_type			= mystl::node_handle<hashtable>;
+	using insert_return_type		= mystl::node_insert_return<iterator, node_handle_type>;
 
 	allocator_type get_allocator() const { return allocator_type(); }
 private:
-	//  hashtable
+	// ߸ hashtable
 	bucket_type buckets_;
+	node_ptr    head_ = nullptr;	// ĵһڵ
 	size_type   bucket_size_;
 	size_type   size_;
 	float       mlf_;
 	hasher      hash_;
 	key_equal   equal_;
 
+	// Сӣ0 ʾԶС
+	float       min_lf_ = 0.0f;
+
+	// ʽ rehash ״̬old_size_ Ϊ 0 ʾûڽеǨ
+	bucket_type old_buckets_;
+	size_type   old_size_ = 0;
+	size_type   rehash_index_ = 0;
+	bool        incremental_ = false;
+
+	// ʽ rehash ʱÿβǨƵķǿ bucket 
+	static constexpr size_type rehash_step_buckets = 4;
+
 private:
 	bool is_equal(const key_type& key1, const key_type& key2)
 	{
@@ -573,27 +717,6 @@ private:
 		return const_iterator(node, const_cast<hashtable*>(this));
 	}
 
-	iterator M_begin() noexcept
-	{
-		for (size_type n = 0; n < bucket_size_; ++n)
-		{
-			// ҵһнڵλþͷ
-			if (buckets_[n])
-				return iterator(buckets_[n], this);
-		}
-		return iterator(nullptr, this);
-	}
-
-	const_iterator M_begin() const noexcept
-	{
-		for (size_type n = 0; n < bucket_size_; ++n)
-		{
-			if (buckets_[n])
-				return M_cit(buckets_[n]);
-		}
-		return M_cit(nullptr);
-	}
-
 public:
 	explicit hashtable(size_type bucket_count,
 		const Hash& hash = Hash(),
@@ -619,13 +742,19 @@ public:
 	}
 
 	hashtable(hashtable&& rhs) noexcept
-		:bucket_size_{ rhs.bucket_size_ }, size_{ rhs.size_ },
-		mlf_{ rhs.mlf_ }, hash_{ rhs.hash_ }, equal_{ rhs.equal_ }
+		:head_{ rhs.head_ }, bucket_size_{ rhs.bucket_size_ }, size_{ rhs.size_ },
+		mlf_{ rhs.mlf_ }, hash_{ rhs.hash_ }, equal_{ rhs.equal_ }, min_lf_{ rhs.min_lf_ },
+		old_size_{ rhs.old_size_ }, rehash_index_{ rhs.rehash_index_ }, incremental_{ rhs.incremental_ }
 	{
 		buckets_ = mystl::move(rhs.buckets_);
+		old_buckets_ = mystl::move(rhs.old_buckets_);
+		update_begin_bucket();
+		rhs.head_ = nullptr;
 		rhs.bucket_size_ = 0;
 		rhs.size_ = 0;
 		rhs.mlf_ = 0.0f;
+		rhs.old_size_ = 0;
+		rhs.rehash_index_ = 0;
 	}
 
 	hashtable& operator=(const hashtable& rhs)
@@ -652,12 +781,12 @@ public:
 
 	iterator begin() noexcept
 	{
-		return M_begin();
+		return iterator(head_, this);
 	}
 
 	const_iterator begin() const noexcept
 	{
-		return M_begin();
+		return M_cit(head_);
 	}
 
 	iterator end() noexcept
@@ -698,8 +827,7 @@ public:
 
 		try
 		{
-			if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-				rehash(size_ + 1);
+			rehash_if_need(1);
 		}
 		catch (const std::exception&)
 		{
@@ -717,15 +845,18 @@ public:
 		auto np = create_node(mystl::forward<Args>(args)...);
 		try
 		{
-			if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-				rehash(size_ + 1);
+			rehash_if_need(1);
 		}
 		catch (const std::exception&)
 		{
 			destroy_node(np);
 			throw;
 		}
-		return insert_node_unique(np);
+		auto res = insert_node_unique(np);
+		// ֵѴڣ½ڵûв
+		if (!res.second)
+			destroy_node(np);
+		return res;
 	}
 
 	// [note]: hint  hash_table ʵû壬Ϊʹṩ hintҲҪһ hash
@@ -746,25 +877,18 @@ public:
 	// ڲҪؽ²½ڵ㣬ֵظ
 	iterator insert_multi_noresize(const value_type& value)
 	{
-		const auto n = hash(value_traits::get_key(value));
+		const auto code = hash_(value_traits::get_key(value));
+		const auto slot = slot_of(code);
 
-		auto first = buckets_[n];
+		auto link = find_link(slot, code, value_traits::get_key(value));
 		auto tmp = create_node(value);
+		set_code(tmp, code, cache_tag());
 
-		for (auto cur = first; cur; cur = cur->next)
-		{
-			// дֵͬĽڵϲ룬Ȼ󷵻
-			if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
-			{
-				tmp->next = cur->next;
-				cur->next = tmp;
-				++size_;
-				return iterator(tmp, this);
-			}
-		}
-		// ͷ
-		tmp->next = first;
-		buckets_[n] = tmp;
+		// ֵͬĽڵͲ֮󣬷 bucket ͷ
+		if (link)
+			link_after(slot, *link, tmp);
+		else
+			link_bucket_begin(slot, tmp);
 		++size_;
 		return iterator(tmp, this);
 	}
@@ -772,17 +896,15 @@ public:
 	// ڲҪؽ²½ڵ㣬ֵظ
 	pair<iterator, bool> insert_unique_noresize(const value_type& value)
 	{
-		const auto n = hash(value_traits::get_key(value));
-		auto first = buckets_[n];
-		for (auto cur = first; cur; cur = cur->next)
-		{
-			if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
-				return mystl::make_pair(iterator(cur, this), false);
-		}
-		// ½ڵΪĵһڵ
+		const auto code = hash_(value_traits::get_key(value));
+		const auto slot = slot_of(code);
+		auto link = find_link(slot, code, value_traits::get_key(value));
+		if (link)
+			return mystl::make_pair(iterator(*link, this), false);
+		// ½ڵΪ bucket ĵһڵ
 		auto tmp = create_node(value);
-		tmp->next = first;
-		buckets_[n] = tmp;
+		set_code(tmp, code, cache_tag());
+		link_bucket_begin(slot, tmp);
 		++size_;
 		return mystl::make_pair(iterator(tmp, this), true);
 	}
@@ -847,40 +969,9 @@ public:
 
 	void erase(const_iterator position)
 	{
-		auto p = position.node;
-		if (p)
-		{
-			const auto n = hash(value_traits::get_key(p->value));
-
-			auto cur = buckets_[n];
-
-			// p λͷ
-			if (cur == p)
-			{
-				buckets_[n] = cur->next;
-				destroy_node(cur);
-				--size_;
-			}
-			else
-			{
-				auto next = cur->next;
-				while (next)
-				{
-					if (next == p)
-					{
-						cur->next = next->next;
-						destroy_node(next);
-						--size_;
-						break;
-					}
-					else
-					{
-						cur = next;
-						next = cur->next;
-					}
-				}
-			}
-		}
+		auto p = const_cast<node_ptr>(position.node);
+		if (p && unlink_node(p))
+			destroy_node(p);
 	}
 
 	// ɾ[first, last)ڵĽڵ
@@ -889,32 +980,15 @@ public:
 		if (first.node == last.node)
 			return;
 
-		auto first_bucket = first.node
-			? hash(value_traits::get_key(first.node->value))
-			: bucket_size_;
-		auto last_bucket = last.node
-			? hash(value_traits::get_key(last.node->value))
-			: bucket_size_;
-
-		//  bucket ͬһλ
-		if (first_bucket == last_bucket)
-		{
-			erase_bucket(first_bucket, first.node, last.node);
-		}
-		else
+		// ڵĽڵժ link ָĽڵֱ last
+		auto link = find_link(first.node);
+		if (link == nullptr)
+			return;
+		while (*link != last.node)
 		{
-			erase_bucket(first_bucket, first.node, nullptr);
-			for (auto n = first_bucket + 1; n < last_bucket; ++n)
-			{
-				if (buckets_[n] != nullptr)
-				{
-					erase_bucket(n, nullptr);
-				}
-			}
-			if (last_bucket != bucket_size_)
-			{
-				erase_bucket(last_bucket, last.node);
-			}
+			auto p = *link;
+			unlink(node_slot(p), link, p);
+			destroy_node(p);
 		}
 	}
 
@@ -923,8 +997,9 @@ public:
 		auto p = equal_range_multi(key);
 		if (p.first.node != nullptr)
 		{
+			const auto n = mystl::distance(p.first, p.second);
 			erase(p.first, p.second);
-			return mystl::distance(p.first, p.second);
+			return n;
 		}
 		return 0;
 
@@ -932,54 +1007,118 @@ public:
 
 	size_type erase_unique(const key_type& key)
 	{
-		const auto n = hash(key);
-		auto first = buckets_[n];
-		if (first)
+		const auto code = hash_(key);
+		const auto slot = slot_of(code);
+		auto link = find_link(slot, code, key);
+		if (link == nullptr)
+			return 0;
+		auto p = *link;
+		unlink(slot, link, p);
+		destroy_node(p);
+		return 1;
+	}
+
+	//  hashtable
+	void clear()
+	{
+		if (size_ != 0)
+		{
+			for (auto cur = head_; cur;)
+			{
+				node_ptr next = cur->next;
+				destroy_node(cur);
+				cur = next;
+			}
+			head_ = nullptr;
+			mystl::fill(buckets_.begin(), buckets_.end(), nullptr);
+			size_ = 0;
+		}
+		release_old_buckets();
+	}
+
+	//  hashtable bucket 黹ԭΪСĸͷڴ
+	void clear_and_release()
+	{
+		clear();
+		replace_bucket(next_size(0));
+	}
+
+	// node handle
+	// ڵ hashtable ֮תʱֻ޸ӣ·ڵ㣬ҲƻƶԪ
+
+	// ժ position Ľڵ㣬ڵ
+	node_handle_type extract(const_iterator position)
+	{
+		auto p = const_cast<node_ptr>(position.node);
+		if (p && unlink_node(p))
+			return node_handle_type(p);
+		return node_handle_type();
+	}
+
+	// ժһֵ key Ľڵ㣬ʱؿյľ
+	node_handle_type extract(const key_type& key)
+	{
+		auto it = find(key);
+		return it.node == nullptr ? node_handle_type() : extract(it);
+	}
+
+	// еĽڵ㣬ֵظʧʱڵɷֵеľ
+	insert_return_type insert_unique(node_handle_type&& nh)
+	{
+		if (nh.empty())
+			return insert_return_type{ end(), false, node_handle_type() };
+		rehash_if_need(1);
+		auto res = insert_node_unique(nh.get());
+		if (!res.second)
+			return insert_return_type{ res.first, false, mystl::move(nh) };
+		nh.release();
+		return insert_return_type{ res.first, true, node_handle_type() };
+	}
+
+	// еĽڵ㣬ֵظΪʱ end()
+	iterator insert_multi(node_handle_type&& nh)
+	{
+		if (nh.empty())
+			return end();
+		rehash_if_need(1);
+		return insert_node_multi(nh.release());
+	}
+
+	//  source мֵڱвڵĽڵƵڵ source 
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge_unique(hashtable<T, Hash2, KeyEqual2, BucketPolicy2>& source)
+	{
+		if (static_cast<void*>(&source) == static_cast<void*>(this))
+			return;
+		auto link = &source.head_;
+		while (*link)
 		{
-			if (is_equal(value_traits::get_key(first->value), key))
+			auto cur = *link;
+			if (find(value_traits::get_key(cur->value)).node == nullptr)
 			{
-				buckets_[n] = first->next;
-				destroy_node(first);
-				--size_;
-				return 1;
+				source.unlink(source.node_slot(cur), link, cur);
+				rehash_if_need(1);
+				insert_node_unique(cur);
 			}
 			else
 			{
-				auto next = first->next;
-				while (next)
-				{
-					if (is_equal(value_traits::get_key(next->value), key))
-					{
-						first->next = next->next;
-						destroy_node(next);
-						--size_;
-						return 1;
-					}
-					first = next;
-					next = first->next;
-				}
+				link = &cur->next;
 			}
 		}
-		return 0;
 	}
 
-	//  hashtable
-	void clear()
+	//  source еȫڵƵ
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge_multi(hashtable<T, Hash2, KeyEqual2, BucketPolicy2>& source)
 	{
-		if (size_ != 0)
+		if (static_cast<void*>(&source) == static_cast<void*>(this))
+			return;
+		rehash_if_need(source.size_);
+		while (source.head_)
 		{
-			for (size_type i = 0; i < bucket_size_; i++)
-			{
-				node_ptr cur = buckets_[i];
-				while (cur)
-				{
-					node_ptr next = cur->next;
-					destroy_node(cur);
-					cur = next;
-				}
-				buckets_[i] = nullptr;
-			}
-			size_ = 0;
+			auto cur = source.head_;
+			source.unlink(source.node_slot(cur), &source.head_, cur);
+			insert_node_multi(cur);
 		}
 	}
 
@@ -988,11 +1127,19 @@ public:
 		if (this != &rhs)
 		{
 			buckets_.swap(rhs.buckets_);
+			mystl::swap(head_, rhs.head_);
 			mystl::swap(bucket_size_, rhs.bucket_size_);
 			mystl::swap(size_, rhs.size_);
 			mystl::swap(mlf_, rhs.mlf_);
 			mystl::swap(hash_, rhs.hash_);
 			mystl::swap(equal_, rhs.equal_);
+			mystl::swap(min_lf_, rhs.min_lf_);
+			old_buckets_.swap(rhs.old_buckets_);
+			mystl::swap(old_size_, rhs.old_size_);
+			mystl::swap(rehash_index_, rhs.rehash_index_);
+			mystl::swap(incremental_, rhs.incremental_);
+			update_begin_bucket();
+			rhs.update_begin_bucket();
 		}
 	}
 
@@ -1000,11 +1147,13 @@ public:
 
 	size_type count(const key_type& key) const
 	{
-		const auto n = hash(key);
+		const auto code = hash_(key);
+		auto link = find_link(slot_of(code), code, key);
 		size_type result = 0;
-		for (node_ptr cur = buckets_[n]; cur; cur = cur->next)
+		if (link)
 		{
-			if (is_equal(value_traits::get_key(cur->value), key))
+			// ֵͬĽڵ
+			for (node_ptr cur = *link; cur && node_equal(cur, code, key); cur = cur->next)
 				++result;
 		}
 		return result;
@@ -1012,156 +1161,108 @@ public:
 
 	iterator find(const key_type& key)
 	{
-		const auto n = hash(key);
-		node_ptr first = buckets_[n];
-
-		//for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-		while (first && !is_equal(value_traits::get_key(first->value), key))
-		{
-			first = first->next;
-		}
-		return iterator(first, this);
+		const auto code = hash_(key);
+		auto link = find_link(slot_of(code), code, key);
+		return iterator(link ? *link : nullptr, this);
 	}
 	const_iterator find(const key_type& key) const
 	{
-		const auto n = hash(key);
-		node_ptr first = buckets_[n];
-
-		while (first && !is_equal(value_traits::get_key(first->value), key))
-		{
-			first = first->next;
-		}
-		return M_cit(first);
+		const auto code = hash_(key);
+		auto link = find_link(slot_of(code), code, key);
+		return M_cit(link ? *link : nullptr);
 	}
 
-	pair<iterator, iterator> equal_range_multi(const key_type& key)
+	//  [first, last) еÿֵΰ find Ľд out
+	// ÿȡһֵȼϣֵԤȡ bucketԤȡ bucket еһڵ㣬ң
+	// һڸֵĻȱʧصһһصȴ[first, last) ᱻ
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
 	{
-		const auto n = hash(key);
-		for (node_ptr first = buckets_[n]; first; first = first->next)
-		{
-			// ȵļֵ
-			if (is_equal(value_traits::get_key(first->value), key))
-			{
-				for (node_ptr second = first->next; second; second = second->next)
-				{
-					if (!is_equal(value_traits::get_key(second->value), key))
-					{
-						return mystl::make_pair(iterator(first, this), iterator(second, this));
-					}
-				}
-
-				// ȣһֵλ
-				for (auto m = n + 1; m < bucket_size_; ++m)
-				{
-					if (buckets_[m]) 
-					{
-						return mystl::make_pair(iterator(first, this), iterator(buckets_[m], this));
-					}
-				}
-
-				return mystl::make_pair(iterator(first, this), end());
-			}
+		batch_find(first, last, [&](node_ptr p) { *out = iterator(p, this); ++out; });
+		return out;
+	}
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		batch_find(first, last, [&](node_ptr p) { *out = M_cit(p); ++out; });
+		return out;
+	}
 
-		}
+	// Ԥȡ key ڵ bucket֮󲻾ý key ʱȵ
+	void prefetch(const key_type& key) const
+	{
+		ht_prefetch(slot_of(hash_(key)));
+	}
 
-		return mystl::make_pair(end(), end());
+	pair<iterator, iterator> equal_range_multi(const key_type& key)
+	{
+		const auto code = hash_(key);
+		auto link = find_link(slot_of(code), code, key);
+		if (link == nullptr)
+			return mystl::make_pair(end(), end());
+		node_ptr last = (*link)->next;
+		while (last && node_equal(last, code, key))
+			last = last->next;
+		return mystl::make_pair(iterator(*link, this), iterator(last, this));
 	}
 
 	pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const
 	{
-		const auto n = hash(key);
-		for (node_ptr first = buckets_[n]; first; first = first->next)
-		{
-			if (is_equal(value_traits::get_key(first->value), key))
-			{
-				for (node_ptr second = first->next; second; second = second->next)
-				{
-					if (!is_equal(value_traits::get_key(second->value), key))
-						return mystl::make_pair(M_cit(first), M_cit(second));
-				}
-
-				// ȣһֵλ
-				for (auto m = n + 1; m < bucket_size_; ++m)
-				{ 
-					if (buckets_[m])
-						return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
-				}
-				return mystl::make_pair(M_cit(first), cend());
-			}
-		}
-		return mystl::make_pair(cend(), cend());
+		const auto code = hash_(key);
+		auto link = find_link(slot_of(code), code, key);
+		if (link == nullptr)
+			return mystl::make_pair(cend(), cend());
+		node_ptr last = (*link)->next;
+		while (last && node_equal(last, code, key))
+			last = last->next;
+		return mystl::make_pair(M_cit(*link), M_cit(last));
 	}
 
 	pair<iterator, iterator> equal_range_unique(const key_type& key)
 	{
-		const auto n = hash(key);
-		for (node_ptr first = buckets_[n]; first; first = first->next)
-		{
-			if (is_equal(value_traits::get_key(first->value), key))
-			{
-				if (first->next)
-					return mystl::make_pair(iterator(first, this), iterator(first->next, this));
-				for (auto m = n + 1; m < bucket_size_; ++m)
-				{ // ȣһֵλ
-					if (buckets_[m])
-						return mystl::make_pair(iterator(first, this), iterator(buckets_[m], this));
-				}
-				return mystl::make_pair(iterator(first, this), end());
-			}
-		}
-		return mystl::make_pair(end(), end());
+		auto it = find(key);
+		return mystl::make_pair(it, it.node ? iterator(it.node->next, this) : it);
 	}
 	pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
 	{
-		const auto n = hash(key);
-		for (node_ptr first = buckets_[n]; first; first = first->next)
-		{
-			if (is_equal(value_traits::get_key(first->value), key))
-			{
-				if (first->next)
-					return mystl::make_pair(M_cit(first), M_cit(first->next));
-				for (auto m = n + 1; m < bucket_size_; ++m)
-				{ // ȣһֵλ
-					if (buckets_[m])
-						return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
-				}
-				return mystl::make_pair(M_cit(first), cend());
-			}
-		}
-		return mystl::make_pair(cend(), cend());
+		auto it = find(key);
+		return mystl::make_pair(it, it.node ? M_cit(it.node->next) : it);
 	}
 
 	// bucket interface
-	local_iterator begin(size_type n) noexcept
+	// Ǩ; bucket  bucket ֮ǰǨƣⲻıеԪأ޸ıĽṹ
+	// Ǩƿܵùϣ׳쳣const 汾Ҳ޸ıǨ;в
+	local_iterator begin(size_type n)
 	{
-		MYSTL_DEBUG(n < size_);
-		return buckets_[n];
+		MYSTL_DEBUG(n < bucket_size_);
+		finish_rehash();
+		return local_iterator(bucket_begin(n), n, this);
 	}
-	const_local_iterator begin(size_type n) const noexcept
+	const_local_iterator begin(size_type n) const
 	{
-		MYSTL_DEBUG(n < size_);
-		return buckets_[n];
+		MYSTL_DEBUG(n < bucket_size_);
+		const_cast<hashtable*>(this)->finish_rehash();
+		return const_local_iterator(bucket_begin(n), n, this);
 	}
-	const_local_iterator cbegin(size_type n) const noexcept
+	const_local_iterator cbegin(size_type n) const
 	{
-		MYSTL_DEBUG(n < size_);
-		return buckets_[n];
+		return begin(n);
 	}
 
 	local_iterator end(size_type n) noexcept
 	{
-		MYSTL_DEBUG(n < size_);
-		return nullptr;
+		MYSTL_DEBUG(n < bucket_size_);
+		return local_iterator(nullptr, n, this);
 	}
 	const_local_iterator end(size_type n) const noexcept
 	{
-		MYSTL_DEBUG(n < size_);
-		return nullptr;
+		MYSTL_DEBUG(n < bucket_size_);
+		return const_local_iterator(nullptr, n, this);
 	}
 	const_local_iterator cend(size_type n) const noexcept
 	{
-		MYSTL_DEBUG(n < size_);
-		return nullptr;
+		MYSTL_DEBUG(n < bucket_size_);
+		return const_local_iterator(nullptr, n, this);
 	}
 
 	size_type bucket_count() const noexcept
@@ -1170,13 +1271,13 @@ public:
 	}
 	size_type max_bucket_count() const noexcept
 	{
-		return ht_prime_list[PRIME_NUM - 1];
+		return BucketPolicy::max_size();
 	}
 
-	size_type bucket_size(size_type n) const noexcept
+	size_type bucket_size(size_type n) const
 	{
 		size_type result = 0;
-		for (auto cur = buckets_[n]; cur; cur = cur->next)
+		for (auto it = begin(n); it != end(n); ++it)
 		{
 			++result;
 		}
@@ -1201,13 +1302,42 @@ public:
 	}
 	void max_load_factor(float ml)
 	{
-		THROW_OUT_OF_RANGE_IF(ml != ml || ml < 0, "invalid hash load factor");
+		THROW_OUT_OF_RANGE_IF(ml != ml || ml < 0 || (min_lf_ > 0 && ml <= min_lf_), "invalid hash load factor");
 		mlf_ = ml;
 	}
 
+	// СӣСӣ0 ʾԶС
+	float min_load_factor() const noexcept
+	{
+		return min_lf_;
+	}
+	void min_load_factor(float ml)
+	{
+		THROW_OUT_OF_RANGE_IF(ml != ml || ml < 0 || (ml > 0 && ml >= mlf_), "invalid hash min load factor");
+		min_lf_ = ml;
+	}
+
+	// ʽ rehash أرʱڽеǨ
+	bool incremental_rehash() const noexcept
+	{
+		return incremental_;
+	}
+	void incremental_rehash(bool on)
+	{
+		if (!on)
+			finish_rehash();
+		incremental_ = on;
+	}
+
+	// ǷδɵǨ
+	bool rehashing() const noexcept
+	{
+		return old_size_ != 0;
+	}
+
 	void rehash(size_type count)
 	{
-		auto n = ht_next_prime(count);
+		auto n = next_size(count);
 		if (n > bucket_size_)
 		{
 			replace_bucket(n);
@@ -1227,6 +1357,42 @@ public:
 		rehash(static_cast<size_type>((float)count / max_load_factor() + 0.5f));
 	}
 
+	//  bucket СɵǰԪĸڽеǨ֮
+	void shrink_to_fit()
+	{
+		finish_rehash();
+		const auto n = next_size(mlf_ > 0
+			? static_cast<size_type>((float)size_ / mlf_ + 0.5f) : size_);
+		if (n < bucket_size_)
+			replace_bucket(n);
+	}
+
+	// ͳ bucket ʹռõڴ棬Ҫȫڵ
+	hashtable_stats stats() const
+	{
+		hashtable_stats s{};
+		s.size = size_;
+		s.bucket_count = bucket_size_;
+		s.bucket_bytes = (buckets_.capacity() + old_buckets_.capacity()) * sizeof(link_type);
+		s.node_bytes = size_ * sizeof(node_type);
+		// ͬһ bucket Ľڵ
+		const link_type* prev = nullptr;
+		size_type run = 0;
+		for (auto cur = head_; cur; cur = cur->next)
+		{
+			const auto slot = node_slot(cur);
+			if (slot != prev)
+			{
+				++s.used_buckets;
+				prev = slot;
+				run = 0;
+			}
+			if (++run > s.max_bucket_size)
+				s.max_bucket_size = run;
+		}
+		return s;
+	}
+
 	hasher hash_fcn() const { return hash_; }
 	key_equal key_eq() const { return equal_; }
 private:
@@ -1252,37 +1418,40 @@ private:
 	void copy_init(const hashtable& ht)
 	{
 		bucket_size_ = 0;
+		size_ = 0;
 		buckets_.reserve(ht.bucket_size_);
 		buckets_.assign(ht.bucket_size_, nullptr);
+		bucket_size_ = ht.bucket_size_;
+		mlf_ = ht.mlf_;
+		min_lf_ = ht.min_lf_;
+		incremental_ = ht.incremental_;
 
 		try
 		{
-			for (size_type i = 0; i < ht.bucket_size_; i++)
+			if (ht.old_size_ != 0)
 			{
-				node_ptr cur = ht.buckets_[i];
-
-				// ĳ bucket 
-				if (cur)
-				{
-					auto copy = create_node(cur->value);
-					buckets_[i] = copy;
-
-					for (auto next = cur->next = 0; next; next = cur->next)
-					{
-						copy->next = create_node(next->value);
-						copy = copy->next;
-					}
-					copy->next = nullptr;
-				}
+				// ht Ǩʱ¾飬뵽
+				for (auto cur = ht.head_; cur; cur = cur->next)
+					insert_node_multi(clone_node(cur));
+				return;
+			}
+			// ԭ˳ÿ bucket ָһڵǰһ
+			link_type tail = &head_;
+			for (auto cur = ht.head_; cur; cur = cur->next)
+			{
+				auto copy = clone_node(cur);
+				*tail = copy;
+				++size_;
+				const auto n = node_bucket(copy);
+				if (buckets_[n] == nullptr)
+					buckets_[n] = tail;
+				tail = &copy->next;
 			}
-
-			bucket_size_ = ht.bucket_size_;
-			mlf_ = ht.mlf_;
-			size_ = ht.size_;
 		}
 		catch (const std::exception&)
 		{
 			clear();
+			throw;
 		}
 	}
 
@@ -1303,7 +1472,24 @@ private:
 		}
 		return tmp;
 	}
-	void destroy_node(node_ptr node)
+	// ƽڵԪ뱣Ĺϣֵ
+	node_ptr clone_node(const node_type* p)
+	{
+		auto tmp = create_node(p->value);
+		copy_code(tmp, p, cache_tag());
+		return tmp;
+	}
+
+	static void copy_code(node_ptr dst, const node_type* src, m_true_type) noexcept
+	{
+		dst->hash_code = src->hash_code;
+	}
+
+	static void copy_code(node_ptr, const node_type*, m_false_type) noexcept
+	{
+	}
+
+	static void destroy_node(node_ptr node)
 	{
 		data_allocator::destroy(mystl::address_of(node->value));
 		node_allocator::deallocate(node);
@@ -1313,23 +1499,116 @@ private:
 	// hash
 	size_type next_size(size_type n) const
 	{
-		return ht_next_prime(n);
+		return BucketPolicy::next_size(n);
 	}
 
-	size_type hash(const key_type& key, size_type n) const
+	size_type hash(const key_type& key) const
 	{
-		return hash_(key) % n;
+		return BucketPolicy::index(hash_(key), bucket_size_);
 	}
 
-	size_type hash(const key_type& key) const
+	// ڵڵ bucket˹ϣֵĽڵ㲻ٵùϣ
+	size_type node_bucket(const node_type* p, size_type n) const
+	{
+		return BucketPolicy::index(node_code(p, cache_tag()), n);
+	}
+
+	size_type node_bucket(const node_type* p) const
+	{
+		return node_bucket(p, bucket_size_);
+	}
+
+	// ϣֵΪ code Ľڵڵ bucketǨʱδǨƵ bucket ھ
+	const link_type* slot_of(size_type code) const
+	{
+		if (old_size_ != 0)
+		{
+			const auto i = BucketPolicy::index(code, old_size_);
+			if (i >= rehash_index_)
+				return &old_buckets_[i];
+		}
+		return &buckets_[BucketPolicy::index(code, bucket_size_)];
+	}
+
+	link_type* slot_of(size_type code)
+	{
+		return const_cast<link_type*>(static_cast<const hashtable*>(this)->slot_of(code));
+	}
+
+	const link_type* node_slot(const node_type* p) const
+	{
+		return slot_of(node_code(p, cache_tag()));
+	}
+
+	link_type* node_slot(const node_type* p)
+	{
+		return slot_of(node_code(p, cache_tag()));
+	}
+
+	size_type node_code(const node_type* p, m_true_type) const noexcept
+	{
+		return p->hash_code;
+	}
+
+	size_type node_code(const node_type* p, m_false_type) const
+	{
+		return hash_(value_traits::get_key(p->value));
+	}
+
+	static void set_code(node_ptr p, size_type code, m_true_type) noexcept
+	{
+		p->hash_code = code;
+	}
+
+	static void set_code(node_ptr, size_type, m_false_type) noexcept
+	{
+	}
+
+	// ڵļֵǷ keycode Ϊ key Ĺϣֵڵ㱣˹ϣֵʱȱȽϹϣֵ
+	bool node_equal(const node_type* p, size_type code, const key_type& key) const
+	{
+		return code_equal(p, code, cache_tag()) && is_equal(value_traits::get_key(p->value), key);
+	}
+
+	static bool code_equal(const node_type* p, size_type code, m_true_type) noexcept
+	{
+		return p->hash_code == code;
+	}
+
+	static bool code_equal(const node_type*, size_type, m_false_type) noexcept
 	{
-		return hash_(key) % bucket_size_;
+		return true;
 	}
 
+	// ʽ rehash ʱ봥СֻʼǨƣһ
 	void rehash_if_need(size_type n)
 	{
+		if (old_size_ != 0)
+			rehash_step(rehash_step_buckets);
 		if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
-			rehash(size_ + n);
+		{
+			if (incremental_ && n == 1)
+				start_rehash(next_size(size_ + n));
+			else
+				rehash(size_ + n);
+		}
+		else if (static_cast<float>(size_ + n) < (float)bucket_size_ * min_lf_)
+		{
+			shrink_if_need(size_ + n, incremental_ && n == 1);
+		}
+	}
+
+	// ԪظΪ count ʱС bucket 飬ʹӻصСӵм丽
+	// С󲻻һҪҲͲᷴС
+	void shrink_if_need(size_type count, bool incremental)
+	{
+		const auto n = next_size(static_cast<size_type>((float)count / ((min_lf_ + mlf_) * 0.5f)) + 1);
+		if (n >= bucket_size_)
+			return;
+		if (incremental)
+			start_rehash(n);
+		else
+			replace_bucket(n);
 	}
 
 	// insert
@@ -1370,140 +1649,289 @@ private:
 	// insert node
 	pair<iterator, bool> insert_node_unique(node_ptr np)
 	{
-		const auto n = hash(value_traits::get_key(np->value));
+		// ڵԹϣͬ¼ϣֵ
+		const auto code = hash_(value_traits::get_key(np->value));
+		const auto slot = slot_of(code);
+		set_code(np, code, cache_tag());
+
+		auto link = find_link(slot, code, value_traits::get_key(np->value));
+		if (link)
+			return mystl::make_pair(iterator(*link, this), false);
+
+		link_bucket_begin(slot, np);
+		++size_;
+		return mystl::make_pair(iterator(np, this), true);
+	}
+
+	iterator insert_node_multi(node_ptr np)
+	{
+		// ڵԹϣͬ¼ϣֵ
+		const auto code = hash_(value_traits::get_key(np->value));
+		const auto slot = slot_of(code);
+		set_code(np, code, cache_tag());
+
+		auto link = find_link(slot, code, value_traits::get_key(np->value));
+		if (link)
+			link_after(slot, *link, np);
+		else
+			link_bucket_begin(slot, np);
+		++size_;
+		return iterator(np, this);
+	}
+
+	// ѽڵӱժ£٣ڵ㲻ڱʱ false
+	bool unlink_node(node_ptr p)
+	{
+		auto link = find_link(p);
+		if (link == nullptr)
+			return false;
+		unlink(node_slot(p), link, p);
+		return true;
+	}
+
+	// link
 
-		auto cur = buckets_[n];
+	//  n  bucket ĵһڵ㣬bucket Ϊʱ nullptr
+	node_ptr bucket_begin(size_type n) const noexcept
+	{
+		return buckets_[n] ? *buckets_[n] : nullptr;
+	}
 
-		if (cur == nullptr)
+	//  slot ָ bucket вҼֵ key ĵһڵ㣬ָӣʱ nullptr
+	link_type find_link(const link_type* slot, size_type code, const key_type& key) const
+	{
+		link_type link = *slot;
+		if (link == nullptr)
+			return nullptr;
+		for (;;)
 		{
-			buckets_[n] = np;
-			++size_;
-			return mystl::make_pair(iterator(np, this), true);
+			node_ptr cur = *link;
+			if (node_equal(cur, code, key))
+				return link;
+			if (cur->next == nullptr || node_slot(cur->next) != slot)
+				return nullptr;
+			link = &cur->next;
 		}
+	}
 
-		for (; cur; cur = cur->next)
+	// find_batch ʵ֣ÿֵҵĽڵ㣨ʱΪ nullptr emit
+	template <class ForwardIter, class Emit>
+	void batch_find(ForwardIter first, ForwardIter last, Emit emit) const
+	{
+		static constexpr size_type group = 16;
+		size_type codes[group];
+		const link_type* slots[group];
+		while (first != last)
 		{
-			if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
+			auto group_first = first;
+			size_type n = 0;
+			for (; n < group && first != last; ++n, ++first)
+			{
+				codes[n] = hash_(*first);
+				slots[n] = slot_of(codes[n]);
+				ht_prefetch(slots[n]);
+			}
+			// bucket еָǰһڵ next  head_ԤȡԤȡ bucket ĵһڵ
+			for (size_type i = 0; i < n; ++i)
 			{
-				return mystl::make_pair(iterator(cur, this), false);
+				if (*slots[i])
+					ht_prefetch(*slots[i]);
+			}
+			for (size_type i = 0; i < n; ++i)
+			{
+				if (*slots[i])
+					ht_prefetch(**slots[i]);
+			}
+			for (size_type i = 0; i < n; ++i, ++group_first)
+			{
+				auto link = find_link(slots[i], codes[i], *group_first);
+				emit(link ? *link : nullptr);
 			}
 		}
-
-		np->next = buckets_[n];
-		buckets_[n] = np;
-		++size_;
-		return mystl::make_pair(iterator(np, this), true);
 	}
 
-	iterator insert_node_multi(node_ptr np)
+	// ָڵ p ӣp ڱʱ nullptr
+	link_type find_link(const node_type* p) const
 	{
-		const auto n = hash(value_traits::get_key(np->value));
+		const auto slot = node_slot(p);
+		link_type link = *slot;
+		if (link == nullptr)
+			return nullptr;
+		for (node_ptr cur = *link; cur != p; cur = *link)
+		{
+			if (cur->next == nullptr || node_slot(cur->next) != slot)
+				return nullptr;
+			link = &cur->next;
+		}
+		return link;
+	}
 
-		auto cur = buckets_[n];
+	//  np Ϊ slot ָ bucket ĵһڵ
+	void link_bucket_begin(link_type* slot, node_ptr np)
+	{
+		if (*slot)
+		{
+			np->next = **slot;
+			**slot = np;
+		}
+		else
+		{
+			// bucket Ϊʱͷԭĵһڵڵ bucket Ϊ np->next 
+			np->next = head_;
+			head_ = np;
+			if (np->next)
+				*node_slot(np->next) = &np->next;
+			*slot = &head_;
+		}
+	}
 
-		if (cur == nullptr)
+	//  np  slot ָ bucket Ľڵ pos ֮
+	void link_after(link_type* slot, node_ptr pos, node_ptr np)
+	{
+		np->next = pos->next;
+		pos->next = np;
+		if (np->next)
 		{
-			buckets_[n] = np;
-			++size_;
-			return iterator(np, this);
+			const auto next_slot = node_slot(np->next);
+			if (next_slot != slot)
+				*next_slot = &np->next;
 		}
+	}
 
-		for (; cur; cur = cur->next)
+	// ժ slot ָ bucket  link ӵĽڵ p
+	void unlink(link_type* slot, link_type link, node_ptr p)
+	{
+		node_ptr next = p->next;
+		const auto next_slot = next ? node_slot(next) : slot;
+		if (next && next_slot != slot)
 		{
-			if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
-			{
-				np->next = cur->next;
-				cur->next = np;
-				++size_;
-				return iterator(np, this);
-			}
+			// һ bucket Ϊ link 
+			*next_slot = link;
+			// p  bucket ΨһĽڵ
+			if (*slot == link)
+				*slot = nullptr;
+		}
+		else if (next == nullptr && *slot == link)
+		{
+			*slot = nullptr;
 		}
+		*link = next;
+		p->next = nullptr;
+		--size_;
+	}
 
-		np->next = buckets_[n];
-		buckets_[n] = np;
-		++size_;
-		return iterator(np, this);
+	// ͷڵڵ bucket ӵ head_ƶ򽻻֮Ҫ
+	void update_begin_bucket()
+	{
+		if (head_)
+			*node_slot(head_) = &head_;
 	}
 
 	// bucket operator
+	// ԭеĽڵӵµ bucket У·ڵ㣬ڵָԪصָ뱣Ч
+	// ڽеǨ֮
 	void replace_bucket(size_type bucket_count)
 	{
 		bucket_type bucket(bucket_count);
 
-		if (size_ != 0)
+		buckets_.swap(bucket);
+		bucket_size_ = bucket_count;
+		release_old_buckets();
+		node_ptr first = head_;
+		head_ = nullptr;
+		while (first)
 		{
-			for (size_type i = 0; i < bucket_size_; ++i)
-			{
-				for (auto first = buckets_[i]; first; first = first->next)
-				{
-					auto tmp = create_node(first->value);
-					const auto n = hash(value_traits::get_key(first->value), bucket_count);
-					auto f = bucket[n];
-					bool is_inserted = false;
-
-					for (auto cur = f; cur; cur = cur->next)
-					{
-						if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value)))
-						{
-							tmp->next = cur->next;
-							cur->next = tmp;
-							is_inserted = true;
-							break;
-						}
-					}
-
-					if (!is_inserted)
-					{
-						tmp->next = f;
-						bucket[n] = tmp;
-					}
-				}
-			}
+			auto next = first->next;
+			relink_node(first);
+			first = next;
 		}
-
-		buckets_.swap(bucket);
-		bucket_size_ = buckets_.size();
 	}
 
-	// ڵ n  bucket ڣɾ [first, last) Ľڵ
-	void erase_bucket(size_type n, node_ptr first, node_ptr last)
+	// ѲϵĽڵӵе bucketֵͬĽڵ㱣
+	void relink_node(node_ptr np)
 	{
-		auto cur = buckets_[n];
-
-		if (cur == first)
-		{
-			erase_bucket(n, last);
-		}
+		const auto code = node_code(np, cache_tag());
+		const auto slot = &buckets_[BucketPolicy::index(code, bucket_size_)];
+		auto link = find_link(slot, code, value_traits::get_key(np->value));
+		if (link)
+			link_after(slot, *link, np);
 		else
-		{
-			node_ptr next = cur->next;
+			link_bucket_begin(slot, np);
+	}
 
-			// ҵҪɾλ
-			for (; next != first; cur = next, next = cur->next)
-			{ }
+	// incremental rehash
 
-			while (next != last)
+	// ʼʽ rehashǰΪ飬 bucket_count  bucket 飬ɴС
+	void start_rehash(size_type bucket_count)
+	{
+		finish_rehash();
+		if (bucket_count == bucket_size_)
+			return;
+		bucket_type bucket(bucket_count);
+		old_buckets_.swap(buckets_);
+		buckets_.swap(bucket);
+		old_size_ = bucket_size_;
+		bucket_size_ = bucket_count;
+		rehash_index_ = 0;
+	}
+
+	// Ǩ count ǿյľ bucketĿ bucket  count * 10 һβʱ
+	void rehash_step(size_type count)
+	{
+		auto empty_visits = count * 10;
+		while (count > 0 && rehash_index_ < old_size_)
+		{
+			if (old_buckets_[rehash_index_] == nullptr)
 			{
-				cur->next = next->next;
-				destroy_node(next);
-				next = cur->next;
-				--size_;
+				++rehash_index_;
+				if (--empty_visits == 0)
+					break;
+				continue;
 			}
+			migrate_bucket();
+			--count;
+		}
+		if (rehash_index_ >= old_size_)
+			release_old_buckets();
+	}
+
+	// һȫǨ
+	void finish_rehash()
+	{
+		while (old_size_ != 0)
+			rehash_step(old_size_);
+	}
+
+	// Ѿе rehash_index_  bucket ĽڵǨƵ
+	void migrate_bucket()
+	{
+		auto old_slot = &old_buckets_[rehash_index_];
+		link_type link = *old_slot;
+		//  bucket Ľڵժ£ƽ rehash_index_
+		// ƶʱƵĽڵᱻΪھ
+		node_ptr first = *link;
+		node_ptr last = first;
+		while (last->next && node_slot(last->next) == old_slot)
+			last = last->next;
+		*link = last->next;
+		if (last->next)
+			*node_slot(last->next) = link;
+		last->next = nullptr;
+		*old_slot = nullptr;
+		++rehash_index_;
+		while (first)
+		{
+			auto next = first->next;
+			relink_node(first);
+			first = next;
 		}
 	}
 
-	// ڵ n  bucket ڣɾ [buckets_[n], last) Ľڵ
-	void erase_bucket(size_type n, node_ptr last)
+	void release_old_buckets() noexcept
 	{
-		auto cur = buckets_[n];
-		while (cur != last)
-		{
-			auto next = cur->next;
-			destroy_node(cur);
-			cur = next;
-			--size_;
-		}
-		buckets_[n] = last;
+		bucket_type().swap(old_buckets_);
+		old_size_ = 0;
+		rehash_index_ = 0;
 	}
 
 	// comparision
@@ -1537,9 +1965,9 @@ private:
 };
 
 //  mystl  swap
-template <typename T, typename Hash, typename KeyEqual>
-void swap(hashtable<T, Hash, KeyEqual>& lhs,
-	hashtable<T, Hash, KeyEqual>& rhs) noexcept
+template <typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+void swap(hashtable<T, Hash, KeyEqual, BucketPolicy>& lhs,
+	hashtable<T, Hash, KeyEqual, BucketPolicy>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
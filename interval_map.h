@@ -0,0 +1,492 @@
+#ifndef MY_STL_INTERVAL_MAP_H_
+#define MY_STL_INTERVAL_MAP_H_
+
+// ͷļģ interval  interval_map
+// interval     : 뿪 [low, high)
+// interval_map : ӳ䣬Ϊֵ֮صְ֧صԪ
+
+// notes:
+//
+// interval_map ĵײ rb_tree_max_augment ΪάԵ rb_tree
+// Ԫذ (low, high) ÿڵ¼Ҷ˵ֵ
+// ת롢ɾʱ rb_tree һάʱĳҶ˵㲻ѯ˵㣬
+// ѯصֱǰڵ˵ѲСڲѯҶ˵㣬
+// Ҳٷʡ
+//
+// find_overlap / find_containing ˵СصԪأӶ O(log n)
+// for_each_overlap Ⱥ˵˳ȫ k صԪأӶΪ O(min(n, k log n))
+// 以صʱֻ insert_coalesce ͬʵֵ䣬 interval_setΪ O(log n + k)
+// ֮ȣ˵Ϊֵ multimap ֻɨ˵СڲѯҶ˵Ԫء
+//
+// 䣨low >= highκصʱԡ
+// ˵ҪƽƣָȣڵбҶ˵һݿ
+
+#include <initializer_list>
+
+#include "functional.h"
+#include "rb_tree.h"
+#include "vector.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 뿪 [low, high)
+template <typename T>
+struct interval
+{
+	using endpoint_type = T;
+
+	T low;
+	T high;
+
+	interval() :low(), high() {}
+	interval(const T& l, const T& h) :low(l), high(h) {}
+
+	bool empty()			const { return !(low < high); }
+	bool contains(const T& x) const { return !(x < low) && x < high; }
+	bool overlaps(const interval& rhs) const { return low < rhs.high && rhs.low < high; }
+};
+
+template <typename T>
+bool operator==(const interval<T>& lhs, const interval<T>& rhs)
+{
+	return lhs.low == rhs.low && lhs.high == rhs.high;
+}
+
+template <typename T>
+bool operator!=(const interval<T>& lhs, const interval<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <typename T>
+bool operator<(const interval<T>& lhs, const interval<T>& rhs)
+{
+	return lhs.low < rhs.low || (!(rhs.low < lhs.low) && lhs.high < rhs.high);
+}
+
+// ıȽϷʽȱȽ˵㣬ٱȽҶ˵㣬 Compare Ϊ˵ıȽϷʽ
+template <typename T, typename Compare>
+struct interval_compare : public binary_function<interval<T>, interval<T>, bool>
+{
+	Compare comp;
+
+	bool operator()(const interval<T>& lhs, const interval<T>& rhs) const
+	{
+		return comp(lhs.low, rhs.low) || (!comp(rhs.low, lhs.low) && comp(lhs.high, rhs.high));
+	}
+};
+
+// ԪȡҶ˵㣬 rb_tree_max_augment ʹ
+template <typename Value>
+struct interval_get_high
+{
+	using key_type = typename rb_tree_value_traits<Value>::key_type;
+
+	const typename key_type::endpoint_type& operator()(const Value& value) const
+	{
+		return rb_tree_value_traits<Value>::get_key(value).high;
+	}
+};
+
+// Ĳѯ
+// ends_after(h)    : Ҷ˵Ϊ h ڰҶ˵֦
+// starts_before(l) : ˵Ϊ l ʱ䶼
+// һǿҽͬʱ
+
+//  [low, high) ص
+template <typename T, typename Compare>
+struct interval_overlap_query
+{
+	const T& low;
+	const T& high;
+	Compare  comp;
+
+	bool ends_after(const T& h)    const { return comp(low, h); }
+	bool starts_before(const T& l) const { return comp(l, high); }
+};
+
+//  point
+template <typename T, typename Compare>
+struct interval_point_query
+{
+	const T& point;
+	Compare  comp;
+
+	bool ends_after(const T& h)    const { return comp(point, h); }
+	bool starts_before(const T& l) const { return !comp(point, l); }
+};
+
+//  [low, high) صڣںϲ
+template <typename T, typename Compare>
+struct interval_touch_query
+{
+	const T& low;
+	const T& high;
+	Compare  comp;
+
+	bool ends_after(const T& h)    const { return !comp(h, low); }
+	bool starts_before(const T& l) const { return !comp(high, l); }
+};
+
+//  x ѯġ˵СĽڵ㣬ʱ nullptrӶ O(log n)
+// дҶ˵䣬ȴû䣬˵ǵ˵㶼Խѯ
+// еҲֻһ·²
+template <typename Tree, typename Query>
+typename Tree::base_ptr interval_tree_first(typename Tree::base_ptr x, const Query& q)
+{
+	using augment = typename Tree::augment_type;
+	while (x != nullptr)
+	{
+		if (x->left != nullptr && q.ends_after(augment::max_high(x->left)))
+		{
+			x = x->left;
+			continue;
+		}
+		const auto& iv = Tree::value_traits::get_key(x->get_node_ptr()->value);
+		if (!q.starts_before(iv.low))
+			return nullptr;
+		if (q.ends_after(iv.high))
+			return x;
+		x = x->right;
+	}
+	return nullptr;
+}
+
+// ˵˳ x ѯÿڵ f(x)
+template <typename Tree, typename Query, typename Func>
+void interval_tree_visit(typename Tree::base_ptr x, const Query& q, Func& f)
+{
+	using augment = typename Tree::augment_type;
+	while (x != nullptr && q.ends_after(augment::max_high(x)))
+	{
+		interval_tree_visit<Tree>(x->left, q, f);
+		const auto& iv = Tree::value_traits::get_key(x->get_node_ptr()->value);
+		if (!q.starts_before(iv.low))
+			return;
+		if (q.ends_after(iv.high))
+			f(x);
+		x = x->right;
+	}
+}
+
+// ģ interval_mapֵΪ䣬صҲظ
+// һ˵ͣʵֵͣ˵ıȽϷʽȱʡʹ mystl::less
+template <typename T, typename V, typename Compare = mystl::less<T>>
+class interval_map
+{
+public:
+	// interval_map Ƕͱ
+	using endpoint_type		= T;
+	using key_type			= interval<T>;
+	using mapped_type		= V;
+	using value_type		= mystl::pair<const interval<T>, V>;
+	using key_compare		= interval_compare<T, Compare>;
+	using endpoint_compare	= Compare;
+
+private:
+	using augment_type = rb_tree_max_augment<value_type, T, interval_get_high<value_type>, Compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare, augment_type>;
+	using base_ptr = typename base_type::base_ptr;
+	base_type tree_;
+
+	using overlap_query		= interval_overlap_query<T, Compare>;
+	using point_query		= interval_point_query<T, Compare>;
+	using touch_query		= interval_touch_query<T, Compare>;
+
+public:
+	// ʹ rb_tree ͱ
+	using pointer					= typename base_type::pointer;
+	using const_pointer				= typename base_type::const_pointer;
+	using reference					= typename base_type::reference;
+	using const_reference			= typename base_type::const_reference;
+	using iterator					= typename base_type::iterator;
+	using const_iterator			= typename base_type::const_iterator;
+	using reverse_iterator			= typename base_type::reverse_iterator;
+	using const_reverse_iterator	= typename base_type::const_reverse_iterator;
+	using size_type					= typename base_type::size_type;
+	using difference_type			= typename base_type::difference_type;
+	using allocator_type			= typename base_type::allocator_type;
+
+public:
+	// 졢ơƶֵ
+
+	interval_map() = default;
+
+	template <typename InputIterator>
+	interval_map(InputIterator first, InputIterator last)
+		:tree_()
+	{
+		insert(first, last);
+	}
+
+	interval_map(std::initializer_list<value_type> ilist)
+		:tree_()
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	interval_map(const interval_map& rhs) : tree_{ rhs.tree_ } {}
+
+	interval_map(interval_map&& rhs) noexcept : tree_{ mystl::move(rhs.tree_) } {}
+
+	interval_map& operator=(const interval_map& rhs)
+	{
+		tree_ = rhs.tree_;
+		return *this;
+	}
+
+	interval_map& operator=(interval_map&& rhs) noexcept
+	{
+		tree_ = mystl::move(rhs.tree_);
+		return *this;
+	}
+
+	interval_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		tree_.clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	// ؽӿ
+
+	key_compare		key_comp()		const { return tree_.key_comp(); }
+	allocator_type	get_allocator()	const { return tree_.get_allocator(); }
+
+	// 
+
+	iterator				begin()			noexcept { return tree_.begin(); }
+	const_iterator			begin()	  const noexcept { return tree_.begin(); }
+	iterator				end()			noexcept { return tree_.end(); }
+	const_iterator			end()	  const noexcept { return tree_.end(); }
+
+	reverse_iterator		rbegin()		noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator	rbegin()  const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator		rend()			noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator	rend()	  const noexcept { return const_reverse_iterator(begin()); }
+
+	const_iterator			cbegin()  const noexcept { return begin(); }
+	const_iterator			cend()	  const noexcept { return end(); }
+	const_reverse_iterator	crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator	crend()	  const noexcept { return rend(); }
+
+	// 
+	bool		empty()		const noexcept { return tree_.empty(); }
+	size_type	size()		const noexcept { return tree_.size(); }
+	size_type	max_size()	const noexcept { return tree_.max_size(); }
+
+	// ɾ
+
+	// һԪأΪʱ룬 end()
+	iterator insert(const value_type& value)
+	{
+		if (!Compare()(value.first.low, value.first.high))
+			return end();
+		return tree_.insert_multi(value);
+	}
+
+	iterator insert(const key_type& iv, const mapped_type& v)
+	{
+		return insert(value_type(iv, v));
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			insert(*first);
+	}
+
+	// ϲ룺 iv صڡʵֵ v Ԫرɾ iv ϲΪһ
+	// ʵֵͬ䱣ֲ䡣غϲԪأΪʱ end()
+	iterator insert_coalesce(const key_type& iv, const mapped_type& v)
+	{
+		Compare comp;
+		if (!comp(iv.low, iv.high))
+			return end();
+		key_type merged(iv);
+		mystl::vector<base_ptr> victims;
+		// ϲԪڣֱ䲻Ϊֹ
+		for (bool grown = true; grown; )
+		{
+			grown = false;
+			victims.clear();
+			auto collect = [&](base_ptr x) {
+				if (x->get_node_ptr()->value.second == v)
+					victims.push_back(x);
+			};
+			interval_tree_visit<base_type>(tree_.root_node(), touch_query{ merged.low, merged.high, comp }, collect);
+			for (auto x : victims)
+			{
+				const key_type& cur = x->get_node_ptr()->value.first;
+				if (comp(cur.low, merged.low))
+				{
+					merged.low = cur.low;
+					grown = true;
+				}
+				if (comp(merged.high, cur.high))
+				{
+					merged.high = cur.high;
+					grown = true;
+				}
+			}
+		}
+		auto it = tree_.insert_multi(value_type(merged, v));
+		for (auto x : victims)
+			tree_.erase(iterator(x));
+		return it;
+	}
+
+	iterator erase(iterator position)
+	{
+		return tree_.erase(position);
+	}
+
+	// ɾ iv ȫԪ
+	size_type erase(const key_type& iv)
+	{
+		return tree_.erase_multi(iv);
+	}
+
+	void erase(iterator first, iterator last)
+	{
+		tree_.erase(first, last);
+	}
+
+	void clear() { tree_.clear(); }
+
+	// 侫ȷ
+
+	iterator		find(const key_type& iv)			{ return tree_.find(iv); }
+	const_iterator	find(const key_type& iv)	const	{ return tree_.find(iv); }
+
+	size_type		count(const key_type& iv)	const	{ return tree_.count_multi(iv); }
+
+	iterator		lower_bound(const key_type& iv)			{ return tree_.lower_bound(iv); }
+	const_iterator	lower_bound(const key_type& iv)	const	{ return tree_.lower_bound(iv); }
+
+	iterator		upper_bound(const key_type& iv)			{ return tree_.upper_bound(iv); }
+	const_iterator	upper_bound(const key_type& iv)	const	{ return tree_.upper_bound(iv); }
+
+	pair<iterator, iterator>
+		equal_range(const key_type& iv)
+	{
+		return tree_.equal_range_multi(iv);
+	}
+
+	pair<const_iterator, const_iterator>
+		equal_range(const key_type& iv) const
+	{
+		return tree_.equal_range_multi(iv);
+	}
+
+	// صѯ
+
+	//  iv صġ˵СԪأʱ end()
+	iterator find_overlap(const key_type& iv)
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }));
+	}
+	const_iterator find_overlap(const key_type& iv) const
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }));
+	}
+
+	//  point ġ˵СԪأʱ end()
+	iterator find_containing(const T& point)
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), point_query{ point, Compare() }));
+	}
+	const_iterator find_containing(const T& point) const
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), point_query{ point, Compare() }));
+	}
+
+	// ˵˳ÿ iv صԪص f(value)
+	template <typename Func>
+	void for_each_overlap(const key_type& iv, Func f)
+	{
+		auto visit = [&](base_ptr x) { f(x->get_node_ptr()->value); };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+	}
+	template <typename Func>
+	void for_each_overlap(const key_type& iv, Func f) const
+	{
+		auto visit = [&](base_ptr x) { f(static_cast<const value_type&>(x->get_node_ptr()->value)); };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+	}
+
+	// ˵˳ÿ point Ԫص f(value)
+	template <typename Func>
+	void for_each_containing(const T& point, Func f)
+	{
+		auto visit = [&](base_ptr x) { f(x->get_node_ptr()->value); };
+		interval_tree_visit<base_type>(tree_.root_node(), point_query{ point, Compare() }, visit);
+	}
+	template <typename Func>
+	void for_each_containing(const T& point, Func f) const
+	{
+		auto visit = [&](base_ptr x) { f(static_cast<const value_type&>(x->get_node_ptr()->value)); };
+		interval_tree_visit<base_type>(tree_.root_node(), point_query{ point, Compare() }, visit);
+	}
+
+	//  iv صԪصĵд result
+	template <typename OutputIterator>
+	OutputIterator overlaps(const key_type& iv, OutputIterator result) const
+	{
+		auto visit = [&](base_ptr x) { *result = const_iterator(x); ++result; };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+		return result;
+	}
+
+	size_type count_overlaps(const key_type& iv) const
+	{
+		size_type n = 0;
+		auto visit = [&](base_ptr) { ++n; };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+		return n;
+	}
+
+	size_type count_containing(const T& point) const
+	{
+		size_type n = 0;
+		auto visit = [&](base_ptr) { ++n; };
+		interval_tree_visit<base_type>(tree_.root_node(), point_query{ point, Compare() }, visit);
+		return n;
+	}
+
+	void swap(interval_map& rhs) noexcept
+	{
+		tree_.swap(rhs.tree_);
+	}
+
+public:
+	friend bool operator==(const interval_map& lhs, const interval_map& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		for (auto it1 = lhs.begin(), it2 = rhs.begin(); it1 != lhs.end(); ++it1, ++it2)
+		{
+			if (!(it1->first == it2->first && it1->second == it2->second))
+				return false;
+		}
+		return true;
+	}
+	friend bool operator!=(const interval_map& lhs, const interval_map& rhs) { return !(lhs == rhs); }
+
+private:
+	iterator make_iter(base_ptr x) { return x == nullptr ? end() : iterator(x); }
+	const_iterator make_iter(base_ptr x) const { return x == nullptr ? end() : const_iterator(x); }
+};
+
+//  mystl  swap
+template <typename T, typename V, typename Compare>
+void swap(interval_map<T, V, Compare>& lhs, interval_map<T, V, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_INTERVAL_MAP_H_
@@ -0,0 +1,258 @@
+#ifndef MY_STL_INTERVAL_MAP_TEST_H_
+#define MY_STL_INTERVAL_MAP_TEST_H_
+
+// interval_map test :  interval_map, interval_set Ľӿصѯ
+
+#include "interval_map.h"
+#include "interval_set.h"
+#include "map.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace interval_map_test
+{
+
+// interval ĺ궨
+#define IV(l, h)    mystl::interval<int>(l, h)
+
+// interval_map ı
+#define INTERVAL_MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto& it : m)    std::cout << " <[" << it.first.low << "," << it.first.high << ")," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// interval_set ı
+#define INTERVAL_SET_COUT(s) do { \
+    std::string s_name = #s; \
+    std::cout << " " << s_name << " :"; \
+    for (auto& it : s)    std::cout << " [" << it.low << "," << it.high << ")"; \
+    std::cout << std::endl; \
+} while(0)
+
+// interval_map ĺ
+#define INTERVAL_MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    INTERVAL_MAP_COUT(con); \
+} while(0)
+
+// interval_set ĺ
+#define INTERVAL_SET_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    INTERVAL_SET_COUT(con); \
+} while(0)
+
+// interval_map ĺֵ
+#define INTERVAL_MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <[" << it.first.low << "," << it.first.high << ")," << it.second << ">\n"; \
+} while(0)
+
+// interval_set ĺֵ
+#define INTERVAL_SET_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : [" << it.low << "," << it.high << ")\n"; \
+} while(0)
+
+//  len  10 صѯ
+// multimap ˵ֻɨ˵СڲѯҶ˵ȫ
+#define INTERVAL_OVERLAP_MULTIMAP_TEST(len) do {                 \
+  srand((int)time(0));                                         \
+  clock_t start, end;                                          \
+  char buf[10];                                                \
+  const int range = static_cast<int>(len) * 4;                 \
+  mystl::multimap<int, int> m;                                 \
+  for (size_t i = 0; i < len; ++i)                             \
+  {                                                            \
+    int l = rand() % range;                                    \
+    m.emplace(l, l + 1 + rand() % 64);                         \
+  }                                                            \
+  volatile size_t hits = 0;                                    \
+  start = clock();                                             \
+  for (int q = 0; q < 10; ++q)                                 \
+  {                                                            \
+    int ql = rand() % range;                                   \
+    int qh = ql + 1 + rand() % 64;                             \
+    for (auto it = m.begin(), last = m.lower_bound(qh);        \
+         it != last; ++it)                                     \
+      if (ql < it->second)  hits = hits + 1;                   \
+  }                                                            \
+  end = clock();                                               \
+  int n = static_cast<int>(static_cast<double>(end - start)    \
+      / CLOCKS_PER_SEC * 1000);                                \
+  std::snprintf(buf, sizeof(buf), "%d", n);                    \
+  std::string t = buf;                                         \
+  t += "ms    |";                                              \
+  std::cout << std::setw(WIDE) << t;                           \
+} while(0)
+
+#define INTERVAL_OVERLAP_TREE_TEST(len) do {                     \
+  srand((int)time(0));                                         \
+  clock_t start, end;                                          \
+  char buf[10];                                                \
+  const int range = static_cast<int>(len) * 4;                 \
+  mystl::interval_map<int, int> m;                             \
+  for (size_t i = 0; i < len; ++i)                             \
+  {                                                            \
+    int l = rand() % range;                                    \
+    m.insert(IV(l, l + 1 + rand() % 64), l);                   \
+  }                                                            \
+  volatile size_t hits = 0;                                    \
+  start = clock();                                             \
+  for (int q = 0; q < 10; ++q)                                 \
+  {                                                            \
+    int ql = rand() % range;                                   \
+    int qh = ql + 1 + rand() % 64;                             \
+    hits = hits + m.count_overlaps(IV(ql, qh));                \
+  }                                                            \
+  end = clock();                                               \
+  int n = static_cast<int>(static_cast<double>(end - start)    \
+      / CLOCKS_PER_SEC * 1000);                                \
+  std::snprintf(buf, sizeof(buf), "%d", n);                    \
+  std::string t = buf;                                         \
+  t += "ms    |";                                              \
+  std::cout << std::setw(WIDE) << t;                           \
+} while(0)
+
+#define INTERVAL_OVERLAP_TEST(len1, len2, len3)                  \
+  TEST_LEN(len1, len2, len3, WIDE);                            \
+  std::cout << "|   mystl::multimap   |";                      \
+  INTERVAL_OVERLAP_MULTIMAP_TEST(len1);                        \
+  INTERVAL_OVERLAP_MULTIMAP_TEST(len2);                        \
+  INTERVAL_OVERLAP_MULTIMAP_TEST(len3);                        \
+  std::cout << "\n| mystl::interval_map |";                    \
+  INTERVAL_OVERLAP_TREE_TEST(len1);                            \
+  INTERVAL_OVERLAP_TREE_TEST(len2);                            \
+  INTERVAL_OVERLAP_TREE_TEST(len3);
+
+void interval_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[-------------- Run container test : interval_map --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<mystl::pair<mystl::interval<int>, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(mystl::pair<mystl::interval<int>, int>(IV(i * 2, i * 2 + 3), i));
+    mystl::interval_map<int, int> m1;
+    mystl::interval_map<int, int, mystl::greater<int>> m2;
+    mystl::interval_map<int, int> m3(v.begin(), v.end());
+    mystl::interval_map<int, int> m4(m3);
+    mystl::interval_map<int, int> m5(std::move(m3));
+    mystl::interval_map<int, int> m6;
+    m6 = m4;
+
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(IV(1, 5), 1));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(IV(3, 9), 2));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(IV(3, 4), 3));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(IV(12, 15), 4));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(IV(7, 7), 5));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.erase(IV(0, 3)));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert_coalesce(IV(20, 22), 7));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert_coalesce(IV(24, 26), 7));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.insert_coalesce(IV(22, 24), 7));
+    INTERVAL_MAP_FUN_AFTER(m2, m2.insert(IV(9, 3), 1));
+    INTERVAL_MAP_FUN_AFTER(m2, m2.insert(IV(5, 1), 2));
+    FUN_VALUE(m1.count(IV(3, 9)));
+    FUN_VALUE(m1.count_overlaps(IV(4, 8)));
+    FUN_VALUE(m1.count_containing(3));
+    FUN_VALUE(m1.count_containing(10));
+    INTERVAL_MAP_VALUE(*m1.find(IV(12, 15)));
+    INTERVAL_MAP_VALUE(*m1.find_overlap(IV(9, 13)));
+    INTERVAL_MAP_VALUE(*m1.find_containing(6));
+    INTERVAL_MAP_VALUE(*m2.find_overlap(IV(4, 2)));
+    std::cout << " m1.for_each_overlap(IV(4, 10)) :";
+    m1.for_each_overlap(IV(4, 10), [](const mystl::pair<const mystl::interval<int>, int>& p)
+    { std::cout << " <[" << p.first.low << "," << p.first.high << ")," << p.second << ">"; });
+    std::cout << std::endl;
+    mystl::interval_map<int, int>::const_iterator hits[8];
+    auto hits_end = m1.overlaps(IV(5, 13), hits);
+    FUN_VALUE(hits_end - hits);
+    std::cout << std::boolalpha;
+    FUN_VALUE((m4 == m6));
+    FUN_VALUE((m1 == m4));
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    INTERVAL_MAP_FUN_AFTER(m1, m1.swap(m5));
+    INTERVAL_MAP_FUN_AFTER(m1, m1.clear());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 10 overlap queries  |";
+#if LARGER_TEST_DATA_ON
+    INTERVAL_OVERLAP_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    INTERVAL_OVERLAP_TEST(SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : interval_map --------------]" << std::endl;
+}
+
+void interval_set_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[-------------- Run container test : interval_set --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::interval_set<int> s1;
+    mystl::interval_set<int> s2{ IV(1, 3), IV(5, 8), IV(2, 4) };
+    mystl::interval_set<int> s3(s2);
+    mystl::interval_set<int> s4(std::move(s3));
+    mystl::interval_set<int> s5;
+    s5 = s4;
+
+    INTERVAL_SET_COUT(s2);
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(10, 20)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(30, 40)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(20, 25)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(5, 12)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(26, 28)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(24, 31)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(50, 50)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.erase(IV(15, 18)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.erase(IV(0, 8)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.erase(IV(17, 35)));
+    INTERVAL_SET_FUN_AFTER(s1, s1.insert(IV(60, 70)));
+    std::cout << std::boolalpha;
+    FUN_VALUE(s1.contains(12));
+    FUN_VALUE(s1.contains(15));
+    FUN_VALUE(s1.contains(IV(8, 15)));
+    FUN_VALUE(s1.contains(IV(8, 16)));
+    FUN_VALUE((s4 == s5));
+    FUN_VALUE(s1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(s1.size());
+    FUN_VALUE(s1.count_overlaps(IV(0, 100)));
+    INTERVAL_SET_VALUE(*s1.find(37));
+    INTERVAL_SET_VALUE(*s1.find_overlap(IV(16, 62)));
+    std::cout << " s1.for_each_overlap(IV(9, 65)) :";
+    s1.for_each_overlap(IV(9, 65), [](const mystl::interval<int>& iv)
+    { std::cout << " [" << iv.low << "," << iv.high << ")"; });
+    std::cout << std::endl;
+    INTERVAL_SET_FUN_AFTER(s1, s1.erase(s1.begin()));
+    INTERVAL_SET_FUN_AFTER(s1, s1.swap(s4));
+    INTERVAL_SET_FUN_AFTER(s1, s1.clear());
+    PASSED;
+    std::cout << "[-------------- End container test : interval_set --------------]" << std::endl;
+}
+
+} // namespace interval_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_INTERVAL_MAP_TEST_H_
@@ -0,0 +1,264 @@
+#ifndef MY_STL_INTERVAL_SET_H_
+#define MY_STL_INTERVAL_SET_H_
+
+// ͷļģ interval_set
+// interval_set : 伯ϣɻصڵİ뿪䣬ʱԶϲ
+
+// notes:
+//
+// interval_set  interval_map ʹͬһصʱ
+// ǱϲΪһ䣻erase(iv) Ӽмȥ ivֱǵᱻض̻һΪ
+// ˼еʼհ˵򡢻صصѯĸӶΪ O(log n + k)
+// ÿβľ̯ӶΪ O(log n)
+//
+// 䣨low >= highᱻ롣
+
+#include <initializer_list>
+
+#include "interval_map.h"
+
+namespace mystl
+{
+
+// ģ interval_set
+// һ˵ͣ˵ıȽϷʽȱʡʹ mystl::less
+template <typename T, typename Compare = mystl::less<T>>
+class interval_set
+{
+public:
+	// interval_set Ƕͱ
+	using endpoint_type		= T;
+	using key_type			= interval<T>;
+	using value_type		= interval<T>;
+	using key_compare		= interval_compare<T, Compare>;
+	using value_compare		= interval_compare<T, Compare>;
+	using endpoint_compare	= Compare;
+
+private:
+	using augment_type = rb_tree_max_augment<value_type, T, interval_get_high<value_type>, Compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare, augment_type>;
+	using base_ptr = typename base_type::base_ptr;
+	base_type tree_;
+
+	using overlap_query		= interval_overlap_query<T, Compare>;
+	using point_query		= interval_point_query<T, Compare>;
+	using touch_query		= interval_touch_query<T, Compare>;
+
+public:
+	// ʹ rb_tree ͱ𣬼е䲻ͨ޸
+	using pointer					= typename base_type::const_pointer;
+	using const_pointer				= typename base_type::const_pointer;
+	using reference					= typename base_type::const_reference;
+	using const_reference			= typename base_type::const_reference;
+	using iterator					= typename base_type::const_iterator;
+	using const_iterator			= typename base_type::const_iterator;
+	using reverse_iterator			= typename base_type::const_reverse_iterator;
+	using const_reverse_iterator	= typename base_type::const_reverse_iterator;
+	using size_type					= typename base_type::size_type;
+	using difference_type			= typename base_type::difference_type;
+	using allocator_type			= typename base_type::allocator_type;
+
+public:
+	// 졢ơƶֵ
+
+	interval_set() = default;
+
+	template <typename InputIterator>
+	interval_set(InputIterator first, InputIterator last)
+		:tree_()
+	{
+		insert(first, last);
+	}
+
+	interval_set(std::initializer_list<value_type> ilist)
+		:tree_()
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	interval_set(const interval_set& rhs) : tree_{ rhs.tree_ } {}
+
+	interval_set(interval_set&& rhs) noexcept : tree_{ mystl::move(rhs.tree_) } {}
+
+	interval_set& operator=(const interval_set& rhs)
+	{
+		tree_ = rhs.tree_;
+		return *this;
+	}
+
+	interval_set& operator=(interval_set&& rhs) noexcept
+	{
+		tree_ = mystl::move(rhs.tree_);
+		return *this;
+	}
+
+	interval_set& operator=(std::initializer_list<value_type> ilist)
+	{
+		tree_.clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	// ؽӿ
+
+	key_compare		key_comp()		const { return tree_.key_comp(); }
+	value_compare	value_comp()	const { return tree_.key_comp(); }
+	allocator_type	get_allocator()	const { return tree_.get_allocator(); }
+
+	// 
+
+	iterator				begin()	  const noexcept { return tree_.begin(); }
+	iterator				end()	  const noexcept { return tree_.end(); }
+	reverse_iterator		rbegin()  const noexcept { return reverse_iterator(end()); }
+	reverse_iterator		rend()	  const noexcept { return reverse_iterator(begin()); }
+
+	const_iterator			cbegin()  const noexcept { return begin(); }
+	const_iterator			cend()	  const noexcept { return end(); }
+	const_reverse_iterator	crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator	crend()	  const noexcept { return rend(); }
+
+	// 
+	bool		empty()		const noexcept { return tree_.empty(); }
+	size_type	size()		const noexcept { return tree_.size(); }
+	size_type	max_size()	const noexcept { return tree_.max_size(); }
+
+	// ɾ
+
+	//  iv֮صڵ䱻ϲغϲ䣬iv Ϊʱ end()
+	iterator insert(const value_type& iv)
+	{
+		Compare comp;
+		if (!comp(iv.low, iv.high))
+			return end();
+		// е以ڣ iv صڵ˳һ
+		iterator first = make_iter(interval_tree_first<base_type>(tree_.root_node(),
+			touch_query{ iv.low, iv.high, comp }));
+		if (first == end())
+			return tree_.insert_unique(iv).first;
+		value_type merged(iv);
+		if (comp(first->low, merged.low))
+			merged.low = first->low;
+		iterator last = first;
+		for (; last != end() && !comp(iv.high, last->low); ++last)
+		{
+			if (comp(merged.high, last->high))
+				merged.high = last->high;
+		}
+		if (merged == *first && ++iterator(first) == last)
+			return first;
+		tree_.erase(first, last);
+		return tree_.insert_unique(merged).first;
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			insert(*first);
+	}
+
+	iterator erase(iterator position)
+	{
+		return tree_.erase(position);
+	}
+
+	void erase(iterator first, iterator last)
+	{
+		tree_.erase(first, last);
+	}
+
+	// Ӽмȥ iv˱ָǵ䱣δǵĲ
+	void erase(const value_type& iv)
+	{
+		Compare comp;
+		if (!comp(iv.low, iv.high))
+			return;
+		iterator first = make_iter(interval_tree_first<base_type>(tree_.root_node(),
+			overlap_query{ iv.low, iv.high, comp }));
+		if (first == end())
+			return;
+		iterator last = first;
+		iterator back = first;
+		for (; last != end() && comp(last->low, iv.high); ++last)
+			back = last;
+		const bool keep_left = comp(first->low, iv.low);
+		const bool keep_right = comp(iv.high, back->high);
+		const value_type left(first->low, iv.low);
+		const value_type right(iv.high, back->high);
+		tree_.erase(first, last);
+		if (keep_left)
+			tree_.insert_unique(left);
+		if (keep_right)
+			tree_.insert_unique(right);
+	}
+
+	void clear() { tree_.clear(); }
+
+	// 
+
+	// Ƿ point
+	bool contains(const T& point) const
+	{
+		return find(point) != end();
+	}
+
+	//  iv Ƿ񱻼ȫǣǱ
+	bool contains(const value_type& iv) const
+	{
+		Compare comp;
+		if (!comp(iv.low, iv.high))
+			return true;
+		auto it = find(iv.low);
+		return it != end() && !comp(it->high, iv.high);
+	}
+
+	//  point 䣬ʱ end()
+	iterator find(const T& point) const
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), point_query{ point, Compare() }));
+	}
+
+	//  iv صĵһ䣬ʱ end()
+	iterator find_overlap(const value_type& iv) const
+	{
+		return make_iter(interval_tree_first<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }));
+	}
+
+	// ˳ÿ iv ص f(interval)
+	template <typename Func>
+	void for_each_overlap(const value_type& iv, Func f) const
+	{
+		auto visit = [&](base_ptr x) { f(static_cast<const value_type&>(x->get_node_ptr()->value)); };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+	}
+
+	size_type count_overlaps(const value_type& iv) const
+	{
+		size_type n = 0;
+		auto visit = [&](base_ptr) { ++n; };
+		interval_tree_visit<base_type>(tree_.root_node(), overlap_query{ iv.low, iv.high, Compare() }, visit);
+		return n;
+	}
+
+	void swap(interval_set& rhs) noexcept
+	{
+		tree_.swap(rhs.tree_);
+	}
+
+public:
+	friend bool operator==(const interval_set& lhs, const interval_set& rhs) { return lhs.tree_ == rhs.tree_; }
+	friend bool operator!=(const interval_set& lhs, const interval_set& rhs) { return !(lhs == rhs); }
+
+private:
+	iterator make_iter(base_ptr x) const { return x == nullptr ? end() : iterator(x); }
+};
+
+//  mystl  swap
+template <typename T, typename Compare>
+void swap(interval_set<T, Compare>& lhs, interval_set<T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_INTERVAL_SET_H_
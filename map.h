@@ -18,9 +18,12 @@
 namespace mystl
 {
 
+template <typename Key, typename T, typename Compare, bool OrderStatistic> class multimap;
+
 // ģ mapֵظ
-// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
-template <typename Key, typename T, typename Compare = mystl::less<Key>>
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+// ıʾǷά˳ͳϢnth / rankȱʡΪ false
+template <typename Key, typename T, typename Compare = mystl::less<Key>, bool OrderStatistic = false>
 class map
 {
 public:
@@ -33,7 +36,7 @@ public:
 	// һ functorԪرȽ
 	class value_compare : public binary_function <value_type, value_type, bool>
 	{
-		friend class map<Key, T, Compare>;
+		friend class map<Key, T, Compare, OrderStatistic>;
 	public:
 		bool operator()(const value_type& lhs, const value_type& rhs) const
 		{
@@ -45,12 +48,13 @@ public:
 	};
 
 private:
-	using base_type = mystl::rb_tree<value_type, key_compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare,
+		rb_tree_select_augment<value_type, OrderStatistic>>;
 	base_type tree_;
 
 public:
 	// ʹ rb_tree ͱ
-	using node_type					= base_type::node_type;
+	using node_type					= base_type::node_handle_type;
 	using pointer					= base_type::pointer;
 	using const_pointer				= base_type::const_pointer;
 	using reference					= base_type::reference;
@@ -62,6 +66,11 @@ public:
 	using size_type					= base_type::size_type;
 	using difference_type			= base_type::difference_type;
 	using allocator_type			= base_type::allocator_type;
+	using insert_return_type		= base_type::insert_return_type;
+
+	// merge Ҫ map / multimap  rb_tree
+	template <typename, typename, typename, bool> friend class map;
+	template <typename, typename, typename, bool> friend class multimap;
 
 public:
 
@@ -76,6 +85,14 @@ public:
 		tree_.insert_unique(first, last);
 	}
 
+	// Ѿʱʹã O(n) 밴ֵϸ
+	template <typename InputIterator>
+	map(from_sorted_range_t, InputIterator first, InputIterator last)
+		:tree_()
+	{
+		tree_.insert_unique(from_sorted_range, first, last);
+	}
+
 	map(std::initializer_list<value_type> ilist)
 		:tree_()
 	{
@@ -201,19 +218,11 @@ public:
 
 	mapped_type& operator[](const key_type& key)
 	{
-		iterator it = lower_bound(key);
-		// it->first >= key
-		if (it == end() || key_comp()(key, it->first))
-			it = emplace_hint(it, key, T{});
-		return it->second;
+		return try_emplace(key).first->second;
 	}
 	mapped_type& operator[](key_type&& key)
 	{
-		iterator it = lower_bound(key);
-		// it->first >= key
-		if (it == end() || key_comp()(key, it->first))
-			it = emplace_hint(it, mystl::move(key), T{});
-		return it->second;
+		return try_emplace(mystl::move(key)).first->second;
 	}
 
 	// ɾ
@@ -229,6 +238,50 @@ public:
 		return tree_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...);
 	}
 
+	// ȰֵңֵʱŹԪأֵѴʱ args ᱻƶ
+	template <typename ...Args>
+	pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{
+		return tree_.try_emplace_unique(key, mystl::forward<Args>(args)...);
+	}
+	template <typename ...Args>
+	pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+	{
+		return tree_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...);
+	}
+	template <typename ...Args>
+	iterator try_emplace(iterator hint, const key_type& key, Args&& ...args)
+	{
+		return tree_.try_emplace_unique_use_hint(hint, key, mystl::forward<Args>(args)...);
+	}
+	template <typename ...Args>
+	iterator try_emplace(iterator hint, key_type&& key, Args&& ...args)
+	{
+		return tree_.try_emplace_unique_use_hint(hint, mystl::move(key), mystl::forward<Args>(args)...);
+	}
+
+	// ֵѴʱ obj ʵֵԪ
+	template <typename M>
+	pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+	{
+		return tree_.insert_or_assign_unique(key, mystl::forward<M>(obj));
+	}
+	template <typename M>
+	pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+	{
+		return tree_.insert_or_assign_unique(mystl::move(key), mystl::forward<M>(obj));
+	}
+	template <typename M>
+	iterator insert_or_assign(iterator hint, const key_type& key, M&& obj)
+	{
+		return tree_.insert_or_assign_unique_use_hint(hint, key, mystl::forward<M>(obj));
+	}
+	template <typename M>
+	iterator insert_or_assign(iterator hint, key_type&& key, M&& obj)
+	{
+		return tree_.insert_or_assign_unique_use_hint(hint, mystl::move(key), mystl::forward<M>(obj));
+	}
+
 	pair<iterator, bool> insert(const value_type& value)
 	{
 		return tree_.insert_unique(value);
@@ -259,6 +312,17 @@ public:
 
 	void clear() { tree_.clear(); }
 
+	// ڵزֻ޸Ӷ·ڵ㣬 rb_tree
+	node_type extract(const_iterator position) { return tree_.extract(position); }
+	node_type extract(const key_type& key) { return tree_.extract(key); }
+
+	insert_return_type insert(node_type&& nh) { return tree_.insert_unique(mystl::move(nh)); }
+
+	template <typename Compare2>
+	void merge(map<Key, T, Compare2, OrderStatistic>& source) { tree_.merge_unique(source.tree_); }
+	template <typename Compare2>
+	void merge(multimap<Key, T, Compare2, OrderStatistic>& source) { tree_.merge_unique(source.tree_); }
+
 	// map ز
 
 	iterator find(const key_type& key) { return tree_.find(key); }
@@ -267,7 +331,7 @@ public:
 	size_type count(const key_type& key) const { return tree_.count_unique(key); }
 
 	iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
-	const_iterator lower_bound(const key_type& key) const { return tree_.lower_bpund(key); }
+	const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
 
 	iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
 	const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
@@ -282,6 +346,56 @@ public:
 		return tree_.equal_range_unique(key);
 	}
 
+	// 칹ңֻбȽϺ͸ mystl::less<>ʱ
+	// key κֵȽϵͣʱعʱļֵ
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator find(const K& key) { return tree_.find(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator find(const K& key) const { return tree_.find(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	size_type count(const K& key) const { return tree_.count_unique(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator lower_bound(const K& key) { return tree_.lower_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator upper_bound(const K& key) { return tree_.upper_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<iterator, iterator> equal_range(const K& key)
+	{
+		return tree_.equal_range_unique(key);
+	}
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return tree_.equal_range_unique(key);
+	}
+
+	//  join / split ĲýڵԪأ rb_tree
+	void split(const key_type& key, map& right) { tree_.split(key, right.tree_); }
+	void join(map& right) { tree_.join(right.tree_); }
+
+	void union_with(map& rhs, bool parallel = false) { tree_.union_with(rhs.tree_, parallel); }
+	void intersect_with(const map& rhs, bool parallel = false) { tree_.intersect_with(rhs.tree_, parallel); }
+	void difference_with(const map& rhs, bool parallel = false) { tree_.difference_with(rhs.tree_, parallel); }
+
+	// ˳ͳزֻ OrderStatistic Ϊ true ʱ
+	iterator nth(size_type k) { return tree_.nth(k); }
+	const_iterator nth(size_type k) const { return tree_.nth(k); }
+
+	size_type rank(const key_type& key) const { return tree_.rank(key); }
+
+	difference_type distance(const_iterator first, const_iterator last) const
+	{
+		return tree_.distance(first, last);
+	}
+
 	void swap(map& rhs) noexcept
 	{
 		tree_.swap(rhs.tree_);
@@ -294,45 +408,45 @@ public:
 
 
 // رȽϲ
-template <typename Key, typename T, typename Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator==(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator<(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return lhs < rhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator!=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator>(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator<=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator>=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <typename Key, typename T, typename Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+void swap(map<Key, T, Compare, OrderStatistic>& lhs, map<Key, T, Compare, OrderStatistic>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
@@ -340,8 +454,9 @@ void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
 /*****************************************************************************************/
 
 // ģ multimapֵظ
-// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
-template <typename Key, typename T, typename Compare = mystl::less<Key>>
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+// ıʾǷά˳ͳϢnth / rankȱʡΪ false
+template <typename Key, typename T, typename Compare = mystl::less<Key>, bool OrderStatistic = false>
 class multimap
 {
 public:
@@ -354,7 +469,7 @@ public:
 	// һ functorԪرȽ
 	class value_compare : public binary_function <value_type, value_type, bool>
 	{
-		friend class multimap<Key, T, Compare>;
+		friend class multimap<Key, T, Compare, OrderStatistic>;
 	private:
 		Compare comp;
 		value_compare(Compare c) : comp(c) {}
@@ -366,12 +481,13 @@ public:
 	};
 
 private:
-	using base_type = mystl::rb_tree<value_type, key_compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare,
+		rb_tree_select_augment<value_type, OrderStatistic>>;
 	base_type tree_;
 public:
 	// ʹ rb_tree ͱ
 		// ʹ rb_tree ͱ
-	using node_type					= base_type::node_type;
+	using node_type					= base_type::node_handle_type;
 	using pointer					= base_type::pointer;
 	using const_pointer				= base_type::const_pointer;
 	using reference					= base_type::reference;
@@ -384,6 +500,9 @@ public:
 	using difference_type			= base_type::difference_type;
 	using allocator_type			= base_type::allocator_type;
 
+	template <typename, typename, typename, bool> friend class map;
+	template <typename, typename, typename, bool> friend class multimap;
+
 public:
 	multimap() = default;
 
@@ -394,6 +513,14 @@ public:
 		tree_.insert_multi(first, last);
 	}
 
+	// Ѿʱʹã O(n) 밴ֵݼ
+	template <typename InputIterator>
+	multimap(from_sorted_range_t, InputIterator first, InputIterator last)
+		:tree_{}
+	{
+		tree_.insert_multi(from_sorted_range, first, last);
+	}
+
 	multimap(std::initializer_list<value_type> ilist)
 		:tree_{}
 	{
@@ -550,6 +677,17 @@ public:
 
 	void clear() { tree_.clear(); }
 
+	// ڵزֻ޸Ӷ·ڵ㣬 rb_tree
+	node_type extract(const_iterator position) { return tree_.extract(position); }
+	node_type extract(const key_type& key) { return tree_.extract(key); }
+
+	iterator insert(node_type&& nh) { return tree_.insert_multi(mystl::move(nh)); }
+
+	template <typename Compare2>
+	void merge(multimap<Key, T, Compare2, OrderStatistic>& source) { tree_.merge_multi(source.tree_); }
+	template <typename Compare2>
+	void merge(map<Key, T, Compare2, OrderStatistic>& source) { tree_.merge_multi(source.tree_); }
+
 	// multimap ز
 
 	iterator find(const key_type& key) { return tree_.find(key); }
@@ -573,6 +711,52 @@ public:
 		return tree_.equal_range_multi(key);
 	}
 
+	// 칹ңֻбȽϺ͸ mystl::less<>ʱ
+	// key κֵȽϵͣʱعʱļֵ
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator find(const K& key) { return tree_.find(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator find(const K& key) const { return tree_.find(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	size_type count(const K& key) const { return tree_.count_multi(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator lower_bound(const K& key) { return tree_.lower_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator upper_bound(const K& key) { return tree_.upper_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<iterator, iterator> equal_range(const K& key)
+	{
+		return tree_.equal_range_multi(key);
+	}
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return tree_.equal_range_multi(key);
+	}
+
+	//  join / split ĲýڵԪأ rb_tree
+	void split(const key_type& key, multimap& right) { tree_.split(key, right.tree_); }
+	void join(multimap& right) { tree_.join(right.tree_); }
+
+	// ˳ͳزֻ OrderStatistic Ϊ true ʱ
+	iterator nth(size_type k) { return tree_.nth(k); }
+	const_iterator nth(size_type k) const { return tree_.nth(k); }
+
+	size_type rank(const key_type& key) const { return tree_.rank(key); }
+
+	difference_type distance(const_iterator first, const_iterator last) const
+	{
+		return tree_.distance(first, last);
+	}
+
 	void swap(multimap& rhs) noexcept
 	{
 		tree_.swap(rhs.tree_);
@@ -584,49 +768,56 @@ public:
 };
 
 // رȽϲ
-template <typename Key, typename T, typename Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator==(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator<(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return lhs < rhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator!=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator>(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator<=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+bool operator>=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <typename Key, typename T, typename Compare>
-void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept
+template <typename Key, typename T, typename Compare, bool OrderStatistic>
+void swap(multimap<Key, T, Compare, OrderStatistic>& lhs, multimap<Key, T, Compare, OrderStatistic>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
 
+// ֧˳ͳƵ map / multimapṩ O(log n)  nthrank  distance
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+using ranked_map = map<Key, T, Compare, true>;
+
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+using ranked_multimap = multimap<Key, T, Compare, true>;
+
 } // namespace mystl
 #endif // !MY_STL_MAP_H_
 
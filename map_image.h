@@ -0,0 +1,602 @@
+#ifndef MY_STL_MAP_IMAGE_H_
+#define MY_STL_MAP_IMAGE_H_
+
+// ͷļӳдɶƾԼھֱӲҵֻͼ
+// write_unordered_image :  unordered_map ȹϣдɹϣ unordered_map_image_view 
+// write_ordered_image   :  map дɰֵľ map_image_view 
+// mapped_file           : ֻʽļӳ䵽ڴ
+
+// notes:
+//
+// ֵʵֵǿƽƵֻ͡ھƫƶûָ룬
+// ڵĵַ޹أӳ䵽ڴҪлͼֻļͷԪظ޹أ
+//   * ļͷ map_image_header¼ʽֽsize_t λ͵ĴСͼݴ˾ܾƥľ
+//   * ϣbucket ȡ 2 ݣ֮ bucket_count + 1  uint64_t ƫƣ b  bucket ԪΪ
+//     [offsets[b], offsets[b + 1])Ԫذ bucket ţֻһ bucket һڴ棻
+//   * Ԫذֵţöֲҡ
+// ζ 16 ֽڶ룬Ӱҳӳ㿪ʼʱеԪؿֱӷʡ
+//
+// ϣдʱʹͬһϣڲͬĽнͬmystl::hash һҪ
+// ݱŵݣͼֻļͷεķΧƫ顣
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "algo.h"
+#include "functional.h"
+#include "hashtable.h"
+#include "vector.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// еԪأֵʵֵԭ
+template <typename Key, typename T>
+struct map_image_entry
+{
+	Key first;
+	T   second;
+};
+
+// ļͷƫƶھ
+struct map_image_header
+{
+	uint64_t magic;
+	uint32_t version;
+	uint32_t kind;				// map_image_unordered  map_image_ordered
+	uint32_t byte_order;		// дʱ map_image_byte_orderֽͬʱֵͬ
+	uint32_t size_bits;			// size_t λϣֵ
+	uint32_t key_size;
+	uint32_t mapped_size;
+	uint32_t entry_size;
+	uint32_t entry_align;
+	uint64_t count;				// Ԫظ
+	uint64_t bucket_count;		// ϣ bucket Ϊ 0
+	uint64_t buckets_offset;	// ƫλãΪ 0
+	uint64_t entries_offset;	// Ԫصλ
+	uint64_t image_size;		// ֽ
+};
+
+constexpr uint64_t map_image_magic = 0x474d494c5453594dull;	// "MYSTLIMG"
+constexpr uint32_t map_image_version = 1;
+constexpr uint32_t map_image_unordered = 1;
+constexpr uint32_t map_image_ordered = 2;
+constexpr uint32_t map_image_byte_order = 0x01020304u;
+constexpr uint64_t map_image_align = 16;
+
+namespace map_image_detail
+{
+
+inline uint64_t align_up(uint64_t n) noexcept
+{
+	return (n + map_image_align - 1) & ~(map_image_align - 1);
+}
+
+template <typename Key, typename T>
+void check_types()
+{
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<T>::value,
+		"map image needs trivially copyable key and mapped types");
+	static_assert(alignof(map_image_entry<Key, T>) <= map_image_align,
+		"map image entries must not need more than 16-byte alignment");
+}
+
+template <typename Key, typename T>
+map_image_header make_header(uint32_t kind, uint64_t count, uint64_t bucket_count)
+{
+	map_image_header h{};
+	h.magic = map_image_magic;
+	h.version = map_image_version;
+	h.kind = kind;
+	h.byte_order = map_image_byte_order;
+	h.size_bits = static_cast<uint32_t>(sizeof(size_t) * 8);
+	h.key_size = static_cast<uint32_t>(sizeof(Key));
+	h.mapped_size = static_cast<uint32_t>(sizeof(T));
+	h.entry_size = static_cast<uint32_t>(sizeof(map_image_entry<Key, T>));
+	h.entry_align = static_cast<uint32_t>(alignof(map_image_entry<Key, T>));
+	h.count = count;
+	h.bucket_count = bucket_count;
+	uint64_t pos = align_up(sizeof(map_image_header));
+	if (bucket_count != 0)
+	{
+		h.buckets_offset = pos;
+		pos = align_up(pos + (bucket_count + 1) * sizeof(uint64_t));
+	}
+	h.entries_offset = pos;
+	h.image_size = align_up(pos + count * sizeof(map_image_entry<Key, T>));
+	return h;
+}
+
+inline void write_bytes(std::ostream& os, const void* p, uint64_t n)
+{
+	os.write(static_cast<const char*>(p), static_cast<std::streamsize>(n));
+	THROW_RUNTIME_ERROR_IF(!os, "map image write failed");
+}
+
+inline void write_padding(std::ostream& os, uint64_t written)
+{
+	static const char zeros[map_image_align] = {};
+	write_bytes(os, zeros, align_up(written) - written);
+}
+
+//  order ˳дԪأÿдһԼٵô
+template <typename Key, typename T, typename Ptr>
+void write_entries(std::ostream& os, const mystl::vector<Ptr>& order)
+{
+	using entry = map_image_entry<Key, T>;
+	const size_t batch = 4096;
+	// ֵʼʹֽΪ 0ֻ֮ԱֵԪΨһȷ
+	mystl::vector<entry> buf(batch);
+	for (size_t i = 0; i < order.size(); i += batch)
+	{
+		const size_t n = mystl::min(batch, order.size() - i);
+		for (size_t j = 0; j < n; ++j)
+		{
+			buf[j].first = order[i + j]->first;
+			buf[j].second = order[i + j]->second;
+		}
+		write_bytes(os, buf.data(), n * sizeof(entry));
+	}
+	write_padding(os, order.size() * sizeof(entry));
+}
+
+//  data ʼ size ֽǷΪ KeyT ƥ kind ྵ񣬷ļͷ
+template <typename Key, typename T>
+map_image_header read_header(const void* data, size_t size, uint32_t kind)
+{
+	map_image_header h{};
+	THROW_RUNTIME_ERROR_IF(data == nullptr || size < sizeof(h), "map image is too small");
+	THROW_RUNTIME_ERROR_IF(reinterpret_cast<uintptr_t>(data) % map_image_align != 0,
+		"map image is not 16-byte aligned");
+	std::memcpy(&h, data, sizeof(h));
+	THROW_RUNTIME_ERROR_IF(h.magic != map_image_magic || h.version != map_image_version,
+		"not a map image of this version");
+	THROW_RUNTIME_ERROR_IF(h.kind != kind, "map image kind mismatch");
+	THROW_RUNTIME_ERROR_IF(h.byte_order != map_image_byte_order ||
+		h.size_bits != sizeof(size_t) * 8, "map image was written on an incompatible platform");
+	THROW_RUNTIME_ERROR_IF(h.key_size != sizeof(Key) || h.mapped_size != sizeof(T) ||
+		h.entry_size != sizeof(map_image_entry<Key, T>) ||
+		h.entry_align != alignof(map_image_entry<Key, T>), "map image type mismatch");
+	const map_image_header expect = make_header<Key, T>(kind, h.count, h.bucket_count);
+	THROW_RUNTIME_ERROR_IF(h.buckets_offset != expect.buckets_offset ||
+		h.entries_offset != expect.entries_offset || h.image_size != expect.image_size ||
+		h.count > (h.image_size - h.entries_offset) / sizeof(map_image_entry<Key, T>) ||
+		h.image_size > size, "map image is truncated or corrupted");
+	THROW_RUNTIME_ERROR_IF(kind == map_image_unordered &&
+		(h.bucket_count == 0 || (h.bucket_count & (h.bucket_count - 1)) != 0),
+		"map image is truncated or corrupted");
+	return h;
+}
+
+} // namespace map_image_detail
+
+// ѹϣдɹϣ񣬼ֵظʱ find / at ҵÿһԪ
+// ΪдʱʹõĹϣʱͬԼĹϣ޹
+template <typename Map, typename Hash = mystl::hash<typename Map::key_type>>
+void write_unordered_image(std::ostream& os, const Map& m, const Hash& hash = Hash())
+{
+	using key_type = typename Map::key_type;
+	using mapped_type = typename Map::mapped_type;
+	map_image_detail::check_types<key_type, mapped_type>();
+
+	const uint64_t count = m.size();
+	uint64_t bucket_count = 1;
+	while (bucket_count < count)
+		bucket_count <<= 1;
+
+	// ͳÿ bucket Ԫظٰ bucket Ԫ
+	mystl::vector<uint64_t> offsets(static_cast<size_t>(bucket_count + 1), 0);
+	mystl::vector<uint64_t> bucket_of(static_cast<size_t>(count));
+	size_t i = 0;
+	for (auto it = m.begin(); it != m.end(); ++it, ++i)
+	{
+		bucket_of[i] = ht_hash_mix(hash(it->first)) & (bucket_count - 1);
+		++offsets[static_cast<size_t>(bucket_of[i] + 1)];
+	}
+	for (size_t b = 0; b < bucket_count; ++b)
+		offsets[b + 1] += offsets[b];
+	mystl::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+	using value_type = typename Map::value_type;
+	mystl::vector<const value_type*> order(static_cast<size_t>(count));
+	i = 0;
+	for (auto it = m.begin(); it != m.end(); ++it, ++i)
+		order[static_cast<size_t>(cursor[static_cast<size_t>(bucket_of[i])]++)] = &*it;
+
+	const auto header = map_image_detail::make_header<key_type, mapped_type>(
+		map_image_unordered, count, bucket_count);
+	map_image_detail::write_bytes(os, &header, sizeof(header));
+	map_image_detail::write_padding(os, sizeof(header));
+	map_image_detail::write_bytes(os, offsets.data(), offsets.size() * sizeof(uint64_t));
+	map_image_detail::write_padding(os, offsets.size() * sizeof(uint64_t));
+	map_image_detail::write_entries<key_type, mapped_type>(os, order);
+}
+
+// дɰֵľʱ򣬼ֵظ
+template <typename Map, typename Compare = mystl::less<typename Map::key_type>>
+void write_ordered_image(std::ostream& os, const Map& m, Compare comp = Compare())
+{
+	using key_type = typename Map::key_type;
+	using mapped_type = typename Map::mapped_type;
+	using value_type = typename Map::value_type;
+	using pointer = const value_type*;
+	map_image_detail::check_types<key_type, mapped_type>();
+
+	mystl::vector<pointer> order;
+	order.reserve(m.size());
+	for (auto it = m.begin(); it != m.end(); ++it)
+		order.push_back(&*it);
+	auto key_less = [&comp](pointer a, pointer b) { return comp(a->first, b->first); };
+	if (!mystl::is_sorted(order.begin(), order.end(), key_less))
+		mystl::sort(order.begin(), order.end(), key_less);
+
+	const auto header = map_image_detail::make_header<key_type, mapped_type>(
+		map_image_ordered, order.size(), 0);
+	map_image_detail::write_bytes(os, &header, sizeof(header));
+	map_image_detail::write_padding(os, sizeof(header));
+	map_image_detail::write_entries<key_type, mapped_type>(os, order);
+}
+
+// ģ unordered_map_image_viewڹϣֱӲңԪأڴʹ߹
+// һֵͣʵֵͣϣĴֵȽϷʽ
+template <typename Key, typename T, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+class unordered_map_image_view
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= map_image_entry<Key, T>;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+
+	using iterator					= const value_type*;
+	using const_iterator			= const value_type*;
+
+private:
+	const uint64_t*		offsets_;
+	const value_type*	entries_;
+	size_type			size_;
+	uint64_t			bucket_mask_;
+	hasher				hash_;
+	key_equal			equal_;
+
+public:
+	// ɾڵڴ湹죬ƥʱ׳ runtime_error
+	unordered_map_image_view(const void* data, size_type size,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:hash_(hash), equal_(equal)
+	{
+		const auto h = map_image_detail::read_header<Key, T>(data, size, map_image_unordered);
+		const auto base = static_cast<const char*>(data);
+		offsets_ = reinterpret_cast<const uint64_t*>(base + h.buckets_offset);
+		entries_ = reinterpret_cast<const value_type*>(base + h.entries_offset);
+		size_ = static_cast<size_type>(h.count);
+		bucket_mask_ = h.bucket_count - 1;
+		THROW_RUNTIME_ERROR_IF(offsets_[h.bucket_count] != h.count, "map image is truncated or corrupted");
+	}
+
+	// ز bucket ˳
+	const_iterator begin() const noexcept
+	{ return entries_; }
+	const_iterator end() const noexcept
+	{ return entries_ + size_; }
+	const_iterator cbegin() const noexcept
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	bool empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+
+	// ز
+	const mapped_type& at(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "unordered_map_image_view<Key, T> no such element exists");
+		return it->second;
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		const auto b = ht_hash_mix(hash_(key)) & bucket_mask_;
+		for (auto first = entries_ + offsets_[b], last = entries_ + offsets_[b + 1]; first != last; ++first)
+		{
+			if (equal_(first->first, key))
+				return first;
+		}
+		return end();
+	}
+
+	size_type count(const key_type& key) const
+	{
+		const auto b = ht_hash_mix(hash_(key)) & bucket_mask_;
+		size_type n = 0;
+		for (auto first = entries_ + offsets_[b], last = entries_ + offsets_[b + 1]; first != last; ++first)
+			n += equal_(first->first, key) ? 1 : 0;
+		return n;
+	}
+
+	bool contains(const key_type& key) const
+	{
+		return find(key) != end();
+	}
+
+	// bucket 
+	size_type bucket_count() const noexcept { return static_cast<size_type>(bucket_mask_ + 1); }
+	float load_factor() const noexcept { return (float)size_ / (float)(bucket_mask_ + 1); }
+
+	hasher hash_fcn() const { return hash_; }
+	key_equal key_eq() const { return equal_; }
+};
+
+// ģ map_image_viewֱӲңԪأڴʹ߹
+// һֵͣʵֵֵͣȽϷʽдʱͬ
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+class map_image_view
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= map_image_entry<Key, T>;
+	using key_compare				= Compare;
+
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+
+	using iterator					= const value_type*;
+	using const_iterator			= const value_type*;
+
+private:
+	const value_type*	entries_;
+	size_type			size_;
+	key_compare			comp_;
+
+public:
+	// ɾڵڴ湹죬ƥʱ׳ runtime_error
+	map_image_view(const void* data, size_type size, const Compare& comp = Compare())
+		:comp_(comp)
+	{
+		const auto h = map_image_detail::read_header<Key, T>(data, size, map_image_ordered);
+		entries_ = reinterpret_cast<const value_type*>(static_cast<const char*>(data) + h.entries_offset);
+		size_ = static_cast<size_type>(h.count);
+	}
+
+	// زֵС
+	const_iterator begin() const noexcept
+	{ return entries_; }
+	const_iterator end() const noexcept
+	{ return entries_ + size_; }
+	const_iterator cbegin() const noexcept
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	bool empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+
+	// ز
+	const mapped_type& at(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "map_image_view<Key, T> no such element exists");
+		return it->second;
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		const_iterator it = lower_bound(key);
+		return (it == end() || comp_(key, it->first)) ? end() : it;
+	}
+
+	size_type count(const key_type& key) const
+	{
+		return static_cast<size_type>(upper_bound(key) - lower_bound(key));
+	}
+
+	bool contains(const key_type& key) const
+	{
+		return find(key) != end();
+	}
+
+	const_iterator lower_bound(const key_type& key) const
+	{
+		const_iterator first = entries_;
+		size_type len = size_;
+		while (len > 0)
+		{
+			const size_type half = len >> 1;
+			if (comp_(first[half].first, key))
+			{
+				first += half + 1;
+				len -= half + 1;
+			}
+			else
+			{
+				len = half;
+			}
+		}
+		return first;
+	}
+
+	const_iterator upper_bound(const key_type& key) const
+	{
+		const_iterator first = entries_;
+		size_type len = size_;
+		while (len > 0)
+		{
+			const size_type half = len >> 1;
+			if (!comp_(key, first[half].first))
+			{
+				first += half + 1;
+				len -= half + 1;
+			}
+			else
+			{
+				len = half;
+			}
+		}
+		return first;
+	}
+
+	pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+	{
+		return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+	}
+
+	key_compare key_comp() const { return comp_; }
+};
+
+// mapped_file : ֻʽļӳ䵽ڴ棬ӳ㰴ҳ룬ֱ쾵ͼ
+class mapped_file
+{
+private:
+	const void* data_ = nullptr;
+	size_t      size_ = 0;
+#if defined(_WIN32)
+	HANDLE      file_ = INVALID_HANDLE_VALUE;
+	HANDLE      mapping_ = nullptr;
+#else
+	int         fd_ = -1;
+#endif
+
+public:
+	mapped_file() noexcept = default;
+
+	// ӳ path ָļʧʱ׳ runtime_error
+	explicit mapped_file(const char* path)
+	{
+#if defined(_WIN32)
+		file_ = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		THROW_RUNTIME_ERROR_IF(file_ == INVALID_HANDLE_VALUE, "mapped_file cannot open the file");
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(file_, &size))
+		{
+			close();
+			THROW_RUNTIME_ERROR_IF(true, "mapped_file cannot get the file size");
+		}
+		size_ = static_cast<size_t>(size.QuadPart);
+		if (size_ != 0)
+		{
+			mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			data_ = mapping_ ? ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			if (data_ == nullptr)
+			{
+				close();
+				THROW_RUNTIME_ERROR_IF(true, "mapped_file cannot map the file");
+			}
+		}
+#else
+		fd_ = ::open(path, O_RDONLY);
+		THROW_RUNTIME_ERROR_IF(fd_ < 0, "mapped_file cannot open the file");
+		struct stat st;
+		if (::fstat(fd_, &st) != 0)
+		{
+			close();
+			THROW_RUNTIME_ERROR_IF(true, "mapped_file cannot get the file size");
+		}
+		size_ = static_cast<size_t>(st.st_size);
+		if (size_ != 0)
+		{
+			void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+			if (p == MAP_FAILED)
+			{
+				close();
+				THROW_RUNTIME_ERROR_IF(true, "mapped_file cannot map the file");
+			}
+			data_ = p;
+		}
+#endif
+	}
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	mapped_file(mapped_file&& rhs) noexcept
+	{
+		swap(rhs);
+	}
+
+	mapped_file& operator=(mapped_file&& rhs) noexcept
+	{
+		mapped_file tmp(mystl::move(rhs));
+		swap(tmp);
+		return *this;
+	}
+
+	~mapped_file()
+	{
+		close();
+	}
+
+	const void* data() const noexcept { return data_; }
+	size_t      size() const noexcept { return size_; }
+	bool        is_open() const noexcept { return data_ != nullptr || size_ != 0; }
+
+	// ӳ䲢رļ
+	void close() noexcept
+	{
+#if defined(_WIN32)
+		if (data_)
+			::UnmapViewOfFile(data_);
+		if (mapping_)
+			::CloseHandle(mapping_);
+		if (file_ != INVALID_HANDLE_VALUE)
+			::CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+		mapping_ = nullptr;
+#else
+		if (data_)
+			::munmap(const_cast<void*>(data_), size_);
+		if (fd_ >= 0)
+			::close(fd_);
+		fd_ = -1;
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	void swap(mapped_file& rhs) noexcept
+	{
+		mystl::swap(data_, rhs.data_);
+		mystl::swap(size_, rhs.size_);
+#if defined(_WIN32)
+		mystl::swap(file_, rhs.file_);
+		mystl::swap(mapping_, rhs.mapping_);
+#else
+		mystl::swap(fd_, rhs.fd_);
+#endif
+	}
+};
+
+} // namespace mystl
+#endif // !MY_STL_MAP_IMAGE_H_
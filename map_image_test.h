@@ -0,0 +1,254 @@
+#ifndef MY_STL_MAP_IMAGE_TEST_H_
+#define MY_STL_MAP_IMAGE_TEST_H_
+
+// map_image test : Թϣд롢ӳͲңԼ¹ unordered_map ʱԱ
+
+#include <cstdio>
+#include <fstream>
+
+#include "map_image.h"
+#include "map.h"
+#include "unordered_map.h"
+#include "map_test.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace map_image_test
+{
+
+// ʹõľļ
+const char* const image_path = "map_image_test.bin";
+
+//  m дɾļwriter Ϊ write_unordered_image  write_ordered_image
+template <typename Map, typename Writer>
+void write_image_file(const Map& m, Writer writer)
+{
+    std::ofstream os(image_path, std::ios::binary | std::ios::trunc);
+    writer(os, m);
+}
+
+//  i ֵ˳ҵ˳ŵ˳ͬ
+inline int image_key(size_t i)
+{
+    return static_cast<int>((i * 2654435761u) & 0x7fffffff);
+}
+
+//  len Ԫʱmode Ϊ 0 ʾԭʼ¹ unordered_mapΪ 1 ʾӳ侵ļͼʱ
+void image_startup_do_test(size_t len, int mode)
+{
+    mystl::vector<mystl::pair<int, int>> data;
+    data.reserve(len);
+    for (size_t i = 0; i < len; ++i)
+        data.push_back(mystl::pair<int, int>(image_key(i), static_cast<int>(i)));
+    if (mode == 1)
+    {
+        mystl::unordered_map<int, int> m(data.begin(), data.end());
+        write_image_file(m, [](std::ostream& os, const mystl::unordered_map<int, int>& c)
+        { mystl::write_unordered_image(os, c); });
+    }
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    if (mode == 0)
+    {
+        mystl::unordered_map<int, int> m(data.begin(), data.end());
+        hits = m.count(image_key(len / 2));
+    }
+    else
+    {
+        mystl::mapped_file file(image_path);
+        mystl::unordered_map_image_view<int, int> view(file.data(), file.size());
+        hits = view.count(image_key(len / 2));
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    if (mode == 1)
+        std::remove(image_path);
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  len Ԫв len Σÿζҵmode Ϊ 0 ʾ unordered_map вңΪ 1 ʾھͼвңʱ
+void image_find_do_test(size_t len, int mode)
+{
+    mystl::unordered_map<int, int> m;
+    m.reserve(len);
+    for (size_t i = 0; i < len; ++i)
+        m.emplace(image_key(i), static_cast<int>(i));
+    write_image_file(m, [](std::ostream& os, const mystl::unordered_map<int, int>& c)
+    { mystl::write_unordered_image(os, c); });
+    mystl::mapped_file file(image_path);
+    mystl::unordered_map_image_view<int, int> view(file.data(), file.size());
+    clock_t start, end;
+    char buf[10];
+    size_t hits = 0;
+    start = clock();
+    if (mode == 0)
+    {
+        for (size_t i = 0; i < len; ++i)
+            hits += m.find(image_key(i)) != m.end();
+    }
+    else
+    {
+        for (size_t i = 0; i < len; ++i)
+            hits += view.find(image_key(i)) != view.end();
+    }
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    file.close();
+    std::remove(image_path);
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define IMAGE_STARTUP_TEST(len1, len2, len3)                                  \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|  rebuild from data  |";                                   \
+  image_startup_do_test(len1, 0);                                           \
+  image_startup_do_test(len2, 0);                                           \
+  image_startup_do_test(len3, 0);                                           \
+  std::cout << "\n| mapped_file + view  |";                                 \
+  image_startup_do_test(len1, 1);                                           \
+  image_startup_do_test(len2, 1);                                           \
+  image_startup_do_test(len3, 1);
+
+#define IMAGE_FIND_TEST(len1, len2, len3)                                     \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_map |";                                   \
+  image_find_do_test(len1, 0);                                              \
+  image_find_do_test(len2, 0);                                              \
+  image_find_do_test(len3, 0);                                              \
+  std::cout << "\n|unordered image view |";                                 \
+  image_find_do_test(len1, 1);                                              \
+  image_find_do_test(len2, 1);                                              \
+  image_find_do_test(len3, 1);
+
+void map_image_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : map_image ---------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::unordered_map<int, int> um;
+    for (int i = 1; i <= 5; ++i)
+        um.emplace(i, i * i);
+    write_image_file(um, [](std::ostream& os, const mystl::unordered_map<int, int>& c)
+    { mystl::write_unordered_image(os, c); });
+    {
+        mystl::mapped_file file(image_path);
+        mystl::unordered_map_image_view<int, int> uv(file.data(), file.size());
+        MAP_COUT(uv);
+        std::cout << std::boolalpha;
+        FUN_VALUE(uv.empty());
+        FUN_VALUE(uv.contains(3));
+        FUN_VALUE(uv.contains(6));
+        FUN_VALUE((uv.find(6) == uv.end()));
+        std::cout << std::noboolalpha;
+        FUN_VALUE(uv.size());
+        FUN_VALUE(uv.bucket_count());
+        FUN_VALUE(uv.at(4));
+        FUN_VALUE(uv.count(4));
+        MAP_VALUE(*uv.find(5));
+        try
+        {
+            uv.at(6);
+        }
+        catch (const std::out_of_range& e)
+        {
+            std::cout << " uv.at(6) : " << e.what() << std::endl;
+        }
+        // Ͳƥľᱻܾ
+        try
+        {
+            mystl::unordered_map_image_view<int, double> bad(file.data(), file.size());
+            (void)bad;
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::cout << " unordered_map_image_view<int, double> : " << e.what() << std::endl;
+        }
+        try
+        {
+            mystl::map_image_view<int, int> bad(file.data(), file.size());
+            (void)bad;
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::cout << " map_image_view<int, int> : " << e.what() << std::endl;
+        }
+    }
+
+    mystl::map<int, double> om;
+    for (int i = 5; i >= 1; --i)
+        om.emplace(i * 10, i * 1.5);
+    write_image_file(om, [](std::ostream& os, const mystl::map<int, double>& c)
+    { mystl::write_ordered_image(os, c); });
+    {
+        mystl::mapped_file file(image_path);
+        mystl::map_image_view<int, double> ov(file.data(), file.size());
+        MAP_COUT(ov);
+        std::cout << std::boolalpha;
+        FUN_VALUE(ov.contains(30));
+        FUN_VALUE(ov.contains(35));
+        std::cout << std::noboolalpha;
+        FUN_VALUE(ov.size());
+        FUN_VALUE(ov.at(20));
+        FUN_VALUE(ov.count(50));
+        MAP_VALUE(*ov.lower_bound(25));
+        MAP_VALUE(*ov.upper_bound(30));
+        FUN_VALUE((ov.equal_range(40).second - ov.equal_range(40).first));
+        FUN_VALUE((ov.upper_bound(50) == ov.end()));
+        // ضϵľᱻܾ
+        try
+        {
+            mystl::map_image_view<int, double> bad(file.data(), file.size() - 16);
+            (void)bad;
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::cout << " map_image_view(truncated) : " << e.what() << std::endl;
+        }
+    }
+    std::remove(image_path);
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| startup + one find  |";
+#if LARGER_TEST_DATA_ON
+    IMAGE_STARTUP_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    IMAGE_STARTUP_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     find (hit)      |";
+#if LARGER_TEST_DATA_ON
+    IMAGE_FIND_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    IMAGE_FIND_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[---------------- End container test : map_image ---------------]" << std::endl;
+}
+
+} // namespace map_image_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_MAP_IMAGE_TEST_H_
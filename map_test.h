@@ -6,6 +6,7 @@
 #include <map>
 
 #include "map.h"
+#include "astring.h"
 #include "vector.h"
 #include "test.h"
 
@@ -42,6 +43,48 @@ namespace map_test
     std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
 } while(0)
 
+// ֵֻ len / 16 ֵĲ룬ļֵѾڣexpr  c Ϊk Ϊֵ
+#define MAP_DUP_DO_TEST(mode, expr, len) do {                 \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  mode::map<int, int> c;                                     \
+  char buf[10];                                              \
+  const int range = static_cast<int>(len / 16) + 1;          \
+  start = clock();                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    int k = rand() % range;                                  \
+    expr;                                                    \
+  }                                                          \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// emplace ĲǼֵʱֻȹڵٲ
+#define MAP_DUP_TEST(len1, len2, len3)                        \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|     std emplace     |";                    \
+  MAP_DUP_DO_TEST(std, c.emplace(k, k), len1);               \
+  MAP_DUP_DO_TEST(std, c.emplace(k, k), len2);               \
+  MAP_DUP_DO_TEST(std, c.emplace(k, k), len3);               \
+  std::cout << "\n|   emplace, no key   |";                  \
+  MAP_DUP_DO_TEST(mystl, c.emplace(static_cast<long>(k), k), len1); \
+  MAP_DUP_DO_TEST(mystl, c.emplace(static_cast<long>(k), k), len2); \
+  MAP_DUP_DO_TEST(mystl, c.emplace(static_cast<long>(k), k), len3); \
+  std::cout << "\n|       emplace       |";                  \
+  MAP_DUP_DO_TEST(mystl, c.emplace(k, k), len1);             \
+  MAP_DUP_DO_TEST(mystl, c.emplace(k, k), len2);             \
+  MAP_DUP_DO_TEST(mystl, c.emplace(k, k), len3);             \
+  std::cout << "\n|     try_emplace     |";                  \
+  MAP_DUP_DO_TEST(mystl, c.try_emplace(k, k), len1);         \
+  MAP_DUP_DO_TEST(mystl, c.try_emplace(k, k), len2);         \
+  MAP_DUP_DO_TEST(mystl, c.try_emplace(k, k), len3);
+
 void map_test()
 {
     std::cout << "[===============================================================]" << std::endl;
@@ -63,6 +106,8 @@ void map_test()
     mystl::map<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
     mystl::map<int, int> m10;
     m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+    mystl::map<int, int> m11(mystl::from_sorted_range, v.begin(), v.end());
+    MAP_COUT(m11);
 
     for (int i = 5; i > 0; --i)
     {
@@ -97,11 +142,35 @@ void map_test()
     FUN_VALUE(m1[1]);
     MAP_FUN_AFTER(m1, m1[1] = 3);
     FUN_VALUE(m1.at(1));
+    MAP_FUN_AFTER(m1, m1.try_emplace(1, 5));
+    MAP_FUN_AFTER(m1, m1.try_emplace(7, 7));
+    MAP_FUN_AFTER(m1, m1.try_emplace(m1.end(), 8, 8));
+    MAP_FUN_AFTER(m1, m1.insert_or_assign(7, 70));
+    MAP_FUN_AFTER(m1, m1.insert_or_assign(m1.begin(), 0, 0));
     std::cout << std::boolalpha;
     FUN_VALUE(m1.empty());
     std::cout << std::noboolalpha;
     FUN_VALUE(m1.size());
     FUN_VALUE(m1.max_size());
+    mystl::ranked_map<int, int> m12(v.begin(), v.end());
+    MAP_VALUE(*m12.nth(2));
+    FUN_VALUE(m12.rank(3));
+    FUN_VALUE(m12.distance(m12.begin(), m12.find(4)));
+    mystl::map<int, int> m13{ PAIR(1,1),PAIR(2,2),PAIR(3,3) };
+    mystl::map<int, int> m14{ PAIR(3,0),PAIR(4,4) };
+    MAP_FUN_AFTER(m13, m13.merge(m14));
+    MAP_COUT(m14);
+    auto nh = m13.extract(1);
+    nh.key() = 5;
+    MAP_FUN_AFTER(m13, m13.insert(mystl::move(nh)));
+    MAP_FUN_AFTER(m14, m14.insert(m13.extract(m13.begin())));
+    FUN_VALUE(m14.insert(m13.extract(3)).inserted);
+    MAP_COUT(m13);
+    mystl::map<mystl::string, int, mystl::less<>> m15{ { "abc", 1 }, { "bcd", 2 }, { "cde", 3 } };
+    FUN_VALUE(m15.count("abc"));
+    MAP_VALUE(*m15.find("bcd"));
+    MAP_VALUE(*m15.lower_bound("b"));
+    MAP_VALUE(*m15.upper_bound("bcd"));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -111,6 +180,14 @@ void map_test()
     MAP_EMPLACE_TEST(map, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #else
     MAP_EMPLACE_TEST(map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  emplace (15/16 dup)|";
+#if LARGER_TEST_DATA_ON
+    MAP_DUP_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    MAP_DUP_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -140,6 +217,8 @@ void multimap_test()
     mystl::multimap<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
     mystl::multimap<int, int> m10;
     m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+    mystl::multimap<int, int> m11(mystl::from_sorted_range, v.begin(), v.end());
+    MAP_COUT(m11);
 
     for (int i = 5; i > 0; --i)
     {
@@ -178,6 +257,22 @@ void multimap_test()
     std::cout << std::noboolalpha;
     FUN_VALUE(m1.size());
     FUN_VALUE(m1.max_size());
+    mystl::ranked_multimap<int, int> m12(v.begin(), v.end());
+    MAP_VALUE(*m12.nth(2));
+    FUN_VALUE(m12.rank(3));
+    FUN_VALUE(m12.distance(m12.begin(), m12.find(4)));
+    mystl::multimap<int, int> m13{ PAIR(1,1),PAIR(2,2),PAIR(3,3) };
+    mystl::map<int, int> m14{ PAIR(3,0),PAIR(4,4) };
+    MAP_FUN_AFTER(m13, m13.merge(m14));
+    MAP_COUT(m14);
+    auto nh = m13.extract(3);
+    nh.key() = 5;
+    MAP_FUN_AFTER(m13, m13.insert(mystl::move(nh)));
+    MAP_FUN_AFTER(m13, m13.insert(m13.extract(m13.begin())));
+    mystl::multimap<mystl::string, int, mystl::less<>> m15{ { "abc", 1 }, { "bcd", 2 }, { "bcd", 3 } };
+    FUN_VALUE(m15.count("bcd"));
+    MAP_VALUE(*m15.equal_range("bcd").first);
+    MAP_VALUE(*m15.lower_bound("b"));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
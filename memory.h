@@ -114,6 +114,7 @@ private:
 	void allocate_buffer()
 	{
 		original_len = len;
+		buffer = nullptr;		// Ϊʱ룬ʱ free(nullptr) ޺
 		if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
 		{
 			len = INT_MAX / sizeof(T);
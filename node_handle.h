@@ -0,0 +1,140 @@
+#ifndef MY_STL_NODE_HANDLE_H_
+#define MY_STL_NODE_HANDLE_H_
+
+// ͷļģ node_handle  node_insert_return
+// node_handle        : ڵдӹʽժµĽڵ
+// node_insert_return : ѽڵ뵽ֵظʱķֵ
+
+// notes:
+//
+// extract ѽڵժ¶٣ node_handle insert(node_type&&) ٰ
+// ڵֱӵһͬС̲·ڵ㣬ҲƻƶԪأ
+// ˿ժº޸ļֵkey()ٲȥ
+// ڵֻƶܸƣʱԳнڵ㣬
+
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// ģ node_handle
+//  Container Ϊڵĵײrb_tree  hashtableҪṩ
+// node_ptrkey_typemapped_typevalue_typevalue_traits Լ̬ destroy_node
+template <typename Container>
+class node_handle
+{
+	friend Container;
+
+public:
+	using container_type	= Container;
+	using key_type			= typename Container::key_type;
+	using mapped_type		= typename Container::mapped_type;
+	using value_type		= typename Container::value_type;
+
+private:
+	using node_ptr			= typename Container::node_ptr;
+	using value_traits		= typename Container::value_traits;
+
+	node_ptr node_;  // еĽڵ㣬ΪձʾΪ
+
+public:
+	// 졢ƶ
+	node_handle() noexcept :node_(nullptr) {}
+
+	node_handle(node_handle&& rhs) noexcept
+		:node_(rhs.node_)
+	{
+		rhs.node_ = nullptr;
+	}
+
+	node_handle& operator=(node_handle&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			reset();
+			node_ = rhs.node_;
+			rhs.node_ = nullptr;
+		}
+		return *this;
+	}
+
+	node_handle(const node_handle&) = delete;
+	node_handle& operator=(const node_handle&) = delete;
+
+	~node_handle() { reset(); }
+
+public:
+	bool empty() const noexcept { return node_ == nullptr; }
+	explicit operator bool() const noexcept { return node_ != nullptr; }
+
+	// ȡýڵеԪأ set 
+	value_type& value() const
+	{
+		MYSTL_DEBUG(node_ != nullptr);
+		return node_->value;
+	}
+
+	// ȡüֵڵ㲻У޸
+	key_type& key() const
+	{
+		MYSTL_DEBUG(node_ != nullptr);
+		return const_cast<key_type&>(value_traits::get_key(node_->value));
+	}
+
+	// ȡʵֵ map 
+	mapped_type& mapped() const
+	{
+		MYSTL_DEBUG(node_ != nullptr);
+		return node_->value.second;
+	}
+
+	void swap(node_handle& rhs) noexcept
+	{
+		mystl::swap(node_, rhs.node_);
+	}
+
+private:
+	// ºֻʹ
+	explicit node_handle(node_ptr p) noexcept :node_(p) {}
+
+	node_ptr get() const noexcept { return node_; }
+
+	// ԽڵȨؽڵ
+	node_ptr release() noexcept
+	{
+		auto p = node_;
+		node_ = nullptr;
+		return p;
+	}
+
+	void reset() noexcept
+	{
+		if (node_ != nullptr)
+		{
+			Container::destroy_node(node_);
+			node_ = nullptr;
+		}
+	}
+};
+
+//  mystl  swap
+template <typename Container>
+void swap(node_handle<Container>& lhs, node_handle<Container>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// ģ node_insert_return
+// inserted Ϊ true ʱ position ָ²Ԫأnode Ϊգ
+//  position ֵָ֮ظԪأΪʱΪ end()node ԳԭĽڵ
+template <typename Iterator, typename NodeType>
+struct node_insert_return
+{
+	Iterator position;
+	bool     inserted;
+	NodeType node;
+};
+
+} // namespace mystl
+#endif // !MY_STL_NODE_HANDLE_H_
@@ -0,0 +1,868 @@
+#ifndef MY_STL_PERSISTENT_MAP_H_
+#define MY_STL_PERSISTENT_MAP_H_
+
+// ͷļģ persistent_map
+// persistent_map : ־ûӳ䣬޸ʱֻƸĿλ·ϵĽ㣬ڸ汾֮乲
+
+// notes:
+//
+// ײһ AVL û parent ָ룬һͬʱڶ汾
+// ɽеԭüڡ
+//
+// һ persistent_mapȡգֻӸüӶ O(1)
+// ޸ʱԶ¼·ϵĽ㣺üΪ 1 Ľֻڵǰ汾ֱԭ޸ģ
+// ȸƸý㣨ӽü޸ĸÿβɾ
+// ิ O(log n) 㣬汾ֲ䡣ûйϵ޸
+// ͨƽһĽ㡣
+//
+// ̰߳ȫһ汾Ͳٱ޸ģȡղҪ
+// ͬ persistent_map ڲͬ߳ͬʱдʹǹ㣻
+// ͬһĲдʹͬ std::shared_ptr Լͬ
+//
+// Ӹǰ·ֻṩ const ʣͨ޸Ԫء
+// Ķ޸ĻٺʧЧȡղʹʧЧ
+//
+// 쳣֤
+// mystl::persistent_map<Key, T> 쳣֤µȺǿ쳣ȫ֤
+//   * emplace
+//   * insert
+//   * insert_or_assign
+//   * erase
+// ɾʱȸ֮޸ĵıĽ㣬һ׳쳣ıԪأ
+// ֮ӻժ㲢ƽ⣬ֻ漰ڵǰ汾Ľ㣬׳쳣
+
+#include <atomic>
+#include <initializer_list>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// persistent_map Ľ
+template <typename T>
+struct persistent_tree_node
+{
+	std::atomic<size_t>		refs;	// øýĸ persistent_map ĸ
+	persistent_tree_node*	left;
+	persistent_tree_node*	right;
+	int						height;	// ԸýΪĸ߶ȣҶΪ 1
+	T						value;
+};
+
+// persistent_map ĵֻܶȡԪ
+// û parent ָ룬һջӸǰ·
+template <typename T>
+struct persistent_tree_iterator :public mystl::iterator<mystl::bidirectional_iterator_tag, T,
+	ptrdiff_t, const T*, const T&>
+{
+	using value_type		= T;
+	using pointer			= const T*;
+	using reference			= const T&;
+	using node_ptr			= persistent_tree_node<T>*;
+	using self				= persistent_tree_iterator<T>;
+
+	// AVL ĸ߶Ȳ 1.44 log(n)64  2^44 ϵԪ
+	static constexpr int max_height = 64;
+
+	node_ptr root;				// ĸ㣬--end() ʱ￪ʼ
+	node_ptr path[max_height];	// path[0] Ϊ㣬path[depth - 1] Ϊǰ
+	int      depth;				// depth Ϊ 0 ʾ end()
+
+	persistent_tree_iterator() :root{ nullptr }, depth{ 0 } {}
+	explicit persistent_tree_iterator(node_ptr r) :root{ r }, depth{ 0 } {}
+
+	persistent_tree_iterator(const self& rhs)
+		:root{ rhs.root }, depth{ rhs.depth }
+	{
+		for (int i = 0; i < depth; ++i)
+			path[i] = rhs.path[i];
+	}
+
+	self& operator=(const self& rhs)
+	{
+		root = rhs.root;
+		depth = rhs.depth;
+		for (int i = 0; i < depth; ++i)
+			path[i] = rhs.path[i];
+		return *this;
+	}
+
+	node_ptr node() const { return depth == 0 ? nullptr : path[depth - 1]; }
+
+	reference operator*()  const { return path[depth - 1]->value; }
+	pointer   operator->() const { return &(operator*()); }
+
+	self& operator++()
+	{
+		MYSTL_DEBUG(depth > 0);
+		node_ptr cur = path[depth - 1];
+		if (cur->right != nullptr)
+		{
+			// Ϊ
+			for (cur = cur->right; cur != nullptr; cur = cur->left)
+				path[depth++] = cur;
+		}
+		else
+		{
+			// ϻݣֱصĳ
+			node_ptr child;
+			do
+			{
+				child = path[--depth];
+			} while (depth > 0 && path[depth - 1]->right == child);
+		}
+		return *this;
+	}
+
+	self operator++(int)
+	{
+		self tmp(*this);
+		++*this;
+		return tmp;
+	}
+
+	self& operator--()
+	{
+		if (depth == 0)
+		{
+			// end() ǰΪҽ㣬Ϊ
+			MYSTL_DEBUG(root != nullptr);
+			node_ptr cur = root;
+			do
+			{
+				path[depth++] = cur;
+				cur = cur->right;
+			} while (cur != nullptr);
+			return *this;
+		}
+		node_ptr cur = path[depth - 1];
+		if (cur->left != nullptr)
+		{
+			for (cur = cur->left; cur != nullptr; cur = cur->right)
+				path[depth++] = cur;
+		}
+		else
+		{
+			node_ptr child;
+			do
+			{
+				child = path[--depth];
+			} while (depth > 0 && path[depth - 1]->left == child);
+		}
+		return *this;
+	}
+
+	self operator--(int)
+	{
+		self tmp(*this);
+		--*this;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return node() == rhs.node(); }
+	bool operator!=(const self& rhs) const { return node() != rhs.node(); }
+};
+
+// ģ persistent_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ mystl::less
+template <typename Key, typename T, typename Compare = mystl::less<Key>>
+class persistent_map
+{
+public:
+	using key_type					= Key;
+	using mapped_type				= T;
+	using value_type				= mystl::pair<const Key, T>;
+	using key_compare				= Compare;
+
+	using node_type					= persistent_tree_node<value_type>;
+	using node_ptr					= node_type*;
+
+	using allocator_type			= mystl::allocator<value_type>;
+	using data_allocator			= mystl::allocator<value_type>;
+	using node_allocator			= mystl::allocator<node_type>;
+
+	using pointer					= const value_type*;
+	using const_pointer				= const value_type*;
+	using reference					= const value_type&;
+	using const_reference			= const value_type&;
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+
+	using iterator					= persistent_tree_iterator<value_type>;
+	using const_iterator			= persistent_tree_iterator<value_type>;
+	using reverse_iterator			= mystl::reverse_iterator<iterator>;
+	using const_reverse_iterator	= mystl::reverse_iterator<const_iterator>;
+
+	// Ϊ map һ£ṩһȽ value_type ĺ
+	class value_compare : public binary_function<value_type, value_type, bool>
+	{
+		friend class persistent_map<Key, T, Compare>;
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	public:
+		bool operator()(const value_type& lhs, const value_type& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	};
+
+private:
+	node_ptr	root_;			// 㣬Ϊ nullptr
+	size_type	node_count_;	// Ԫظ
+	key_compare	key_comp_;
+
+public:
+	// 졢ơƶ
+	persistent_map() :root_{ nullptr }, node_count_{ 0 }, key_comp_{} {}
+
+	explicit persistent_map(const Compare& comp)
+		:root_{ nullptr }, node_count_{ 0 }, key_comp_{ comp }
+	{
+	}
+
+	template <typename InputIterator>
+	persistent_map(InputIterator first, InputIterator last)
+		:root_{ nullptr }, node_count_{ 0 }, key_comp_{}
+	{
+		insert(first, last);
+	}
+
+	persistent_map(std::initializer_list<value_type> ilist)
+		:root_{ nullptr }, node_count_{ 0 }, key_comp_{}
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+	// Ƽȡգȫ
+	persistent_map(const persistent_map& rhs)
+		:root_{ retain(rhs.root_) }, node_count_{ rhs.node_count_ }, key_comp_{ rhs.key_comp_ }
+	{
+	}
+
+	persistent_map(persistent_map&& rhs) noexcept
+		:root_{ rhs.root_ }, node_count_{ rhs.node_count_ }, key_comp_{ rhs.key_comp_ }
+	{
+		rhs.root_ = nullptr;
+		rhs.node_count_ = 0;
+	}
+
+	persistent_map& operator=(const persistent_map& rhs)
+	{
+		if (this != &rhs)
+		{
+			node_ptr old = root_;
+			root_ = retain(rhs.root_);
+			node_count_ = rhs.node_count_;
+			key_comp_ = rhs.key_comp_;
+			release(old);
+		}
+		return *this;
+	}
+
+	persistent_map& operator=(persistent_map&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			release(root_);
+			root_ = rhs.root_;
+			node_count_ = rhs.node_count_;
+			key_comp_ = rhs.key_comp_;
+			rhs.root_ = nullptr;
+			rhs.node_count_ = 0;
+		}
+		return *this;
+	}
+
+	persistent_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~persistent_map() { release(root_); }
+
+public:
+	// ؽӿ
+
+	key_compare		key_comp()		const { return key_comp_; }
+	value_compare	value_comp()	const { return value_compare(key_comp_); }
+	allocator_type	get_allocator()	const { return allocator_type(); }
+
+	// ȡõǰ汾ĿգӶ O(1)
+	persistent_map	snapshot()		const { return *this; }
+
+	// 
+
+	iterator begin() const noexcept
+	{
+		iterator it(root_);
+		for (node_ptr cur = root_; cur != nullptr; cur = cur->left)
+			it.path[it.depth++] = cur;
+		return it;
+	}
+	iterator end() const noexcept
+	{ return iterator(root_); }
+
+	reverse_iterator rbegin() const noexcept
+	{ return reverse_iterator(end()); }
+	reverse_iterator rend() const noexcept
+	{ return reverse_iterator(begin()); }
+
+	const_iterator cbegin() const noexcept
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend() const noexcept
+	{ return rend(); }
+
+	// 
+	bool		empty()		const noexcept { return node_count_ == 0; }
+	size_type	size()		const noexcept { return node_count_; }
+	size_type	max_size()	const noexcept { return static_cast<size_type>(-1); }
+
+	// Ԫ
+
+	// ֵڣat ׳һ쳣
+	const mapped_type& at(const key_type& key) const
+	{
+		node_ptr p = find_node(key);
+		THROW_OUT_OF_RANGE_IF(p == nullptr, "persistent_map<Key, T> no such element exists");
+		return p->value.second;
+	}
+
+	// ɾ
+	// ޸ֻӰ쵱ǰ֮ǰȡõĿձֲ
+
+	template <typename ...Args>
+	pair<iterator, bool> emplace(Args&& ...args)
+	{
+		// ֵҪӲйȹ㣬ֵظʱ
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		try
+		{
+			if (find_node(np->value.first) != nullptr)
+			{
+				iterator it = find(np->value.first);
+				destroy_node(np);
+				return pair<iterator, bool>(it, false);
+			}
+		}
+		catch (...)
+		{
+			destroy_node(np);
+			throw;
+		}
+		return pair<iterator, bool>(insert_new_node(np), true);
+	}
+
+	pair<iterator, bool> insert(const value_type& value)
+	{
+		if (find_node(value.first) != nullptr)
+			return pair<iterator, bool>(find(value.first), false);
+		return pair<iterator, bool>(insert_new_node(create_node(value)), true);
+	}
+
+	pair<iterator, bool> insert(value_type&& value)
+	{
+		if (find_node(value.first) != nullptr)
+			return pair<iterator, bool>(find(value.first), false);
+		return pair<iterator, bool>(insert_new_node(create_node(mystl::move(value))), true);
+	}
+
+	template <typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			insert(*first);
+	}
+
+	// ֵѴʱ滻ʵֵ·ϱĽͬȸ
+	template <typename M>
+	pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+	{
+		if (find_node(key) == nullptr)
+			return pair<iterator, bool>(insert_new_node(create_node(key, mystl::forward<M>(obj))), true);
+		return pair<iterator, bool>(replace_node(create_node(key, mystl::forward<M>(obj))), false);
+	}
+
+	size_type erase(const key_type& key)
+	{
+		// ȱȽϼֵ·ķ򣬼ֵʱκν
+		bool right[iterator::max_height];
+		int n = 0;
+		node_ptr cur = root_;
+		while (cur != nullptr)
+		{
+			if (key_comp_(key, cur->value.first))
+			{
+				right[n++] = false;
+				cur = cur->left;
+			}
+			else if (key_comp_(cur->value.first, key))
+			{
+				right[n++] = true;
+				cur = cur->right;
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (cur == nullptr)
+			return 0;
+		erase_path(right, n);
+		--node_count_;
+		return 1;
+	}
+
+	void clear()
+	{
+		release(root_);
+		root_ = nullptr;
+		node_count_ = 0;
+	}
+
+	// 
+
+	iterator find(const key_type& key) const
+	{
+		iterator it(root_);
+		node_ptr cur = root_;
+		while (cur != nullptr)
+		{
+			it.path[it.depth++] = cur;
+			if (key_comp_(key, cur->value.first))
+				cur = cur->left;
+			else if (key_comp_(cur->value.first, key))
+				cur = cur->right;
+			else
+				return it;
+		}
+		return end();
+	}
+
+	size_type count(const key_type& key) const
+	{
+		return find_node(key) != nullptr ? 1 : 0;
+	}
+
+	// ֵС key ĵһλ
+	iterator lower_bound(const key_type& key) const
+	{
+		iterator it(root_);
+		int found = 0;  // ڵ·ȣ0 ʾ end()
+		for (node_ptr cur = root_; cur != nullptr; )
+		{
+			it.path[it.depth++] = cur;
+			if (!key_comp_(cur->value.first, key))
+			{
+				found = it.depth;
+				cur = cur->left;
+			}
+			else
+			{
+				cur = cur->right;
+			}
+		}
+		it.depth = found;
+		return it;
+	}
+
+	// ֵ key ĵһλ
+	iterator upper_bound(const key_type& key) const
+	{
+		iterator it(root_);
+		int found = 0;
+		for (node_ptr cur = root_; cur != nullptr; )
+		{
+			it.path[it.depth++] = cur;
+			if (key_comp_(key, cur->value.first))
+			{
+				found = it.depth;
+				cur = cur->left;
+			}
+			else
+			{
+				cur = cur->right;
+			}
+		}
+		it.depth = found;
+		return it;
+	}
+
+	pair<iterator, iterator> equal_range(const key_type& key) const
+	{
+		return pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+
+	void swap(persistent_map& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			mystl::swap(root_, rhs.root_);
+			mystl::swap(node_count_, rhs.node_count_);
+			mystl::swap(key_comp_, rhs.key_comp_);
+		}
+	}
+
+	// ǷͬһʱȽԪ
+	bool shares_root_with(const persistent_map& rhs) const noexcept
+	{
+		return root_ == rhs.root_;
+	}
+
+private:
+	// node related
+	template <typename ...Args>
+	static node_ptr create_node(Args&& ...args)
+	{
+		auto temp = node_allocator::allocate(1);
+		try
+		{
+			data_allocator::construct(mystl::address_of(temp->value), mystl::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			node_allocator::deallocate(temp);
+			throw;
+		}
+		::new (static_cast<void*>(mystl::address_of(temp->refs))) std::atomic<size_t>(1);
+		temp->left = nullptr;
+		temp->right = nullptr;
+		temp->height = 1;
+		return temp;
+	}
+
+	static void destroy_node(node_ptr p)
+	{
+		data_allocator::destroy(mystl::address_of(p->value));
+		node_allocator::deallocate(p);
+	}
+
+	static node_ptr retain(node_ptr p) noexcept
+	{
+		if (p != nullptr)
+			p->refs.fetch_add(1, std::memory_order_relaxed);
+		return p;
+	}
+
+	// һãһͷʱٽ㣬ݹͷӽ
+	static void release(node_ptr p) noexcept
+	{
+		while (p != nullptr && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			release(p->left);
+			node_ptr next = p->right;
+			destroy_node(p);
+			p = next;
+		}
+	}
+
+	// ֤ slot ָĽֻڵǰ汾Ҫʱһ滻
+	// ƵĽԭ㹲ӽ
+	static void make_unique(node_ptr& slot)
+	{
+		node_ptr p = slot;
+		if (p->refs.load(std::memory_order_acquire) == 1)
+			return;
+		node_ptr np = create_node(p->value);
+		np->left = retain(p->left);
+		np->right = retain(p->right);
+		np->height = p->height;
+		slot = np;
+		release(p);
+	}
+
+	node_ptr find_node(const key_type& key) const
+	{
+		node_ptr cur = root_;
+		while (cur != nullptr)
+		{
+			if (key_comp_(key, cur->value.first))
+				cur = cur->left;
+			else if (key_comp_(cur->value.first, key))
+				cur = cur->right;
+			else
+				return cur;
+		}
+		return nullptr;
+	}
+
+	// AVL ƽ
+	static int height(node_ptr p) noexcept { return p == nullptr ? 0 : p->height; }
+
+	static void update_height(node_ptr p) noexcept
+	{
+		const int lh = height(p->left);
+		const int rh = height(p->right);
+		p->height = (lh > rh ? lh : rh) + 1;
+	}
+
+	// ת slot Ѿֻڵǰ汾
+	static void rotate_left(node_ptr& slot)
+	{
+		node_ptr p = slot;
+		make_unique(p->right);
+		node_ptr r = p->right;
+		p->right = r->left;
+		r->left = p;
+		update_height(p);
+		update_height(r);
+		slot = r;
+	}
+
+	static void rotate_right(node_ptr& slot)
+	{
+		node_ptr p = slot;
+		make_unique(p->left);
+		node_ptr l = p->left;
+		p->left = l->right;
+		l->right = p;
+		update_height(p);
+		update_height(l);
+		slot = l;
+	}
+
+	static void rebalance(node_ptr& slot)
+	{
+		node_ptr p = slot;
+		const int diff = height(p->left) - height(p->right);
+		if (diff > 1)
+		{
+			if (height(p->left->left) < height(p->left->right))
+			{
+				make_unique(p->left);
+				rotate_left(p->left);
+			}
+			rotate_right(slot);
+		}
+		else if (diff < -1)
+		{
+			if (height(p->right->right) < height(p->right->left))
+			{
+				make_unique(p->right);
+				rotate_right(p->right);
+			}
+			rotate_left(slot);
+		}
+		else
+		{
+			update_height(p);
+		}
+	}
+
+	// ½ np 뵽вԪظָ np ĵǰȷϼֵ
+	// һԶ¸·ϱĽ㲢·Ƚ븴ƶ׳쳣
+	// ʱеԪûиı䣬np ٣ڶ np Եϵƽ⣬
+	// תֻ漰·ϵĽ㣬ڵǰ汾make_unique ٷ䣬׳쳣
+	iterator insert_new_node(node_ptr np)
+	{
+		node_ptr* path[iterator::max_height];
+		bool less[iterator::max_height];	// np ļֵǷС·϶Ӧļֵ
+		int depth = 0;
+		node_ptr* slot = &root_;
+		try
+		{
+			while (*slot != nullptr)
+			{
+				make_unique(*slot);
+				path[depth] = slot;
+				less[depth] = key_comp_(np->value.first, (*slot)->value.first);
+				slot = less[depth] ? &(*slot)->left : &(*slot)->right;
+				++depth;
+			}
+		}
+		catch (...)
+		{
+			destroy_node(np);
+			throw;
+		}
+		*slot = np;
+		++node_count_;
+		node_ptr nodes[iterator::max_height];
+		const int n = depth;
+		for (int i = 0; i < n; ++i)
+			nodes[i] = *path[i];
+		while (depth > 0)
+			rebalance(*path[--depth]);
+		// תıԪصĴnp ԭ·ϵĽ㣬µıȽϽһ npٵñȽϺ
+		iterator it(root_);
+		node_ptr cur = root_;
+		while (cur != np)
+		{
+			it.path[it.depth++] = cur;
+			int i = 0;
+			while (nodes[i] != cur)
+				++i;
+			cur = less[i] ? cur->left : cur->right;
+		}
+		it.path[it.depth++] = np;
+		return it;
+	}
+
+	//  np 滻ֵͬĽ㣬ָ np ĵǰȷϼֵ
+	// ·ϵĽȽ׳쳣ʱ np ûӵУ npеԪûиı
+	iterator replace_node(node_ptr np)
+	{
+		iterator it(root_);
+		node_ptr* slot = &root_;
+		try
+		{
+			while (true)
+			{
+				if (key_comp_(np->value.first, (*slot)->value.first))
+				{
+					make_unique(*slot);
+					it.path[it.depth++] = *slot;
+					slot = &(*slot)->left;
+				}
+				else if (key_comp_((*slot)->value.first, np->value.first))
+				{
+					make_unique(*slot);
+					it.path[it.depth++] = *slot;
+					slot = &(*slot)->right;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+		catch (...)
+		{
+			destroy_node(np);
+			throw;
+		}
+		node_ptr old = *slot;
+		np->left = retain(old->left);
+		np->right = retain(old->right);
+		np->height = old->height;
+		*slot = np;
+		release(old);
+		it.root = root_;
+		it.path[it.depth++] = np;
+		return it;
+	}
+
+	// ժ slot ΪеС㣬صĽֻڵǰ汾
+	static node_ptr take_min(node_ptr& slot)
+	{
+		make_unique(slot);
+		if (slot->left != nullptr)
+		{
+			node_ptr m = take_min(slot->left);
+			rebalance(slot);
+			return m;
+		}
+		node_ptr m = slot;
+		slot = m->right;
+		m->right = nullptr;
+		return m;
+	}
+
+	// ɾ q һܱ䰫һ㣨right_shrinks Ϊ true ʱһֵʱ
+	// ƽתֵܽ㣬˫תõֵܽ㿿ڵӽ㣬ȸЩ㡣ǰ q ڵǰ汾
+	static void prepare_rotation(node_ptr q, bool right_shrinks)
+	{
+		node_ptr& sibling = right_shrinks ? q->left : q->right;
+		if (height(sibling) <= height(right_shrinks ? q->right : q->left))
+			return;
+		make_unique(sibling);
+		node_ptr& inner = right_shrinks ? sibling->right : sibling->left;
+		if (height(inner) > height(right_shrinks ? sibling->left : sibling->right))
+			make_unique(inner);
+	}
+
+	// ɾ root_  right[0, n) ķ򵽴Ľ
+	// һ֮޸ĵıĽ㣺·ϵĽ㡢ɾĽ㡢·
+	// Լƽʱתֵܽ㡣ƿ׳쳣ıԪأ
+	// ڶժ㲢Եϵƽ⣬漰Ľ㶼ڵǰ汾make_unique ٷ䣬ҲٱȽϼֵ׳쳣
+	void erase_path(const bool* right, int n)
+	{
+		node_ptr* path[iterator::max_height];
+		node_ptr* slot = &root_;
+		for (int i = 0; i < n; ++i)
+		{
+			make_unique(*slot);
+			prepare_rotation(*slot, right[i]);
+			path[i] = slot;
+			slot = right[i] ? &(*slot)->right : &(*slot)->left;
+		}
+		make_unique(*slot);
+		node_ptr p = *slot;
+		if (p->left != nullptr && p->right != nullptr)
+		{
+			prepare_rotation(p, true);
+			for (node_ptr* s = &p->right; ; s = &(*s)->left)
+			{
+				make_unique(*s);
+				if ((*s)->left == nullptr)
+					break;
+				prepare_rotation(*s, false);
+			}
+		}
+
+		if (p->left == nullptr || p->right == nullptr)
+		{
+			// ֻһӽ㣬ƽģص
+			*slot = p->left != nullptr ? p->left : p->right;
+		}
+		else
+		{
+			// С汻ɾĽ㣬Ԫ
+			node_ptr m = take_min(p->right);
+			m->left = p->left;
+			m->right = p->right;
+			*slot = m;
+			rebalance(*slot);
+		}
+		p->left = nullptr;
+		p->right = nullptr;
+		release(p);
+		while (n > 0)
+			rebalance(*path[--n]);
+	}
+};
+
+// رȽϲ
+template <typename Key, typename T, typename Compare>
+bool operator==(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+	if (lhs.shares_root_with(rhs))
+		return true;
+	auto it1 = lhs.begin();
+	auto it2 = rhs.begin();
+	for (; it1 != lhs.end(); ++it1, ++it2)
+	{
+		if (!(it1->first == it2->first && it1->second == it2->second))
+			return false;
+	}
+	return true;
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator!=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+//  mystl  swap
+template <typename Key, typename T, typename Compare>
+void swap(persistent_map<Key, T, Compare>& lhs, persistent_map<Key, T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MY_STL_PERSISTENT_MAP_H_
@@ -0,0 +1,162 @@
+#ifndef MY_STL_PERSISTENT_MAP_TEST_H_
+#define MY_STL_PERSISTENT_MAP_TEST_H_
+
+// persistent_map test :  persistent_map Ľӿռ޸ĵ
+
+#include <map>
+
+#include "persistent_map.h"
+#include "map.h"
+#include "vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace persistent_map_test
+{
+
+// pair ĺ궨
+#define PERSISTENT_PAIR    mystl::pair<const int, int>
+
+// persistent_map ı
+#define PERSISTENT_MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// persistent_map ĺ
+#define PERSISTENT_MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    PERSISTENT_MAP_COUT(con); \
+} while(0)
+
+// persistent_map ĺֵ
+#define PERSISTENT_MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// һ len Ԫصӳ䣬֮󷢲 20 汾ÿ汾һ汾ĸ 16 ޸
+// һ汾һ汾ͷţԳоɿյͬ
+#define PERSISTENT_SNAPSHOT_DO_TEST(mode, con, len) do {     \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mode::con<int, int> cur;                                   \
+  for (size_t i = 0; i < len; ++i)                           \
+    cur.emplace(static_cast<int>(i), static_cast<int>(i));   \
+  start = clock();                                           \
+  for (int r = 0; r < 20; ++r)                               \
+  {                                                          \
+    mode::con<int, int> next(cur);                           \
+    for (int j = 0; j < 8; ++j)                              \
+    {                                                        \
+      next.erase(static_cast<int>(rand() % len));            \
+      next.emplace(static_cast<int>(len + rand()), r);       \
+    }                                                        \
+    cur = std::move(next);                                   \
+  }                                                          \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define PERSISTENT_SNAPSHOT_TEST(len1, len2, len3)           \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  PERSISTENT_SNAPSHOT_DO_TEST(std, map, len1);               \
+  PERSISTENT_SNAPSHOT_DO_TEST(std, map, len2);               \
+  PERSISTENT_SNAPSHOT_DO_TEST(std, map, len3);               \
+  std::cout << "\n|     mystl::map      |";                  \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, map, len1);             \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, map, len2);             \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, map, len3);             \
+  std::cout << "\n|mystl::persistent_map|";                  \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, persistent_map, len1);  \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, persistent_map, len2);  \
+  PERSISTENT_SNAPSHOT_DO_TEST(mystl, persistent_map, len3);
+
+void persistent_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : persistent_map -------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<mystl::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(mystl::pair<int, int>(i, i));
+    mystl::persistent_map<int, int> m1;
+    mystl::persistent_map<int, int, mystl::greater<int>> m2;
+    mystl::persistent_map<int, int> m3(v.begin(), v.end());
+    mystl::persistent_map<int, int> m4(m3);
+    mystl::persistent_map<int, int> m5(std::move(m3));
+    mystl::persistent_map<int, int> m6;
+    m6 = m4;
+    mystl::persistent_map<int, int> m7{ PERSISTENT_PAIR(1,1),PERSISTENT_PAIR(3,2),PERSISTENT_PAIR(2,3) };
+    mystl::persistent_map<int, int> m8;
+    m8 = { PERSISTENT_PAIR(1,1),PERSISTENT_PAIR(3,2),PERSISTENT_PAIR(2,3) };
+
+    for (int i = 5; i > 0; --i)
+    {
+        PERSISTENT_MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.insert(PERSISTENT_PAIR(0, 0)));
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.insert_or_assign(3, 30));
+    auto s1 = m1.snapshot();
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.erase(0));
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.insert_or_assign(4, 40));
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.emplace(9, 9));
+    PERSISTENT_MAP_COUT(s1);
+    FUN_VALUE(m1.count(0));
+    FUN_VALUE(s1.count(0));
+    FUN_VALUE(m1.at(3));
+    PERSISTENT_MAP_VALUE(*m1.find(4));
+    PERSISTENT_MAP_VALUE(*s1.find(4));
+    PERSISTENT_MAP_VALUE(*m1.lower_bound(6));
+    PERSISTENT_MAP_VALUE(*m1.upper_bound(2));
+    PERSISTENT_MAP_VALUE(*m1.rbegin());
+    auto first = *m1.equal_range(2).first;
+    auto second = *m1.equal_range(2).second;
+    std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+        << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+    std::cout << std::boolalpha;
+    FUN_VALUE((m1 == s1));
+    FUN_VALUE((m4 == m6));
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    FUN_VALUE(s1.size());
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.swap(m7));
+    PERSISTENT_MAP_FUN_AFTER(m1, m1.clear());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| 20 x (copy+16 edits)|";
+#if LARGER_TEST_DATA_ON
+    PERSISTENT_SNAPSHOT_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    PERSISTENT_SNAPSHOT_TEST(SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : persistent_map -------------]" << std::endl;
+}
+
+} // namespace persistent_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_PERSISTENT_MAP_TEST_H_
@@ -22,6 +22,8 @@
 // 5) һԣ䵽Ҷβ NIL ָÿһ·ͬĿĺڽ㡣
 
 #include <initializer_list>
+#include <future>
+#include <thread>
 
 #include <cassert>
 
@@ -30,6 +32,7 @@
 #include "memory.h"
 #include "type_traits.h"
 #include "exceptdef.h"
+#include "node_handle.h"
 
 namespace mystl
 {
@@ -40,6 +43,10 @@ using  rb_tree_color_type = bool;
 static constexpr rb_tree_color_type rb_tree_red = false;
 static constexpr rb_tree_color_type rb_tree_black = true;
 
+// ǩͣʾѾձȽ׼źֱ O(n) 
+struct from_sorted_range_t { explicit from_sorted_range_t() = default; };
+static constexpr from_sorted_range_t from_sorted_range{};
+
 // forward declaration
 template <typename T> struct rb_tree_node_base;
 template <typename T> struct rb_tree_node;
@@ -178,6 +185,21 @@ struct rb_tree_node :public rb_tree_node_base<T>
 	}
 };
 
+// СĽڵ㣬˳ͳorder statistic tree
+// size  value ֮ʹ value ƫ rb_tree_node ͬԲֵط
+template <typename T>
+struct rb_tree_size_node :public rb_tree_node<T>
+{
+	size_t size;	// ԸýڵΪĽڵ
+};
+
+// ˵Ľڵ㣬interval tree
+template <typename T, typename Endpoint>
+struct rb_tree_max_node :public rb_tree_node<T>
+{
+	Endpoint max_high;	// ԸýڵΪУҶ˵ֵ
+};
+
 // rb tree traits
 template <typename T>
 struct rb_tree_traits
@@ -284,8 +306,9 @@ struct rb_tree_iterator : public rb_tree_iterator_base<T>
 	rb_tree_iterator() {}
 	rb_tree_iterator(base_ptr x) { node = x; }
 	rb_tree_iterator(node_ptr x) { node = x; }	
-	rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
+	rb_tree_iterator(const iterator& rhs) = default;
 	rb_tree_iterator(const const_iterator& rhs) { node = rhs.node; }
+	iterator& operator=(const iterator& rhs) = default;
 
 	// ز
 	reference operator*()  const { return node->get_node_ptr()->value; }
@@ -338,7 +361,8 @@ struct rb_tree_const_iterator : public rb_tree_iterator_base<T>
 	rb_tree_const_iterator(base_ptr x) { node = x; }
 	rb_tree_const_iterator(node_ptr x) { node = x; }
 	rb_tree_const_iterator(const iterator& rhs) { node = rhs.node; }
-	rb_tree_const_iterator(const const_iterator& rhs) { node = rhs.node; }
+	rb_tree_const_iterator(const const_iterator& rhs) = default;
+	const_iterator& operator=(const const_iterator& rhs) = default;
 
 	// ز
 	reference operator*()  const { return node->get_node_ptr()->value; }
@@ -431,6 +455,113 @@ NodePtr rb_tree_next(NodePtr node) noexcept
 	return node->parent;
 }
 
+// ڵ㸽Ϣά
+// ת롢ɾı״󣬵 operator()(x)  x ӽڵ¼ x ĸϢ
+// copy(dst, src) ڸƽڵʱƸϢnode_type ΪʵʷĴиϢĽڵ
+
+// άκθϢ rb_tree ȱʡ
+struct rb_tree_no_augment
+{
+	template <typename NodePtr>
+	void operator()(NodePtr) const noexcept {}
+
+	template <typename NodePtr>
+	void copy(NodePtr, NodePtr) const noexcept {}
+};
+
+// άС O(log n)  nth / rank
+template <typename T>
+struct rb_tree_size_augment
+{
+	using node_type = rb_tree_size_node<T>;
+	using base_ptr  = rb_tree_node_base<T>*;
+	using size_ptr  = rb_tree_size_node<T>*;
+
+	static size_t size(base_ptr x) noexcept
+	{
+		return x == nullptr ? 0 : static_cast<size_ptr>(x)->size;
+	}
+
+	void operator()(base_ptr x) const noexcept
+	{
+		static_cast<size_ptr>(x)->size = size(x->left) + size(x->right) + 1;
+	}
+
+	void copy(base_ptr dst, base_ptr src) const noexcept
+	{
+		static_cast<size_ptr>(dst)->size = size(src);
+	}
+};
+
+// άҶ˵ֵصѯ
+// GetHigh ԪȡҶ˵㣬EndpointCompare Ƚ˵
+// ϢֱӸֵ˶˵Ҫƽ
+template <typename T, typename Endpoint, typename GetHigh, typename EndpointCompare>
+struct rb_tree_max_augment
+{
+	static_assert(std::is_trivially_copyable<Endpoint>::value,
+		"rb_tree_max_augment requires a trivially copyable endpoint type");
+
+	using node_type = rb_tree_max_node<T, Endpoint>;
+	using base_ptr  = rb_tree_node_base<T>*;
+	using max_ptr   = rb_tree_max_node<T, Endpoint>*;
+
+	static const Endpoint& max_high(base_ptr x) noexcept
+	{
+		return static_cast<max_ptr>(x)->max_high;
+	}
+
+	void operator()(base_ptr x) const noexcept
+	{
+		EndpointCompare comp;
+		const Endpoint* m = &GetHigh()(static_cast<max_ptr>(x)->value);
+		if (x->left != nullptr && comp(*m, max_high(x->left)))
+			m = &max_high(x->left);
+		if (x->right != nullptr && comp(*m, max_high(x->right)))
+			m = &max_high(x->right);
+		static_cast<max_ptr>(x)->max_high = *m;
+	}
+
+	void copy(base_ptr dst, base_ptr src) const noexcept
+	{
+		static_cast<max_ptr>(dst)->max_high = max_high(src);
+	}
+};
+
+// άʵʷĽڵͣάϢʱΪ rb_tree_node
+template <typename T, typename Augment>
+struct rb_tree_augment_node
+{
+	using type = typename Augment::node_type;
+};
+
+template <typename T>
+struct rb_tree_augment_node<T, rb_tree_no_augment>
+{
+	using type = rb_tree_node<T>;
+};
+
+// map / set һ bool ѡǷάС
+template <typename T, bool OrderStatistic>
+using rb_tree_select_augment = typename std::conditional<OrderStatistic,
+	rb_tree_size_augment<T>, rb_tree_no_augment>::type;
+
+//  x ʼֱڵ㣬¼㸽Ϣx  header
+template <typename NodePtr, typename Augment>
+void rb_tree_augment_propagate(NodePtr x, NodePtr root, Augment aug) noexcept
+{
+	if (root == nullptr)
+		return;
+	auto header = root->parent;
+	for (; x != header; x = x->parent)
+		aug(x);
+}
+
+template <typename NodePtr>
+void rb_tree_augment_propagate(NodePtr, NodePtr, rb_tree_no_augment) noexcept
+{
+}
+
 /*---------------------------------------*\
 |       p                         p       |
 |      / \                       / \      |
@@ -441,8 +572,8 @@ NodePtr rb_tree_next(NodePtr node) noexcept
 |     b   c                 a   b         |
 \*---------------------------------------*/
 // һΪ㣬Ϊڵ
-template <typename NodePtr>
-void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
+template <typename NodePtr, typename Augment = rb_tree_no_augment>
+void rb_tree_rotate_left(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept
 {
 	// y Ϊ x ӽڵ
 	auto y = x->right;
@@ -473,6 +604,10 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
 
 	y->left = x;
 	x->parent = y;
+
+	// x Ϊ y ӽڵ㣬ȸ x ٸ y
+	aug(x);
+	aug(y);
 }
 
 /*----------------------------------------*\
@@ -485,8 +620,8 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
 |   b   c                         c   a    |
 \*----------------------------------------*/
 // һΪ㣬Ϊڵ
-template <typename NodePtr>
-void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
+template <typename NodePtr, typename Augment = rb_tree_no_augment>
+void rb_tree_rotate_right(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept
 {
 	auto y = x->left;
 	x->left = y->right;
@@ -513,6 +648,9 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
 	//  x  y Ĺϵ
 	y->right = x;
 	x->parent = y;
+
+	aug(x);
+	aug(y);
 }
 
 // ڵʹ rb tree ƽ⣬һΪڵ㣬Ϊڵ
@@ -526,10 +664,14 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
 // case 5: ڵΪ죬ڵΪ NIL ɫڵΪңӣǰڵΪңӣ
 //         øڵΪɫ游ڵΪɫ游ڵΪ֧ң
 //
-template <typename NodePtr>
-void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
+// ֵʾڵǷɺڣʱĺڸ 1
+//
+template <typename NodePtr, typename Augment = rb_tree_no_augment>
+bool rb_tree_insert_rebalance(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept
 {
 	rb_tree_set_red(x);		// ڵΪɫ
+	// ڵ㵽ڵ·ϵĸϢ˱仯֮תֻάֲ
+	rb_tree_augment_propagate(x, root, aug);
 	
 	// ڵΪ
 	while (x != root && rb_tree_is_red(x->parent))
@@ -545,7 +687,7 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
 				rb_tree_set_black(x->parent);
 				rb_tree_set_black(uncle);
 				x = x->parent->parent;
-				rb_tree_is_red(x);
+				rb_tree_set_red(x);
 			}
 			else    // ڵڵΪ
 			{
@@ -553,12 +695,12 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
 				if (!rb_tree_is_lchild(x))
 				{
 					x = x->parent;
-					rb_tree_rotate_left(x, root);
+					rb_tree_rotate_left(x, root, aug);
 				}
 				// ת case 5 ǰڵΪӽڵ
 				rb_tree_set_black(x->parent);
 				rb_tree_set_red(x->parent->parent);
-				rb_tree_rotate_right(x->parent->parent, root);
+				rb_tree_rotate_right(x->parent->parent, root, aug);
 				break;
 			}
 		}
@@ -581,25 +723,28 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
 				if (rb_tree_is_lchild(x))
 				{ 
 					x = x->parent;
-					rb_tree_rotate_right(x, root);
+					rb_tree_rotate_right(x, root, aug);
 				}
 
 				// ת case 5 ǰڵΪӽڵ
 				rb_tree_set_black(x->parent);
 				rb_tree_set_red(x->parent->parent);
-				rb_tree_rotate_left(x->parent->parent, root);
+				rb_tree_rotate_left(x->parent->parent, root, aug);
 				break;
 			}
 		}
 	}
+	const bool grown = rb_tree_is_red(root);
 	rb_tree_set_black(root);  // ڵԶΪ
+	return grown;
 }
 
 // ɾڵʹ rb tree ƽ⣬һΪҪɾĽڵ㣬Ϊڵ㣬
 // ΪСڵ㣬Ϊڵ
 
-template <typename NodePtr>
-NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, NodePtr& rightmost)
+template <typename NodePtr, typename Augment = rb_tree_no_augment>
+NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, NodePtr& rightmost,
+	Augment aug = Augment())
 {
 	// y ǿܵ滻ڵ㣬ָҪɾĽڵ
 	auto y = (z->left == nullptr || z->right == nullptr) ? z : rb_tree_next(z);
@@ -688,6 +833,9 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 
 	}
 
+	// xp ϸڵһڵ㣬ڵɫת֮ǰȸ¸Ϣ
+	rb_tree_augment_propagate(xp, root, aug);
+
 	// ʱy ָҪɾĽڵ㣬x Ϊڵ㣬 x ڵ㿪ʼ
 	// ɾĽڵΪɫûбƻx ΪӽڵΪ
 	// case 1: ֵܽڵΪɫڵΪ죬ֵܽڵΪڣң
@@ -712,7 +860,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 				{
 					rb_tree_set_black(brother);
 					rb_tree_set_red(xp);
-					rb_tree_rotate_left(xp, root);
+					rb_tree_rotate_left(xp, root, aug);
 					brother = xp->right;
 				}
 
@@ -732,7 +880,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 						if (brother->left != nullptr)
 							rb_tree_set_black(brother->left);
 						rb_tree_set_red(brother);
-						rb_tree_rotate_right(brother, root);
+						rb_tree_rotate_right(brother, root, aug);
 						brother = xp->right;
 					}
 					// תΪ case 4
@@ -740,7 +888,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 					rb_tree_set_black(xp);
 					if (brother->right != nullptr)
 						rb_tree_set_black(brother->right);
-					rb_tree_rotate_left(xp, root);
+					rb_tree_rotate_left(xp, root, aug);
 					break;
 				}
 			}
@@ -751,7 +899,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 				{ // case 1
 					rb_tree_set_black(brother);
 					rb_tree_set_red(xp);
-					rb_tree_rotate_right(xp, root);
+					rb_tree_rotate_right(xp, root, aug);
 					brother = xp->left;
 				}
 				if ((brother->left == nullptr || !rb_tree_is_red(brother->left)) &&
@@ -768,7 +916,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 						if (brother->right != nullptr)
 							rb_tree_set_black(brother->right);
 						rb_tree_set_red(brother);
-						rb_tree_rotate_left(brother, root);
+						rb_tree_rotate_left(brother, root, aug);
 						brother = xp->left;
 					}
 					// תΪ case 4
@@ -776,7 +924,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 					rb_tree_set_black(xp);
 					if (brother->left != nullptr)
 						rb_tree_set_black(brother->left);
-					rb_tree_rotate_right(xp, root);
+					rb_tree_rotate_right(xp, root, aug);
 					break;
 				}
 			}
@@ -787,9 +935,37 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 	return y;
 }
 
+// rb_tree_emplace_key : ж emplace Ĳ decayֱܷӸֵIsMap ʾԪΪ pair
+// set ֻһֵ map ĲΪһ first Ϊֵ pairеһΪֵʱ value Ϊ true
+// ʱ get زеļֵemplace_unique ȲңֵѴʱعڵ
+// set Ķһֵһյļֵֻȹڵ
+template <bool IsMap, typename Key, typename ...Args>
+struct rb_tree_emplace_key : m_false_type {};
+
+template <typename Key>
+struct rb_tree_emplace_key<false, Key, Key> : m_true_type
+{
+	static const Key& get(const Key& key) noexcept { return key; }
+};
+
+template <typename Key, typename T1, typename T2>
+struct rb_tree_emplace_key<true, Key, mystl::pair<T1, T2>>
+	: m_bool_constant<std::is_same<typename std::remove_cv<T1>::type, Key>::value>
+{
+	static const Key& get(const mystl::pair<T1, T2>& value) noexcept { return value.first; }
+};
+
+template <typename Key, typename T>
+struct rb_tree_emplace_key<true, Key, Key, T> : m_true_type
+{
+	template <typename U>
+	static const Key& get(const Key& key, const U&) noexcept { return key; }
+};
+
 // ģ rb_tree
-// һֵͣȽ
-template <typename T, typename Compare>
+// һֵͣȽͣ
+// Ϊڵ㸽ϢάԣΪ rb_tree_size_augment ʱ֧ O(log n)  nth / rank / distance
+template <typename T, typename Compare, typename Augment = rb_tree_no_augment>
 class rb_tree
 {
 public:
@@ -808,8 +984,12 @@ public:
 
 	using allocator_type			= mystl::allocator<T>;
 	using data_allocator			= mystl::allocator<T>;
+	// ʵʷĽڵͼϢά
+	using augment_type				= Augment;
+	using storage_node_type			= typename rb_tree_augment_node<T, Augment>::type;
+
 	using base_allocator			= mystl::allocator<base_type>;
-	using node_allocator			= mystl::allocator<node_type>;
+	using node_allocator			= mystl::allocator<storage_node_type>;
 
 	using pointer					= allocator_type::pointer;
 	using const_pointer				= allocator_type::const_pointer;
@@ -823,9 +1003,22 @@ public:
 	using reverse_iterator			= mystl::reverse_iterator<iterator>;
 	using const_reverse_iterator	= mystl::reverse_iterator<const_iterator>;
 
+	using node_handle_type			= mystl::node_handle<rb_tree>;
+	using insert_return_type		= mystl::node_insert_return<iterator, node_handle_type>;
+
 	allocator_type get_allocator() const { return node_allocator(); }
+
+	// ڵҪٽڵ㣬merge Ҫһժ½ڵ
+	friend class mystl::node_handle<rb_tree>;
+	template <typename, typename, typename> friend class rb_tree;
 	key_compare    key_comp()      const { return key_comp_; }
 
+	// ǷάС
+	static constexpr bool order_statistic = mystl::is_same<Augment, rb_tree_size_augment<T>>::value;
+
+	// ڵ㣬ʱΪ nullptrϢĲʹãصѯ
+	base_ptr root_node() const noexcept { return root(); }
+
 private:
 	// ݱ rb tree
 	base_ptr    header_;      // ڵ㣬ڵ㻥ΪԷĸڵ
@@ -971,20 +1164,12 @@ public:
 	}
 
 	// ͵زԪأֵظ
+	// ֱӸֵʱȲҲλãֵѴ򲻹ڵ
 	template <typename ...Args>
 	mystl::pair<iterator, bool> emplace_unique(Args&& ...args)
 	{
-		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
-		node_ptr np = create_node(mystl::forward<Args>(args)...);
-		auto res = get_insert_unique_pos(value_traits::get_key(np->value));
-		
-		// ɹ
-		if (res.second)
-		{ 
-			return mystl::make_pair(insert_node_at(res.first.first, np, res.first.second), true);
-		}
-		destroy_node(np);
-		return mystl::make_pair(iterator(res.first.first), false);
+		using key_arg = rb_tree_emplace_key<value_traits::is_map, key_type, typename std::decay<Args>::type...>;
+		return emplace_unique_aux(m_bool_constant<key_arg::value>(), mystl::forward<Args>(args)...);
 	}
 
 	// ͵زԪأֵظ hint λλýӽʱʱ临ӶȿԽ
@@ -999,7 +1184,7 @@ public:
 			return insert_node_at(header_, np, true);
 		}
 
-		key_type key = value_traits::get_key(np->value);
+		const key_type& key = value_traits::get_key(np->value);
 
 		// λ begin 
 		if (hint == begin())
@@ -1033,48 +1218,65 @@ public:
 	template <typename ...Args>
 	iterator emplace_unique_use_hint(iterator hint, Args&& ...args)
 	{
+		using key_arg = rb_tree_emplace_key<value_traits::is_map, key_type, typename std::decay<Args>::type...>;
+		return emplace_unique_use_hint_aux(m_bool_constant<key_arg::value>(), hint,
+			mystl::forward<Args>(args)...);
+	}
+
+	// try_emplace / insert_or_assignֻ map
+	// Ȱ key ңֵʱŷڵ㣬 key  args ʵֵԪأ
+	// ֵѴʱκζargs Ҳᱻƶ
+	template <typename K, typename ...Args>
+	mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args)
+	{
+		auto res = get_insert_unique_pos(key);
+		if (!res.second)
+			return mystl::pair<iterator, bool>(iterator(res.first.first), false);
 		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
-		node_ptr np = create_node(mystl::forward<Args>(args)...);
-		if (node_count_ == 0)
-		{
-			return insert_node_at(header_, np, true);
-		}
-		key_type key = value_traits::get_key(np->value);
-		if (hint == begin())
+		node_ptr np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+		return mystl::pair<iterator, bool>(insert_node_at(res.first.first, np, res.first.second), true);
+	}
+
+	template <typename K, typename ...Args>
+	iterator try_emplace_unique_use_hint(iterator hint, K&& key, Args&& ...args)
+	{
+		auto res = get_insert_unique_pos_use_hint(hint, key);
+		if (!res.second)
+			return iterator(res.first.first);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+		return insert_node_at(res.first.first, np, res.first.second);
+	}
+
+	// ֵѴʱ obj ʵֵԪأֵĵڶʾǷ
+	template <typename K, typename M>
+	mystl::pair<iterator, bool> insert_or_assign_unique(K&& key, M&& obj)
+	{
+		auto res = get_insert_unique_pos(key);
+		if (!res.second)
 		{
-			if (key_comp_(key, value_traits::get_key(*hint)))
-			{
-				return insert_node_at(hint.node, np, true);
-			}
-			else
-			{
-				auto pos = get_insert_unique_pos(key);
-				if (!pos.second)
-				{
-					destroy_node(np);
-					return pos.first.first;
-				}
-				return insert_node_at(pos.first.first, np, pos.first.second);
-			}
+			iterator it(res.first.first);
+			it->second = mystl::forward<M>(obj);
+			return mystl::pair<iterator, bool>(it, false);
 		}
-		else if (hint == end())
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<K>(key), mystl::forward<M>(obj));
+		return mystl::pair<iterator, bool>(insert_node_at(res.first.first, np, res.first.second), true);
+	}
+
+	template <typename K, typename M>
+	iterator insert_or_assign_unique_use_hint(iterator hint, K&& key, M&& obj)
+	{
+		auto res = get_insert_unique_pos_use_hint(hint, key);
+		if (!res.second)
 		{
-			if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key))
-			{
-				return insert_node_at(rightmost(), np, false);
-			}
-			else
-			{
-				auto pos = get_insert_unique_pos(key);
-				if (!pos.second)
-				{
-					destroy_node(np);
-					return pos.first.first;
-				}
-				return insert_node_at(pos.first.first, np, pos.first.second);
-			}
+			iterator it(res.first.first);
+			it->second = mystl::forward<M>(obj);
+			return it;
 		}
-		return insert_unique_use_hint(hint, key, np);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<K>(key), mystl::forward<M>(obj));
+		return insert_node_at(res.first.first, np, res.first.second);
 	}
 
 	// insert
@@ -1105,6 +1307,27 @@ public:
 	{
 		size_type n = mystl::distance(first, last);
 		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+		// 䲻ݼʱֱ O(n) 
+		if (node_count_ == 0 && n > 1 && is_sorted_range(first, last, false))
+		{
+			build_from_sorted(first, n);
+			return;
+		}
+		for (; n > 0; --n, ++first)
+			insert_multi(end(), *first);
+	}
+
+	// ֤߱䲻ݼټ
+	template <class InputIterator>
+	void insert_multi(from_sorted_range_t, InputIterator first, InputIterator last)
+	{
+		size_type n = mystl::distance(first, last);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+		if (node_count_ == 0)
+		{
+			build_from_sorted(first, n);
+			return;
+		}
 		for (; n > 0; --n, ++first)
 			insert_multi(end(), *first);
 	}
@@ -1139,6 +1362,27 @@ public:
 	{
 		size_type n = mystl::distance(first, last);
 		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+		// ϸʱֱ O(n) 
+		if (node_count_ == 0 && n > 1 && is_sorted_range(first, last, true))
+		{
+			build_from_sorted(first, n);
+			return;
+		}
+		for (; n > 0; --n, ++first)
+			insert_unique(end(), *first);
+	}
+
+	// ֤߱ϸûظֵټ
+	template <class InputIterator>
+	void insert_unique(from_sorted_range_t, InputIterator first, InputIterator last)
+	{
+		size_type n = mystl::distance(first, last);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+		if (node_count_ == 0)
+		{
+			build_from_sorted(first, n);
+			return;
+		}
 		for (; n > 0; --n, ++first)
 			insert_unique(end(), *first);
 	}
@@ -1151,7 +1395,7 @@ public:
 		iterator next(node);
 		++next;
 
-		rb_tree_erase_rebalance(hint.node, root(), leftmost(), rightmost());
+		rb_tree_erase_rebalance(hint.node, root(), leftmost(), rightmost(), augment_type());
 		destroy_node(node);
 		--node_count_;
 		return next;
@@ -1203,157 +1447,306 @@ public:
 		}
 	}
 
-	// rb_tree ز
-	// ҼֵΪ k Ľڵ㣬ָĵ
-	iterator find(const key_type& key)
+	// node handle
+	// ڵ֮תʱֻ޸ӣ·ڵ㣬ҲƻƶԪء
+	// иϢĽڵͨڵĲֲֻͬά֮ͬתơ
+
+	// ժ position Ľڵ㣬ڵ
+	node_handle_type extract(const_iterator position)
 	{
-		auto y = header_;
-		auto x = root();
-		while (x != nullptr)
+		return node_handle_type(extract_node(position.node));
+	}
+
+	// ժµһֵ key Ľڵ㣬ʱؿյľ
+	node_handle_type extract(const key_type& key)
+	{
+		auto it = find(key);
+		return it == end() ? node_handle_type() : extract(it);
+	}
+
+	// еĽڵ㣬ֵظʧʱڵɷֵеľ
+	insert_return_type insert_unique(node_handle_type&& nh)
+	{
+		if (nh.empty())
+			return insert_return_type{ end(), false, node_handle_type() };
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		auto res = get_insert_unique_pos(value_traits::get_key(nh.get()->value));
+		if (!res.second)
+			return insert_return_type{ iterator(res.first.first), false, mystl::move(nh) };
+		auto it = insert_node_at(res.first.first, nh.release(), res.first.second);
+		return insert_return_type{ it, true, node_handle_type() };
+	}
+
+	// еĽڵ㣬ֵظΪʱ end()
+	iterator insert_multi(node_handle_type&& nh)
+	{
+		if (nh.empty())
+			return end();
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		auto res = get_insert_multi_pos(value_traits::get_key(nh.get()->value));
+		return insert_node_at(res.first, nh.release(), res.second);
+	}
+
+	//  source мֵڱвڵĽڵƵڵ source 
+	template <typename Compare2>
+	void merge_unique(rb_tree<T, Compare2, Augment>& source)
+	{
+		if (static_cast<void*>(&source) == static_cast<void*>(this))
+			return;
+		for (auto it = source.begin(); it != source.end(); )
 		{
-			// key <= x.val left
-			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-			{
-				y = x;
-				x = x->left;
-			}
-			else    // key > x.val right
-			{
-				x = x->right;
-			}
+			auto cur = it++;
+			auto res = get_insert_unique_pos(value_traits::get_key(*cur));
+			if (res.second)
+				insert_node_at(res.first.first, source.extract_node(cur.node), res.first.second);
 		}
-		iterator j = iterator(y);
-		return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 	}
-	const_iterator find(const key_type& key) const
+
+	//  source еȫڵƵ
+	template <typename Compare2>
+	void merge_multi(rb_tree<T, Compare2, Augment>& source)
 	{
-		auto y = header_;  // һС key Ľڵ
-		auto x = root();
-		while (x != nullptr)
+		if (static_cast<void*>(&source) == static_cast<void*>(this))
+			return;
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - source.size(), "rb_tree<T, Comp>'s size too big");
+		for (auto it = source.begin(); it != source.end(); )
 		{
-			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-			{
-				y = x;
-				x = x->left;
-			}
-			else
-			{ 
-				x = x->right;
-			}
+			auto cur = it++;
+			auto res = get_insert_multi_pos(value_traits::get_key(*cur));
+			insert_node_at(res.first, source.extract_node(cur.node), res.second);
 		}
-		const_iterator j = const_iterator(y);
+	}
+
+	// rb_tree ز
+	// ²ҺĲǼֵ KֻҪȽϺֱӱȽ K ֵ
+	// ֻڱȽϺ͸ is_transparentʱŰʹ
+
+	// ҼֵΪ k Ľڵ㣬ָĵ
+	template <typename K>
+	iterator find(const K& key)
+	{
+		iterator j = iterator(lower_bound_node(key));
+		return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+	}
+	template <typename K>
+	const_iterator find(const K& key) const
+	{
+		const_iterator j = const_iterator(lower_bound_node(key));
 		return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 	}
 
-	size_type count_multi(const key_type& key) const
+	template <typename K>
+	size_type count_multi(const K& key) const
 	{
 		auto p = equal_range_multi(key);
 		return static_cast<size_type>(mystl::distance(p.first, p.second));
 	}
-	size_type count_unique(const key_type& key) const
+	template <typename K>
+	size_type count_unique(const K& key) const
 	{
 		return find(key) != end() ? 1 : 0;
 	}
 
 	// ֵС key ĵһλ
-	iterator lower_bound(const key_type& key)
+	template <typename K>
+	iterator lower_bound(const K& key)
 	{
-		auto y = header_;
-		auto x = root();
-		while (x != nullptr)
-		{
-			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-			{
-				y = x;
-				x = x->left;
-			}
-			else
-			{
-				x = x->right;
-			}
-		}
-		return iterator(y);
+		return iterator(lower_bound_node(key));
 	}
-	const_iterator lower_bound(const key_type& key) const
+	template <typename K>
+	const_iterator lower_bound(const K& key) const
 	{
-		auto y = header_;
+		return const_iterator(lower_bound_node(key));
+	}
+
+	// ֵ key ĵһλ
+	template <typename K>
+	iterator upper_bound(const K& key)
+	{
+		return iterator(upper_bound_node(key));
+	}
+	template <typename K>
+	const_iterator upper_bound(const K& key) const
+	{
+		return const_iterator(upper_bound_node(key));
+	}
+
+	template <typename K>
+	mystl::pair<iterator, iterator>
+		equal_range_multi(const K& key)
+	{
+		return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+	template <typename K>
+	mystl::pair<const_iterator, const_iterator>
+		equal_range_multi(const K& key) const
+	{
+		return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+	}
+
+	template <typename K>
+	mystl::pair<iterator, iterator>
+		equal_range_unique(const K& key)
+	{
+		iterator it = find(key);
+		auto next = it;
+		return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+	}
+	template <typename K>
+	mystl::pair<const_iterator, const_iterator>
+		equal_range_unique(const K& key) const
+	{
+		const_iterator it = find(key);
+		auto next = it;
+		return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+	}
+
+	// ˳ͳزֻάΪ rb_tree_size_augment ʱãӶȾΪ O(log n)
+
+	// ص k Ԫأ 0 ʼƣĵk == size() ʱ end()
+	iterator nth(size_type k)
+	{
+		return iterator(nth_node(k));
+	}
+	const_iterator nth(size_type k) const
+	{
+		return const_iterator(nth_node(k));
+	}
+
+	// ؼֵС key Ԫظ lower_bound(key) ڵλ
+	template <typename K>
+	size_type rank(const K& key) const
+	{
+		static_assert(order_statistic, "rank requires rb_tree<T, Comp, rb_tree_size_augment<T>>");
+		size_type r = 0;
 		auto x = root();
 		while (x != nullptr)
 		{
 			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
 			{
-				y = x;
 				x = x->left;
 			}
 			else
 			{
+				r += augment_type::size(x->left) + 1;
 				x = x->right;
 			}
 		}
-		return const_iterator(y);
+		return r;
 	}
 
-	iterator upper_bound(const key_type& key)
+	// صڵλãend() λΪ size()
+	size_type index_of(const_iterator position) const
 	{
-		auto y = header_;
-		auto x = root();
-		while (x != nullptr)
+		static_assert(order_statistic, "index_of requires rb_tree<T, Comp, rb_tree_size_augment<T>>");
+		base_ptr x = position.node;
+		if (x == header_)
+			return node_count_;
+		size_type r = augment_type::size(x->left);
+		for (; x != root(); x = x->parent)
 		{
-			if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
-			{
-				y = x;
-				x = x->left;
-			}
-			else
-			{
-				x = x->right;
-			}
+			if (!rb_tree_is_lchild(x))
+				r += augment_type::size(x->parent->left) + 1;
 		}
-		return iterator(y);
-	}
-	const_iterator upper_bound(const key_type& key) const
-	{
-		auto y = header_;
-		auto x = root();
-		while (x != nullptr)
-		{
-			if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
-			{
-				y = x;
-				x = x->left;
-			}
-			else
-			{
-				x = x->right;
-			}
-		}
-		return const_iterator(y);
+		return r;
 	}
 
-	mystl::pair<iterator, iterator>
-		equal_range_multi(const key_type& key)
+	// ش first  last ľ
+	difference_type distance(const_iterator first, const_iterator last) const
 	{
-		return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
-	}
-	mystl::pair<const_iterator, const_iterator>
-		equal_range_multi(const key_type& key) const
-	{
-		return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		return static_cast<difference_type>(index_of(last)) -
+			static_cast<difference_type>(index_of(first));
 	}
 
-	mystl::pair<iterator, iterator>
-		equal_range_unique(const key_type& key)
-	{
-		iterator it = find(key);
-		auto next = it;
-		return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
-	}
-	mystl::pair<const_iterator, const_iterator>
-		equal_range_unique(const key_type& key) const
+	//  join / split ļϲ
+	// ֱӲ֡еĽڵԪء
+	// union_with / intersect_with / difference_with ֻڼֵظ
+	// ӶΪ O(m log(n / m + 1))mn ֱΪСͽϴԪظ
+	// parallel Ϊ true Ԫ㹻ʱĵݹ齻ͬ߳ɡ
+	// ϲҪȽϺ׳쳣
+
+	// ѼֵС key ԪƵ right Уright ԭеԪر
+	// ֱΪ O(log n)δάСͳԪظСһ
+	void split(const key_type& key, rb_tree& right)
 	{
-		const_iterator it = find(key);
-		auto next = it;
-		return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+		MYSTL_DEBUG(this != &right);
+		right.clear();
+		if (node_count_ == 0)
+			return;
+		const size_type n = node_count_;
+		const size_type h = black_height(root());
+		base_ptr l = nullptr, r = nullptr;
+		size_type hl = 0, hr = 0;
+		split_lower(take_root(), h, key, l, hl, r, hr);
+		adopt_root(l, 0);
+		right.adopt_root(r, 0);
+		const size_type left_n = count_split(right, n);
+		node_count_ = left_n;
+		right.node_count_ = n - left_n;
+	}
+
+	//  right ԪȫӵβҪ right еļֵСڣֵΨһʱڣеļֵ
+	// Ӷ O(log n)ɺ right Ϊ
+	void join(rb_tree& right)
+	{
+		if (this == &right || right.node_count_ == 0)
+			return;
+		MYSTL_DEBUG(node_count_ == 0 ||
+			!key_comp_(value_traits::get_key(right.leftmost()->get_node_ptr()->value),
+				value_traits::get_key(rightmost()->get_node_ptr()->value)));
+		const size_type n = node_count_ + right.node_count_;
+		const size_type hl = black_height(root());
+		const size_type hr = black_height(right.root());
+		size_type h = 0;
+		auto l = take_root();
+		auto r = right.take_root();
+		adopt_root(join_tree(l, hl, r, hr, h), n);
+	}
+
+	// rhs Ľڵ뱾ֵظʱԪأɺ rhs Ϊ
+	void union_with(rb_tree& rhs, bool parallel = false)
+	{
+		if (this == &rhs || rhs.node_count_ == 0)
+			return;
+		const size_type n = node_count_ + rhs.node_count_;
+		const size_type h1 = black_height(root());
+		const size_type h2 = black_height(rhs.root());
+		size_type h = 0, dup = 0;
+		auto t1 = take_root();
+		auto t2 = rhs.take_root();
+		auto t = union_node(t1, h1, t2, h2, h, dup, fork_depth(n, parallel));
+		adopt_root(t, n - dup);
+	}
+
+	// ɾмֵ rhs еԪأrhs 
+	void intersect_with(const rb_tree& rhs, bool parallel = false)
+	{
+		if (this == &rhs || node_count_ == 0)
+			return;
+		const size_type n = node_count_;
+		const size_type h1 = black_height(root());
+		size_type h = 0, removed = 0;
+		auto t = intersect_node(take_root(), h1, rhs.root(), h, removed,
+			fork_depth(n + rhs.node_count_, parallel));
+		adopt_root(t, n - removed);
+	}
+
+	// ɾмֵ rhs гֵԪأrhs 
+	void difference_with(const rb_tree& rhs, bool parallel = false)
+	{
+		if (this == &rhs)
+		{
+			clear();
+			return;
+		}
+		if (node_count_ == 0 || rhs.node_count_ == 0)
+			return;
+		const size_type n = node_count_;
+		const size_type h1 = black_height(root());
+		size_type h = 0, removed = 0;
+		auto t = difference_node(take_root(), h1, rhs.root(), h, removed,
+			fork_depth(n + rhs.node_count_, parallel));
+		adopt_root(t, n - removed);
 	}
 
 	void swap(rb_tree& rhs) noexcept
@@ -1395,16 +1788,98 @@ private:
 	{
 		node_ptr temp = create_node(node->get_node_ptr()->value);
 		temp->color = node->color;
+		augment_type().copy(temp->get_base_ptr(), node);
 		temp->left = nullptr;
 		temp->right = nullptr;
 		return temp;
 	}
 
 	// һ
-	void destroy_node(node_ptr p)
+	static void destroy_node(node_ptr p)
 	{
 		data_allocator::destroy(&p->value);
-		node_allocator::deallocate(p);
+		node_allocator::deallocate(static_cast<storage_node_type*>(p));
+	}
+
+	// ѽڵժµ٣صĽڵ㲻ӵκνڵ
+	node_ptr extract_node(base_ptr p)
+	{
+		rb_tree_erase_rebalance(p, root(), leftmost(), rightmost(), augment_type());
+		--node_count_;
+		p->parent = nullptr;
+		p->left = nullptr;
+		p->right = nullptr;
+		return p->get_node_ptr();
+	}
+
+	// һֵС key Ľڵ㣬ʱΪ header_
+	template <typename K>
+	base_ptr lower_bound_node(const K& key) const
+	{
+		auto y = header_;
+		auto x = root();
+		while (x != nullptr)
+		{
+			// key <= x.val left
+			if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
+			{
+				y = x;
+				x = x->left;
+			}
+			else    // key > x.val right
+			{
+				x = x->right;
+			}
+		}
+		return y;
+	}
+
+	// һֵ key Ľڵ㣬ʱΪ header_
+	template <typename K>
+	base_ptr upper_bound_node(const K& key) const
+	{
+		auto y = header_;
+		auto x = root();
+		while (x != nullptr)
+		{
+			if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
+			{
+				y = x;
+				x = x->left;
+			}
+			else
+			{
+				x = x->right;
+			}
+		}
+		return y;
+	}
+
+	// С²ҵ k ڵ
+	base_ptr nth_node(size_type k) const
+	{
+		static_assert(order_statistic, "nth requires rb_tree<T, Comp, rb_tree_size_augment<T>>");
+		THROW_OUT_OF_RANGE_IF(k > node_count_, "rb_tree<T, Comp>'s nth out of range");
+		if (k == node_count_)
+			return header_;
+		auto x = root();
+		while (true)
+		{
+			const size_type left = augment_type::size(x->left);
+			if (k < left)
+			{
+				x = x->left;
+			}
+			else if (k == left)
+			{
+				return x;
+			}
+			else
+			{
+				k -= left + 1;
+				x = x->right;
+			}
+		}
 	}
 
 	// init / reset
@@ -1485,8 +1960,8 @@ private:
 		{ 
 			return mystl::make_pair(mystl::make_pair(y, add_to_left), true);
 		}
-		// ˣʾ½ڵнڵֵظ
-		return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
+		// ˣʾ½ڵнڵֵظظĽڵ
+		return mystl::make_pair(mystl::make_pair(j.node, add_to_left), false);
 	}
 
 	// insert value / insert node
@@ -1519,7 +1994,7 @@ private:
 				rightmost() = base_node;
 			}
 		}
-		rb_tree_insert_rebalance(base_node, root());
+		rb_tree_insert_rebalance(base_node, root(), augment_type());
 		++node_count_;
 		return iterator(node);
 	}
@@ -1548,14 +2023,14 @@ private:
 			if (rightmost() == x)
 				rightmost() = base_node;
 		}
-		rb_tree_insert_rebalance(base_node, root());
+		rb_tree_insert_rebalance(base_node, root(), augment_type());
 		++node_count_;
 		return iterator(node);
 	}
 
 	// insert use hint
 	// Ԫأֵظʹ hint
-	iterator insert_multi_use_hint(iterator hint, key_type key, node_ptr node)
+	iterator insert_multi_use_hint(iterator hint, const key_type& key, node_ptr node)
 	{
 		//  hint Ѱҿɲλ
 		auto np = hint.node;
@@ -1578,33 +2053,95 @@ private:
 		return insert_node_at(pos.first, node, pos.second);
 	}
 
-	// Ԫأֵظʹ hint
-	iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
+	//  hint ѰҼֵ key Ĳλãֵظֵ get_insert_unique_pos ͬ
+	mystl::pair<mystl::pair<base_ptr, bool>, bool>
+		get_insert_unique_pos_use_hint(iterator hint, const key_type& key)
 	{
-		//  hint Ѱҿɲλ
-		auto np = hint.node;
-		auto before = hint;
-		--before;
-		auto bnp = before.node;
-		if (key_comp_(value_traits::get_key(*before), key) &&
-			key_comp_(key, value_traits::get_key(*hint)))
-		{ // before < node < hint
-			if (bnp->right == nullptr)
-			{
-				return insert_node_at(bnp, node, false);
-			}
-			else if (np->left == nullptr)
-			{
-				return insert_node_at(np, node, true);
+		using pos_type = mystl::pair<base_ptr, bool>;
+		using res_type = mystl::pair<pos_type, bool>;
+		if (node_count_ == 0)
+		{
+			return res_type(pos_type(header_, true), true);
+		}
+		if (hint == begin())
+		{
+			if (key_comp_(key, value_traits::get_key(*hint)))
+				return res_type(pos_type(hint.node, true), true);
+		}
+		else if (hint == end())
+		{
+			if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key))
+				return res_type(pos_type(rightmost(), false), true);
+		}
+		else
+		{
+			auto before = hint;
+			--before;
+			if (key_comp_(value_traits::get_key(*before), key) &&
+				key_comp_(key, value_traits::get_key(*hint)))
+			{ // before < node < hint
+				if (before.node->right == nullptr)
+					return res_type(pos_type(before.node, false), true);
+				else if (hint.node->left == nullptr)
+					return res_type(pos_type(hint.node, true), true);
 			}
 		}
-		auto pos = get_insert_unique_pos(key);
-		if (!pos.second)
+		return get_insert_unique_pos(key);
+	}
+
+	// emplace unique
+	// кмֵȲٹڵ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_unique_aux(m_true_type, Args&& ...args)
+	{
+		using key_arg = rb_tree_emplace_key<value_traits::is_map, key_type, typename std::decay<Args>::type...>;
+		auto res = get_insert_unique_pos(key_arg::get(args...));
+		if (!res.second)
+			return mystl::pair<iterator, bool>(iterator(res.first.first), false);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		return mystl::pair<iterator, bool>(insert_node_at(res.first.first, np, res.first.second), true);
+	}
+
+	// ֻȹڵܵõֵ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_unique_aux(m_false_type, Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		auto res = get_insert_unique_pos(value_traits::get_key(np->value));
+		if (!res.second)
 		{
-			destroy_node(node);
-			return pos.first.first;
+			destroy_node(np);
+			return mystl::pair<iterator, bool>(iterator(res.first.first), false);
 		}
-		return insert_node_at(pos.first.first, node, pos.first.second);
+		return mystl::pair<iterator, bool>(insert_node_at(res.first.first, np, res.first.second), true);
+	}
+
+	template <typename ...Args>
+	iterator emplace_unique_use_hint_aux(m_true_type, iterator hint, Args&& ...args)
+	{
+		using key_arg = rb_tree_emplace_key<value_traits::is_map, key_type, typename std::decay<Args>::type...>;
+		auto res = get_insert_unique_pos_use_hint(hint, key_arg::get(args...));
+		if (!res.second)
+			return iterator(res.first.first);
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		return insert_node_at(res.first.first, np, res.first.second);
+	}
+
+	template <typename ...Args>
+	iterator emplace_unique_use_hint_aux(m_false_type, iterator hint, Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+		node_ptr np = create_node(mystl::forward<Args>(args)...);
+		auto res = get_insert_unique_pos_use_hint(hint, value_traits::get_key(np->value));
+		if (!res.second)
+		{
+			destroy_node(np);
+			return iterator(res.first.first);
+		}
+		return insert_node_at(res.first.first, np, res.first.second);
 	}
 
 	// copy tree / erase tree
@@ -1639,59 +2176,524 @@ private:
 		return top;
 	}
 
-	//  x ڵ㿪ʼɾýڵ㼰
-	void erase_since(base_ptr x)
+	// build from sorted range
+	// жǷѰ key_comp_ strict Ϊ true ʱҪϸ
+	// ֻԪصļֵ key_type ͬȽʱʱ
+	template <class InputIterator>
+	bool is_sorted_range(InputIterator first, InputIterator last, bool strict)
+	{
+		using iter_value = typename iterator_traits<InputIterator>::value_type;
+		using iter_key = typename rb_tree_value_traits<iter_value>::key_type;
+		return is_sorted_range_aux(first, last, strict,
+			m_bool_constant<is_forward_iterator<InputIterator>::value &&
+			std::is_same<iter_key, key_type>::value>());
+	}
+
+	template <class ForwardIterator>
+	bool is_sorted_range_aux(ForwardIterator first, ForwardIterator last, bool strict, m_true_type)
+	{
+		auto next = first;
+		for (++next; next != last; ++first, ++next)
+		{
+			const bool ordered = strict
+				? key_comp_(value_traits::get_key(*first), value_traits::get_key(*next))
+				: !key_comp_(value_traits::get_key(*next), value_traits::get_key(*first));
+			if (!ordered)
+				return false;
+		}
+		return true;
+	}
+
+	template <class InputIterator>
+	bool is_sorted_range_aux(InputIterator, InputIterator, bool, m_false_type)
+	{
+		return false;
+	}
+
+	// ڿǰ n Ԫؽһƽĺ
+	// ڵ㣬ÿԪֻһΣκαȽϺת
+	// һĽڵȾɺɫȾɺɫƽ⻮¿ָֻ㣬
+	// ÿ·ϵĺڽڵͬ
+	template <class InputIterator>
+	void build_from_sorted(InputIterator& first, size_type n)
+	{
+		if (n == 0)
+			return;
+		size_type red_depth = 0;
+		for (size_type m = n; m > 1; m >>= 1)
+			++red_depth;
+		root() = build_sorted_subtree(first, n, 0, red_depth, header_);
+		rb_tree_set_black(root());
+		leftmost() = rb_tree_min(root());
+		rightmost() = rb_tree_max(root());
+		node_count_ = n;
+	}
+
+	// ݹ齨 n ڵdepth Ϊڵȣp Ϊڵĸڵ
+	template <class InputIterator>
+	base_ptr build_sorted_subtree(InputIterator& first, size_type n, size_type depth,
+		size_type red_depth, base_ptr p)
+	{
+		if (n == 0)
+			return nullptr;
+		const size_type left_n = (n - 1) / 2;
+		base_ptr left = build_sorted_subtree(first, left_n, depth + 1, red_depth, nullptr);
+		node_ptr top = nullptr;
+		try
+		{
+			top = create_node(*first);
+		}
+		catch (...)
+		{
+			erase_since(left);
+			throw;
+		}
+		++first;
+		top->color = depth == red_depth ? rb_tree_red : rb_tree_black;
+		top->parent = p;
+		top->left = left;
+		if (left != nullptr)
+			left->parent = top;
+		try
+		{
+			top->right = build_sorted_subtree(first, n - 1 - left_n, depth + 1, red_depth, top);
+		}
+		catch (...)
+		{
+			erase_since(top);
+			throw;
+		}
+		augment_type()(top->get_base_ptr());
+		return top;
+	}
+
+	// join / split
+	// º headerڵ parent Ϊ nullptrڵΪɫ
+	// h ͷĲʾĺڸߣڵ㵽 NIL ·Ϻڽڵĸڵ㣩
+
+	// ʹмϲ̵ֳ߳СԪظ
+	static constexpr size_type parallel_threshold = 1 << 16;
+
+	// ·ĺڸ
+	static size_type black_height(base_ptr x) noexcept
+	{
+		size_type h = 0;
+		for (; x != nullptr; x = x->left)
+		{
+			if (!rb_tree_is_red(x))
+				++h;
+		}
+		return h;
+	}
+
+	// ӽڵĺڸ
+	static size_type child_height(base_ptr x, size_type h) noexcept
+	{
+		return rb_tree_is_red(x) ? h : h - 1;
+	}
+
+	static base_ptr detach(base_ptr x) noexcept
+	{
+		if (x != nullptr)
+			x->parent = nullptr;
+		return x;
+	}
+
+	// ȡΪ
+	base_ptr take_root() noexcept
+	{
+		auto x = detach(root());
+		root() = nullptr;
+		leftmost() = header_;
+		rightmost() = header_;
+		node_count_ = 0;
+		return x;
+	}
+
+	//  x Ϊڵ¹ҵ header 
+	void adopt_root(base_ptr x, size_type n) noexcept
+	{
+		root() = x;
+		node_count_ = n;
+		if (x == nullptr)
+		{
+			leftmost() = header_;
+			rightmost() = header_;
+			return;
+		}
+		x->parent = header_;
+		rb_tree_set_black(root());
+		leftmost() = rb_tree_min(x);
+		rightmost() = rb_tree_max(x);
+	}
+
+	// split ֮ͳƱԪظn Ϊ
+	size_type count_split(const rb_tree& right, size_type n) const
+	{
+		return count_split_aux(right, n, m_bool_constant<order_statistic>());
+	}
+
+	size_type count_split_aux(const rb_tree&, size_type, m_true_type) const
+	{
+		return augment_type::size(root());
+	}
+
+	// ûСʱͬʱ࣬Сһ
+	size_type count_split_aux(const rb_tree& right, size_type n, m_false_type) const
+	{
+		auto a = cbegin();
+		auto b = right.cbegin();
+		size_type k = 0;
+		for (; a != cend() && b != right.cend(); ++a, ++b)
+			++k;
+		return a == cend() ? k : n - k;
+	}
+
+	//  k Ϊмڵ l  rl еļֵ kr еļֵС k
+	// µĸڵ㣬h ΪĺڸߣӶ O(|hl - hr| + 1)
+	base_ptr join_node(base_ptr l, size_type hl, base_ptr k, base_ptr r, size_type hr,
+		size_type& h) noexcept
+	{
+		if (l != nullptr && rb_tree_is_red(l))
+		{
+			rb_tree_set_black(l);
+			++hl;
+		}
+		if (r != nullptr && rb_tree_is_red(r))
+		{
+			rb_tree_set_black(r);
+			++hr;
+		}
+		if (hl == hr)
+		{
+			k->parent = nullptr;
+			k->left = l;
+			k->right = r;
+			if (l != nullptr)
+				l->parent = k;
+			if (r != nullptr)
+				r->parent = k;
+			rb_tree_set_black(k);
+			augment_type()(k);
+			h = hl + 1;
+			return k;
+		}
+
+		// ؽϸһң󣩲·£ҵϰڸͬĺɫڵ㣨Ϊ NIL
+		// Ժɫ k 滻λãٰķʽ
+		const bool on_right = hl > hr;
+		base_ptr root = on_right ? l : r;
+		const size_type target = on_right ? hr : hl;
+		size_type hx = on_right ? hl : hr;
+		base_ptr p = nullptr;
+		base_ptr x = root;
+		while (hx != target || (x != nullptr && rb_tree_is_red(x)))
+		{
+			if (!rb_tree_is_red(x))
+				--hx;
+			p = x;
+			x = on_right ? x->right : x->left;
+		}
+		k->parent = p;
+		if (on_right)
+		{
+			k->left = x;
+			k->right = r;
+			p->right = k;
+			if (r != nullptr)
+				r->parent = k;
+		}
+		else
+		{
+			k->left = l;
+			k->right = x;
+			p->left = k;
+			if (l != nullptr)
+				l->parent = k;
+		}
+		if (x != nullptr)
+			x->parent = k;
+		h = on_right ? hl : hr;
+		if (rb_tree_insert_rebalance(k, root, augment_type()))
+			++h;
+		return root;
+	}
+
+	//  l  rl еļֵ r еļֵ
+	base_ptr join_tree(base_ptr l, size_type hl, base_ptr r, size_type hr, size_type& h) noexcept
 	{
+		if (l == nullptr)
+		{
+			h = hr;
+			return r;
+		}
+		if (r == nullptr)
+		{
+			h = hl;
+			return l;
+		}
+		base_ptr last = nullptr;
+		size_type hrest = 0;
+		auto rest = split_last(l, hl, last, hrest);
+		return join_node(rest, hrest, last, r, hr, h);
+	}
+
+	// ӷǿ x ȡĽڵ lastʣಿ
+	base_ptr split_last(base_ptr x, size_type hx, base_ptr& last, size_type& h) noexcept
+	{
+		const size_type hc = child_height(x, hx);
+		auto l = detach(x->left);
+		auto r = detach(x->right);
+		if (r == nullptr)
+		{
+			last = x;
+			h = hc;
+			return l;
+		}
+		size_type hr = 0;
+		r = split_last(r, hc, last, hr);
+		return join_node(l, hc, x, r, hr, h);
+	}
+
+	//  x ΪֵС key  l ֵС key  r
+	void split_lower(base_ptr x, size_type hx, const key_type& key,
+		base_ptr& l, size_type& hl, base_ptr& r, size_type& hr)
+	{
+		if (x == nullptr)
+		{
+			l = r = nullptr;
+			hl = hr = 0;
+			return;
+		}
+		const size_type hc = child_height(x, hx);
+		auto xl = detach(x->left);
+		auto xr = detach(x->right);
+		if (key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
+		{
+			base_ptr rl = nullptr;
+			size_type hrl = 0;
+			split_lower(xr, hc, key, rl, hrl, r, hr);
+			l = join_node(xl, hc, x, rl, hrl, hl);
+		}
+		else
+		{
+			base_ptr lr = nullptr;
+			size_type hlr = 0;
+			split_lower(xl, hc, key, l, hl, lr, hlr);
+			r = join_node(lr, hlr, x, xr, hc, hr);
+		}
+	}
+
+	// ѼֵΨһ x ΪֵС key  l key  r ͵ key Ľڵ midΪ nullptr
+	void split_node(base_ptr x, size_type hx, const key_type& key,
+		base_ptr& l, size_type& hl, base_ptr& mid, base_ptr& r, size_type& hr)
+	{
+		if (x == nullptr)
+		{
+			l = mid = r = nullptr;
+			hl = hr = 0;
+			return;
+		}
+		const size_type hc = child_height(x, hx);
+		auto xl = detach(x->left);
+		auto xr = detach(x->right);
+		const key_type& xkey = value_traits::get_key(x->get_node_ptr()->value);
+		if (key_comp_(key, xkey))
+		{
+			base_ptr lr = nullptr;
+			size_type hlr = 0;
+			split_node(xl, hc, key, l, hl, mid, lr, hlr);
+			r = join_node(lr, hlr, x, xr, hc, hr);
+		}
+		else if (key_comp_(xkey, key))
+		{
+			base_ptr rl = nullptr;
+			size_type hrl = 0;
+			split_node(xr, hc, key, rl, hrl, mid, r, hr);
+			l = join_node(xl, hc, x, rl, hrl, hl);
+		}
+		else
+		{
+			l = xl;
+			hl = hc;
+			r = xr;
+			hr = hc;
+			mid = x;
+		}
+	}
+
+	// мϲֳĲÿ߳
+	static size_type fork_depth(size_type n, bool parallel)
+	{
+		if (!parallel || n < parallel_threshold)
+			return 0;
+		size_type depth = 1;
+		for (auto t = std::thread::hardware_concurrency(); t > 1; t >>= 1)
+			++depth;
+		return depth;
+	}
+
+	// ִ left  rightdepth Ϊ 0 ʱ left ̣߳ right ͬʱִ
+	template <class Left, class Right>
+	static void fork_join(size_type depth, Left left, Right right)
+	{
+		if (depth == 0)
+		{
+			left();
+			right();
+			return;
+		}
+		auto task = std::async(std::launch::async, left);
+		right();
+		task.get();
+	}
+
+	//  t1  t2 Ĳֵͬʱ t1 Ľڵ㣬dup ۼӱٵ t2 еĽڵ
+	base_ptr union_node(base_ptr t1, size_type h1, base_ptr t2, size_type h2,
+		size_type& h, size_type& dup, size_type depth)
+	{
+		if (t1 == nullptr)
+		{
+			h = h2;
+			return t2;
+		}
+		if (t2 == nullptr)
+		{
+			h = h1;
+			return t1;
+		}
+		const size_type hc = child_height(t1, h1);
+		auto l1 = detach(t1->left);
+		auto r1 = detach(t1->right);
+		base_ptr l2 = nullptr, m = nullptr, r2 = nullptr;
+		size_type hl2 = 0, hr2 = 0;
+		split_node(t2, h2, value_traits::get_key(t1->get_node_ptr()->value), l2, hl2, m, r2, hr2);
+		if (m != nullptr)
+		{
+			destroy_node(m->get_node_ptr());
+			++dup;
+		}
+		base_ptr l = nullptr, r = nullptr;
+		size_type hl = 0, hr = 0, dup_l = 0, dup_r = 0;
+		const size_type next = depth == 0 ? 0 : depth - 1;
+		fork_join(depth,
+			[&]() { l = union_node(l1, hc, l2, hl2, hl, dup_l, next); },
+			[&]() { r = union_node(r1, hc, r2, hr2, hr, dup_r, next); });
+		dup += dup_l + dup_r;
+		return join_node(l, hl, t1, r, hr, h);
+	}
+
+	//  t1  t2 Ľt1 в t2 Ľڵ㱻ٲۼӵ removedt2 ֻ
+	base_ptr intersect_node(base_ptr t1, size_type h1, base_ptr t2,
+		size_type& h, size_type& removed, size_type depth)
+	{
+		if (t1 == nullptr)
+		{
+			h = 0;
+			return nullptr;
+		}
+		if (t2 == nullptr)
+		{
+			removed += erase_since(t1);
+			h = 0;
+			return nullptr;
+		}
+		base_ptr l1 = nullptr, m = nullptr, r1 = nullptr;
+		size_type hl1 = 0, hr1 = 0;
+		split_node(t1, h1, value_traits::get_key(t2->get_node_ptr()->value), l1, hl1, m, r1, hr1);
+		base_ptr l = nullptr, r = nullptr;
+		size_type hl = 0, hr = 0, removed_l = 0, removed_r = 0;
+		const size_type next = depth == 0 ? 0 : depth - 1;
+		fork_join(depth,
+			[&]() { l = intersect_node(l1, hl1, t2->left, hl, removed_l, next); },
+			[&]() { r = intersect_node(r1, hr1, t2->right, hr, removed_r, next); });
+		removed += removed_l + removed_r;
+		return m != nullptr ? join_node(l, hl, m, r, hr, h) : join_tree(l, hl, r, hr, h);
+	}
+
+	//  t1  t2 Ĳt1  t2 ֵĽڵ㱻ٲۼӵ removedt2 ֻ
+	base_ptr difference_node(base_ptr t1, size_type h1, base_ptr t2,
+		size_type& h, size_type& removed, size_type depth)
+	{
+		if (t1 == nullptr || t2 == nullptr)
+		{
+			h = h1;
+			return t1;
+		}
+		base_ptr l1 = nullptr, m = nullptr, r1 = nullptr;
+		size_type hl1 = 0, hr1 = 0;
+		split_node(t1, h1, value_traits::get_key(t2->get_node_ptr()->value), l1, hl1, m, r1, hr1);
+		if (m != nullptr)
+		{
+			destroy_node(m->get_node_ptr());
+			++removed;
+		}
+		base_ptr l = nullptr, r = nullptr;
+		size_type hl = 0, hr = 0, removed_l = 0, removed_r = 0;
+		const size_type next = depth == 0 ? 0 : depth - 1;
+		fork_join(depth,
+			[&]() { l = difference_node(l1, hl1, t2->left, hl, removed_l, next); },
+			[&]() { r = difference_node(r1, hr1, t2->right, hr, removed_r, next); });
+		removed += removed_l + removed_r;
+		return join_tree(l, hl, r, hr, h);
+	}
+
+	//  x ڵ㿪ʼɾýڵ㼰ɾĽڵ
+	size_type erase_since(base_ptr x)
+	{
+		size_type n = 0;
 		while (x != nullptr)
 		{
-			erase_since(x->right);
+			n += erase_since(x->right);
 			auto y = x->left;
 			destroy_node(x->get_node_ptr());
 			x = y;
+			++n;
 		}
+		return n;
 	}
 };
 
 // رȽϲ
-template <typename T, typename Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator==(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <typename T, typename Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator<(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, typename Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator!=(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <typename T, typename Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator>(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return rhs < lhs;
 }
 
-template <typename T, typename Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator<=(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return !(rhs < lhs);
 }
 
-template <typename T, typename Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
+template <typename T, typename Compare, typename Augment>
+bool operator>=(const rb_tree<T, Compare, Augment>& lhs, const rb_tree<T, Compare, Augment>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <typename T, typename Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept
+template <typename T, typename Compare, typename Augment>
+void swap(rb_tree<T, Compare, Augment>& lhs, rb_tree<T, Compare, Augment>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
@@ -0,0 +1,881 @@
+#ifndef MY_STL_ROBIN_HOOD_HASHTABLE_H_
+#define MY_STL_ROBIN_HOOD_HASHTABLE_H_
+
+// ͷļһģ robin_hood_hashtable
+// robin_hood_hashtable : Ŷַ̽Ĺϣʱ Robin Hood λԶԪȣɾʱǰƶ
+
+// notes:
+//
+// ֣
+//   * bucket  n Ϊ 2 ݣԪصλΪɢĹϣֵĵλ
+//   * ۲ƣn  bucket ֮ٽ min(n, 255) ۣԪֻ̽⣬
+//     ˵˳ǲ۵˳ǰƶԪҲԽͷ
+//   * dist_ Ϊÿ۱һֽڣ0 Ϊղۣd + 1 ΪԪλ d ۣ
+//     dist_[] Ϊڱȡֵ 1ڴֹͣκ̽⵽Ҳֹͣ
+//   * ֵϴܰλƣַʱ hashes_ ÿԪصĹϣֵ
+//     ȽϼֵǰȱȽϹϣֵƶԪ¹ϣʱҲٵùϣ
+//     СġɰλƵļֵָȣϣֵÿֻռһֽڡ
+//
+// ʱλÿʼ̽⣬ԪСĲ۾ռֱղ۵Ԫһλ
+// ȵǰ̽СĲۼɶ϶ֵڡ˸Ԫص̽
+//  0.9 ʱ̽Ȼ̣ܶʺʱĳϡ
+//
+// ɾĹ벻Ϊ 0 ԪǰһλѾһbackward shift
+// ״̬δɾԪʱͬ
+//
+// 볬 254 ̽⵽۵ĩβʱǰݡԪؿ԰λʱƶ¹ϣֱӸڴ档
+// ¹ϣȷ鲢ȷܷȫԪأһλ飬ϣ׳쳣ʱ䡣
+// ɾƶԪأ֮ǰȡõԪصָ֮ʧЧҪԪصƶ첻׳쳣
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// ֽڵޣ0 ʾղۣ1 ~ 255 ʾ 0 ~ 254
+constexpr uint8_t rh_dist_max = 255;
+
+// ձõľ飬ֻһڱʹձ begin() == end() ҲҪڴ
+inline uint8_t* rh_empty_dist() noexcept
+{
+	static uint8_t sentinel[1] = { 1 };
+	return sentinel;
+}
+
+// ֵСҿ԰λʱϣֵ
+template <typename Key>
+struct rh_compact_key
+	:public m_bool_constant<std::is_trivially_copyable<Key>::value &&
+		sizeof(Key) <= 2 * sizeof(size_t)> {};
+
+// Ԫؿ԰λʱֱӸڴƶmystl::pair Զ˸ֵԱж
+template <typename T>
+struct rh_trivially_relocatable :public m_bool_constant<std::is_trivially_copyable<T>::value> {};
+
+template <typename T1, typename T2>
+struct rh_trivially_relocatable<mystl::pair<T1, T2>>
+	:public m_bool_constant<std::is_trivially_copyable<T1>::value &&
+		std::is_trivially_copyable<T2>::value> {};
+
+// robin_hood_hashtable ĵֽ۵ָ룬ǰʱղۣڱֹͣ
+template <typename T, typename Ref, typename Ptr>
+struct rh_iterator :public mystl::iterator<mystl::forward_iterator_tag, T, ptrdiff_t, Ptr, Ref>
+{
+	using self				= rh_iterator<T, Ref, Ptr>;
+	using reference			= Ref;
+	using pointer			= Ptr;
+
+	const uint8_t*	dist;
+	T*				slot;
+
+	rh_iterator() noexcept :dist{ nullptr }, slot{ nullptr } {}
+	rh_iterator(const uint8_t* d, T* s) noexcept :dist{ d }, slot{ s } {}
+	//  const תΪ const дģ壬ƹ븴Ƹֵɱ
+	template <typename R, typename P, mystl::enable_if_t<
+		std::is_convertible<P, Ptr>::value, int> = 0>
+	rh_iterator(const rh_iterator<T, R, P>& rhs) noexcept :dist{ rhs.dist }, slot{ rhs.slot } {}
+
+	reference operator*()  const { return *slot; }
+	pointer   operator->() const { return slot; }
+
+	self& operator++()
+	{
+		do
+		{
+			++dist;
+			++slot;
+		} while (*dist == 0);
+		return *this;
+	}
+
+	self operator++(int)
+	{
+		self tmp(*this);
+		++*this;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return dist == rhs.dist; }
+	bool operator!=(const self& rhs) const { return dist != rhs.dist; }
+};
+
+// ģ robin_hood_hashtableֵظ
+// һԪͣϣֵȵıȽϺ
+template <typename T, typename Hash, typename KeyEqual>
+class robin_hood_hashtable
+{
+public:
+	using value_traits				= ht_value_traits<T>;
+	using key_type					= typename value_traits::key_type;
+	using mapped_type				= typename value_traits::mapped_type;
+	using value_type				= typename value_traits::value_type;
+	using hasher					= Hash;
+	using key_equal					= KeyEqual;
+
+	using allocator_type			= mystl::allocator<T>;
+	using data_allocator			= mystl::allocator<T>;
+	using dist_allocator			= mystl::allocator<uint8_t>;
+	using hash_allocator			= mystl::allocator<size_t>;
+
+	using pointer					= typename allocator_type::pointer;
+	using const_pointer				= typename allocator_type::const_pointer;
+	using reference					= typename allocator_type::reference;
+	using const_reference			= typename allocator_type::const_reference;
+	using size_type					= typename allocator_type::size_type;
+	using difference_type			= typename allocator_type::difference_type;
+
+	using iterator					= rh_iterator<T, T&, T*>;
+	using const_iterator			= rh_iterator<T, const T&, const T*>;
+
+	using compact_tag				= rh_compact_key<key_type>;
+	using relocate_tag				= rh_trivially_relocatable<T>;
+
+	static constexpr size_type npos	= static_cast<size_type>(-1);
+
+	allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+	uint8_t*	dist_;		//  + 1 ֽڣһΪڱ
+	T*			slots_;
+	size_t*		hashes_;	// ÿ۵ĹϣֵϣֵʱΪ nullptr
+	size_type	buckets_;	// bucket Ϊ 0  2 
+	size_type	size_;
+	float		mlf_;
+	hasher		hash_;
+	key_equal	equal_;
+
+public:
+	// 졢ơƶ
+	explicit robin_hood_hashtable(size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual())
+		:dist_(rh_empty_dist()), slots_(nullptr), hashes_(nullptr),
+		buckets_(0), size_(0), mlf_(0.9f), hash_(hash), equal_(equal)
+	{
+		if (bucket_count > 0)
+			rehash(bucket_count);
+	}
+
+	robin_hood_hashtable(const robin_hood_hashtable& rhs);
+
+	robin_hood_hashtable(robin_hood_hashtable&& rhs) noexcept
+		:dist_(rhs.dist_), slots_(rhs.slots_), hashes_(rhs.hashes_), buckets_(rhs.buckets_),
+		size_(rhs.size_), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_)
+	{
+		rhs.reset_empty();
+	}
+
+	robin_hood_hashtable& operator=(const robin_hood_hashtable& rhs)
+	{
+		if (this != &rhs)
+		{
+			robin_hood_hashtable tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	robin_hood_hashtable& operator=(robin_hood_hashtable&& rhs) noexcept
+	{
+		robin_hood_hashtable tmp(mystl::move(rhs));
+		swap(tmp);
+		return *this;
+	}
+
+	~robin_hood_hashtable()
+	{
+		clear();
+		deallocate_arrays(dist_, slots_, hashes_, buckets_);
+	}
+
+	// ز
+	iterator begin() noexcept
+	{ return make_begin<iterator>(); }
+	const_iterator begin() const noexcept
+	{ return make_begin<const_iterator>(); }
+	iterator end() noexcept
+	{ return iterator(dist_ + slot_count(), slots_ + slot_count()); }
+	const_iterator end() const noexcept
+	{ return const_iterator(dist_ + slot_count(), slots_ + slot_count()); }
+
+	const_iterator cbegin() const noexcept
+	{ return begin(); }
+	const_iterator cend() const noexcept
+	{ return end(); }
+
+	// ز
+	bool		empty()		const noexcept { return size_ == 0; }
+	size_type	size()		const noexcept { return size_; }
+	size_type	max_size()	const noexcept { return static_cast<size_type>(-1) / (sizeof(T) + 1); }
+
+	// ޸ز
+
+	// emplace / try_emplace
+
+	// ȹԪزܵõֵֵѴʱԪ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_unique(Args&& ...args)
+	{
+		T tmp(mystl::forward<Args>(args)...);
+		return emplace_key(value_traits::get_key(tmp), mystl::move(tmp));
+	}
+
+	// ֵѴʱκζ󣬷 args ڲԭعԪ
+	template <typename ...Args>
+	mystl::pair<iterator, bool> emplace_key(const key_type& key, Args&& ...args);
+
+	mystl::pair<iterator, bool> insert_unique(const value_type& value)
+	{
+		return emplace_key(value_traits::get_key(value), value);
+	}
+	mystl::pair<iterator, bool> insert_unique(value_type&& value)
+	{
+		return emplace_key(value_traits::get_key(value), mystl::move(value));
+	}
+
+	template <typename InputIter>
+	void insert_unique(InputIter first, InputIter last)
+	{
+		for (; first != last; ++first)
+			insert_unique(*first);
+	}
+
+	// erase / clear
+
+	// ɾԪǰƣָԭһԪصĵ
+	iterator erase(const_iterator position)
+	{
+		const size_type idx = static_cast<size_type>(position.slot - slots_);
+		erase_index(idx);
+		iterator it(dist_ + idx, slots_ + idx);
+		if (dist_[idx] == 0)
+			++it;
+		return it;
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		// Ԫػǰƣlast ٿɿҪɾĸ
+		size_type n = 0;
+		for (const_iterator it = first; it != last; ++it)
+			++n;
+		iterator it(first.dist, const_cast<T*>(first.slot));
+		for (; n > 0; --n)
+			it = erase(it);
+		return it;
+	}
+
+	size_type erase_unique(const key_type& key)
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		if (idx == npos)
+			return 0;
+		erase_index(idx);
+		return 1;
+	}
+
+	void clear();
+
+	void swap(robin_hood_hashtable& rhs) noexcept;
+
+	// ز
+
+	size_type count(const key_type& key) const
+	{
+		return find_index(key, hash_code(key)) == npos ? 0 : 1;
+	}
+
+	iterator find(const key_type& key)
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		return idx == npos ? end() : iterator(dist_ + idx, slots_ + idx);
+	}
+	const_iterator find(const key_type& key) const
+	{
+		const size_type idx = find_index(key, hash_code(key));
+		return idx == npos ? end() : const_iterator(dist_ + idx, slots_ + idx);
+	}
+
+	mystl::pair<iterator, iterator> equal_range_unique(const key_type& key)
+	{
+		iterator it = find(key);
+		if (it == end())
+			return mystl::pair<iterator, iterator>(it, it);
+		iterator next = it;
+		return mystl::pair<iterator, iterator>(it, ++next);
+	}
+	mystl::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+	{
+		const_iterator it = find(key);
+		if (it == end())
+			return mystl::pair<const_iterator, const_iterator>(it, it);
+		const_iterator next = it;
+		return mystl::pair<const_iterator, const_iterator>(it, ++next);
+	}
+
+	// bucket interface
+
+	size_type bucket_count() const noexcept { return buckets_; }
+	size_type max_bucket_count() const noexcept { return max_size(); }
+
+	// ԪλԶľ
+	size_type max_probe_length() const noexcept;
+
+	// hash policy
+
+	float load_factor() const noexcept
+	{ return buckets_ != 0 ? static_cast<float>(size_) / buckets_ : 0.0f; }
+
+	float max_load_factor() const noexcept { return mlf_; }
+
+	//  (0, 1) ֮ڣȱʡΪ 0.9
+	void max_load_factor(float ml)
+	{
+		THROW_OUT_OF_RANGE_IF(ml != ml || ml <= 0.0f || ml >= 1.0f, "invalid hash load factor");
+		mlf_ = ml;
+		if (size_ > max_elements(buckets_))
+			grow(size_);
+	}
+
+	// ʹ bucket Ϊ count Ԫ
+	void rehash(size_type count);
+
+	// ʹ count Ԫض¹ϣ
+	void reserve(size_type count)
+	{
+		if (count > max_elements(buckets_))
+			rehash(static_cast<size_type>(static_cast<float>(count) / mlf_) + 1);
+	}
+
+	hasher		hash_fcn()	const { return hash_; }
+	key_equal	key_eq()	const { return equal_; }
+
+	// ͬԪʱ true
+	bool equal_to(const robin_hood_hashtable& rhs) const;
+
+private:
+	size_type max_elements(size_type buckets) const noexcept
+	{
+		return static_cast<size_type>(static_cast<float>(buckets) * mlf_);
+	}
+
+	// bucket ֮۸
+	static size_type overflow_slots(size_type buckets) noexcept
+	{
+		return buckets < rh_dist_max ? buckets : rh_dist_max;
+	}
+
+	size_type slot_count() const noexcept
+	{
+		return buckets_ + overflow_slots(buckets_);
+	}
+
+	// ̽ȡλ÷ֲǷȣһ 128 λ˷۵ɢϣֵ ht_hash_mix 
+	size_type hash_code(const key_type& key) const
+	{
+		return static_cast<size_type>(hash_detail::mix(
+			static_cast<uint64_t>(hash_(key)) ^ hash_detail::secret0, hash_detail::secret1));
+	}
+
+	size_type home(size_type h) const noexcept
+	{
+		return h & (buckets_ - 1);
+	}
+
+	//  idx еԪصļֵǷΪ key
+	bool slot_equal(size_type idx, size_type, const key_type& key, m_true_type) const
+	{
+		return equal_(value_traits::get_key(slots_[idx]), key);
+	}
+	bool slot_equal(size_type idx, size_type h, const key_type& key, m_false_type) const
+	{
+		return hashes_[idx] == h && equal_(value_traits::get_key(slots_[idx]), key);
+	}
+
+	size_type slot_hash(size_type idx, m_true_type) const
+	{
+		return hash_code(value_traits::get_key(slots_[idx]));
+	}
+	size_type slot_hash(size_type idx, m_false_type) const noexcept
+	{
+		return hashes_[idx];
+	}
+
+	void set_hash(size_type, size_type, m_true_type) noexcept {}
+	void set_hash(size_type idx, size_type h, m_false_type) noexcept
+	{
+		hashes_[idx] = h;
+	}
+
+	template <typename Iter>
+	Iter make_begin() const noexcept
+	{
+		if (size_ == 0)
+			return Iter(dist_ + slot_count(), slots_ + slot_count());
+		Iter it(dist_, slots_);
+		if (*dist_ == 0)
+			++it;
+		return it;
+	}
+
+	void reset_empty() noexcept
+	{
+		dist_ = rh_empty_dist();
+		slots_ = nullptr;
+		hashes_ = nullptr;
+		buckets_ = 0;
+		size_ = 0;
+	}
+
+	static void allocate_arrays(size_type buckets, uint8_t*& dist, T*& slots, size_t*& hashes);
+	static void deallocate_arrays(uint8_t* dist, T* slots, size_t* hashes, size_type buckets) noexcept;
+
+	static void relocate(T* dst, T* src, size_type n, m_true_type) noexcept;
+	static void relocate(T* dst, T* src, size_type n, m_false_type) noexcept;
+
+	size_type find_index(const key_type& key, size_type h) const;
+	size_type make_room(size_type h) noexcept;
+	void      close_gap(size_type idx) noexcept;
+	void      erase_index(size_type idx);
+	void      grow(size_type min_size);
+	void      resize(size_type buckets);
+
+	static bool layout_fits(size_type buckets, uint8_t* dist, const uint8_t* old_dist,
+		const size_t* hashes, size_type old_n) noexcept;
+};
+
+/*****************************************************************************************/
+
+// ƹʱͬ bucket 벼֣Ԫ
+template <typename T, typename Hash, typename KeyEqual>
+robin_hood_hashtable<T, Hash, KeyEqual>::
+robin_hood_hashtable(const robin_hood_hashtable& rhs)
+	:dist_(rh_empty_dist()), slots_(nullptr), hashes_(nullptr),
+	buckets_(0), size_(0), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_)
+{
+	if (rhs.size_ == 0)
+		return;
+	uint8_t* dist;
+	T* slots;
+	size_t* hashes;
+	allocate_arrays(rhs.buckets_, dist, slots, hashes);
+	const size_type n = rhs.slot_count();
+	size_type i = 0;
+	try
+	{
+		for (; i < n; ++i)
+		{
+			if (rhs.dist_[i] != 0)
+				data_allocator::construct(slots + i, rhs.slots_[i]);
+		}
+	}
+	catch (...)
+	{
+		while (i-- > 0)
+		{
+			if (rhs.dist_[i] != 0)
+				data_allocator::destroy(slots + i);
+		}
+		deallocate_arrays(dist, slots, hashes, rhs.buckets_);
+		throw;
+	}
+	std::memcpy(dist, rhs.dist_, n + 1);
+	if (hashes)
+		std::memcpy(hashes, rhs.hashes_, n * sizeof(size_t));
+	dist_ = dist;
+	slots_ = slots;
+	hashes_ = hashes;
+	buckets_ = rhs.buckets_;
+	size_ = rhs.size_;
+}
+
+// ڼֵʱԪ
+template <typename T, typename Hash, typename KeyEqual>
+template <typename ...Args>
+mystl::pair<typename robin_hood_hashtable<T, Hash, KeyEqual>::iterator, bool>
+robin_hood_hashtable<T, Hash, KeyEqual>::
+emplace_key(const key_type& key, Args&& ...args)
+{
+	const size_type h = hash_code(key);
+	size_type idx = find_index(key, h);
+	if (idx != npos)
+		return mystl::pair<iterator, bool>(iterator(dist_ + idx, slots_ + idx), false);
+	if (size_ + 1 > max_elements(buckets_))
+		grow(size_ + 1);
+	while ((idx = make_room(h)) == npos)
+	{
+		// زȴ̽Զ˵ֵĹϣֵͬҲ޼
+		THROW_LENGTH_ERROR_IF(size_ < buckets_ / 8, "robin_hood_map<Key, T> too many colliding keys");
+		resize(buckets_ * 2);
+	}
+	// ׳쳣ʱڳĲٺϣֲ
+	try
+	{
+		data_allocator::construct(slots_ + idx, mystl::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		close_gap(idx);
+		throw;
+	}
+	set_hash(idx, h, compact_tag());
+	++size_;
+	return mystl::pair<iterator, bool>(iterator(dist_ + idx, slots_ + idx), true);
+}
+
+// Ԫأ
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+clear()
+{
+	if (size_ == 0)
+		return;
+	const size_type n = slot_count();
+	for (size_type i = 0; i < n; ++i)
+	{
+		if (dist_[i] != 0)
+			data_allocator::destroy(slots_ + i);
+	}
+	std::memset(dist_, 0, n);
+	size_ = 0;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+swap(robin_hood_hashtable& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		mystl::swap(dist_, rhs.dist_);
+		mystl::swap(slots_, rhs.slots_);
+		mystl::swap(hashes_, rhs.hashes_);
+		mystl::swap(buckets_, rhs.buckets_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(mlf_, rhs.mlf_);
+		mystl::swap(hash_, rhs.hash_);
+		mystl::swap(equal_, rhs.equal_);
+	}
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+typename robin_hood_hashtable<T, Hash, KeyEqual>::size_type
+robin_hood_hashtable<T, Hash, KeyEqual>::
+max_probe_length() const noexcept
+{
+	uint8_t result = 0;
+	const size_type n = slot_count();
+	for (size_type i = 0; i < n; ++i)
+	{
+		if (dist_[i] > result)
+			result = dist_[i];
+	}
+	return result == 0 ? 0 : result - 1;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+rehash(size_type count)
+{
+	size_type buckets = 1;
+	while (buckets < count || max_elements(buckets) < size_)
+		buckets <<= 1;
+	if (buckets != buckets_)
+		resize(buckets);
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+bool robin_hood_hashtable<T, Hash, KeyEqual>::
+equal_to(const robin_hood_hashtable& rhs) const
+{
+	if (size_ != rhs.size_)
+		return false;
+	for (auto it = begin(), last = end(); it != last; ++it)
+	{
+		auto p = rhs.find(value_traits::get_key(*it));
+		if (p == rhs.end() || !ht_value_equal(*it, *p, mystl::is_pair<T>()))
+			return false;
+	}
+	return true;
+}
+
+//  buckets  bucket 飬ȫ 0 ڱ
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+allocate_arrays(size_type buckets, uint8_t*& dist, T*& slots, size_t*& hashes)
+{
+	const size_type n = buckets + overflow_slots(buckets);
+	dist = dist_allocator::allocate(n + 1);
+	hashes = nullptr;
+	try
+	{
+		slots = data_allocator::allocate(n);
+		if (!compact_tag::value)
+		{
+			try
+			{
+				hashes = hash_allocator::allocate(n);
+			}
+			catch (...)
+			{
+				data_allocator::deallocate(slots);
+				throw;
+			}
+		}
+	}
+	catch (...)
+	{
+		dist_allocator::deallocate(dist);
+		throw;
+	}
+	std::memset(dist, 0, n);
+	dist[n] = 1;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+deallocate_arrays(uint8_t* dist, T* slots, size_t* hashes, size_type buckets) noexcept
+{
+	if (buckets == 0)
+		return;
+	dist_allocator::deallocate(dist);
+	data_allocator::deallocate(slots);
+	if (hashes)
+		hash_allocator::deallocate(hashes);
+}
+
+//  src  n ԪƵ dst λãοصɰλƵԪֱӸڴ
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+relocate(T* dst, T* src, size_type n, m_true_type) noexcept
+{
+	std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+relocate(T* dst, T* src, size_type n, m_false_type) noexcept
+{
+	if (dst < src)
+	{
+		for (size_type i = 0; i < n; ++i)
+		{
+			data_allocator::construct(dst + i, mystl::move(src[i]));
+			data_allocator::destroy(src + i);
+		}
+	}
+	else
+	{
+		for (size_type i = n; i > 0; --i)
+		{
+			data_allocator::construct(dst + i - 1, mystl::move(src[i - 1]));
+			data_allocator::destroy(src + i - 1);
+		}
+	}
+}
+
+// ҼֵΪ key ԪڵĲۣʱ npos
+// ղۻȵǰ̽СĲʱֹͣkey ڣʱռۡڱľΪ 1̽⵽ʱҲֹͣ
+template <typename T, typename Hash, typename KeyEqual>
+typename robin_hood_hashtable<T, Hash, KeyEqual>::size_type
+robin_hood_hashtable<T, Hash, KeyEqual>::
+find_index(const key_type& key, size_type h) const
+{
+	if (size_ == 0)
+		return npos;
+	size_type idx = home(h);
+	for (size_type d = 1; dist_[idx] >= d; ++idx, ++d)
+	{
+		if (dist_[idx] == d && slot_equal(idx, h, key, compact_tag()))
+			return idx;
+	}
+	return npos;
+}
+
+// ΪϣֵΪ h ԪڳһۣҵһԪСĲۣһղ֮Ԫغһλ
+// ڳĲۣѾá볬޻ûпղۿʱκ޸ģ npos
+template <typename T, typename Hash, typename KeyEqual>
+typename robin_hood_hashtable<T, Hash, KeyEqual>::size_type
+robin_hood_hashtable<T, Hash, KeyEqual>::
+make_room(size_type h) noexcept
+{
+	const size_type n = slot_count();
+	size_type idx = home(h);
+	size_type d = 1;
+	for (; dist_[idx] >= d; ++idx, ++d)
+		;
+	if (idx >= n || d > rh_dist_max)
+		return npos;
+	size_type last = idx;
+	for (; last < n && dist_[last] != 0; ++last)
+	{
+		if (dist_[last] == rh_dist_max)
+			return npos;
+	}
+	if (last == n)
+		return npos;
+	if (last != idx)
+	{
+		relocate(slots_ + idx + 1, slots_ + idx, last - idx, relocate_tag());
+		if (hashes_)
+			std::memmove(hashes_ + idx + 1, hashes_ + idx, (last - idx) * sizeof(size_t));
+		for (size_type i = last; i > idx; --i)
+			dist_[i] = static_cast<uint8_t>(dist_[i - 1] + 1);
+	}
+	dist_[idx] = static_cast<uint8_t>(d);
+	return idx;
+}
+
+//  idx ѾճλϵԪǰһλbackward shift
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+close_gap(size_type idx) noexcept
+{
+	size_type last = idx + 1;
+	for (; dist_[last] > 1; ++last)
+		dist_[last - 1] = static_cast<uint8_t>(dist_[last] - 1);
+	dist_[last - 1] = 0;
+	const size_type n = last - idx - 1;
+	if (n != 0)
+	{
+		relocate(slots_ + idx, slots_ + idx + 1, n, relocate_tag());
+		if (hashes_)
+			std::memmove(hashes_ + idx, hashes_ + idx + 1, n * sizeof(size_t));
+	}
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+erase_index(size_type idx)
+{
+	data_allocator::destroy(slots_ + idx);
+	close_gap(idx);
+	--size_;
+}
+
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+grow(size_type min_size)
+{
+	size_type buckets = buckets_ == 0 ? 2 : buckets_ * 2;
+	while (max_elements(buckets) < min_size)
+		buckets <<= 1;
+	resize(buckets);
+}
+
+// ±иԪذλУÿԪط max(λ, ǰһԪ֮)ղ֣
+// еľ벻ᳬյľ롣dist Ϊ·ľ飬ͳÿλϵԪظ
+// ݴж buckets  bucket ܷȫԪأǰָΪ 0
+template <typename T, typename Hash, typename KeyEqual>
+bool robin_hood_hashtable<T, Hash, KeyEqual>::
+layout_fits(size_type buckets, uint8_t* dist, const uint8_t* old_dist, const size_t* hashes,
+	size_type old_n) noexcept
+{
+	const size_type n = buckets + overflow_slots(buckets);
+	bool fits = true;
+	for (size_type i = 0; i < old_n; ++i)
+	{
+		if (old_dist[i] == 0)
+			continue;
+		uint8_t& c = dist[hashes[i] & (buckets - 1)];
+		if (c == rh_dist_max)
+			fits = false;
+		else
+			++c;
+	}
+	size_type pos = 0;
+	for (size_type b = 0; fits && b < buckets; ++b)
+	{
+		if (dist[b] == 0)
+			continue;
+		if (pos < b)
+			pos = b;
+		pos += dist[b];
+		// λϵһԪط pos - 1Ϊ pos - b
+		if (pos - b > rh_dist_max || pos > n)
+			fits = false;
+	}
+	std::memset(dist, 0, n);
+	return fits;
+}
+
+// Ԫƶ buckets  bucket 
+// ھֲз飬 layout_fits жϷŲʱٷϣֵʱȫϣֵ
+// ϣ׳쳣ʱ䣬֮һλ飬ƶԪز׳쳣make_room Ҳʧ
+template <typename T, typename Hash, typename KeyEqual>
+void robin_hood_hashtable<T, Hash, KeyEqual>::
+resize(size_type buckets)
+{
+	const size_type old_n = slot_count();
+	size_t* tmp = nullptr;
+	if (hashes_ == nullptr && size_ != 0)
+	{
+		tmp = hash_allocator::allocate(old_n);
+		try
+		{
+			for (size_type i = 0; i < old_n; ++i)
+			{
+				if (dist_[i] != 0)
+					tmp[i] = hash_code(value_traits::get_key(slots_[i]));
+			}
+		}
+		catch (...)
+		{
+			hash_allocator::deallocate(tmp);
+			throw;
+		}
+	}
+	const size_t* old_hs = hashes_ ? hashes_ : tmp;
+
+	uint8_t* dist;
+	T* slots;
+	size_t* hashes;
+	try
+	{
+		for (;;)
+		{
+			allocate_arrays(buckets, dist, slots, hashes);
+			if (layout_fits(buckets, dist, dist_, old_hs, old_n))
+				break;
+			deallocate_arrays(dist, slots, hashes, buckets);
+			buckets *= 2;
+		}
+	}
+	catch (...)
+	{
+		hash_allocator::deallocate(tmp);
+		throw;
+	}
+
+	uint8_t* old_dist = dist_;
+	T* old_slots = slots_;
+	size_t* old_hashes = hashes_;
+	const size_type old_buckets = buckets_;
+	const size_type count = size_;
+	dist_ = dist;
+	slots_ = slots;
+	hashes_ = hashes;
+	buckets_ = buckets;
+	size_ = 0;
+	for (size_type i = 0; i < old_n; ++i)
+	{
+		if (old_dist[i] == 0)
+			continue;
+		const size_type h = old_hs[i];
+		const size_type idx = make_room(h);
+		MYSTL_DEBUG(idx != npos);
+		relocate(slots_ + idx, old_slots + i, 1, relocate_tag());
+		set_hash(idx, h, compact_tag());
+		++size_;
+	}
+	MYSTL_DEBUG(size_ == count);
+	(void)count;
+	deallocate_arrays(old_dist, old_slots, old_hashes, old_buckets);
+	hash_allocator::deallocate(tmp);
+}
+
+} // namespace mystl
+#endif // !MY_STL_ROBIN_HOOD_HASHTABLE_H_
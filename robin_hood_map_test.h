@@ -0,0 +1,240 @@
+#ifndef MY_STL_ROBIN_HOOD_MAP_TEST_H_
+#define MY_STL_ROBIN_HOOD_MAP_TEST_H_
+
+// robin_hood_map test :  robin_hood_map Ľӿڣ unordered_mapflat_hash_map ܶԱȣԼ߸µ̽
+
+#include "robin_hood_map.h"
+#include "astring.h"
+#include "flat_hash_map_test.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace robin_hood_map_test
+{
+
+using flat_hash_map_test::hash_op;
+using flat_hash_map_test::hash_op_do_test;
+using flat_hash_map_test::hash_test_key;
+using flat_hash_map_test::fail_after_hash;
+
+#define ROBIN_HOOD_OP_TEST(op, len1, len2, len3)                              \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|mystl::unordered_map |";                                   \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len1);                \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len2);                \
+  hash_op_do_test<mystl::unordered_map<int, int>>(op, len3);                \
+  std::cout << "\n|mystl::flat_hash_map |";                                 \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len1);                \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len2);                \
+  hash_op_do_test<mystl::flat_hash_map<int, int>>(op, len3);                \
+  std::cout << "\n|mystl::robin_hood_map|";                                 \
+  hash_op_do_test<mystl::robin_hood_map<int, int>>(op, len1);               \
+  hash_op_do_test<mystl::robin_hood_map<int, int>>(op, len2);               \
+  hash_op_do_test<mystl::robin_hood_map<int, int>>(op, len3);
+
+#if LARGER_TEST_DATA_ON
+#define ROBIN_HOOD_OP_TEST_ALL(op) ROBIN_HOOD_OP_TEST(op, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3))
+#else
+#define ROBIN_HOOD_OP_TEST_ALL(op) ROBIN_HOOD_OP_TEST(op, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3))
+#endif
+
+// ȡ count  bucket ı ml ٲһͻݣʱ̽
+void max_probe_do_test(size_t count, float ml)
+{
+    char buf[10];
+    mystl::robin_hood_map<int, int> m;
+    m.max_load_factor(ml);
+    m.rehash(count);
+    const size_t n = static_cast<size_t>(static_cast<float>(m.bucket_count()) * ml);
+    for (size_t i = 0; i < n; ++i)
+        m.emplace(hash_test_key(i), static_cast<int>(i));
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(m.max_probe_length()));
+    std::string t = buf;
+    t += "      |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define MAX_PROBE_TEST(len1, len2, len3)                                      \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|  max load factor .9 |";                                   \
+  max_probe_do_test(len1, 0.9f);                                            \
+  max_probe_do_test(len2, 0.9f);                                            \
+  max_probe_do_test(len3, 0.9f);                                            \
+  std::cout << "\n| max load factor .95 |";                                 \
+  max_probe_do_test(len1, 0.95f);                                           \
+  max_probe_do_test(len2, 0.95f);                                           \
+  max_probe_do_test(len3, 0.95f);
+
+void robin_hood_map_test()
+{
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : robin_hood_map -------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    mystl::vector<PAIR> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(PAIR(5 - i, 5 - i));
+    mystl::robin_hood_map<int, int> rm1;
+    mystl::robin_hood_map<int, int> rm2(520);
+    mystl::robin_hood_map<int, int> rm3(520, mystl::hash<int>());
+    mystl::robin_hood_map<int, int> rm4(520, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::robin_hood_map<int, int> rm5(v.begin(), v.end());
+    mystl::robin_hood_map<int, int> rm6(v.begin(), v.end(), 100);
+    mystl::robin_hood_map<int, int> rm7(v.begin(), v.end(), 100, mystl::hash<int>());
+    mystl::robin_hood_map<int, int> rm8(v.begin(), v.end(), 100, mystl::hash<int>(), mystl::equal_to<int>());
+    mystl::robin_hood_map<int, int> rm9(rm5);
+    mystl::robin_hood_map<int, int> rm10(std::move(rm5));
+    mystl::robin_hood_map<int, int> rm11;
+    rm11 = rm6;
+    mystl::robin_hood_map<int, int> rm12;
+    rm12 = std::move(rm6);
+    mystl::robin_hood_map<int, int> rm13{ PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+    mystl::robin_hood_map<int, int> rm14;
+    rm14 = { PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+
+    MAP_FUN_AFTER(rm1, rm1.emplace(1, 1));
+    MAP_FUN_AFTER(rm1, rm1.emplace_hint(rm1.begin(), 1, 2));
+    MAP_FUN_AFTER(rm1, rm1.insert(PAIR(2, 2)));
+    MAP_FUN_AFTER(rm1, rm1.insert(rm1.end(), PAIR(3, 3)));
+    MAP_FUN_AFTER(rm1, rm1.insert(v.begin(), v.end()));
+    MAP_FUN_AFTER(rm1, rm1.try_emplace(6, 6));
+    MAP_FUN_AFTER(rm1, rm1.erase(rm1.begin()));
+    MAP_FUN_AFTER(rm1, rm1.erase(rm1.find(3), rm1.end()));
+    MAP_FUN_AFTER(rm1, rm1.erase(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE(rm1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(rm1.size());
+    FUN_VALUE(rm1.bucket_count());
+    MAP_FUN_AFTER(rm1, rm1.clear());
+    MAP_FUN_AFTER(rm1, rm1.swap(rm7));
+    FUN_VALUE(rm1.at(1));
+    FUN_VALUE(rm1[1]);
+    FUN_VALUE(rm1[10]);
+    std::cout << std::boolalpha;
+    FUN_VALUE(rm1.empty());
+    FUN_VALUE((rm1 == rm7));
+    FUN_VALUE((rm8 == rm9));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(rm1.size());
+    FUN_VALUE(rm1.bucket_count());
+    MAP_FUN_AFTER(rm1, rm1.reserve(1000));
+    FUN_VALUE(rm1.size());
+    FUN_VALUE(rm1.bucket_count());
+    MAP_FUN_AFTER(rm1, rm1.rehash(150));
+    FUN_VALUE(rm1.bucket_count());
+    FUN_VALUE(rm1.count(1));
+    MAP_VALUE(*rm1.find(3));
+    auto first = *rm1.equal_range(3).first;
+    std::cout << " rm1.equal_range(3).first : <" << first.first << ", " << first.second << ">" << std::endl;
+    FUN_VALUE(rm1.load_factor());
+    FUN_VALUE(rm1.max_load_factor());
+    rm1.max_load_factor(0.95f);
+    FUN_VALUE(rm1.max_load_factor());
+
+    // ߸·ɾɾǰƶԪأԽԽ̽
+    mystl::robin_hood_map<int, int> rm15;
+    rm15.max_load_factor(0.95f);
+    for (int i = 0; i < 1900; ++i)
+        rm15.emplace(i * 7, i);
+    FUN_VALUE(rm15.bucket_count());
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 1900; i += 2)
+            rm15.erase(i * 7);
+        for (int i = 0; i < 1900; i += 2)
+            rm15.emplace(i * 7, i);
+    }
+    FUN_VALUE(rm15.size());
+    FUN_VALUE(rm15.bucket_count());
+    FUN_VALUE(rm15.count(7 * 1899));
+    std::cout << std::boolalpha;
+    FUN_VALUE((rm15.max_probe_length() < 32));
+    std::cout << std::noboolalpha;
+
+    // ʱ erase ķֵɾȫżֵ
+    for (auto it = rm15.begin(); it != rm15.end(); )
+    {
+        if (it->second % 2 == 0)
+            it = rm15.erase(it);
+        else
+            ++it;
+    }
+    FUN_VALUE(rm15.size());
+    FUN_VALUE(rm15.count(7 * 1898));
+    FUN_VALUE(rm15.count(7 * 1899));
+
+    // ֵַϣֵ
+    mystl::robin_hood_map<mystl::string, int> rm16;
+    rm16["robin"] = 1;
+    rm16["hood"] = 2;
+    rm16.emplace("map", 3);
+    rm16.erase("robin");
+    FUN_VALUE(rm16.size());
+    FUN_VALUE(rm16.at("map"));
+    FUN_VALUE(rm16.count("robin"));
+
+    // ¹ϣʱ 4 μϣֵʧܣеԪֲ
+    int budget = -1;
+    mystl::robin_hood_map<int, int, fail_after_hash> rm17(0, fail_after_hash{ &budget });
+    for (int i = 0; i < 14; ++i)
+        rm17.emplace(i, i);
+    FUN_VALUE(rm17.bucket_count());
+    budget = 3;
+    try
+    {
+        rm17.rehash(1024);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << " rm17.rehash(1024) : " << e.what() << std::endl;
+    }
+    budget = -1;
+    FUN_VALUE(rm17.size());
+    FUN_VALUE(rm17.bucket_count());
+    size_t found = 0;
+    for (int i = 0; i < 14; ++i)
+        found += rm17.count(i);
+    FUN_VALUE(found);
+    rm17.rehash(1024);
+    FUN_VALUE(rm17.bucket_count());
+    FUN_VALUE(rm17.at(13));
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|       emplace       |";
+    ROBIN_HOOD_OP_TEST_ALL(hash_op::emplace);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     find (hit)      |";
+    ROBIN_HOOD_OP_TEST_ALL(hash_op::find_hit);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     find (miss)     |";
+    ROBIN_HOOD_OP_TEST_ALL(hash_op::find_miss);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|        erase        |";
+    ROBIN_HOOD_OP_TEST_ALL(hash_op::erase);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  max probe length   |";
+#if LARGER_TEST_DATA_ON
+    MAX_PROBE_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    MAX_PROBE_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : robin_hood_map -------------]" << std::endl;
+}
+
+} // namespace robin_hood_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MY_STL_ROBIN_HOOD_MAP_TEST_H_
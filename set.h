@@ -18,9 +18,12 @@
 namespace mystl
 {
 
+template <typename Key, typename Compare, bool OrderStatistic> class multiset;
+
 // ģ setֵظ
-// һֵֵͣȽϷʽȱʡʹ mystl::less 
-template <typename Key, typename Compare = mystl::less<Key>>
+// һֵֵͣȽϷʽȱʡʹ mystl::less
+// ʾǷά˳ͳϢnth / rankȱʡΪ false
+template <typename Key, typename Compare = mystl::less<Key>, bool OrderStatistic = false>
 class set
 {
 public:
@@ -30,11 +33,12 @@ public:
 	using value_compare		= Compare;
 
 private:
-	using base_type = mystl::rb_tree<value_type, key_compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare,
+		rb_tree_select_augment<value_type, OrderStatistic>>;
 	base_type tree_;
 
 public:
-	using node_type					= base_type::node_type;
+	using node_type					= base_type::node_handle_type;
 	using pointer					= base_type::const_pointer;
 	using const_pointer				= base_type::const_pointer;
 	using reference					= base_type::const_reference;
@@ -46,6 +50,11 @@ public:
 	using size_type					= base_type::size_type;
 	using difference_type			= base_type::difference_type;
 	using allocator_type			= base_type::allocator_type;
+	using insert_return_type		= mystl::node_insert_return<iterator, node_type>;
+
+	// merge Ҫ set / multiset  rb_tree
+	template <typename, typename, bool> friend class set;
+	template <typename, typename, bool> friend class multiset;
 
 public:
 	set() = default;
@@ -57,6 +66,14 @@ public:
 		tree_.insert_unique(first, last);
 	}
 
+	// Ѿʱʹã O(n) 밴ֵϸ
+	template <typename InputIterator>
+	set(from_sorted_range_t, InputIterator first, InputIterator last)
+		:tree_()
+	{
+		tree_.insert_unique(from_sorted_range, first, last);
+	}
+
 	set(std::initializer_list<value_type> ilist)
 		:tree_()
 	{
@@ -210,6 +227,21 @@ public:
 
 	void clear() { tree_.clear(); }
 
+	// ڵزֻ޸Ӷ·ڵ㣬 rb_tree
+	node_type extract(const_iterator position) { return tree_.extract(position); }
+	node_type extract(const key_type& key) { return tree_.extract(key); }
+
+	insert_return_type insert(node_type&& nh)
+	{
+		auto res = tree_.insert_unique(mystl::move(nh));
+		return insert_return_type{ res.position, res.inserted, mystl::move(res.node) };
+	}
+
+	template <typename Compare2>
+	void merge(set<Key, Compare2, OrderStatistic>& source) { tree_.merge_unique(source.tree_); }
+	template <typename Compare2>
+	void merge(multiset<Key, Compare2, OrderStatistic>& source) { tree_.merge_unique(source.tree_); }
+
 	// set ز
 
 	iterator find(const key_type& key) { return tree_.find(key); }
@@ -233,6 +265,56 @@ public:
 		return tree_.equal_range_unique(key);
 	}
 
+	// 칹ңֻбȽϺ͸ mystl::less<>ʱ
+	// key κֵȽϵͣʱعʱļֵ
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator find(const K& key) { return tree_.find(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator find(const K& key) const { return tree_.find(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	size_type count(const K& key) const { return tree_.count_unique(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator lower_bound(const K& key) { return tree_.lower_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator upper_bound(const K& key) { return tree_.upper_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<iterator, iterator> equal_range(const K& key)
+	{
+		return tree_.equal_range_unique(key);
+	}
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return tree_.equal_range_unique(key);
+	}
+
+	//  join / split ĲýڵԪأ rb_tree
+	void split(const key_type& key, set& right) { tree_.split(key, right.tree_); }
+	void join(set& right) { tree_.join(right.tree_); }
+
+	void union_with(set& rhs, bool parallel = false) { tree_.union_with(rhs.tree_, parallel); }
+	void intersect_with(const set& rhs, bool parallel = false) { tree_.intersect_with(rhs.tree_, parallel); }
+	void difference_with(const set& rhs, bool parallel = false) { tree_.difference_with(rhs.tree_, parallel); }
+
+	// ˳ͳزֻ OrderStatistic Ϊ true ʱ
+	iterator nth(size_type k) { return tree_.nth(k); }
+	const_iterator nth(size_type k) const { return tree_.nth(k); }
+
+	size_type rank(const key_type& key) const { return tree_.rank(key); }
+
+	difference_type distance(const_iterator first, const_iterator last) const
+	{
+		return tree_.distance(first, last);
+	}
+
 	void swap(set& rhs) noexcept
 	{
 		tree_.swap(rhs.tree_);
@@ -245,45 +327,45 @@ public:
 
 
 // رȽϲ
-template <typename Key, typename Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator==(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator<(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return lhs < rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator!=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator>(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return rhs < lhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator<=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator>=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <typename Key, typename Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
+template <typename Key, typename Compare, bool OrderStatistic>
+void swap(set<Key, Compare, OrderStatistic>& lhs, set<Key, Compare, OrderStatistic>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
@@ -291,8 +373,9 @@ void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
 /*****************************************************************************************/
 
 // ģ multisetֵظ
-// һֵֵͣȽϷʽȱʡʹ mystl::less 
-template <typename Key, typename Compare = mystl::less<Key>>
+// һֵֵͣȽϷʽȱʡʹ mystl::less
+// ʾǷά˳ͳϢnth / rankȱʡΪ false
+template <typename Key, typename Compare = mystl::less<Key>, bool OrderStatistic = false>
 class multiset
 {
 public:
@@ -302,11 +385,12 @@ public:
 	using value_compare		= Compare;
 
 private:
-	using base_type = mystl::rb_tree<value_type, key_compare>;
+	using base_type = mystl::rb_tree<value_type, key_compare,
+		rb_tree_select_augment<value_type, OrderStatistic>>;
 	base_type tree_;
 
 public:
-	using node_type					= base_type::node_type;
+	using node_type					= base_type::node_handle_type;
 	using pointer					= base_type::const_pointer;
 	using const_pointer				= base_type::const_pointer;
 	using reference					= base_type::const_reference;
@@ -319,6 +403,9 @@ public:
 	using difference_type			= base_type::difference_type;
 	using allocator_type			= base_type::allocator_type;
 
+	template <typename, typename, bool> friend class set;
+	template <typename, typename, bool> friend class multiset;
+
 public:
 	multiset() = default;
 
@@ -329,6 +416,14 @@ public:
 		tree_.insert_multi(first, last);
 	}
 
+	// Ѿʱʹã O(n) 밴ֵݼ
+	template <typename InputIterator>
+	multiset(from_sorted_range_t, InputIterator first, InputIterator last)
+		:tree_ { }
+	{
+		tree_.insert_multi(from_sorted_range, first, last);
+	}
+
 	multiset(std::initializer_list<value_type> ilist)
 		: tree_{ }
 	{
@@ -481,6 +576,17 @@ public:
 
 	void clear() { tree_.clear(); }
 
+	// ڵزֻ޸Ӷ·ڵ㣬 rb_tree
+	node_type extract(const_iterator position) { return tree_.extract(position); }
+	node_type extract(const key_type& key) { return tree_.extract(key); }
+
+	iterator insert(node_type&& nh) { return tree_.insert_multi(mystl::move(nh)); }
+
+	template <typename Compare2>
+	void merge(multiset<Key, Compare2, OrderStatistic>& source) { tree_.merge_multi(source.tree_); }
+	template <typename Compare2>
+	void merge(set<Key, Compare2, OrderStatistic>& source) { tree_.merge_multi(source.tree_); }
+
 	// multiset ز
 
 	iterator find(const key_type& key) { return tree_.find(key); }
@@ -504,6 +610,52 @@ public:
 		return tree_.equal_range_multi(key);
 	}
 
+	// 칹ңֻбȽϺ͸ mystl::less<>ʱ
+	// key κֵȽϵͣʱعʱļֵ
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator find(const K& key) { return tree_.find(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator find(const K& key) const { return tree_.find(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	size_type count(const K& key) const { return tree_.count_multi(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator lower_bound(const K& key) { return tree_.lower_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	iterator upper_bound(const K& key) { return tree_.upper_bound(key); }
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<iterator, iterator> equal_range(const K& key)
+	{
+		return tree_.equal_range_multi(key);
+	}
+	template <typename K, typename C = Compare, mystl::enable_if_t<is_transparent_compare<C>::value, int> = 0>
+	pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return tree_.equal_range_multi(key);
+	}
+
+	//  join / split ĲýڵԪأ rb_tree
+	void split(const key_type& key, multiset& right) { tree_.split(key, right.tree_); }
+	void join(multiset& right) { tree_.join(right.tree_); }
+
+	// ˳ͳزֻ OrderStatistic Ϊ true ʱ
+	iterator nth(size_type k) { return tree_.nth(k); }
+	const_iterator nth(size_type k) const { return tree_.nth(k); }
+
+	size_type rank(const key_type& key) const { return tree_.rank(key); }
+
+	difference_type distance(const_iterator first, const_iterator last) const
+	{
+		return tree_.distance(first, last);
+	}
+
 	void swap(multiset& rhs) noexcept
 	{
 		tree_.swap(rhs.tree_);
@@ -515,48 +667,55 @@ public:
 };
 
 // رȽϲ
-template <typename Key, typename Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator==(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator<(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return lhs < rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator!=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator>(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return rhs < lhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator<=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <typename Key, typename Compare, bool OrderStatistic>
+bool operator>=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <typename Key, typename Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept
+template <typename Key, typename Compare, bool OrderStatistic>
+void swap(multiset<Key, Compare, OrderStatistic>& lhs, multiset<Key, Compare, OrderStatistic>& rhs) noexcept
 {
 	lhs.swap(rhs);
 }
 
+// ֧˳ͳƵ set / multisetṩ O(log n)  nthrank  distance
+template <typename Key, typename Compare = mystl::less<Key>>
+using ranked_set = set<Key, Compare, true>;
+
+template <typename Key, typename Compare = mystl::less<Key>>
+using ranked_multiset = multiset<Key, Compare, true>;
+
 } // namespace mystl
 #endif // !MY_STL_SET_H_
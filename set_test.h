@@ -1,11 +1,14 @@
 #ifndef MY_STL_SET_TEST_H_
 #define MY_STL_SET_TEST_H_
 
-// set test :  set, multiset Ľӿ insert 
+// set test :  set, multiset Ľӿ insert
 
 #include <set>
 
 #include "set.h"
+#include "astring.h"
+#include "set_algo.h"
+#include "vector.h"
 #include "test.h"
 
 namespace mystl
@@ -15,6 +18,50 @@ namespace test
 namespace set_test
 {
 
+// СΪ len  len / 16  set󲢼 expr a Ϊ
+#define SET_UNION_DO_TEST(expr, len) do {                     \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mystl::set<int> a, b;                                      \
+  for (size_t i = 0; i < len; ++i)                           \
+    a.insert(rand());                                        \
+  for (size_t i = 0; i < len / 16; ++i)                      \
+    b.insert(rand());                                        \
+  start = clock();                                           \
+  expr;                                                      \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+//  set_algo  set_union 飬ؽһ
+#define SET_UNION_REBUILD do {                               \
+  mystl::vector<int> v(a.size() + b.size());                 \
+  auto last = mystl::set_union(a.begin(), a.end(),           \
+                               b.begin(), b.end(), v.begin());\
+  a = mystl::set<int>(v.begin(), last);                      \
+} while(0)
+
+#define SET_UNION_TEST(len1, len2, len3)                     \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|  set_union+rebuild  |";                    \
+  SET_UNION_DO_TEST(SET_UNION_REBUILD, len1);                \
+  SET_UNION_DO_TEST(SET_UNION_REBUILD, len2);                \
+  SET_UNION_DO_TEST(SET_UNION_REBUILD, len3);                \
+  std::cout << "\n|     union_with      |";                  \
+  SET_UNION_DO_TEST(a.union_with(b), len1);                  \
+  SET_UNION_DO_TEST(a.union_with(b), len2);                  \
+  SET_UNION_DO_TEST(a.union_with(b), len3);                  \
+  std::cout << "\n| union_with parallel |";                  \
+  SET_UNION_DO_TEST(a.union_with(b, true), len1);            \
+  SET_UNION_DO_TEST(a.union_with(b, true), len2);            \
+  SET_UNION_DO_TEST(a.union_with(b, true), len3);
+
 void set_test()
 {
     std::cout << "[===============================================================]" << std::endl;
@@ -34,6 +81,9 @@ void set_test()
     mystl::set<int> s9{ 1,2,3,4,5 };
     mystl::set<int> s10;
     s10 = { 1,2,3,4,5 };
+    int sorted[] = { 1,2,3,4,5 };
+    mystl::set<int> s11(mystl::from_sorted_range, sorted, sorted + 5);
+    COUT(s11);
 
     for (int i = 5; i > 0; --i)
     {
@@ -70,6 +120,39 @@ void set_test()
     std::cout << std::noboolalpha;
     FUN_VALUE(s1.size());
     FUN_VALUE(s1.max_size());
+    mystl::ranked_set<int> s12(a, a + 5);
+    FUN_VALUE(*s12.nth(2));
+    FUN_VALUE(s12.rank(3));
+    FUN_VALUE(s12.distance(s12.begin(), s12.find(4)));
+    mystl::set<int> s13{ 1,3,5,7,9 };
+    mystl::set<int> s14{ 3,4,5,6 };
+    FUN_AFTER(s13, s13.difference_with(s14));
+    FUN_AFTER(s13, s13.union_with(s14));
+    FUN_AFTER(s13, s13.split(5, s14));
+    COUT(s14);
+    FUN_AFTER(s13, s13.join(s14));
+    s14 = { 3,4,10 };
+    FUN_AFTER(s13, s13.intersect_with(s14));
+    mystl::set<int> s15{ 1,2,3 };
+    FUN_AFTER(s15, s15.merge(s14));
+    COUT(s14);
+    auto nh = s15.extract(1);
+    nh.value() = 5;
+    FUN_AFTER(s15, s15.insert(mystl::move(nh)));
+    FUN_AFTER(s14, s14.insert(s15.extract(s15.begin())));
+    FUN_VALUE(s14.insert(s15.extract(3)).inserted);
+    COUT(s15);
+    mystl::set<mystl::string, mystl::less<>> s16{ "abc", "bcd", "cde" };
+    FUN_VALUE(s16.count("abc"));
+    FUN_VALUE(*s16.find("bcd"));
+    FUN_VALUE(*s16.lower_bound("b"));
+    FUN_VALUE(*s16.upper_bound("bcd"));
+    // һֵstring(string("bzz"), 1) Ϊ "zz"ܰһ
+    mystl::set<mystl::string> s17{ "a", "m", "zzz" };
+    FUN_AFTER(s17, s17.emplace(mystl::string("bzz"), 1));
+    FUN_AFTER(s17, s17.emplace_hint(s17.end(), mystl::string("azz"), 1));
+    FUN_VALUE(s17.count("zz"));
+    FUN_VALUE(s17.count("bzz"));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -79,6 +162,14 @@ void set_test()
     CON_TEST_P1(set<int>, emplace, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #else
     CON_TEST_P1(set<int>, emplace, rand(), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    union (n, n/16)  |";
+#if LARGER_TEST_DATA_ON
+    SET_UNION_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    SET_UNION_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -107,6 +198,9 @@ void multiset_test()
     mystl::multiset<int> s9{ 1,2,3,4,5 };
     mystl::multiset<int> s10;
     s10 = { 1,2,3,4,5 };
+    int sorted[] = { 1,2,3,4,5 };
+    mystl::multiset<int> s11(mystl::from_sorted_range, sorted, sorted + 5);
+    COUT(s11);
 
     for (int i = 5; i > 0; --i)
     {
@@ -143,6 +237,21 @@ void multiset_test()
     std::cout << std::noboolalpha;
     FUN_VALUE(s1.size());
     FUN_VALUE(s1.max_size());
+    mystl::ranked_multiset<int> s12(a, a + 5);
+    FUN_VALUE(*s12.nth(2));
+    FUN_VALUE(s12.rank(3));
+    FUN_VALUE(s12.distance(s12.begin(), s12.find(4)));
+    mystl::multiset<int> s13{ 1,2,3 };
+    mystl::set<int> s14{ 3,4 };
+    FUN_AFTER(s13, s13.merge(s14));
+    COUT(s14);
+    auto nh = s13.extract(3);
+    nh.value() = 5;
+    FUN_AFTER(s13, s13.insert(mystl::move(nh)));
+    FUN_AFTER(s13, s13.insert(s13.extract(s13.begin())));
+    mystl::multiset<mystl::string, mystl::less<>> s15{ "abc", "bcd", "bcd" };
+    FUN_VALUE(s15.count("bcd"));
+    FUN_VALUE(*s15.equal_range("abc").second);
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
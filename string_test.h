@@ -2,11 +2,14 @@
 #ifndef MYTINYSTL_STRING_TEST_H_
 #define MYTINYSTL_STRING_TEST_H_
 
-// string test :  string Ľӿں insert 
+// string test :  string Ľӿڡinsert ܡͬȼֵĹϣԼַĹ졢Ϊֵ
 
 #include <string>
 
 #include "astring.h"
+#include "vector.h"
+#include "map.h"
+#include "unordered_map.h"
 #include "test.h"
 
 namespace mystl
@@ -16,6 +19,157 @@ namespace test
 namespace string_test
 {
 
+// ֽڵ FNV-1aΪϣĶ
+inline size_t fnv1a_hash(const unsigned char* first, size_t count)
+{
+	uint64_t result = 14695981039346656037ull;
+	for (size_t i = 0; i < count; ++i)
+	{
+		result ^= first[i];
+		result *= 1099511628211ull;
+	}
+	return static_cast<size_t>(result);
+}
+
+// ԳΪ len ļֵϣԼ total ֽڲʱֵȡԻвͬλãûж
+template <typename HashFn>
+void hash_do_test(HashFn fn, const mystl::vector<unsigned char>& buf, size_t len, size_t total)
+{
+	clock_t start, end;
+	char tbuf[10];
+	size_t h = 0;
+	size_t off = 0;
+	const size_t span = buf.size() - len;
+	start = clock();
+	for (size_t done = 0; done < total; done += len)
+	{
+		h ^= fn(buf.data() + off, len);
+		off += 7;
+		if (off >= span)
+			off = 0;
+	}
+	end = clock();
+	volatile size_t sink = h;
+	(void)sink;
+	int n = static_cast<int>(static_cast<double>(end - start)
+		/ CLOCKS_PER_SEC * 1000);
+	std::snprintf(tbuf, sizeof(tbuf), "%d", n);
+	std::string t = tbuf;
+	t += "ms    |";
+	std::cout << std::setw(WIDE) << t;
+}
+
+#define HASH_BYTES_TEST(total, len1, len2, len3)                              \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|   FNV-1a bytewise   |";                                   \
+  hash_do_test(fnv1a_hash, buf, len1, total);                               \
+  hash_do_test(fnv1a_hash, buf, len2, total);                               \
+  hash_do_test(fnv1a_hash, buf, len3, total);                               \
+  std::cout << "\n|  mystl::hash_bytes  |";                                 \
+  hash_do_test(hash_fn, buf, len1, total);                                  \
+  hash_do_test(hash_fn, buf, len2, total);                                  \
+  hash_do_test(hash_fn, buf, len3, total);
+
+// ַĲԲ
+enum class short_key_op { construct, copy, map_insert, unordered_map_insert };
+
+// ֵļ࣬ÿֵͬĩβĿַռ 16 ֽ
+const size_t short_key_stride = 16;
+
+// ѵ i ֵ̼д bufΪ 2  11 ַܷŽ mystl::string ڲռ
+inline void make_short_key(char* buf, size_t i)
+{
+	std::snprintf(buf, short_key_stride, "k%u",
+		static_cast<unsigned>(i * 2654435761u % 1000000007u));
+}
+
+// std::string ʹ mystl::string ͬĹϣ
+struct std_string_hash
+{
+	size_t operator()(const std::string& str) const
+	{
+		return mystl::hash_bytes(str.data(), str.size());
+	}
+};
+
+//  len ִֵ̼ opʱʱ
+template <typename Str, typename Hash>
+void short_key_do_test(short_key_op op, size_t len)
+{
+	mystl::vector<char> raw(len * short_key_stride);
+	for (size_t i = 0; i < len; ++i)
+		make_short_key(raw.data() + i * short_key_stride, i);
+	mystl::vector<Str> keys;
+	if (op != short_key_op::construct)
+	{
+		keys.reserve(len);
+		for (size_t i = 0; i < len; ++i)
+			keys.push_back(Str(raw.data() + i * short_key_stride));
+	}
+	clock_t start, end;
+	char buf[10];
+	size_t n = 0;
+	start = clock();
+	switch (op)
+	{
+	case short_key_op::construct:
+	{
+		mystl::vector<Str> v;
+		v.reserve(len);
+		for (size_t i = 0; i < len; ++i)
+			v.emplace_back(raw.data() + i * short_key_stride);
+		n = v.size();
+		break;
+	}
+	case short_key_op::copy:
+	{
+		mystl::vector<Str> v;
+		v.reserve(len);
+		for (size_t i = 0; i < len; ++i)
+			v.push_back(keys[i]);
+		n = v.size();
+		break;
+	}
+	case short_key_op::map_insert:
+	{
+		mystl::map<Str, int> m;
+		for (size_t i = 0; i < len; ++i)
+			m.emplace(keys[i], static_cast<int>(i));
+		n = m.size();
+		break;
+	}
+	case short_key_op::unordered_map_insert:
+	{
+		mystl::unordered_map<Str, int, Hash> m;
+		m.reserve(len);
+		for (size_t i = 0; i < len; ++i)
+			m.emplace(keys[i], static_cast<int>(i));
+		n = m.size();
+		break;
+	}
+	}
+	end = clock();
+	volatile size_t sink = n;
+	(void)sink;
+	int ms = static_cast<int>(static_cast<double>(end - start)
+		/ CLOCKS_PER_SEC * 1000);
+	std::snprintf(buf, sizeof(buf), "%d", ms);
+	std::string t = buf;
+	t += "ms    |";
+	std::cout << std::setw(WIDE) << t;
+}
+
+#define SHORT_KEY_TEST(op, len1, len2, len3)                                  \
+  TEST_LEN(len1, len2, len3, WIDE);                                         \
+  std::cout << "|     std::string     |";                                   \
+  short_key_do_test<std::string, std_string_hash>(op, len1);                \
+  short_key_do_test<std::string, std_string_hash>(op, len2);                \
+  short_key_do_test<std::string, std_string_hash>(op, len3);                \
+  std::cout << "\n|    mystl::string    |";                                 \
+  short_key_do_test<mystl::string, mystl::hash<mystl::string>>(op, len1);   \
+  short_key_do_test<mystl::string, mystl::hash<mystl::string>>(op, len2);   \
+  short_key_do_test<mystl::string, mystl::hash<mystl::string>>(op, len3);
+
 void string_test()
 {
 	std::cout << "[===============================================================]" << std::endl;
@@ -178,6 +332,13 @@ void string_test()
 	FUN_VALUE(str.capacity());
 	STR_FUN_AFTER(str, str.reserve(50));
 	FUN_VALUE(str.capacity());
+	//  local_capacity ַʱڶڲ
+	FUN_VALUE(mystl::string::local_capacity);
+	FUN_VALUE(mystl::u32string::local_capacity);
+	FUN_VALUE(sizeof(mystl::string));
+	STR_FUN_AFTER(str, str = "short");
+	STR_FUN_AFTER(str, str.shrink_to_fit());
+	FUN_VALUE(str.capacity());
 	STR_FUN_AFTER(str3, str3 = "test");
 	STR_FUN_AFTER(str4, str4 = " ok!");
 	std::cout << " str3 + '!' : " << str3 + '!' << std::endl;
@@ -185,6 +346,12 @@ void string_test()
 	std::cout << " str3 + \" success\" : " << str3 + " success" << std::endl;
 	std::cout << " \"My \" + str3 : " << "My " + str3 << std::endl;
 	std::cout << " str3 + str4 : " << str3 + str4 << std::endl;
+	mystl::hash<mystl::string> hash_fcn;
+	std::cout << std::boolalpha;
+	FUN_VALUE((hash_fcn(str) == hash_fcn(mystl::string(str.c_str()))));
+	FUN_VALUE((hash_fcn(mystl::string("abc")) != hash_fcn(mystl::string("abd"))));
+	FUN_VALUE((mystl::hash<double>()(0.0) == mystl::hash<double>()(-0.0)));
+	std::cout << std::noboolalpha;
 	PASSED;
 #if PERFORMANCE_TEST_ON
 	std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -194,6 +361,56 @@ void string_test()
 	CON_TEST_P1(string, append, "s", SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
 #else
 	CON_TEST_P1(string, append, "s", SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+	std::cout << std::endl;
+	std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+	{
+		// ÿһйϣֽͬͷΪֵ
+		mystl::vector<unsigned char> buf(1 << 16);
+		for (size_t i = 0; i < buf.size(); ++i)
+			buf[i] = static_cast<unsigned char>(i * 131 + (i >> 8));
+		auto hash_fn = [](const unsigned char* p, size_t n) { return mystl::hash_bytes(p, n); };
+#if LARGER_TEST_DATA_ON
+		const size_t total = LEN3 * 100;
+#else
+		const size_t total = LEN3 * 10;
+#endif
+		std::cout << "| hash bytes / keylen |";
+		HASH_BYTES_TEST(total, 8, 32, 100);
+		std::cout << "\n|                     |";
+		HASH_BYTES_TEST(total, 256, 1000, 4096);
+		std::cout << std::endl;
+		std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+	}
+	std::cout << "| construct short key |";
+#if LARGER_TEST_DATA_ON
+	SHORT_KEY_TEST(short_key_op::construct, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+	SHORT_KEY_TEST(short_key_op::construct, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+	std::cout << std::endl;
+	std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+	std::cout << "|   copy short key    |";
+#if LARGER_TEST_DATA_ON
+	SHORT_KEY_TEST(short_key_op::copy, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+	SHORT_KEY_TEST(short_key_op::copy, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+	std::cout << std::endl;
+	std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+	std::cout << "| map<key, int> insert|";
+#if LARGER_TEST_DATA_ON
+	SHORT_KEY_TEST(short_key_op::map_insert, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+	SHORT_KEY_TEST(short_key_op::map_insert, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+	std::cout << std::endl;
+	std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+	std::cout << "|unordered_map insert |";
+#if LARGER_TEST_DATA_ON
+	SHORT_KEY_TEST(short_key_op::unordered_map_insert, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+	SHORT_KEY_TEST(short_key_op::unordered_map_insert, SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
 #endif
 	std::cout << std::endl;
 	std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
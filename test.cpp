@@ -20,6 +20,17 @@
 #include "unordered_map_test.h"
 #include "unordered_set_test.h"
 #include "string_test.h"
+#include "flat_map_test.h"
+#include "persistent_map_test.h"
+#include "interval_map_test.h"
+#include "concurrent_map_test.h"
+#include "flat_hash_map_test.h"
+#include "concurrent_hash_map_test.h"
+#include "robin_hood_map_test.h"
+#include "frozen_map_test.h"
+#include "map_image_test.h"
+#include "bloom_filter_test.h"
+#include "cuckoo_filter_test.h"
 
 
 int main()
@@ -46,6 +57,22 @@ int main()
 	unordered_set_test::unordered_set_test();
 	unordered_set_test::unordered_multiset_test();
 	string_test::string_test();
+	flat_map_test::flat_map_test();
+	flat_map_test::flat_multimap_test();
+	flat_map_test::flat_set_test();
+	persistent_map_test::persistent_map_test();
+	interval_map_test::interval_map_test();
+	interval_map_test::interval_set_test();
+	concurrent_map_test::concurrent_map_test();
+	flat_hash_map_test::flat_hash_map_test();
+	flat_hash_map_test::flat_hash_set_test();
+	concurrent_hash_map_test::concurrent_hash_map_test();
+	robin_hood_map_test::robin_hood_map_test();
+	frozen_map_test::frozen_map_test();
+	frozen_map_test::frozen_set_test();
+	map_image_test::map_image_test();
+	bloom_filter_test::bloom_filter_test();
+	cuckoo_filter_test::cuckoo_filter_test();
 	return 0;
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -44,6 +44,22 @@ struct is_pair : mystl::m_false_type {};
 
 template <typename T1, typename T2>
 struct is_pair<mystl::pair<T1, T2>> : mystl::m_true_type {};
+
+// void_t : ӳΪ void SFINAE Աͣstd::void_t Ҫ C++17 
+template <typename...>
+struct make_void { using type = void; };
+
+template <typename ...Ts>
+using void_t = typename make_void<Ts...>::type;
+
+// жϱȽϺǷ͸ is_transparent ıȽϺֱӱȽϼֵͣ
+// ʽݴṩ칹ңʱعʱļֵ
+template <typename Compare, typename = void>
+struct is_transparent_compare : mystl::m_false_type {};
+
+template <typename Compare>
+struct is_transparent_compare<Compare, mystl::void_t<typename Compare::is_transparent>>
+	: mystl::m_true_type {};
 }	//namespace mystl
 
 #endif // !MY_STL_TYPE_TRAITS_H_
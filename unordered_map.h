@@ -17,14 +17,18 @@
 namespace mystl
 {
 
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy> class unordered_multimap;
+
 // ģ unordered_mapֵظ
 // һֵͣʵֵͣϣȱʡʹ mystl::hash
 // ĴֵȽϷʽȱʡʹ mystl::equal_to
-template <typename Key, typename T, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+//  bucket ԣȱʡʹ mystl::ht_prime_policy
+template <typename Key, typename T, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>,
+	typename BucketPolicy = mystl::ht_prime_policy>
 class unordered_map
 {
 private:
-	using base_type = hashtable<mystl::pair<const Key, T>, Hash, KeyEqual>;
+	using base_type = hashtable<mystl::pair<const Key, T>, Hash, KeyEqual, BucketPolicy>;
 	base_type ht_;
 
 public:
@@ -47,8 +51,15 @@ public:
 	using local_iterator			= base_type::local_iterator;
 	using const_local_iterator		= base_type::const_local_iterator;
 
+	using node_type					= base_type::node_handle_type;
+	using insert_return_type		= base_type::insert_return_type;
+
 	allocator_type get_allocator() const { return ht_.get_allocator(); }
 
+	// merge Ҫ unordered_map / unordered_multimap  hashtable
+	template <typename, typename, typename, typename, typename> friend class unordered_map;
+	template <typename, typename, typename, typename, typename> friend class unordered_multimap;
+
 public:
 	// 졢ơƶ
     unordered_map()
@@ -214,6 +225,39 @@ public:
         ht_.clear();
     }
 
+    // ղ bucket 黹ԭΪСĸͷڴ
+    void clear_and_release()
+    {
+        ht_.clear_and_release();
+    }
+
+    // ڵزֻ޸Ӷ·ڵ㣬 hashtable
+
+    node_type extract(const_iterator position)
+    {
+        return ht_.extract(position);
+    }
+    node_type extract(const key_type& key)
+    {
+        return ht_.extract(key);
+    }
+
+    insert_return_type insert(node_type&& nh)
+    {
+        return ht_.insert_unique(mystl::move(nh));
+    }
+
+    template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+    void merge(unordered_map<Key, T, Hash2, KeyEqual2, BucketPolicy2>& source)
+    {
+        ht_.merge_unique(source.ht_);
+    }
+    template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+    void merge(unordered_multimap<Key, T, Hash2, KeyEqual2, BucketPolicy2>& source)
+    {
+        ht_.merge_unique(source.ht_);
+    }
+
     void swap(unordered_map& other) noexcept
     {
         ht_.swap(other.ht_);
@@ -262,6 +306,23 @@ public:
         return ht_.find(key);
     }
 
+    // ң˳ÿֵ find д out hashtable::find_batch
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+    {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    {
+        return ht_.find_batch(first, last, out);
+    }
+
+    void prefetch(const key_type& key) const
+    {
+        ht_.prefetch(key);
+    }
+
     pair<iterator, iterator> equal_range(const key_type& key)
     {
         return ht_.equal_range_unique(key);
@@ -273,15 +334,15 @@ public:
 
     // bucket interface
 
-    local_iterator begin(size_type n) noexcept
+    local_iterator begin(size_type n)
     {
         return ht_.begin(n);
     }
-    const_local_iterator begin(size_type n)  const noexcept
+    const_local_iterator begin(size_type n)  const
     {
         return ht_.begin(n);
     }
-    const_local_iterator cbegin(size_type n) const noexcept
+    const_local_iterator cbegin(size_type n) const
     {
         return ht_.cbegin(n);
     }
@@ -308,7 +369,7 @@ public:
         return ht_.max_bucket_count();
     }
 
-    size_type bucket_size(size_type n) const noexcept
+    size_type bucket_size(size_type n) const
     {
         return ht_.bucket_size(n);
     }
@@ -324,8 +385,20 @@ public:
     float max_load_factor() const noexcept { return ht_.max_load_factor(); }
     void max_load_factor(float ml) { ht_.max_load_factor(ml); }
 
+    // Сӣ 0 ʱӵıһβʱС
+    float min_load_factor() const noexcept { return ht_.min_load_factor(); }
+    void min_load_factor(float ml) { ht_.min_load_factor(ml); }
+
     void rehash(size_type count) { ht_.rehash(count); }
     void reserve(size_type count) { ht_.reserve(count); }
+    void shrink_to_fit() { ht_.shrink_to_fit(); }
+
+    // ʽ rehashʱһǨȫڵ㣬֮ÿβǨƼ bucket
+    bool incremental_rehash() const noexcept { return ht_.incremental_rehash(); }
+    void incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
+    // bucket ʹռõڴ
+    hashtable_stats stats() const { return ht_.stats(); }
 
     hasher hash_fcn() const { return ht_.hash_fcn(); }
     key_equal key_eq() const { return ht_.key_eq(); }
@@ -342,24 +415,24 @@ public:
 };
 
 // رȽϲ
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-    const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    const unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     return lhs == rhs;
 }
 
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-    const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    const unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     return lhs != rhs;
 }
 
 //  mystl  swap
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-    unordered_map<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+void swap(unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    unordered_map<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     lhs.swap(rhs);
 }
@@ -369,11 +442,13 @@ void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
 // ģ unordered_multimapֵظ
 // һֵͣʵֵͣϣȱʡʹ mystl::hash
 // ĴֵȽϷʽȱʡʹ mystl::equal_to
-template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+//  bucket ԣȱʡʹ mystl::ht_prime_policy
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>,
+	class BucketPolicy = mystl::ht_prime_policy>
 class unordered_multimap
 {
 private:
-	using base_type = hashtable<mystl::pair<const Key, T>, Hash, KeyEqual>;
+	using base_type = hashtable<mystl::pair<const Key, T>, Hash, KeyEqual, BucketPolicy>;
 	base_type ht_;
 
 public:
@@ -396,8 +471,13 @@ public:
 	using local_iterator			= base_type::local_iterator;
 	using const_local_iterator		= base_type::const_local_iterator;
 
+	using node_type					= base_type::node_handle_type;
+
 	allocator_type get_allocator() const { return ht_.get_allocator(); }
 
+	template <typename, typename, typename, typename, typename> friend class unordered_map;
+	template <typename, typename, typename, typename, typename> friend class unordered_multimap;
+
     // 졢ơƶ
 
     unordered_multimap()
@@ -564,6 +644,39 @@ public:
         ht_.clear();
     }
 
+    // ղ bucket 黹ԭΪСĸͷڴ
+    void clear_and_release()
+    {
+        ht_.clear_and_release();
+    }
+
+    // ڵزֻ޸Ӷ·ڵ㣬 hashtable
+
+    node_type extract(const_iterator position)
+    {
+        return ht_.extract(position);
+    }
+    node_type extract(const key_type& key)
+    {
+        return ht_.extract(key);
+    }
+
+    iterator insert(node_type&& nh)
+    {
+        return ht_.insert_multi(mystl::move(nh));
+    }
+
+    template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+    void merge(unordered_multimap<Key, T, Hash2, KeyEqual2, BucketPolicy2>& source)
+    {
+        ht_.merge_multi(source.ht_);
+    }
+    template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+    void merge(unordered_map<Key, T, Hash2, KeyEqual2, BucketPolicy2>& source)
+    {
+        ht_.merge_multi(source.ht_);
+    }
+
     void swap(unordered_multimap& other) noexcept
     {
         ht_.swap(other.ht_);
@@ -585,6 +698,23 @@ public:
         return ht_.find(key);
     }
 
+    // ң˳ÿֵ find д out hashtable::find_batch
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+    {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    {
+        return ht_.find_batch(first, last, out);
+    }
+
+    void prefetch(const key_type& key) const
+    {
+        ht_.prefetch(key);
+    }
+
     pair<iterator, iterator> equal_range(const key_type& key)
     {
         return ht_.equal_range_multi(key);
@@ -596,15 +726,15 @@ public:
 
     // bucket interface
 
-    local_iterator begin(size_type n) noexcept
+    local_iterator begin(size_type n)
     {
         return ht_.begin(n);
     }
-    const_local_iterator begin(size_type n) const noexcept
+    const_local_iterator begin(size_type n) const
     {
         return ht_.begin(n);
     }
-    const_local_iterator cbegin(size_type n) const noexcept
+    const_local_iterator cbegin(size_type n) const
     {
         return ht_.cbegin(n);
     }
@@ -631,7 +761,7 @@ public:
         return ht_.max_bucket_count();
     }
 
-    size_type bucket_size(size_type n) const noexcept
+    size_type bucket_size(size_type n) const
     {
         return ht_.bucket_size(n);
     }
@@ -647,8 +777,20 @@ public:
     float max_load_factor() const noexcept { return ht_.max_load_factor(); }
     void max_load_factor(float ml) { ht_.max_load_factor(ml); }
 
+    // Сӣ 0 ʱӵıһβʱС
+    float min_load_factor() const noexcept { return ht_.min_load_factor(); }
+    void min_load_factor(float ml) { ht_.min_load_factor(ml); }
+
     void rehash(size_type count) { ht_.rehash(count); }
     void reserve(size_type count) { ht_.reserve(count); }
+    void shrink_to_fit() { ht_.shrink_to_fit(); }
+
+    // ʽ rehashʱһǨȫڵ㣬֮ÿβǨƼ bucket
+    bool incremental_rehash() const noexcept { return ht_.incremental_rehash(); }
+    void incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
+    // bucket ʹռõڴ
+    hashtable_stats stats() const { return ht_.stats(); }
 
     hasher hash_fcn() const { return ht_.hash_fcn(); }
     key_equal key_eq() const { return ht_.key_eq(); }
@@ -665,24 +807,24 @@ public:
 };
 
 // رȽϲ
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-    const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    const unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     return lhs == rhs;
 }
 
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-    const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    const unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     return lhs != rhs;
 }
 
 //  mystl  swap
-template <typename Key, typename T, typename Hash, typename KeyEqual>
-void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-    unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename BucketPolicy>
+void swap(unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& lhs,
+    unordered_multimap<Key, T, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     lhs.swap(rhs);
 }
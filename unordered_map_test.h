@@ -1,21 +1,225 @@
 #ifndef MY_STL_UNORDERED_MAP_TEST_H_
 #define MY_STL_UNORDERED_MAP_TEST_H_
 
-// unordered_map test :  unordered_map, unordered_multimap Ľӿ insert 
+// unordered_map test :  unordered_map, unordered_multimap Ľӿ insert ܣԼͬ bucket ԡڵǷ񱣴ϣֵܡϡıʽ rehash Ĳӳ١ɾ bucket Ļ
 
+#include <chrono>
 #include <unordered_map>
 
+#include "astring.h"
 #include "unordered_map.h"
 #include "map_test.h"
 #include "test.h"
 
 namespace mystl
 {
+
+// ڵ㲻ϣֵַϣڶԱȱϣֵЧ
+struct string_hash_no_cache :public mystl::hash<mystl::string> {};
+
+template <>
+struct ht_cache_hash_code<string_hash_no_cache> :public m_false_type {};
+
 namespace test
 {
 namespace unordered_map_test
 {
 
+//  count ֵңʱ
+template <typename Map, typename KeyOf>
+void insert_find_do_test(size_t count, KeyOf key_of)
+{
+    clock_t start, end;
+    char buf[10];
+    Map m;
+    size_t hits = 0;
+    start = clock();
+    for (size_t i = 0; i < count; ++i)
+        m.emplace(key_of(i), static_cast<int>(i));
+    for (size_t i = 0; i < count; ++i)
+        hits += m.count(key_of(i));
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  bucket ܶԪϡıзɾ begin()ʱ
+template <typename Map>
+void erase_begin_do_test(size_t count)
+{
+    clock_t start, end;
+    char buf[10];
+    Map m;
+    m.reserve(count * 16);
+    for (size_t i = 0; i < count; ++i)
+        m.emplace(static_cast<int>(i), static_cast<int>(i));
+    start = clock();
+    while (!m.empty())
+        m.erase(m.begin());
+    end = clock();
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  count ֵ¼ÿβĺʱ p99.9 ʱ΢룩
+mystl::pair<double, double> insert_latency_do_test(size_t count, bool incremental)
+{
+    mystl::unordered_map<int, int> m;
+    m.incremental_rehash(incremental);
+    mystl::vector<double> cost(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto key = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+        const auto start = std::chrono::steady_clock::now();
+        m.emplace(key, static_cast<int>(i));
+        const auto end = std::chrono::steady_clock::now();
+        cost[i] = std::chrono::duration<double, std::micro>(end - start).count();
+    }
+    mystl::sort(cost.begin(), cost.end());
+    return mystl::make_pair(cost[count - count / 1000 - 1], cost[count - 1]);
+}
+
+// һβĺʱ 1ms ʱԺΪλ
+void latency_do_print(double us)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%.2f", us < 1000.0 ? us : us / 1000.0);
+    std::string t = buf;
+    t += us < 1000.0 ? "us    |" : "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// һ rehash 뽥ʽ rehash ĲӳٶԱȣһǨֻӰβ룬Ҫʱ
+void insert_latency_test(size_t len1, size_t len2, size_t len3)
+{
+    const size_t lens[3] = { len1, len2, len3 };
+    // mystl::pair ĬϹ죬ֱ𱣴 p99.9 ʱ
+    double once_p999[3], once_max[3], inc_p999[3], inc_max[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto once = insert_latency_do_test(lens[i], false);
+        const auto incremental = insert_latency_do_test(lens[i], true);
+        once_p999[i] = once.first;
+        once_max[i] = once.second;
+        inc_p999[i] = incremental.first;
+        inc_max[i] = incremental.second;
+    }
+    TEST_LEN(len1, len2, len3, WIDE);
+    std::cout << "|  all-at-once p99.9  |";
+    for (int i = 0; i < 3; ++i)
+        latency_do_print(once_p999[i]);
+    std::cout << "\n|  incremental p99.9  |";
+    for (int i = 0; i < 3; ++i)
+        latency_do_print(inc_p999[i]);
+    std::cout << "\n|   all-at-once max   |";
+    for (int i = 0; i < 3; ++i)
+        latency_do_print(once_max[i]);
+    std::cout << "\n|   incremental max   |";
+    for (int i = 0; i < 3; ++i)
+        latency_do_print(inc_max[i]);
+}
+
+//  count Ԫصıа˳ȫֵbatch Ϊ true ʱʹ find_batchֻͳƲҵĺʱ
+// Զڻʱ find ÿβҶҪεȴ bucket ڵĻȱʧ
+void find_batch_do_test(size_t count, bool batch)
+{
+    clock_t start, end;
+    char buf[10];
+    mystl::unordered_map<int, int> m;
+    mystl::vector<int> keys(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        keys[i] = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+        m.emplace(keys[i], static_cast<int>(i));
+    }
+    // rand() ڲƽֻ̨ 15 λԼңڵĲڴԶĽڵ
+    uint32_t seed = 1;
+    auto rng = [&seed](ptrdiff_t n)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<ptrdiff_t>((static_cast<uint64_t>(seed) * static_cast<uint64_t>(n)) >> 32);
+    };
+    mystl::random_shuffle(keys.begin(), keys.end(), rng);
+    mystl::vector<mystl::unordered_map<int, int>::iterator> result(count);
+    size_t hits = 0;
+    start = clock();
+    if (batch)
+    {
+        m.find_batch(keys.begin(), keys.end(), result.begin());
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+            result[i] = m.find(keys[i]);
+    }
+    for (size_t i = 0; i < count; ++i)
+        hits += result[i]->second;
+    end = clock();
+    volatile size_t sink = hits;
+    (void)sink;
+    int n = static_cast<int>(static_cast<double>(end - start)
+        / CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+//  count Ԫغɾе 99%ٲһԪأʱ bucket ռõڴ
+// mode Ϊ 0 ʱգΪ 1 ʱСӣΪ 2 ʱɾ shrink_to_fit
+void burst_memory_do_test(size_t count, int mode)
+{
+    char buf[16];
+    mystl::unordered_map<int, int> m;
+    if (mode == 1)
+        m.min_load_factor(0.1f);
+    for (size_t i = 0; i < count; ++i)
+        m.emplace(static_cast<int>(i), static_cast<int>(i));
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % 100 != 0)
+            m.erase(static_cast<int>(i));
+    }
+    if (mode == 2)
+        m.shrink_to_fit();
+    m.emplace(-1, -1);
+    const auto kb = static_cast<int>(m.stats().bucket_bytes / 1024);
+    std::snprintf(buf, sizeof(buf), "%d", kb);
+    std::string t = buf;
+    t += "KB    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+template <typename Key, typename KeyOf>
+void bucket_policy_test(size_t len1, size_t len2, size_t len3, KeyOf key_of)
+{
+    TEST_LEN(len1, len2, len3, WIDE);
+    std::cout << "|   ht_prime_policy   |";
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_prime_policy>>(len1, key_of);
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_prime_policy>>(len2, key_of);
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_prime_policy>>(len3, key_of);
+    std::cout << "\n|   ht_pow2_policy    |";
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_pow2_policy>>(len1, key_of);
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_pow2_policy>>(len2, key_of);
+    insert_find_do_test<mystl::unordered_map<Key, int, mystl::hash<Key>,
+        mystl::equal_to<Key>, mystl::ht_pow2_policy>>(len3, key_of);
+}
+
 void unordered_map_test()
 {
     std::cout << "[===============================================================]" << std::endl;
@@ -90,6 +294,71 @@ void unordered_map_test()
     FUN_VALUE(um1.max_load_factor());
     MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
     FUN_VALUE(um1.max_load_factor());
+    mystl::unordered_map<int, int> um15{ PAIR(1,1),PAIR(2,2),PAIR(3,3) };
+    mystl::unordered_map<int, int> um16{ PAIR(3,0),PAIR(4,4) };
+    MAP_FUN_AFTER(um15, um15.merge(um16));
+    MAP_COUT(um16);
+    auto nh = um15.extract(1);
+    nh.key() = 5;
+    MAP_FUN_AFTER(um15, um15.insert(mystl::move(nh)));
+    FUN_VALUE(um16.insert(um15.extract(3)).inserted);
+    MAP_COUT(um15);
+    mystl::unordered_map<int, int, mystl::hash<int>, mystl::equal_to<int>, mystl::ht_pow2_policy> um17(v.begin(), v.end());
+    FUN_VALUE(um17.bucket_count());
+    MAP_FUN_AFTER(um17, um17.reserve(100));
+    FUN_VALUE(um17.bucket_count());
+    MAP_FUN_AFTER(um17, um17.merge(um15));
+    FUN_VALUE(um17.count(5));
+    mystl::unordered_map<int, int> um18;
+    um18.incremental_rehash(true);
+    for (int i = 0; i < 100; ++i)
+        um18.emplace(i, i);
+    FUN_VALUE(um18.bucket_count());
+    FUN_VALUE(um18.count(50));
+    // Ǩ;ͨ const ÷ bucket bucket Ԫظ֮Ӧ size
+    const auto& cum18 = um18;
+    size_t bucket_total = 0;
+    for (size_t n = 0; n < cum18.bucket_count(); ++n)
+        bucket_total += cum18.bucket_size(n);
+    FUN_VALUE(bucket_total);
+    for (int i = 0; i < 95; ++i)
+        um18.erase(i);
+    MAP_COUT(um18);
+    int keys[] = { 95, 3, 99, 120 };
+    mystl::vector<mystl::unordered_map<int, int>::iterator> found(4);
+    um18.find_batch(keys, keys + 4, found.begin());
+    um18.prefetch(97);
+    std::cout << std::boolalpha;
+    FUN_VALUE(found[0]->second);
+    FUN_VALUE((found[1] == um18.end()));
+    FUN_VALUE(found[2]->second);
+    FUN_VALUE((found[3] == um18.end()));
+    std::cout << std::noboolalpha;
+    mystl::unordered_map<int, int> um19;
+    for (int i = 0; i < 10000; ++i)
+        um19.emplace(i, i);
+    for (int i = 10; i < 10000; ++i)
+        um19.erase(i);
+    FUN_VALUE(um19.bucket_count());
+    um19.shrink_to_fit();
+    FUN_VALUE(um19.bucket_count());
+    FUN_VALUE(um19.count(5));
+    auto st = um19.stats();
+    std::cout << " um19.stats() : size " << st.size << ", buckets " << st.bucket_count
+        << ", used " << st.used_buckets << ", longest " << st.max_bucket_size
+        << ", bucket bytes " << st.bucket_bytes << std::endl;
+    um19.min_load_factor(0.25f);
+    FUN_VALUE(um19.min_load_factor());
+    for (int i = 0; i < 10000; ++i)
+        um19.emplace(i, i);
+    for (int i = 10; i < 10000; ++i)
+        um19.erase(i);
+    FUN_VALUE(um19.bucket_count());
+    MAP_FUN_AFTER(um19, um19.emplace(10, 10));
+    FUN_VALUE(um19.bucket_count());
+    um19.clear_and_release();
+    FUN_VALUE(um19.size());
+    FUN_VALUE(um19.bucket_count());
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -102,6 +371,90 @@ void unordered_map_test()
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    {
+#if LARGER_TEST_DATA_ON
+        const size_t len1 = SCALE_M(LEN1), len2 = SCALE_M(LEN2), len3 = SCALE_M(LEN3);
+#else
+        const size_t len1 = SCALE_S(LEN1), len2 = SCALE_S(LEN2), len3 = SCALE_S(LEN3);
+#endif
+        // ֵ˳ֵָȡĶ󣬵λͬ
+        mystl::vector<double> objs(len3);
+        std::cout << "| int insert + find   |";
+        bucket_policy_test<int>(len1, len2, len3,
+            [](size_t i) { return static_cast<int>(static_cast<uint32_t>(i) * 2654435761u); });
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        std::cout << "| ptr insert + find   |";
+        bucket_policy_test<double*>(len1, len2, len3,
+            [&objs](size_t i) { return &objs[i]; });
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        // ֵַȽϽڵ㱣벻ϣֵ
+        mystl::vector<mystl::string> keys(len3);
+        for (size_t i = 0; i < len3; ++i)
+        {
+            char key[32];
+            std::snprintf(key, sizeof(key), "unordered_map_key_%zu", i);
+            keys[i] = key;
+        }
+        auto key_of = [&keys](size_t i) -> const mystl::string& { return keys[i]; };
+        std::cout << "| str insert + find   |";
+        TEST_LEN(len1, len2, len3, WIDE);
+        std::cout << "|   cache hash code   |";
+        insert_find_do_test<mystl::unordered_map<mystl::string, int>>(len1, key_of);
+        insert_find_do_test<mystl::unordered_map<mystl::string, int>>(len2, key_of);
+        insert_find_do_test<mystl::unordered_map<mystl::string, int>>(len3, key_of);
+        std::cout << "\n|  no hash code cache |";
+        insert_find_do_test<mystl::unordered_map<mystl::string, int, string_hash_no_cache>>(len1, key_of);
+        insert_find_do_test<mystl::unordered_map<mystl::string, int, string_hash_no_cache>>(len2, key_of);
+        insert_find_do_test<mystl::unordered_map<mystl::string, int, string_hash_no_cache>>(len3, key_of);
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        std::cout << "| erase(begin()) loop |";
+        TEST_LEN(len1 / 10, len2 / 10, len3 / 10, WIDE);
+        std::cout << "|         std         |";
+        erase_begin_do_test<std::unordered_map<int, int>>(len1 / 10);
+        erase_begin_do_test<std::unordered_map<int, int>>(len2 / 10);
+        erase_begin_do_test<std::unordered_map<int, int>>(len3 / 10);
+        std::cout << "\n|        mystl        |";
+        erase_begin_do_test<mystl::unordered_map<int, int>>(len1 / 10);
+        erase_begin_do_test<mystl::unordered_map<int, int>>(len2 / 10);
+        erase_begin_do_test<mystl::unordered_map<int, int>>(len3 / 10);
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        std::cout << "| insert latency      |";
+        insert_latency_test(len1, len2, len3);
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        std::cout << "| random find         |";
+        TEST_LEN(len1, len2, len3, WIDE);
+        std::cout << "|   find one by one   |";
+        find_batch_do_test(len1, false);
+        find_batch_do_test(len2, false);
+        find_batch_do_test(len3, false);
+        std::cout << "\n|     find_batch      |";
+        find_batch_do_test(len1, true);
+        find_batch_do_test(len2, true);
+        find_batch_do_test(len3, true);
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+        std::cout << "| buckets after burst |";
+        TEST_LEN(len1, len2, len3, WIDE);
+        std::cout << "|     no shrink       |";
+        burst_memory_do_test(len1, 0);
+        burst_memory_do_test(len2, 0);
+        burst_memory_do_test(len3, 0);
+        std::cout << "\n| min load factor .1  |";
+        burst_memory_do_test(len1, 1);
+        burst_memory_do_test(len2, 1);
+        burst_memory_do_test(len3, 1);
+        std::cout << "\n|    shrink_to_fit    |";
+        burst_memory_do_test(len1, 2);
+        burst_memory_do_test(len2, 2);
+        burst_memory_do_test(len3, 2);
+        std::cout << std::endl;
+        std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    }
     PASSED;
 #endif
     std::cout << "[-------------- End container test : unordered_map -------------]" << std::endl;
@@ -179,6 +532,13 @@ void unordered_multimap_test()
     FUN_VALUE(um1.max_load_factor());
     MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
     FUN_VALUE(um1.max_load_factor());
+    mystl::unordered_multimap<int, int> um15{ PAIR(1,1),PAIR(2,2),PAIR(3,3) };
+    mystl::unordered_map<int, int> um16{ PAIR(3,0),PAIR(4,4) };
+    MAP_FUN_AFTER(um15, um15.merge(um16));
+    MAP_COUT(um16);
+    auto nh = um15.extract(3);
+    nh.key() = 5;
+    MAP_FUN_AFTER(um15, um15.insert(mystl::move(nh)));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
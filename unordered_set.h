@@ -17,14 +17,18 @@
 namespace mystl 
 {
 
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy> class unordered_multiset;
+
 // ģ unordered_setֵظ
 // һֵͣϣȱʡʹ mystl::hash
 // ֵȽϷʽȱʡʹ mystl::equal_to
-template <typename Key, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+// Ĵ bucket ԣȱʡʹ mystl::ht_prime_policy
+template <typename Key, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>,
+	typename BucketPolicy = mystl::ht_prime_policy>
 class unordered_set
 {
 private:
-	using base_type = hashtable<Key, Hash, KeyEqual>;
+	using base_type = hashtable<Key, Hash, KeyEqual, BucketPolicy>;
 	base_type ht_;
 
 public:
@@ -46,8 +50,15 @@ public:
 	using local_iterator			= base_type::const_local_iterator;
 	using const_local_iterator		= base_type::const_local_iterator;
 
+	using node_type					= base_type::node_handle_type;
+	using insert_return_type		= mystl::node_insert_return<iterator, node_type>;
+
 	allocator_type get_allocator() const { return ht_.get_allocator(); }
 
+	// merge Ҫ unordered_set / unordered_multiset  hashtable
+	template <typename, typename, typename, typename> friend class unordered_set;
+	template <typename, typename, typename, typename> friend class unordered_multiset;
+
 public:
 
 	unordered_set() : ht_(100, Hash(), KeyEqual()) {}
@@ -201,6 +212,40 @@ public:
 		ht_.clear();
 	}
 
+	// ղ bucket 黹ԭΪСĸͷڴ
+	void clear_and_release()
+	{
+		ht_.clear_and_release();
+	}
+
+	// ڵزֻ޸Ӷ·ڵ㣬 hashtable
+
+	node_type extract(const_iterator position)
+	{
+		return ht_.extract(position);
+	}
+	node_type extract(const key_type& key)
+	{
+		return ht_.extract(key);
+	}
+
+	insert_return_type insert(node_type&& nh)
+	{
+		auto res = ht_.insert_unique(mystl::move(nh));
+		return insert_return_type{ res.position, res.inserted, mystl::move(res.node) };
+	}
+
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge(unordered_set<Key, Hash2, KeyEqual2, BucketPolicy2>& source)
+	{
+		ht_.merge_unique(source.ht_);
+	}
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge(unordered_multiset<Key, Hash2, KeyEqual2, BucketPolicy2>& source)
+	{
+		ht_.merge_unique(source.ht_);
+	}
+
 	void swap(unordered_set& other) noexcept
 	{
 		ht_.swap(other.ht_);
@@ -222,6 +267,23 @@ public:
 		return ht_.find(key);
 	}
 
+	// ң˳ÿֵ find д out hashtable::find_batch
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+	{
+		return ht_.find_batch(first, last, out);
+	}
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		return ht_.find_batch(first, last, out);
+	}
+
+	void prefetch(const key_type& key) const
+	{
+		ht_.prefetch(key);
+	}
+
 	pair<iterator, iterator> equal_range(const key_type& key)
 	{
 		return ht_.equal_range_unique(key);
@@ -233,15 +295,15 @@ public:
 
 	// bucket interface
 
-	local_iterator begin(size_type n) noexcept
+	local_iterator begin(size_type n)
 	{
 		return ht_.begin(n);
 	}
-	const_local_iterator begin(size_type n) const noexcept
+	const_local_iterator begin(size_type n) const
 	{
 		return ht_.begin(n);
 	}
-	const_local_iterator cbegin(size_type n) const noexcept
+	const_local_iterator cbegin(size_type n) const
 	{
 		return ht_.cbegin(n);
 	}
@@ -268,7 +330,7 @@ public:
 		return ht_.max_bucket_count();
 	}
 
-	size_type bucket_size(size_type n) const noexcept
+	size_type bucket_size(size_type n) const
 	{
 		return ht_.bucket_size(n);
 	}
@@ -283,8 +345,20 @@ public:
 	float max_load_factor() const noexcept { return ht_.max_load_factor(); }
 	void max_load_factor(float ml) { ht_.max_load_factor(ml); }
 
+	// Сӣ 0 ʱӵıһβʱС
+	float min_load_factor() const noexcept { return ht_.min_load_factor(); }
+	void min_load_factor(float ml) { ht_.min_load_factor(ml); }
+
 	void rehash(size_type count) { ht_.rehash(count); }
 	void reserve(size_type count) { ht_.reserve(count); }
+	void shrink_to_fit() { ht_.shrink_to_fit(); }
+
+	// ʽ rehashʱһǨȫڵ㣬֮ÿβǨƼ bucket
+	bool incremental_rehash() const noexcept { return ht_.incremental_rehash(); }
+	void incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
+	// bucket ʹռõڴ
+	hashtable_stats stats() const { return ht_.stats(); }
 
 	hasher hash_fcn() const { return ht_.hash_fcn(); }
 	key_equal key_eq() const { return ht_.key_eq(); }
@@ -301,24 +375,24 @@ public:
 
 
 // رȽϲ
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
-	const unordered_set<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator==(const unordered_set<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	const unordered_set<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
-	const unordered_set<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	const unordered_set<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	return lhs != rhs;
 }
 
 //  mystl  swap
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
-	unordered_set<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+void swap(unordered_set<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	unordered_set<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	lhs.swap(rhs);
 }
@@ -329,11 +403,13 @@ void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
 // ģ unordered_multisetֵظ
 // һֵͣϣȱʡʹ mystl::hash
 // ֵȽϷʽȱʡʹ mystl::equal_to
-template <typename Key, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>>
+// Ĵ bucket ԣȱʡʹ mystl::ht_prime_policy
+template <typename Key, typename Hash = mystl::hash<Key>, typename KeyEqual = mystl::equal_to<Key>,
+	typename BucketPolicy = mystl::ht_prime_policy>
 class unordered_multiset
 {
 private :
-	using base_type = hashtable<Key, Hash, KeyEqual>;
+	using base_type = hashtable<Key, Hash, KeyEqual, BucketPolicy>;
 	base_type ht_;
 
 public:
@@ -355,8 +431,13 @@ public:
 	using local_iterator			= base_type::const_local_iterator;
 	using const_local_iterator		= base_type::const_local_iterator;
 
+	using node_type					= base_type::node_handle_type;
+
 	allocator_type get_allocator() const { return ht_.get_allocator(); }
 
+	template <typename, typename, typename, typename> friend class unordered_set;
+	template <typename, typename, typename, typename> friend class unordered_multiset;
+
 public:
 	unordered_multiset(): ht_(100, Hash(), KeyEqual()) {}
 
@@ -520,6 +601,39 @@ public:
 		ht_.clear();
 	}
 
+	// ղ bucket 黹ԭΪСĸͷڴ
+	void clear_and_release()
+	{
+		ht_.clear_and_release();
+	}
+
+	// ڵزֻ޸Ӷ·ڵ㣬 hashtable
+
+	node_type extract(const_iterator position)
+	{
+		return ht_.extract(position);
+	}
+	node_type extract(const key_type& key)
+	{
+		return ht_.extract(key);
+	}
+
+	iterator insert(node_type&& nh)
+	{
+		return ht_.insert_multi(mystl::move(nh));
+	}
+
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge(unordered_multiset<Key, Hash2, KeyEqual2, BucketPolicy2>& source)
+	{
+		ht_.merge_multi(source.ht_);
+	}
+	template <typename Hash2, typename KeyEqual2, typename BucketPolicy2>
+	void merge(unordered_set<Key, Hash2, KeyEqual2, BucketPolicy2>& source)
+	{
+		ht_.merge_multi(source.ht_);
+	}
+
 	void swap(unordered_multiset& other) noexcept
 	{
 		ht_.swap(other.ht_);
@@ -541,6 +655,23 @@ public:
 		return ht_.find(key);
 	}
 
+	// ң˳ÿֵ find д out hashtable::find_batch
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+	{
+		return ht_.find_batch(first, last, out);
+	}
+	template <class ForwardIter, class OutputIter>
+	OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+	{
+		return ht_.find_batch(first, last, out);
+	}
+
+	void prefetch(const key_type& key) const
+	{
+		ht_.prefetch(key);
+	}
+
 	pair<iterator, iterator> equal_range(const key_type& key)
 	{
 		return ht_.equal_range_multi(key);
@@ -552,15 +683,15 @@ public:
 
 	// bucket interface
 
-	local_iterator begin(size_type n) noexcept
+	local_iterator begin(size_type n)
 	{
 		return ht_.begin(n);
 	}
-	const_local_iterator begin(size_type n) const noexcept
+	const_local_iterator begin(size_type n) const
 	{
 		return ht_.begin(n);
 	}
-	const_local_iterator cbegin(size_type n) const noexcept
+	const_local_iterator cbegin(size_type n) const
 	{
 		return ht_.cbegin(n);
 	}
@@ -587,7 +718,7 @@ public:
 		return ht_.max_bucket_count();
 	}
 
-	size_type bucket_size(size_type n) const noexcept
+	size_type bucket_size(size_type n) const
 	{
 		return ht_.bucket_size(n);
 	}
@@ -603,8 +734,20 @@ public:
 	float max_load_factor() const noexcept { return ht_.max_load_factor(); }
 	void max_load_factor(float ml) { ht_.max_load_factor(ml); }
 
+	// Сӣ 0 ʱӵıһβʱС
+	float min_load_factor() const noexcept { return ht_.min_load_factor(); }
+	void min_load_factor(float ml) { ht_.min_load_factor(ml); }
+
 	void rehash(size_type count) { ht_.rehash(count); }
 	void reserve(size_type count) { ht_.reserve(count); }
+	void shrink_to_fit() { ht_.shrink_to_fit(); }
+
+	// ʽ rehashʱһǨȫڵ㣬֮ÿβǨƼ bucket
+	bool incremental_rehash() const noexcept { return ht_.incremental_rehash(); }
+	void incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
+	// bucket ʹռõڴ
+	hashtable_stats stats() const { return ht_.stats(); }
 
 	hasher hash_fcn() const { return ht_.hash_fcn(); }
 	key_equal key_eq() const { return ht_.key_eq(); }
@@ -621,24 +764,24 @@ public:
 };
 
 // رȽϲ
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-	const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator==(const unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	const unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	return lhs == rhs;
 }
 
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-	const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	const unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	return lhs != rhs;
 }
 
 //  mystl  swap
-template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
-void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs,
-	unordered_multiset<Key, Hash, KeyEqual>& rhs)
+template <typename Key, typename Hash, typename KeyEqual, typename BucketPolicy>
+void swap(unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& lhs,
+	unordered_multiset<Key, Hash, KeyEqual, BucketPolicy>& rhs)
 {
 	lhs.swap(rhs);
 }
@@ -84,6 +84,15 @@ void unordered_set_test()
 	FUN_VALUE(us1.max_load_factor());
 	FUN_AFTER(us1, us1.max_load_factor(1.5f));
 	FUN_VALUE(us1.max_load_factor());
+	mystl::unordered_set<int> us15{ 1,2,3 };
+	mystl::unordered_set<int> us16{ 3,4 };
+	FUN_AFTER(us15, us15.merge(us16));
+	COUT(us16);
+	auto nh = us15.extract(1);
+	nh.value() = 5;
+	FUN_AFTER(us15, us15.insert(mystl::move(nh)));
+	FUN_VALUE(us16.insert(us15.extract(3)).inserted);
+	COUT(us15);
 	PASSED;
 #if PERFORMANCE_TEST_ON
 	std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -168,6 +177,13 @@ void unordered_multiset_test()
 	FUN_VALUE(us1.max_load_factor());
 	FUN_AFTER(us1, us1.max_load_factor(1.5f));
 	FUN_VALUE(us1.max_load_factor());
+	mystl::unordered_multiset<int> us15{ 1,2,3 };
+	mystl::unordered_set<int> us16{ 3,4 };
+	FUN_AFTER(us15, us15.merge(us16));
+	COUT(us16);
+	auto nh = us15.extract(3);
+	nh.value() = 5;
+	FUN_AFTER(us15, us15.insert(mystl::move(nh)));
 	PASSED;
 #if PERFORMANCE_TEST_ON
 	std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
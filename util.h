@@ -134,7 +134,7 @@ using decay_t = decay<T>::type;
 
 //move
 template <typename T>
-remove_reference_t<T>&& move(T&& __t) noexcept
+constexpr remove_reference_t<T>&& move(T&& __t) noexcept
 {
     return static_cast<remove_reference_t<T>&&>(__t);
 }
@@ -142,13 +142,13 @@ remove_reference_t<T>&& move(T&& __t) noexcept
 // forward
 
 template <typename T>
-T&& forward(remove_reference_t<T>& arg) noexcept
+constexpr T&& forward(remove_reference_t<T>& arg) noexcept
 {
     return static_cast<T&&>(arg);
 }
 
 template <typename T>
-T&& forward(remove_reference_t<T>&& arg) noexcept
+constexpr T&& forward(remove_reference_t<T>&& arg) noexcept
 {
     //static_assert(!is_lvalue_reference_v<T>, "bad forward");
     static_assert(!mystl::is_lvalue_reference<T>::value, "bad forward");